@@ -0,0 +1,106 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/func/functor_arrfunc.hpp>
+#include <dynd/func/lift_arrfunc.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t sizes[] = {1024, 65536, 1048576};
+
+/**
+ * The arithmetic benchmarks are in three layouts, to compare the
+ * unit-stride loops with the general strided loop: both operands
+ * contiguous, the second operand a broadcast scalar, and both operands
+ * with a stride of two elements.
+ */
+template <class T>
+static void bench_add(bench::state &st, bool broadcast, bool strided)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<T>(strided ? 2 * size : size);
+    nd::array b = bench::make_pattern_array<T>(strided ? 2 * size : size);
+    nd::array c = nd::empty(size, ndt::make_type<T>());
+    if (strided) {
+        a = a(irange().by(2));
+        b = b(irange().by(2));
+    }
+    if (broadcast) {
+        b = nd::array(static_cast<T>(3));
+    }
+    nd::array expr = a + b;
+    while (st.keep_running()) {
+        c.val_assign(expr);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration((broadcast ? 2 : 3) * size * sizeof(T));
+}
+
+DYND_BENCHMARK_ARGS(add_float64_contiguous, sizes)
+{
+    bench_add<double>(st, false, false);
+}
+
+DYND_BENCHMARK_ARGS(add_float64_broadcast, sizes)
+{
+    bench_add<double>(st, true, false);
+}
+
+DYND_BENCHMARK_ARGS(add_float64_strided, sizes)
+{
+    bench_add<double>(st, false, true);
+}
+
+DYND_BENCHMARK_ARGS(add_int32_contiguous, sizes)
+{
+    bench_add<int32_t>(st, false, false);
+}
+
+DYND_BENCHMARK_ARGS(add_int32_broadcast, sizes)
+{
+    bench_add<int32_t>(st, true, false);
+}
+
+DYND_BENCHMARK_ARGS(add_int32_strided, sizes)
+{
+    bench_add<int32_t>(st, false, true);
+}
+
+DYND_BENCHMARK_ARGS(multiply_float32_contiguous, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<float>(size);
+    nd::array b = bench::make_pattern_array<float>(size);
+    nd::array c = nd::empty(size, ndt::make_type<float>());
+    nd::array expr = a * b;
+    while (st.keep_running()) {
+        c.val_assign(expr);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(3 * size * sizeof(float));
+}
+
+static double axpy(double x, double y)
+{
+    return 2.5 * x + y;
+}
+
+DYND_BENCHMARK_ARGS(functor_axpy_contiguous, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc af = lift_arrfunc(nd::make_functor_arrfunc(&axpy));
+    nd::array a = bench::make_pattern_array<double>(size);
+    nd::array b = bench::make_pattern_array<double>(size);
+    while (st.keep_running()) {
+        nd::array c = af(a, b);
+        bench::do_not_optimize(c.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(3 * size * sizeof(double));
+}
@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/types/string_type.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t sizes[] = {1024, 65536, 1048576};
+
+/**
+ * Assignment from a contiguous array of Src to a contiguous array of Dst,
+ * through the builtin assignment table.
+ */
+template <class Dst, class Src>
+static void bench_builtin_assign(bench::state &st)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<Src>(size);
+    nd::array b = nd::empty(size, ndt::make_type<Dst>());
+    while (st.keep_running()) {
+        b.val_assign(a);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * (sizeof(Src) + sizeof(Dst)));
+}
+
+DYND_BENCHMARK_ARGS(assign_float64_float64, sizes)
+{
+    bench_builtin_assign<double, double>(st);
+}
+
+DYND_BENCHMARK_ARGS(assign_int64_int32, sizes)
+{
+    bench_builtin_assign<int64_t, int32_t>(st);
+}
+
+DYND_BENCHMARK_ARGS(assign_float64_int8, sizes)
+{
+    bench_builtin_assign<double, int8_t>(st);
+}
+
+DYND_BENCHMARK_ARGS(assign_float32_float64, sizes)
+{
+    bench_builtin_assign<float, double>(st);
+}
+
+DYND_BENCHMARK_ARGS(assign_int16_float32, sizes)
+{
+    bench_builtin_assign<int16_t, float>(st);
+}
+
+DYND_BENCHMARK_ARGS(assign_strided_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<double>(2 * size);
+    nd::array b = nd::empty(size, ndt::make_type<double>());
+    nd::array a_strided = a(irange().by(2));
+    while (st.keep_running()) {
+        b.val_assign(a_strided);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(2 * size * sizeof(double));
+}
+
+/**
+ * A chain of conversions between mixed widths, int8 -> float64 -> int16
+ * -> float32, which is evaluated through buffered expression kernels
+ * in chunks.
+ */
+DYND_BENCHMARK_ARGS(convert_chain_int8_to_float32, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<int8_t>(size);
+    nd::array b = nd::empty(size, ndt::make_type<float>());
+    nd::array expr = a.ucast<double>().ucast<int16_t>().ucast<float>();
+    while (st.keep_running()) {
+        b.val_assign(expr);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * (sizeof(int8_t) + sizeof(float)));
+}
+
+DYND_BENCHMARK_ARGS(convert_chain_float64_to_int64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<double>(size);
+    nd::array b = nd::empty(size, ndt::make_type<int64_t>());
+    nd::array expr = a.ucast<float>().ucast<int32_t>().ucast<int64_t>();
+    while (st.keep_running()) {
+        b.val_assign(expr);
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * (sizeof(double) + sizeof(int64_t)));
+}
+
+DYND_BENCHMARK_ARGS(convert_int32_to_string, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<int32_t>(size, 1000000);
+    nd::array b = nd::empty(size, ndt::make_string());
+    while (st.keep_running()) {
+        b.val_assign(a);
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(convert_string_to_int32, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<int32_t>(size, 1000000)
+                      .ucast(ndt::make_string())
+                      .eval();
+    nd::array b = nd::empty(size, ndt::make_type<int32_t>());
+    while (st.keep_running()) {
+        b.val_assign(a);
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(convert_string_to_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = bench::make_pattern_array<double>(size, 1000000)
+                      .ucast(ndt::make_string())
+                      .eval();
+    nd::array b = nd::empty(size, ndt::make_type<double>());
+    while (st.keep_running()) {
+        b.val_assign(a);
+    }
+    st.set_items_per_iteration(size);
+}
@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/array.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+#include <dynd/func/rolling_arrfunc.hpp>
+#include <dynd/func/take_arrfunc.hpp>
+#include <dynd/func/sort_arrfunc.hpp>
+#include <dynd/func/comparison_arrfunc.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t sizes[] = {1024, 65536, 1048576};
+
+DYND_BENCHMARK_ARGS(sum1d_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc sum_1d = kernels::make_builtin_sum1d_arrfunc(float64_type_id);
+    nd::array a = bench::make_pattern_array<double>(size);
+    while (st.keep_running()) {
+        nd::array s = sum_1d(a);
+        bench::do_not_optimize(s.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * sizeof(double));
+}
+
+DYND_BENCHMARK_ARGS(sum1d_int32, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc sum_1d = kernels::make_builtin_sum1d_arrfunc(int32_type_id);
+    nd::array a = bench::make_pattern_array<int32_t>(size);
+    while (st.keep_running()) {
+        nd::array s = sum_1d(a);
+        bench::do_not_optimize(s.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * sizeof(int32_t));
+}
+
+DYND_BENCHMARK_ARGS(rolling_mean_float64_window16, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc rolling_mean = make_rolling_arrfunc(
+        kernels::make_builtin_mean1d_arrfunc(float64_type_id, 0), 16);
+    nd::array a = bench::make_pattern_array<double>(size);
+    while (st.keep_running()) {
+        nd::array r = rolling_mean(a);
+        bench::do_not_optimize(r.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * sizeof(double));
+}
+
+DYND_BENCHMARK_ARGS(take_indexed_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc take = kernels::make_take_arrfunc();
+    nd::array a = bench::make_pattern_array<double>(size);
+    // A scattered gather of every element
+    nd::array idx = nd::empty(size, ndt::make_type<intptr_t>());
+    intptr_t *idx_data =
+        reinterpret_cast<intptr_t *>(idx.get_readwrite_originptr());
+    for (intptr_t i = 0; i < size; ++i) {
+        idx_data[i] = (i * 7919) % size;
+    }
+    while (st.keep_running()) {
+        nd::array r = take(a, idx);
+        bench::do_not_optimize(r.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(take_masked_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc take = kernels::make_take_arrfunc();
+    nd::arrfunc less = kernels::make_comparison_arrfunc(comparison_type_less);
+    nd::array a = bench::make_pattern_array<double>(size);
+    nd::array mask = less(a, 50.0);
+    while (st.keep_running()) {
+        nd::array r = take(a, mask);
+        bench::do_not_optimize(r.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(compare_less_float64, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc less = kernels::make_comparison_arrfunc(comparison_type_less);
+    nd::array a = bench::make_pattern_array<double>(size);
+    nd::array b = bench::make_pattern_array<double>(size, 77);
+    while (st.keep_running()) {
+        nd::array mask = less(a, b);
+        bench::do_not_optimize(mask.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(2 * size * sizeof(double));
+}
+
+DYND_BENCHMARK_ARGS(sort_int32, sizes)
+{
+    intptr_t size = st.arg();
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    nd::array a = bench::make_pattern_array<int32_t>(size, 1000003);
+    while (st.keep_running()) {
+        nd::array r = sort(a);
+        bench::do_not_optimize(r.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(size);
+}
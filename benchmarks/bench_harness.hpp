@@ -0,0 +1,175 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__BENCH_HARNESS_HPP_
+#define _DYND__BENCH_HARNESS_HPP_
+
+#include <string>
+#include <vector>
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+
+namespace dynd { namespace bench {
+
+/**
+ * Returns a monotonic time in seconds, for timing benchmarks.
+ */
+double get_time_seconds();
+
+/**
+ * The state passed to a benchmark function. The function does its
+ * setup, then runs the code being measured in a loop
+ *
+ *     while (st.keep_running()) {
+ *         ...
+ *     }
+ *
+ * Only the loop is timed. The harness calls the function repeatedly
+ * with more iterations until the loop takes at least the minimum time.
+ */
+class state {
+    intptr_t m_arg, m_thread_count;
+    intptr_t m_max_iterations, m_iterations;
+    intptr_t m_items_per_iteration, m_bytes_per_iteration;
+    double m_start_time, m_elapsed;
+
+public:
+    state(intptr_t arg, intptr_t thread_count, intptr_t max_iterations)
+        : m_arg(arg), m_thread_count(thread_count),
+          m_max_iterations(max_iterations), m_iterations(0),
+          m_items_per_iteration(0), m_bytes_per_iteration(0),
+          m_start_time(0), m_elapsed(0)
+    {
+    }
+
+    /** The size argument the benchmark was registered with */
+    intptr_t arg() const {
+        return m_arg;
+    }
+
+    /** The number of threads, for benchmarks registered as scaling ones */
+    intptr_t thread_count() const {
+        return m_thread_count;
+    }
+
+    inline bool keep_running() {
+        if (m_iterations == 0) {
+            m_start_time = get_time_seconds();
+        }
+        if (m_iterations < m_max_iterations) {
+            ++m_iterations;
+            return true;
+        } else {
+            m_elapsed = get_time_seconds() - m_start_time;
+            return false;
+        }
+    }
+
+    /** Sets the number of elements processed by one iteration */
+    void set_items_per_iteration(intptr_t count) {
+        m_items_per_iteration = count;
+    }
+
+    /** Sets the number of input bytes processed by one iteration */
+    void set_bytes_per_iteration(intptr_t count) {
+        m_bytes_per_iteration = count;
+    }
+
+    intptr_t get_iterations() const {
+        return m_iterations;
+    }
+
+    double get_elapsed() const {
+        return m_elapsed;
+    }
+
+    intptr_t get_items_per_iteration() const {
+        return m_items_per_iteration;
+    }
+
+    intptr_t get_bytes_per_iteration() const {
+        return m_bytes_per_iteration;
+    }
+};
+
+typedef void (*benchmark_fn_t)(state &st);
+
+struct benchmark_entry {
+    std::string name;
+    benchmark_fn_t fn;
+    /** The arguments to run the benchmark with */
+    std::vector<intptr_t> args;
+    /** If true, the benchmark is run with 1, 2, 4, ... threads */
+    bool thread_scaling;
+};
+
+/**
+ * Adds a benchmark to the global list. Used by the DYND_BENCHMARK
+ * macros, through static initialization.
+ */
+int register_benchmark(const char *name, benchmark_fn_t fn,
+                       const intptr_t *args, intptr_t arg_count,
+                       bool thread_scaling);
+
+/** The list of all registered benchmarks */
+std::vector<benchmark_entry>& get_benchmarks();
+
+/**
+ * Keeps the compiler from optimizing away a computed value.
+ */
+void do_not_optimize(const void *ptr);
+
+/**
+ * Creates a one-dimensional array of ``size`` elements of type T, with
+ * a repeating pattern of values in the range [0, modulus).
+ */
+template <class T>
+nd::array make_pattern_array(intptr_t size, int modulus = 100)
+{
+    nd::array a = nd::empty(size, ndt::make_type<T>());
+    T *data = reinterpret_cast<T *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < size; ++i) {
+        data[i] = static_cast<T>((i * 7 + 3) % modulus);
+    }
+    return a;
+}
+
+}} // namespace dynd::bench
+
+#if defined(__GNUC__)
+#define DYND_BENCH_ATTRIBUTE_UNUSED __attribute__((unused))
+#else
+#define DYND_BENCH_ATTRIBUTE_UNUSED
+#endif
+
+#define DYND_BENCHMARK_REGISTER_(NAME, ARGS, ARG_COUNT, THREAD_SCALING) \
+    static void NAME(::dynd::bench::state &st); \
+    static int NAME##_registered DYND_BENCH_ATTRIBUTE_UNUSED = \
+        ::dynd::bench::register_benchmark(#NAME, &NAME, ARGS, ARG_COUNT, \
+                                          THREAD_SCALING); \
+    static void NAME(::dynd::bench::state &st)
+
+/**
+ * Defines a benchmark which is run once, with arg() returning 0.
+ */
+#define DYND_BENCHMARK(NAME) \
+    DYND_BENCHMARK_REGISTER_(NAME, NULL, 0, false)
+
+/**
+ * Defines a benchmark which is run for each value in the static
+ * intptr_t array ARGS, usually a list of sizes.
+ */
+#define DYND_BENCHMARK_ARGS(NAME, ARGS) \
+    DYND_BENCHMARK_REGISTER_(NAME, ARGS, sizeof(ARGS) / sizeof(ARGS[0]), false)
+
+/**
+ * Defines a benchmark which is run for each value in ARGS, and for
+ * thread counts doubling from 1 up to the maximum thread count.
+ */
+#define DYND_BENCHMARK_THREADS(NAME, ARGS) \
+    DYND_BENCHMARK_REGISTER_(NAME, ARGS, sizeof(ARGS) / sizeof(ARGS[0]), true)
+
+#endif // _DYND__BENCH_HARNESS_HPP_
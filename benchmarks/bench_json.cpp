@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <sstream>
+
+#include <dynd/array.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t record_counts[] = {1000, 100000};
+
+static const char *record_type = "{id: int64, name: string, value: float64, "
+                                 "flags: 3 * bool, tags: var * string}";
+
+/**
+ * Generates ``count`` records of ``record_type``, as JSON lines.
+ */
+static string make_json_lines(intptr_t count)
+{
+    stringstream ss;
+    for (intptr_t i = 0; i < count; ++i) {
+        ss << "{\"id\": " << (i * 7919) << ", \"name\": \"record " << i
+           << "\", \"value\": " << (i * 0.25) << ", \"flags\": [true, "
+           << ((i % 3 == 0) ? "false" : "true") << ", false], \"tags\": [\"a\", \"tag"
+           << (i % 10) << "\"]}\n";
+    }
+    return ss.str();
+}
+
+/**
+ * The same records as ``make_json_lines``, as a JSON list.
+ */
+static string make_json_list(intptr_t count)
+{
+    string lines = make_json_lines(count);
+    string result = "[";
+    size_t pos = 0;
+    while (pos < lines.size()) {
+        size_t end = lines.find('\n', pos);
+        if (pos > 0) {
+            result += ",\n";
+        }
+        result.append(lines, pos, end - pos);
+        pos = end + 1;
+    }
+    result += "]";
+    return result;
+}
+
+DYND_BENCHMARK_ARGS(json_parse_records, record_counts)
+{
+    intptr_t count = st.arg();
+    string json = make_json_list(count);
+    ndt::type tp = ndt::type(string("var * ") + record_type);
+    while (st.keep_running()) {
+        nd::array a = parse_json(tp, json.data(), json.data() + json.size(),
+                                 &eval::default_eval_context);
+        bench::do_not_optimize(a.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(count);
+    st.set_bytes_per_iteration(json.size());
+}
+
+DYND_BENCHMARK_ARGS(json_parse_float64_list, record_counts)
+{
+    intptr_t count = st.arg();
+    stringstream ss;
+    ss << "[";
+    for (intptr_t i = 0; i < count; ++i) {
+        ss << (i > 0 ? ", " : "") << (i * 1.125 - 1000);
+    }
+    ss << "]";
+    string json = ss.str();
+    ndt::type tp("var * float64");
+    while (st.keep_running()) {
+        nd::array a = parse_json(tp, json.data(), json.data() + json.size(),
+                                 &eval::default_eval_context);
+        bench::do_not_optimize(a.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(count);
+    st.set_bytes_per_iteration(json.size());
+}
+
+/**
+ * JSON lines parsing, scaling from one thread up to the maximum
+ * thread count, reported in bytes of input per second.
+ */
+DYND_BENCHMARK_THREADS(json_lines_parse_records, record_counts)
+{
+    intptr_t count = st.arg();
+    string json = make_json_lines(count);
+    ndt::type tp(record_type);
+    eval::eval_context ectx;
+    ectx.thread_count = st.thread_count();
+    while (st.keep_running()) {
+        nd::array a = parse_json_lines(tp, json.data(),
+                                       json.data() + json.size(), &ectx);
+        bench::do_not_optimize(a.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(count);
+    st.set_bytes_per_iteration(json.size());
+}
+
+DYND_BENCHMARK_ARGS(json_format_records, record_counts)
+{
+    intptr_t count = st.arg();
+    string json = make_json_list(count);
+    nd::array a = parse_json(ndt::type(string("var * ") + record_type),
+                             json.data(), json.data() + json.size(),
+                             &eval::default_eval_context);
+    while (st.keep_running()) {
+        nd::array out = format_json(a);
+        bench::do_not_optimize(out.get_readonly_originptr());
+    }
+    st.set_items_per_iteration(count);
+    st.set_bytes_per_iteration(json.size());
+}
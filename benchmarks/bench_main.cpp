@@ -0,0 +1,337 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <dynd/parallel.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+double bench::get_time_seconds()
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+}
+
+vector<bench::benchmark_entry>& bench::get_benchmarks()
+{
+    static vector<benchmark_entry> benchmarks;
+    return benchmarks;
+}
+
+int bench::register_benchmark(const char *name, benchmark_fn_t fn,
+                              const intptr_t *args, intptr_t arg_count,
+                              bool thread_scaling)
+{
+    benchmark_entry be;
+    be.name = name;
+    be.fn = fn;
+    if (arg_count == 0) {
+        be.args.push_back(0);
+    } else {
+        be.args.assign(args, args + arg_count);
+    }
+    be.thread_scaling = thread_scaling;
+    get_benchmarks().push_back(be);
+    return (int)get_benchmarks().size();
+}
+
+static volatile const void *g_sink;
+
+void bench::do_not_optimize(const void *ptr)
+{
+    g_sink = ptr;
+}
+
+namespace {
+    enum output_format_t {
+        output_format_text,
+        output_format_csv,
+        output_format_json
+    };
+
+    struct options {
+        output_format_t format;
+        string filter;
+        double min_time;
+        intptr_t repetitions;
+        intptr_t max_threads;
+        bool list_only;
+
+        options()
+            : format(output_format_text), min_time(0.1), repetitions(3),
+              max_threads(parallel::get_hardware_thread_count()),
+              list_only(false)
+        {
+        }
+    };
+
+    struct result {
+        string name;
+        intptr_t arg, thread_count, iterations;
+        /** Seconds per iteration, the best and the mean of the repetitions */
+        double best_time, mean_time;
+        intptr_t items_per_iteration, bytes_per_iteration;
+    };
+} // anonymous namespace
+
+static void print_usage(ostream &o)
+{
+    o << "Usage: bench_libdynd [options]\n";
+    o << "  --filter=SUBSTR    Only run benchmarks whose name contains SUBSTR\n";
+    o << "  --format=FMT       Output as 'text' (default), 'csv' or 'json'\n";
+    o << "  --min-time=SECS    Minimum time for each timed loop (default 0.1)\n";
+    o << "  --repetitions=N    Number of timed loops per benchmark (default 3)\n";
+    o << "  --threads=N        Maximum threads for thread scaling benchmarks\n";
+    o << "  --list             List the benchmark names\n";
+}
+
+static bool starts_with(const char *s, const char *prefix, const char **out_rest)
+{
+    size_t len = strlen(prefix);
+    if (strncmp(s, prefix, len) == 0) {
+        *out_rest = s + len;
+        return true;
+    }
+    return false;
+}
+
+static options parse_options(int argc, char **argv)
+{
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        const char *value;
+        if (starts_with(argv[i], "--filter=", &value)) {
+            opts.filter = value;
+        } else if (starts_with(argv[i], "--format=", &value)) {
+            if (strcmp(value, "text") == 0) {
+                opts.format = output_format_text;
+            } else if (strcmp(value, "csv") == 0) {
+                opts.format = output_format_csv;
+            } else if (strcmp(value, "json") == 0) {
+                opts.format = output_format_json;
+            } else {
+                stringstream ss;
+                ss << "unrecognized output format \"" << value << "\"";
+                throw invalid_argument(ss.str());
+            }
+        } else if (starts_with(argv[i], "--min-time=", &value)) {
+            opts.min_time = atof(value);
+        } else if (starts_with(argv[i], "--repetitions=", &value)) {
+            opts.repetitions = max(DYND_ATOLL(value), 1LL);
+        } else if (starts_with(argv[i], "--threads=", &value)) {
+            opts.max_threads = max(DYND_ATOLL(value), 1LL);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            opts.list_only = true;
+        } else {
+            stringstream ss;
+            ss << "unrecognized option \"" << argv[i] << "\"";
+            throw invalid_argument(ss.str());
+        }
+    }
+    return opts;
+}
+
+/**
+ * Runs one configuration of a benchmark, growing the iteration count
+ * until a timed loop takes at least the minimum time, then doing the
+ * requested number of repetitions at that iteration count.
+ */
+static result run_benchmark(const bench::benchmark_entry &be, intptr_t arg,
+                            intptr_t thread_count, const options &opts)
+{
+    intptr_t iterations = 1;
+    for (;;) {
+        bench::state st(arg, thread_count, iterations);
+        be.fn(st);
+        double elapsed = st.get_elapsed();
+        if (elapsed >= opts.min_time || iterations >= 1000000000) {
+            break;
+        }
+        // Aim a bit past the minimum time, growing by at most 10x
+        double factor = elapsed > 0 ? 1.4 * opts.min_time / elapsed : 10;
+        factor = min(max(factor, 2.0), 10.0);
+        iterations = (intptr_t)(iterations * factor);
+    }
+
+    result r;
+    r.name = be.name;
+    r.arg = arg;
+    r.thread_count = thread_count;
+    r.iterations = iterations;
+    r.best_time = 0;
+    r.mean_time = 0;
+    r.items_per_iteration = 0;
+    r.bytes_per_iteration = 0;
+    for (intptr_t rep = 0; rep < opts.repetitions; ++rep) {
+        bench::state st(arg, thread_count, iterations);
+        be.fn(st);
+        double t = st.get_elapsed() / (double)st.get_iterations();
+        r.best_time = (rep == 0) ? t : min(r.best_time, t);
+        r.mean_time += t / (double)opts.repetitions;
+        r.items_per_iteration = st.get_items_per_iteration();
+        r.bytes_per_iteration = st.get_bytes_per_iteration();
+    }
+    return r;
+}
+
+static void print_json_string(ostream &o, const string &s)
+{
+    o << '"';
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '"' || s[i] == '\\') {
+            o << '\\';
+        }
+        o << s[i];
+    }
+    o << '"';
+}
+
+static void print_header(ostream &o, const options &opts)
+{
+    switch (opts.format) {
+        case output_format_text:
+            o << "libdynd " << dynd_version_string << " (" << dynd_git_sha1
+              << ")\n";
+            o << left << setw(48) << "benchmark" << right << setw(14)
+              << "best ns" << setw(14) << "mean ns" << setw(14) << "items/s"
+              << setw(12) << "GB/s" << "\n";
+            break;
+        case output_format_csv:
+            o << "name,arg,threads,iterations,best_ns,mean_ns,"
+                 "items_per_second,bytes_per_second\n";
+            break;
+        case output_format_json:
+            o << "{\n";
+            o << "  \"context\": {\"version\": ";
+            print_json_string(o, dynd_version_string);
+            o << ", \"git_sha1\": ";
+            print_json_string(o, dynd_git_sha1);
+            o << ", \"min_time\": " << opts.min_time
+              << ", \"repetitions\": " << opts.repetitions
+              << ", \"max_threads\": " << opts.max_threads << "},\n";
+            o << "  \"benchmarks\": [";
+            break;
+    }
+}
+
+static void print_result(ostream &o, const result &r, bool first,
+                         const options &opts)
+{
+    double items_per_second =
+        r.items_per_iteration > 0 ? r.items_per_iteration / r.best_time : 0;
+    double bytes_per_second =
+        r.bytes_per_iteration > 0 ? r.bytes_per_iteration / r.best_time : 0;
+    if (opts.format == output_format_json) {
+        o << (first ? "\n" : ",\n");
+        o << "    {\"name\": ";
+        print_json_string(o, r.name);
+        o << ", \"arg\": " << r.arg << ", \"threads\": " << r.thread_count
+          << ", \"iterations\": " << r.iterations
+          << ", \"best_ns\": " << r.best_time * 1e9
+          << ", \"mean_ns\": " << r.mean_time * 1e9
+          << ", \"items_per_second\": " << items_per_second
+          << ", \"bytes_per_second\": " << bytes_per_second << "}";
+    } else if (opts.format == output_format_text) {
+        stringstream name;
+        name << r.name << "/" << r.arg;
+        if (r.thread_count > 1) {
+            name << "/threads:" << r.thread_count;
+        }
+        o << left << setw(48) << name.str() << right << setprecision(4)
+          << setw(14) << r.best_time * 1e9 << setw(14) << r.mean_time * 1e9
+          << setw(14) << items_per_second << setw(12)
+          << bytes_per_second * 1e-9 << "\n";
+    } else {
+        o << r.name << "," << r.arg << "," << r.thread_count << ","
+          << r.iterations << "," << r.best_time * 1e9 << ","
+          << r.mean_time * 1e9 << "," << items_per_second << ","
+          << bytes_per_second << "\n";
+    }
+    o.flush();
+}
+
+static void print_footer(ostream &o, const options &opts)
+{
+    if (opts.format == output_format_json) {
+        o << "\n  ]\n}\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    options opts;
+    try {
+        opts = parse_options(argc, argv);
+    } catch (const exception &e) {
+        cerr << "Error: " << e.what() << "\n";
+        print_usage(cerr);
+        return 1;
+    }
+
+    const vector<bench::benchmark_entry> &benchmarks = bench::get_benchmarks();
+    if (opts.list_only) {
+        for (size_t i = 0; i < benchmarks.size(); ++i) {
+            cout << benchmarks[i].name << "\n";
+        }
+        return 0;
+    }
+
+    libdynd_init();
+    int retval = 0;
+    print_header(cout, opts);
+    bool first = true;
+    for (size_t i = 0; i < benchmarks.size(); ++i) {
+        const bench::benchmark_entry &be = benchmarks[i];
+        if (be.name.find(opts.filter) == string::npos) {
+            continue;
+        }
+        for (size_t j = 0; j < be.args.size(); ++j) {
+            intptr_t thread_count = 1;
+            for (;;) {
+                try {
+                    result r = run_benchmark(be, be.args[j], thread_count, opts);
+                    print_result(cout, r, first, opts);
+                    first = false;
+                } catch (const exception &e) {
+                    cerr << "Error in benchmark " << be.name << "/"
+                         << be.args[j] << ": " << e.what() << "\n";
+                    retval = 1;
+                    break;
+                }
+                if (!be.thread_scaling || thread_count >= opts.max_threads) {
+                    break;
+                }
+                thread_count = min(2 * thread_count, opts.max_threads);
+            }
+        }
+    }
+    print_footer(cout, opts);
+    libdynd_cleanup();
+
+    return retval;
+}
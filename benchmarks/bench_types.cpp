@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <dynd/array.hpp>
+#include <dynd/view.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+
+#include "bench_harness.hpp"
+
+using namespace std;
+using namespace dynd;
+
+static const intptr_t sizes[] = {1024, 65536, 1048576};
+
+/**
+ * Creates an array of strings drawn from ``category_count`` distinct values.
+ */
+static nd::array make_category_strings(intptr_t size, intptr_t category_count)
+{
+    nd::array a = bench::make_pattern_array<int32_t>(size, (int)category_count);
+    return a.ucast(ndt::make_string()).eval();
+}
+
+DYND_BENCHMARK_ARGS(categorical_factor_string, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = make_category_strings(size, 100);
+    while (st.keep_running()) {
+        ndt::type cat_tp = ndt::factor_categorical(a);
+        bench::do_not_optimize(cat_tp.extended());
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(categorical_from_string, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = make_category_strings(size, 100);
+    ndt::type cat_tp = ndt::factor_categorical(a);
+    nd::array b = nd::empty(size, cat_tp);
+    while (st.keep_running()) {
+        b.val_assign(a);
+    }
+    st.set_items_per_iteration(size);
+}
+
+DYND_BENCHMARK_ARGS(categorical_to_string, sizes)
+{
+    intptr_t size = st.arg();
+    nd::array a = make_category_strings(size, 100);
+    nd::array b = a.ucast(ndt::factor_categorical(a)).eval();
+    while (st.keep_running()) {
+        // Strings can only be assigned once, so each iteration
+        // converts into a fresh array
+        nd::array c = nd::empty(size, ndt::make_string());
+        c.val_assign(b);
+    }
+    st.set_items_per_iteration(size);
+}
+
+/**
+ * Memory maps a file of int32 values, views it as an array, and sums it.
+ * The file stays in the page cache, so this measures the map and the scan
+ * rather than the disk.
+ */
+DYND_BENCHMARK_ARGS(memmap_scan_int32, sizes)
+{
+    intptr_t size = st.arg();
+    stringstream fn;
+    fn << "bench_libdynd_memmap_" << size << ".bin";
+    {
+        nd::array a = bench::make_pattern_array<int32_t>(size);
+        ofstream fout(fn.str().c_str(), ios::binary);
+        fout.write(a.get_readonly_originptr(), size * sizeof(int32_t));
+    }
+    nd::arrfunc sum_1d = kernels::make_builtin_sum1d_arrfunc(int32_type_id);
+    ndt::type view_tp = ndt::make_strided_dim(ndt::make_type<int32_t>());
+    while (st.keep_running()) {
+        nd::array mm = nd::memmap(fn.str());
+        nd::array s = sum_1d(nd::view(mm, view_tp));
+        bench::do_not_optimize(s.get_readonly_originptr());
+    }
+    remove(fn.str().c_str());
+    st.set_items_per_iteration(size);
+    st.set_bytes_per_iteration(size * sizeof(int32_t));
+}
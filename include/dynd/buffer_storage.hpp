@@ -8,9 +8,31 @@
 
 #include <dynd/array.hpp>
 #include <dynd/types/strided_dim_type.hpp>
+#include <dynd/eval/eval_context.hpp>
 
 namespace dynd {
 
+/**
+ * Returns the size in bytes of the CPU's level 1 data cache (level == 1)
+ * or its level 2 cache (level == 2). The sizes are detected once from the
+ * operating system, with conservative defaults if that fails.
+ */
+intptr_t get_cpu_cache_size(int level);
+
+/**
+ * Chooses the number of elements a buffered kernel should process per
+ * chunk, so that one chunk of every buffer involved stays in cache.
+ * If ``ectx->buffer_chunk_size`` is nonzero, it is used as is.
+ *
+ * \param nbuffers  The number of buffers (or buffered stages) which are
+ *                  live at the same time during one chunk.
+ * \param element_sizes  The element size in bytes of each buffer.
+ * \param ectx  The evaluation context, may be NULL.
+ */
+intptr_t get_buffer_chunk_size(intptr_t nbuffers,
+                               const intptr_t *element_sizes,
+                               const eval::eval_context *ectx);
+
 /**
  * Given a buffer array of type "strided * T" which was
  * created by nd::empty, resets it so it can be used
@@ -43,14 +65,16 @@ class buffer_storage {
   char *m_arrmeta;
   ndt::type m_type;
   intptr_t m_stride;
+  intptr_t m_element_count;
 
   // Non-assignable
   buffer_storage &operator=(const buffer_storage &);
 
-  void internal_allocate()
+  void internal_allocate(const eval::eval_context *ectx)
   {
     m_stride = m_type.get_data_size();
-    m_storage = new char[DYND_BUFFER_CHUNK_SIZE * m_stride];
+    m_element_count = get_buffer_chunk_size(1, &m_stride, ectx);
+    m_storage = new char[m_element_count * m_stride];
     m_arrmeta = NULL;
     size_t metasize =
         m_type.is_builtin() ? 0 : m_type.extended()->get_arrmeta_size();
@@ -70,22 +94,30 @@ class buffer_storage {
   }
 
 public:
-  inline buffer_storage() : m_storage(NULL), m_arrmeta(NULL), m_type() {}
+  inline buffer_storage()
+      : m_storage(NULL), m_arrmeta(NULL), m_type(), m_stride(0),
+        m_element_count(0)
+  {
+  }
   inline buffer_storage(const buffer_storage &rhs)
       : m_storage(NULL), m_arrmeta(NULL), m_type(rhs.m_type)
   {
-    internal_allocate();
+    eval::eval_context ectx;
+    ectx.buffer_chunk_size = rhs.m_element_count;
+    internal_allocate(&ectx);
   }
-  inline buffer_storage(const ndt::type &tp)
+  inline buffer_storage(const ndt::type &tp,
+                        const eval::eval_context *ectx =
+                            &eval::default_eval_context)
       : m_storage(NULL), m_arrmeta(NULL), m_type(tp)
   {
-    internal_allocate();
+    internal_allocate(ectx);
   }
   ~buffer_storage()
   {
     if (m_storage && m_type.get_flags()&type_flag_destructor) {
       m_type.extended()->data_destruct_strided(m_arrmeta, m_storage, m_stride,
-                                               DYND_BUFFER_CHUNK_SIZE);
+                                               m_element_count);
     }
     delete[] m_storage;
     if (m_arrmeta) {
@@ -94,7 +126,8 @@ public:
     }
   }
 
-  void allocate(const ndt::type &dt)
+  void allocate(const ndt::type &dt,
+                const eval::eval_context *ectx = &eval::default_eval_context)
   {
     delete[] m_storage;
     m_storage = 0;
@@ -104,11 +137,14 @@ public:
       m_arrmeta = NULL;
     }
     m_type = dt;
-    internal_allocate();
+    internal_allocate(ectx);
   }
 
   inline intptr_t get_stride() const { return m_stride; }
 
+  /** The number of elements the buffer holds */
+  inline intptr_t get_element_count() const { return m_element_count; }
+
   inline const ndt::type &get_type() const { return m_type; }
 
   inline char *const &get_storage() const { return m_storage; }
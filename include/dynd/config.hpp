@@ -12,8 +12,15 @@
 
 #include <dynd/cmake_config.hpp>
 
-/** The number of elements to process at once when doing chunking/buffering */
+/**
+ * The number of elements to process at once when doing chunking/buffering
+ * in places where the chunk size is fixed. Buffered kernels choose their
+ * chunk size at instantiation time with get_buffer_chunk_size(), within the
+ * MIN/MAX bounds below.
+ */
 #define DYND_BUFFER_CHUNK_SIZE 128
+#define DYND_BUFFER_CHUNK_SIZE_MIN 16
+#define DYND_BUFFER_CHUNK_SIZE_MAX 4096
 
 
 #ifdef __clang__
@@ -193,6 +200,31 @@ public:
 
 #endif // end of compiler vendor checks
 
+// GCC and Clang have a 128-bit integer on 64-bit targets, which
+// dynd_int128 and dynd_uint128 use for their arithmetic while keeping
+// their two 64-bit word layout
+#if defined(__SIZEOF_INT128__) && !defined(__CUDACC__)
+#  define DYND_HAS_NATIVE_INT128
+namespace dynd {
+    __extension__ typedef __int128 dynd_native_int128;
+    __extension__ typedef unsigned __int128 dynd_native_uint128;
+} // namespace dynd
+#endif
+
+// Use std::thread for the parallel code paths when the standard
+// library has it (C++11 mode, or MSVC 2012 and later)
+#if !defined(DYND_USE_STD_THREAD) && !defined(__CUDACC__) && \
+    (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700))
+#  define DYND_USE_STD_THREAD
+#endif
+
+// Thread local storage for POD variables
+#ifdef _MSC_VER
+#  define DYND_THREAD_LOCAL __declspec(thread)
+#else
+#  define DYND_THREAD_LOCAL __thread
+#endif
+
 // If RValue References are supported
 #ifdef DYND_RVALUE_REFS
 #  include <utility>
@@ -321,6 +353,16 @@ namespace dynd {
  */
 #define DYND_UNUSED(x)
 
+/**
+ * Preprocessor macro for marking pointers which don't alias any
+ * other pointer in scope, so the compiler can vectorize loops over them.
+ */
+#ifdef _MSC_VER
+# define DYND_RESTRICT __restrict
+#else
+# define DYND_RESTRICT __restrict__
+#endif
+
 namespace dynd {
     // These are defined in git_version.cpp, generated from
     // git_version.cpp.in by the CMake build configuration.
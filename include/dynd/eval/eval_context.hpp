@@ -16,7 +16,11 @@
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/date_util.hpp>
 
-namespace dynd { namespace eval {
+namespace dynd {
+
+class ckernel_profiler;
+
+namespace eval {
 
 struct eval_context {
     // If the compiler supports atomics, use them for access
@@ -30,6 +34,12 @@ struct eval_context {
     std::atomic<date_parse_order_t> date_parse_order;
     // Century selection for 2 digit years in date strings
     std::atomic<int> century_window;
+    // Number of elements per buffered chunk, 0 means choose automatically
+    std::atomic<intptr_t> buffer_chunk_size;
+    // Maximum number of threads for parallel operations, 0 means all cores
+    std::atomic<intptr_t> thread_count;
+    // Profiler to instrument the ckernels built, NULL to disable
+    std::atomic<ckernel_profiler *> profiler;
 #else
     // Default error mode for computations
     assign_error_mode errmode;
@@ -39,12 +49,19 @@ struct eval_context {
     date_parse_order_t date_parse_order;
     // Century selection for 2 digit years in date strings
     int century_window;
+    // Number of elements per buffered chunk, 0 means choose automatically
+    intptr_t buffer_chunk_size;
+    // Maximum number of threads for parallel operations, 0 means all cores
+    intptr_t thread_count;
+    // Profiler to instrument the ckernels built, NULL to disable
+    ckernel_profiler *profiler;
 #endif
 
     DYND_CONSTEXPR eval_context()
         : errmode(assign_error_fractional),
           cuda_device_errmode(assign_error_nocheck),
-          date_parse_order(date_parse_no_ambig), century_window(70)
+          date_parse_order(date_parse_no_ambig), century_window(70),
+          buffer_chunk_size(0), thread_count(0), profiler(NULL)
     {
     }
 
@@ -54,7 +71,10 @@ struct eval_context {
         : errmode(rhs.errmode.load()),
           cuda_device_errmode(rhs.cuda_device_errmode.load()),
           date_parse_order(rhs.date_parse_order.load()),
-          century_window(rhs.century_window.load())
+          century_window(rhs.century_window.load()),
+          buffer_chunk_size(rhs.buffer_chunk_size.load()),
+          thread_count(rhs.thread_count.load()),
+          profiler(rhs.profiler.load())
     {
     }
 
@@ -63,6 +83,9 @@ struct eval_context {
         cuda_device_errmode.store(rhs.cuda_device_errmode.load());
         date_parse_order.store(rhs.date_parse_order.load());
         century_window.store(rhs.century_window.load());
+        buffer_chunk_size.store(rhs.buffer_chunk_size.load());
+        thread_count.store(rhs.thread_count.load());
+        profiler.store(rhs.profiler.load());
         return *this;
     }
 #endif
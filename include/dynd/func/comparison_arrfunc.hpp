@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__COMPARISON_ARRFUNC_HPP_
+#define _DYND__COMPARISON_ARRFUNC_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/func/lift_arrfunc.hpp>
+#include <dynd/types/arrfunc_type.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+
+namespace dynd { namespace kernels {
+
+enum logical_op_t {
+    /** (bool, bool) -> bool */
+    logical_and,
+    /** (bool, bool) -> bool */
+    logical_or,
+    /** (bool, bool) -> bool */
+    logical_xor,
+    /** (bool) -> bool */
+    logical_not
+};
+
+/**
+ * Create a scalar arrfunc "(T, S) -> bool" which compares its two
+ * arguments. The result is a bool mask, which can go straight into
+ * the masked form of the take arrfunc.
+ *
+ * When both arguments have the same builtin integer or floating point
+ * type, the strided ckernel is a typed loop, with separate loops for
+ * contiguous inputs and for a broadcast scalar second argument that
+ * the compiler can vectorize. Other types go through the comparison
+ * kernel of ``make_comparison_kernel``.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param comptype  The comparison to do. comparison_type_sorting_less
+ *                  is not supported.
+ */
+void make_comparison_arrfunc(arrfunc_type_data *out_af,
+                             comparison_type_t comptype);
+
+/**
+ * Returns the comparison arrfunc lifted to broadcast over its arguments,
+ * so for example ``make_comparison_arrfunc(comparison_type_less)(a, 3)``
+ * is the mask of ``a < 3``.
+ */
+inline nd::arrfunc make_comparison_arrfunc(comparison_type_t comptype)
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_comparison_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        comptype);
+    af.flag_as_immutable();
+    return lift_arrfunc(af);
+}
+
+/**
+ * Create a scalar arrfunc applying a logical operation to bools, for
+ * combining the masks from comparison arrfuncs.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param op  The logical operation.
+ */
+void make_logical_arrfunc(arrfunc_type_data *out_af, logical_op_t op);
+
+/**
+ * Returns the logical arrfunc lifted to broadcast over its arguments.
+ */
+inline nd::arrfunc make_logical_arrfunc(logical_op_t op)
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_logical_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        op);
+    af.flag_as_immutable();
+    return lift_arrfunc(af);
+}
+
+}} // namespace dynd::kernels
+
+#endif // _DYND__COMPARISON_ARRFUNC_HPP_
@@ -72,6 +72,16 @@ namespace detail {
           e->func(DYND_PP_DEREF_CAST_ARRAY_RANGE_1(D, src, NSRC));             \
     }                                                                          \
                                                                                \
+    /* Contiguous operands, in a loop the compiler can vectorize */            \
+    static void unit_strided(R *DYND_RESTRICT dst,                             \
+                             DYND_PP_RESTRICT_PTR_PARAMS_1(D, src, NSRC),      \
+                             size_t count, Functor func)                       \
+    {                                                                          \
+      for (size_t i = 0; i < count; ++i) {                                     \
+        dst[i] = func(DYND_PP_INDEX_ARGRANGE_1(src, i, NSRC));                 \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
     static void strided(char *dst, intptr_t dst_stride,                        \
                         const char *const *src, const intptr_t *src_stride,    \
                         size_t count, ckernel_prefix *ckp)                     \
@@ -81,6 +91,12 @@ namespace detail {
       /* const char *src# = src[#]; */                                         \
       /* intptr_t src_stride# = src_stride[#]; */                              \
       DYND_PP_INIT_SRC_VARIABLES(NSRC);                                        \
+      if (DYND_PP_IS_UNIT_STRIDED(R, D, NSRC) &&                               \
+          DYND_PP_IS_DISJOINT_FROM_DST(NSRC)) {                                \
+        unit_strided(reinterpret_cast<R *>(dst),                               \
+                     DYND_PP_CAST_ARGRANGE_1(D, src, NSRC), count, func);      \
+        return;                                                                \
+      }                                                                        \
       for (size_t i = 0; i < count; ++i) {                                     \
         /* *(R *)dst = func(*(const D0 *)src0, ...); */                        \
         *reinterpret_cast<R *>(dst) =                                          \
@@ -147,6 +163,16 @@ DYND_PP_JOIN_MAP(DYND_CODE, (), DYND_PP_RANGE(1, DYND_PP_INC(DYND_ELWISE_MAX)))
               DYND_PP_DEREF_CAST_ARRAY_RANGE_1(D, src, NSRC));                 \
     }                                                                          \
                                                                                \
+    /* Contiguous operands, in a loop the compiler can vectorize */            \
+    static void unit_strided(R *DYND_RESTRICT dst,                             \
+                             DYND_PP_RESTRICT_PTR_PARAMS_1(D, src, NSRC),      \
+                             size_t count, Functor func)                       \
+    {                                                                          \
+      for (size_t i = 0; i < count; ++i) {                                     \
+        func(dst[i], DYND_PP_INDEX_ARGRANGE_1(src, i, NSRC));                 \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
     static void strided(char *dst, intptr_t dst_stride,                        \
                         const char *const *src, const intptr_t *src_stride,    \
                         size_t count, ckernel_prefix *ckp)                     \
@@ -156,6 +182,12 @@ DYND_PP_JOIN_MAP(DYND_CODE, (), DYND_PP_RANGE(1, DYND_PP_INC(DYND_ELWISE_MAX)))
       /* const char *src# = src[#]; */                                         \
       /* intptr_t src_stride# = src_stride[#]; */                              \
       DYND_PP_INIT_SRC_VARIABLES(NSRC);                                        \
+      if (DYND_PP_IS_UNIT_STRIDED(R, D, NSRC) &&                               \
+          DYND_PP_IS_DISJOINT_FROM_DST(NSRC)) {                                \
+        unit_strided(reinterpret_cast<R *>(dst),                               \
+                     DYND_PP_CAST_ARGRANGE_1(D, src, NSRC), count, func);      \
+        return;                                                                \
+      }                                                                        \
       for (size_t i = 0; i < count; ++i) {                                     \
         /*  func(*(R *)dst, *(const D0 *)src0, ...); */                        \
         func(*reinterpret_cast<R *>(dst),                                      \
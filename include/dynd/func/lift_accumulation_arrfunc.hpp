@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__LIFT_ACCUMULATION_ARRFUNC_HPP_
+#define _DYND__LIFT_ACCUMULATION_ARRFUNC_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+
+namespace dynd {
+
+/**
+ * Lifts the provided reduction arrfunc into an accumulation (or scan)
+ * along one of the dimensions of ``lifted_arr_type``. The output has
+ * the same shape as the input, and each of its elements is the
+ * reduction of the input elements along the accumulated dimension up
+ * to and including it. With a sum reduction, this is a cumulative sum.
+ *
+ * \param out_af  The output arrfunc which is filled.
+ * \param elwise_reduction  The arrfunc to be lifted. This must
+ *                          be a unary operation, which modifies the output
+ *                          in place.
+ * \param lifted_arr_type  The type the input should be lifted to.
+ * \param dst_initialization  Either a NULL nd::array, or a arrfunc
+ *                            which initializes an accumulator value from an
+ *                            input value. If it is NULL, either the value in
+ *                            `reduction_identity` is used, or a copy operation
+ *                            is used if that is NULL.
+ * \param reduction_ndim  The number of dimensions being lifted. This should
+ *                        be equal to the number of dimensions added in
+ *                        `lifted_types` over what is in `elwise_reduction`.
+ * \param reduction_dimflags  An array of length `reduction_ndim`, in which
+ *                            exactly one flag, for the dimension being
+ *                            accumulated, is true.
+ * \param associative  Indicate whether the operation the reduction is derived
+ *                     from is associative.
+ * \param commutative  Indicate whether the operation the reduction is derived
+ *                     from is commutative.
+ * \param right_associative  If true, the accumulation runs from right to
+ *                           left. This is not yet supported.
+ * \param reduction_identity  If not a NULL nd::array, this is the identity
+ *                            value for the accumulator.
+ */
+void lift_accumulation_arrfunc(arrfunc_type_data *out_af,
+                const nd::arrfunc& elwise_reduction,
+                const ndt::type& lifted_arr_type,
+                const nd::arrfunc& dst_initialization,
+                intptr_t reduction_ndim,
+                const bool *reduction_dimflags,
+                bool associative,
+                bool commutative,
+                bool right_associative,
+                const nd::array& reduction_identity);
+
+inline nd::arrfunc lift_accumulation_arrfunc(
+    const nd::arrfunc &elwise_reduction, const ndt::type &lifted_arr_type,
+    const nd::arrfunc &dst_initialization, intptr_t reduction_ndim,
+    const bool *reduction_dimflags, bool associative, bool commutative,
+    bool right_associative, const nd::array &reduction_identity)
+{
+    nd::array out_af = nd::empty(ndt::make_arrfunc());
+    lift_accumulation_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(out_af.get_readwrite_originptr()),
+        elwise_reduction, lifted_arr_type, dst_initialization, reduction_ndim,
+        reduction_dimflags, associative, commutative, right_associative,
+        reduction_identity);
+    out_af.flag_as_immutable();
+    return out_af;
+}
+
+} // namespace dynd
+
+#endif // _DYND__LIFT_ACCUMULATION_ARRFUNC_HPP_
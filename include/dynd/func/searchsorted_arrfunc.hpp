@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__SEARCHSORTED_ARRFUNC_HPP_
+#define _DYND__SEARCHSORTED_ARRFUNC_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/types/arrfunc_type.hpp>
+#include <dynd/kernels/expr_kernels.hpp>
+
+namespace dynd { namespace kernels {
+
+enum searchsorted_side_t {
+    /** The first position where the needle could be inserted */
+    searchsorted_left,
+    /** The last position where the needle could be inserted */
+    searchsorted_right
+};
+
+enum sorted_set_op_t {
+    /** (M * T) -> var * T, the distinct values */
+    sorted_set_unique,
+    /** (M * T, N * T) -> var * T, the distinct values in both inputs */
+    sorted_set_intersect,
+    /** (M * T, N * T) -> var * T, the distinct values in either input */
+    sorted_set_union
+};
+
+/**
+ * Create an arrfunc "(M * T, N * S) -> N * intptr" which finds, for
+ * every needle in the second argument, the index where it would be
+ * inserted into the sorted haystack in the first argument to keep it
+ * sorted. This is like NumPy's ``searchsorted``.
+ *
+ * When the haystack and needles have the same builtin type, a typed
+ * branchless binary search is used, switching to a single merge walk
+ * over the haystack when the needles are themselves sorted and
+ * numerous. Other types use the sorting_less comparison kernel, so
+ * floating point NaNs are after all other values, as in the sort
+ * arrfunc.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param side  Whether to return the first or last suitable index.
+ */
+void make_searchsorted_arrfunc(arrfunc_type_data *out_af,
+                               searchsorted_side_t side);
+
+inline nd::arrfunc
+make_searchsorted_arrfunc(searchsorted_side_t side = searchsorted_left)
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_searchsorted_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        side);
+    af.flag_as_immutable();
+    return af;
+}
+
+/**
+ * Create an arrfunc which does a set operation on one-dimensional
+ * arrays which are already sorted, producing a sorted array without
+ * duplicates. The result is a var dimension with the element type of
+ * the first argument, since its size depends on the values.
+ *
+ * Runs of equal values and non-matching ranges are skipped with a
+ * galloping search, so intersecting a small set with a large one only
+ * looks at a logarithmic number of the large set's elements.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param op  Which set operation the arrfunc does.
+ */
+void make_sorted_set_arrfunc(arrfunc_type_data *out_af, sorted_set_op_t op);
+
+inline nd::arrfunc make_sorted_set_arrfunc(sorted_set_op_t op)
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_sorted_set_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        op);
+    af.flag_as_immutable();
+    return af;
+}
+
+inline nd::arrfunc make_unique_arrfunc()
+{
+    return make_sorted_set_arrfunc(sorted_set_unique);
+}
+
+inline nd::arrfunc make_intersect_arrfunc()
+{
+    return make_sorted_set_arrfunc(sorted_set_intersect);
+}
+
+inline nd::arrfunc make_union_arrfunc()
+{
+    return make_sorted_set_arrfunc(sorted_set_union);
+}
+
+}} // namespace dynd::kernels
+
+#endif // _DYND__SEARCHSORTED_ARRFUNC_HPP_
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__SORT_ARRFUNC_HPP_
+#define _DYND__SORT_ARRFUNC_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/types/arrfunc_type.hpp>
+#include <dynd/kernels/expr_kernels.hpp>
+
+namespace dynd { namespace kernels {
+
+enum sort_mode_t {
+    /** (M * T) -> M * T, the values in ascending order */
+    sort_mode_sort,
+    /** (M * T) -> M * intptr, the indices which sort the values */
+    sort_mode_argsort,
+    /**
+     * (M * T) -> M * T, the values rearranged so the one at index k is
+     * where it would be if sorted, with no greater values before it and
+     * no lesser values after it
+     */
+    sort_mode_partition,
+    /** (M * T) -> K * T, the k smallest values in ascending order */
+    sort_mode_topk
+};
+
+/**
+ * Create an arrfunc which sorts the elements of a one-dimensional
+ * array, or does one of the related operations selected by ``mode``.
+ *
+ * Builtin integer, floating point and bool elements are sorted with an
+ * LSD radix sort, ascii/utf8 strings with a sort on a fixed-size key
+ * prefix that only falls back to full comparisons between equal
+ * prefixes, and any other type with its sorting_less comparison
+ * kernel. Sorts and argsorts are stable. Large inputs are sorted in
+ * blocks on multiple threads (see ``eval_context::thread_count``), and
+ * the blocks are then merged in parallel.
+ *
+ * Floating point NaNs sort after all other values.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param mode  Which operation the arrfunc does.
+ * \param k  The partition index for sort_mode_partition, or the number
+ *           of values to keep for sort_mode_topk. Ignored otherwise.
+ */
+void make_sort_arrfunc(arrfunc_type_data *out_af, sort_mode_t mode,
+                       intptr_t k = 0);
+
+inline nd::arrfunc make_sort_arrfunc(sort_mode_t mode, intptr_t k = 0)
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_sort_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        mode, k);
+    af.flag_as_immutable();
+    return af;
+}
+
+inline nd::arrfunc make_sort_arrfunc()
+{
+    return make_sort_arrfunc(sort_mode_sort);
+}
+
+inline nd::arrfunc make_argsort_arrfunc()
+{
+    return make_sort_arrfunc(sort_mode_argsort);
+}
+
+inline nd::arrfunc make_partition_arrfunc(intptr_t kth)
+{
+    return make_sort_arrfunc(sort_mode_partition, kth);
+}
+
+inline nd::arrfunc make_topk_arrfunc(intptr_t k)
+{
+    return make_sort_arrfunc(sort_mode_topk, k);
+}
+
+}} // namespace dynd::kernels
+
+#endif // _DYND__SORT_ARRFUNC_HPP_
@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__STENCIL_ARRFUNC_HPP_
+#define _DYND__STENCIL_ARRFUNC_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/types/arrfunc_type.hpp>
+
+namespace dynd {
+
+/**
+ * How a stencil fills in the parts of a neighborhood which fall
+ * outside the array. For an array ``[a b c d]``, these extend it as
+ *
+ *   constant:  k k | a b c d | k k    (k is the constant value)
+ *   nearest:   a a | a b c d | d d
+ *   reflect:   b a | a b c d | d c
+ *   wrap:      c d | a b c d | a b
+ */
+enum stencil_boundary_t {
+    stencil_boundary_constant,
+    stencil_boundary_nearest,
+    stencil_boundary_reflect,
+    stencil_boundary_wrap
+};
+
+/**
+ * Create an arrfunc which applies ``window_op`` to the neighborhood of
+ * every element in the leading ``ndim`` dimensions of its argument, as
+ * for smoothing or convolution filters on gridded data. The output
+ * has the shape of the input.
+ *
+ * The neighborhood of the element at index ``i`` covers
+ * ``i + nh_offset`` up to ``i + nh_offset + nh_shape - 1`` in each
+ * dimension, as in array_neighborhood_iter. Neighborhoods entirely
+ * inside the array are handed to ``window_op`` as strided views of the
+ * source, a whole tile of a row in each call, and the innermost
+ * dimension is processed in tiles so the rows of a neighborhood stay
+ * in cache. The neighborhoods which cross the border are copied into a
+ * buffer with ``boundary`` applied, one at a time.
+ *
+ * \param out_af  The output arrfunc which is filled.
+ * \param window_op  An arrfunc with one parameter of ``ndim`` strided
+ *                   dimensions, returning a scalar, such as a lifted
+ *                   reduction. The element type must be POD, with no
+ *                   arrmeta.
+ * \param ndim  The number of dimensions the neighborhood spans.
+ * \param nh_shape  The shape of the neighborhood.
+ * \param nh_offset  The offset of the neighborhood from each element,
+ *                   or NULL for all zeros.
+ * \param boundary  How to fill in the neighborhood beyond the border.
+ * \param constant  The fill value for ``stencil_boundary_constant``,
+ *                  or a NULL array for zero.
+ */
+void make_stencil_arrfunc(arrfunc_type_data *out_af,
+                          const nd::arrfunc &window_op, intptr_t ndim,
+                          const intptr_t *nh_shape, const intptr_t *nh_offset,
+                          stencil_boundary_t boundary,
+                          const nd::array &constant = nd::array());
+
+inline nd::arrfunc make_stencil_arrfunc(const nd::arrfunc &window_op,
+                                        intptr_t ndim, const intptr_t *nh_shape,
+                                        const intptr_t *nh_offset,
+                                        stencil_boundary_t boundary,
+                                        const nd::array &constant = nd::array())
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_stencil_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        window_op, ndim, nh_shape, nh_offset, boundary, constant);
+    af.flag_as_immutable();
+    return af;
+}
+
+} // namespace dynd
+
+#endif // _DYND__STENCIL_ARRFUNC_HPP_
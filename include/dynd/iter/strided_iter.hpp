@@ -0,0 +1,147 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__STRIDED_ITER_HPP_
+#define _DYND__STRIDED_ITER_HPP_
+
+#include <vector>
+
+#include <dynd/array.hpp>
+#include <dynd/shortvector.hpp>
+
+namespace dynd { namespace iter {
+
+/**
+ * Iterates over any number of strided operands broadcast together,
+ * handing out one strided inner loop at a time, in the manner of
+ * NumPy's NpyIter with an external loop.
+ *
+ * The iteration order follows memory rather than the index order. The
+ * axes are sorted by stride with multistrides_to_axis_perm, and then
+ * neighboring axes which are contiguous for every operand are coalesced
+ * into one, so a transposed or Fortran order array is walked in memory
+ * order, and a contiguous array becomes a single inner loop.
+ *
+ * Example:
+ *     iter::strided_iter it(1, 2, ops);
+ *     if (!it.empty()) {
+ *         do {
+ *             kernel(it.data()[0], it.get_inner_strides()[0],
+ *                    it.data() + 1, it.get_inner_strides() + 1,
+ *                    it.get_inner_size());
+ *         } while (it.next());
+ *     }
+ */
+class strided_iter {
+    int m_noperands;
+    /** The number of dimensions left after reordering and coalescing */
+    intptr_t m_ndim;
+    intptr_t m_itersize;
+    /** The iteration shape, innermost dimension first */
+    dimvector m_shape;
+    /** The strides, ``m_strides[idim * m_noperands + iop]`` */
+    dimvector m_strides;
+    /** The index into each outer dimension (entry 0 is unused) */
+    dimvector m_index;
+    shortvector<char *> m_data;
+    std::vector<ndt::type> m_uniform_tp;
+    shortvector<const char *> m_arrmeta;
+
+    // Non-copyable
+    strided_iter(const strided_iter&);
+    strided_iter& operator=(const strided_iter&);
+
+    void init(const ndt::type *tp, const char *const *arrmeta,
+              char *const *data, int nwrite);
+
+public:
+    /**
+     * Constructs an iterator over ``nwrite + nread`` arrays, of which
+     * the first ``nwrite`` are written. All of their dimensions must be
+     * strided (strided, fixed or cfixed). The read operands broadcast
+     * to the shape of the whole iteration, while the write operands
+     * must already have that shape.
+     *
+     * The iterator doesn't hold references, so the operands must
+     * outlive it.
+     */
+    strided_iter(int nwrite, int nread, const nd::array *ops);
+
+    /** The same, from the type, arrmeta and data of each operand */
+    strided_iter(int nwrite, int nread, const ndt::type *tp,
+                 const char *const *arrmeta, char *const *data);
+
+    inline int get_noperands() const {
+        return m_noperands;
+    }
+
+    /** The number of dimensions iterated, after coalescing */
+    inline intptr_t get_iter_ndim() const {
+        return m_ndim;
+    }
+
+    /** The total number of elements visited */
+    inline intptr_t get_itersize() const {
+        return m_itersize;
+    }
+
+    inline bool empty() const {
+        return m_itersize == 0;
+    }
+
+    /** The number of elements in the current inner loop */
+    inline intptr_t get_inner_size() const {
+        return m_shape[0];
+    }
+
+    /** The inner loop stride of each operand */
+    inline const intptr_t *get_inner_strides() const {
+        return m_strides.get();
+    }
+
+    /** The start of the current inner loop for each operand */
+    inline char *const *data() const {
+        return m_data.get();
+    }
+
+    /** The type of each element visited in operand ``i`` */
+    inline const ndt::type& get_uniform_dtype(int i) const {
+        return m_uniform_tp[i];
+    }
+
+    /** The arrmeta of each element visited in operand ``i`` */
+    inline const char *arrmeta(int i) const {
+        return m_arrmeta[i];
+    }
+
+    /**
+     * Advances to the next inner loop, returning false when the
+     * iteration is finished.
+     */
+    inline bool next() {
+        int nop = m_noperands;
+        for (intptr_t idim = 1; idim < m_ndim; ++idim) {
+            const intptr_t *strides = m_strides.get() + idim * nop;
+            if (++m_index[idim] != m_shape[idim]) {
+                for (int iop = 0; iop < nop; ++iop) {
+                    m_data[iop] += strides[iop];
+                }
+                return true;
+            } else {
+                // Rewind this dimension and carry into the next one
+                intptr_t rewind = m_shape[idim] - 1;
+                for (int iop = 0; iop < nop; ++iop) {
+                    m_data[iop] -= rewind * strides[iop];
+                }
+                m_index[idim] = 0;
+            }
+        }
+        return false;
+    }
+};
+
+}} // namespace dynd::iter
+
+#endif // _DYND__STRIDED_ITER_HPP_
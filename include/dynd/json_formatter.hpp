@@ -19,6 +19,17 @@ namespace dynd {
  */
 nd::array format_json(const nd::array &a, bool struct_as_list = false);
 
+/**
+ * Formats the nd::array as JSON, returning it as a json value instead
+ * of a string. The formatter only produces valid JSON, so assigning the
+ * result to other json values doesn't validate it again.
+ *
+ * \param a  The array to format as JSON.
+ * \param struct_as_list  If true, formats struct objects as lists, otherwise
+ *                        formats them as objects/dicts.
+ */
+nd::array format_json_value(const nd::array &a, bool struct_as_list = false);
+
 } // namespace dynd
 
 #endif // _DYND__JSON_FORMATTER_HPP_
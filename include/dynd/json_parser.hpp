@@ -10,6 +10,77 @@
 
 namespace dynd {
 
+namespace detail {
+    struct json_parse_node;
+} // namespace detail
+
+enum json_string_policy_t {
+    /** Copy every string into the string memory block of the result */
+    json_copy_strings,
+    /**
+     * UTF-8 strings without escapes point directly into the JSON input.
+     * Only strings with escapes get copied.
+     */
+    json_reference_strings
+};
+
+/**
+ * A plan for parsing JSON into a particular dynd type, compiled once
+ * so the parser doesn't dispatch on the type for every value. Struct
+ * fields are found with a hash table, and the plan predicts that object
+ * keys arrive in the same order as in the previous object, so records
+ * of the same shape cost one name comparison per key.
+ *
+ * The parse_json functions build a plan on each call. When parsing many
+ * small documents of the same type, such as JSON lines, reuse one plan.
+ *
+ * A plan updates its key order predictions while parsing, so it must
+ * not be used from multiple threads at once.
+ *
+ * With ``json_reference_strings``, the plan doesn't hold on to the JSON
+ * input, so the caller must keep it alive as long as the parsed strings.
+ * The parse_json overload taking a policy handles this for nd::array inputs.
+ */
+class json_parse_plan {
+    ndt::type m_type;
+    json_string_policy_t m_string_policy;
+    detail::json_parse_node *m_root;
+
+    // Non-copyable
+    json_parse_plan(const json_parse_plan&);
+    json_parse_plan& operator=(const json_parse_plan&);
+public:
+    explicit json_parse_plan(const ndt::type& tp,
+                             json_string_policy_t string_policy = json_copy_strings);
+    ~json_parse_plan();
+
+    const ndt::type& get_type() const {
+        return m_type;
+    }
+
+    json_string_policy_t get_string_policy() const {
+        return m_string_policy;
+    }
+
+    /** The compiled plan, for use within the JSON parser */
+    detail::json_parse_node *get_root() {
+        return m_root;
+    }
+
+    /**
+     * Parses the JSON into an uninitialized dynd array, whose type must
+     * be the plan's type.
+     */
+    void parse(nd::array& out, const char *json_begin, const char *json_end,
+               const eval::eval_context *ectx = &eval::default_eval_context);
+
+    /**
+     * Parses the JSON into a new immutable dynd array.
+     */
+    nd::array parse(const char *json_begin, const char *json_end,
+                    const eval::eval_context *ectx = &eval::default_eval_context);
+};
+
 /**
  * Validates UTF-8 encoded JSON, throwing an exception if it
  * is not valid.
@@ -19,6 +90,21 @@ namespace dynd {
  */
 void validate_json(const char *json_begin, const char *json_end);
 
+/**
+ * Validates a run of UTF-8 strings as JSON, for checking many values
+ * at once without building an error message for each. Use validate_json
+ * on the failing string to get a detailed message.
+ *
+ * \param data  The first string_type_data.
+ * \param stride  The stride between the strings.
+ * \param count  The number of strings.
+ *
+ * \returns  The index of the first string which is not valid JSON,
+ *           or `count` if they all are.
+ */
+intptr_t validate_json_strings(const char *data, intptr_t stride,
+                               intptr_t count);
+
 /**
  * This function parses the JSON, encoded as UTF-8, into an nd::array
  * of the specified type. This parser works directly from JSON to the
@@ -55,6 +141,43 @@ nd::array parse_json(const ndt::type &tp, const nd::array &json,
 void parse_json(nd::array &out, const nd::array &json,
                 const eval::eval_context *ectx);
 
+/**
+ * Parses the input json as the requested type, with a choice of whether
+ * to copy strings. With ``json_reference_strings``, the string memory
+ * blocks of the result hold a reference to the memory of the input, such
+ * as the memory map of an nd::memmap, and unescaped strings point into it.
+ * The result is only immutable if the input is.
+ */
+nd::array parse_json(const ndt::type &tp, const nd::array &json,
+                     json_string_policy_t string_policy,
+                     const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Parses newline-delimited JSON (JSON lines), with a value of type ``tp``
+ * on every non-blank line, into an array of type ``var * tp``.
+ *
+ * The input is split into chunks at line boundaries, which are parsed
+ * on up to ``ectx->thread_count`` threads. The records of all the chunks
+ * are counted first, so each thread parses straight into its own part
+ * of the result. Strings and nested var dimensions go into concurrent
+ * memory blocks, with a separate arena for each thread.
+ *
+ * \param tp  The type of each line.
+ * \param json_begin  The beginning of the UTF-8 buffer containing the JSON.
+ * \param json_end  One past the end of the UTF-8 buffer containing the JSON.
+ * \param ectx  An evaluation context.
+ */
+nd::array parse_json_lines(const ndt::type& tp, const char *json_begin,
+                           const char *json_end,
+                           const eval::eval_context *ectx = &eval::default_eval_context);
+
+/**
+ * Parses the input JSON lines, which can be a string or a bytes array.
+ * If the input is bytes, the parser assumes it is UTF-8 data.
+ */
+nd::array parse_json_lines(const ndt::type &tp, const nd::array &json,
+                           const eval::eval_context *ectx = &eval::default_eval_context);
+
 inline nd::array parse_json(const ndt::type &tp, const std::string &json,
                             const eval::eval_context *ectx)
 {
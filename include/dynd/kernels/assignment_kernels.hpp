@@ -270,6 +270,10 @@ struct strided_assign_ck : public kernels::unary_ck<strided_assign_ck> {
         // Destroy the child ckernel
         get_child_ckernel()->destroy();
     }
+
+    inline void clone_children(const self_type *src) {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
 };
 
 } // namespace kernels
@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__BUSDATE_KERNELS_HPP_
+#define _DYND__BUSDATE_KERNELS_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/array.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/types/arrfunc_type.hpp>
+#include <dynd/types/busdate_type.hpp>
+
+namespace dynd { namespace kernels {
+
+/**
+ * Create an arrfunc "(date, int64) -> date" which rolls each date to a
+ * business day, then moves it by the given number of business days,
+ * like NumPy's ``busday_offset``. The weekmask, holidays and roll policy
+ * are those of ``busdate_tp``. Use lift_arrfunc to apply it to arrays.
+ *
+ * Each element takes constant time plus a binary search over the
+ * holidays, however far it is moved. See busdate_calendar.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param busdate_tp  A busdate type, describing the business days.
+ */
+void make_busday_offset_arrfunc(arrfunc_type_data *out_af,
+                                const ndt::type& busdate_tp);
+
+inline nd::arrfunc
+make_busday_offset_arrfunc(const ndt::type& busdate_tp = ndt::make_busdate())
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_busday_offset_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        busdate_tp);
+    af.flag_as_immutable();
+    return af;
+}
+
+/**
+ * Create an arrfunc "(date, date) -> int64" which counts the business
+ * days from the first date up to but not including the second, or the
+ * negative of the count the other way when the second is earlier, like
+ * NumPy's ``busday_count``. The weekmask and holidays are those of
+ * ``busdate_tp``.
+ *
+ * \param out_af  The arrfunc to fill.
+ * \param busdate_tp  A busdate type, describing the business days.
+ */
+void make_busday_count_arrfunc(arrfunc_type_data *out_af,
+                               const ndt::type& busdate_tp);
+
+inline nd::arrfunc
+make_busday_count_arrfunc(const ndt::type& busdate_tp = ndt::make_busdate())
+{
+    nd::array af = nd::empty(ndt::make_arrfunc());
+    make_busday_count_arrfunc(
+        reinterpret_cast<arrfunc_type_data *>(af.get_readwrite_originptr()),
+        busdate_tp);
+    af.flag_as_immutable();
+    return af;
+}
+
+}} // namespace dynd::kernels
+
+#endif // _DYND__BUSDATE_KERNELS_HPP_
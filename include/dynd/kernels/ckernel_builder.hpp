@@ -42,7 +42,9 @@ namespace kernels {
  *
  * The data placed in the kernel's data must
  * be relocatable with a memcpy, it must not rely on its
- * own address.
+ * own address. Kernels which own resources can be
+ * duplicated with ``clone``, through the clone function
+ * in ckernel_prefix.
  */
 class ckernel_builder {
   // Pointer to the kernel function pointers + data
@@ -184,6 +186,47 @@ public:
     }
   }
 
+  /**
+   * Replaces the contents of ``out`` with an independent replica of
+   * this ckernel, for example to run the same ckernel from several
+   * threads without instantiating it again for each one. The memory
+   * is copied, then the clone functions of the ckernels give the
+   * replica its own resources.
+   *
+   * The replica refers to the same arrmeta as the original, so that
+   * arrmeta must stay alive for as long as any replica is used.
+   * Throws if some ckernel in the hierarchy can't be cloned.
+   */
+  void clone(ckernel_builder &out) const
+  {
+    if (m_data == NULL) {
+      out.reset();
+      return;
+    }
+    out.clone_from(get(), m_capacity);
+  }
+
+  /**
+   * Replaces the contents of this builder with an independent replica
+   * of the ckernel ``src``, whose hierarchy takes ``size`` bytes. This
+   * lets a ckernel make replicas of its children, which live inside
+   * another builder.
+   */
+  void clone_from(const ckernel_prefix *src, intptr_t size)
+  {
+    reset();
+    ensure_capacity_leaf(size);
+    memcpy(m_data, src, size);
+    try {
+      get()->clone_from(src);
+    }
+    catch (...) {
+      // The clone functions released what they acquired
+      memset(m_data, 0, m_capacity);
+      throw;
+    }
+  }
+
   /** For debugging/informational purposes */
   intptr_t get_capacity() const { return m_capacity; }
 
@@ -397,6 +440,7 @@ namespace kernels {
             "internal ckernel error: struct layout is not valid");
       }
       self->base.destructor = &self_type::destruct;
+      self->base.clone = self_type::get_clone_function();
       // A child class must implement this to fill in self->base.function
       self->init_kernfunc(kernreq);
       return self;
@@ -420,6 +464,52 @@ namespace kernels {
      */
     inline void destruct_children() {}
 
+    /**
+     * The ckernel clone function, which is placed in base.clone.
+     * This copy constructs the replica over the copied memory, so
+     * members like ndt::type get their own references.
+     */
+    static void clone(ckernel_prefix *rawdst, const ckernel_prefix *rawsrc)
+    {
+      const self_type *src = get_self(rawsrc);
+      self_type *dst = new (rawdst) self_type(*src);
+      try {
+        // If there are any child kernels, a child class
+        // must implement this to clone them.
+        dst->clone_children(src);
+      }
+      catch (...) {
+        dst->~self_type();
+        throw;
+      }
+    }
+
+    /**
+     * Default implementation of clone_children does nothing. A ckernel
+     * which implements destruct_children must also implement this for
+     * it to be cloneable. If cloning a child throws, it must destroy
+     * the children it already cloned.
+     */
+    inline void clone_children(const self_type *DYND_UNUSED(src)) {}
+
+    /**
+     * Returns the function for base.clone. A child class whose members
+     * can't be copied to make a replica hides this with a version
+     * returning NULL.
+     */
+    static ckernel_prefix::clone_fn_t get_clone_function()
+    {
+      // Children which are destroyed but not cloned would be shared
+      void (self_type::*destruct_children_fn)() = &self_type::destruct_children;
+      void (self_type::*clone_children_fn)(const self_type *) =
+          &self_type::clone_children;
+      if (destruct_children_fn != &general_ck::destruct_children &&
+          clone_children_fn == &general_ck::clone_children) {
+        return NULL;
+      }
+      return &self_type::clone;
+    }
+
     /**
      * Returns the child ckernel immediately following this one.
      */
@@ -435,6 +525,16 @@ namespace kernels {
     {
       return base.get_child_ckernel(ckernel_prefix::align_offset(offset));
     }
+
+    inline const ckernel_prefix *get_child_ckernel() const
+    {
+      return get_child_ckernel(sizeof(self_type));
+    }
+
+    inline const ckernel_prefix *get_child_ckernel(intptr_t offset) const
+    {
+      return base.get_child_ckernel(ckernel_prefix::align_offset(offset));
+    }
   };
 } // namespace kernels
 
@@ -20,6 +20,13 @@ namespace kernels {
  */
 void destroy_trivial_parent_ckernel(ckernel_prefix *ckp);
 
+/**
+ * A function to clone a ckernel which doesn't have
+ * any extra data, and has a single child kernel.
+ */
+void clone_trivial_parent_ckernel(ckernel_prefix *dst,
+                                  const ckernel_prefix *src);
+
 /**
  * An expr single ckernel function which adapts a child
  * unary single ckernel.
@@ -57,8 +57,8 @@ typedef uint32_t kernel_request_t;
  * This is the struct which begins the memory layout
  * of all ckernels. First comes the function pointer,
  * which has a context-specific prototype, such as
- * `expr_single_t`, and then comes the
- * destructor.
+ * `expr_single_t`, then comes the destructor, and
+ * then the clone function.
  *
  * The ckernel is defined in terms of a C ABI definition,
  * and must satisfy alignments, movability, and
@@ -67,9 +67,23 @@ typedef uint32_t kernel_request_t;
  */
 struct ckernel_prefix {
     typedef void (*destructor_fn_t)(ckernel_prefix *);
+    /**
+     * Makes the ckernel at ``dst``, whose memory starts out as a copy
+     * of the one at ``src``, into an independent replica of it, for
+     * example by taking its own references and cloning its children.
+     * If it throws, it must first release whatever it acquired, as
+     * the replica is then discarded without being destroyed.
+     */
+    typedef void (*clone_fn_t)(ckernel_prefix *dst, const ckernel_prefix *src);
 
     void *function;
     destructor_fn_t destructor;
+    /**
+     * NULL if copying the memory is enough to clone the ckernel, which
+     * must then also have a NULL destructor, otherwise the ckernel
+     * can't be cloned.
+     */
+    clone_fn_t clone;
 
     /**
      * To help with generic code a bit, structs which
@@ -134,6 +148,18 @@ struct ckernel_prefix {
         }
     }
 
+    /**
+     * Makes this ckernel, whose memory was copied from ``src``,
+     * into an independent replica of ``src``.
+     */
+    inline void clone_from(const ckernel_prefix *src) {
+        if (src->clone != NULL) {
+            src->clone(this, src);
+        } else if (src->destructor != NULL) {
+            throw std::runtime_error("dynd ckernel does not support cloning");
+        }
+    }
+
     /**
      * Returns the pointer to a child ckernel at the provided
      * offset.
@@ -144,6 +170,12 @@ struct ckernel_prefix {
           ckernel_prefix::align_offset(offset));
     }
 
+    inline const ckernel_prefix *get_child_ckernel(intptr_t offset) const {
+      return reinterpret_cast<const ckernel_prefix *>(
+          reinterpret_cast<const char *>(this) +
+          ckernel_prefix::align_offset(offset));
+    }
+
     /**
      * If the provided offset is non-zero, destroys
      * a ckernel at the given offset from `this`.
@@ -154,6 +186,37 @@ struct ckernel_prefix {
         child->destroy();
       }
     }
+
+    /**
+     * If the provided offset is non-zero, clones the child
+     * ckernel at the given offset from `src` into the same
+     * offset from `this`.
+     */
+    inline void clone_child_ckernel(const ckernel_prefix *src, size_t offset) {
+      if (offset != 0) {
+        get_child_ckernel(offset)->clone_from(src->get_child_ckernel(offset));
+      }
+    }
+
+    /**
+     * Clones the child ckernels at the provided offsets from `src`
+     * into the same offsets from `this`, skipping zero offsets. If
+     * one of them throws, the ones already cloned are destroyed.
+     */
+    inline void clone_child_ckernels(const ckernel_prefix *src, intptr_t count,
+                                     const size_t *offsets) {
+      intptr_t i = 0;
+      try {
+        for (; i < count; ++i) {
+          clone_child_ckernel(src, offsets[i]);
+        }
+      } catch (...) {
+        for (intptr_t j = 0; j < i; ++j) {
+          destroy_child_ckernel(offsets[j]);
+        }
+        throw;
+      }
+    }
 };
 
 } // namespace dynd
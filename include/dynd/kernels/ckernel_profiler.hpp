@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__CKERNEL_PROFILER_HPP_
+#define _DYND__CKERNEL_PROFILER_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+
+#include <dynd/config.hpp>
+#include <dynd/type.hpp>
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+
+namespace dynd {
+
+/**
+ * Collects per-node statistics about ckernels while they run. To
+ * use it, point the ``profiler`` field of an eval_context at one,
+ * and every ckernel built with that context through one of the
+ * instrumented construction points (assignment kernels, arrfunc
+ * calls, lifted and chained arrfuncs) gets a shim ckernel in front
+ * of it which counts calls and elements, and times them with the
+ * CPU's cycle counter.
+ *
+ * The shims record into a tree of nodes which mirrors the ckernel
+ * hierarchy, one root per top level ckernel built, and ``print``
+ * dumps it with the statistics. Times are inclusive of the children,
+ * the "self" column subtracts the time of the child nodes.
+ *
+ * When the eval_context has no profiler, nothing is inserted, and
+ * the ckernels are exactly as without profiling. The profiler is not
+ * thread-safe, so build and run profiled ckernels from one thread,
+ * and keep it alive for as long as they exist.
+ */
+class ckernel_profiler {
+public:
+    struct node {
+        /** Description of the ckernel, e.g. its types */
+        std::string label;
+        /** The kernel request the ckernel was built for */
+        kernel_request_t kernreq;
+        /** Number of calls to the ckernel */
+        uint64_t calls;
+        /** Number of elements processed, one per call for single calls */
+        uint64_t elements;
+        /** Cycle counter ticks spent in the ckernel, including children */
+        uint64_t ticks;
+        node *parent;
+        std::vector<node *> children;
+    };
+
+private:
+    // A deque so node pointers held by the shims stay valid
+    std::deque<node> m_nodes;
+    std::vector<node *> m_roots;
+    // The nodes of the ckernels currently being built
+    std::vector<node *> m_build_stack;
+
+    // Non-copyable
+    ckernel_profiler(const ckernel_profiler&);
+    ckernel_profiler& operator=(const ckernel_profiler&);
+
+public:
+    ckernel_profiler() {}
+
+    /** The nodes for the top level ckernels, in the order built */
+    inline const std::vector<node *>& get_roots() const {
+        return m_roots;
+    }
+
+    /** The total number of nodes recorded */
+    inline intptr_t get_node_count() const {
+        return (intptr_t)m_nodes.size();
+    }
+
+    /** Sets all the counts and times back to zero */
+    void reset_counts();
+
+    /**
+     * Removes all the nodes. This must not be called while any
+     * profiled ckernel built with this profiler still exists.
+     */
+    void clear();
+
+    /**
+     * Prints the tree of nodes, with call counts, element counts,
+     * and inclusive and self ticks.
+     */
+    void print(std::ostream& o) const;
+
+    /**
+     * Adds a node for a ckernel about to be built, and if ``kernreq``
+     * is one the shim supports, places the shim at ``inout_ckb_offset``
+     * and advances it to where the profiled ckernel should go.
+     * Returns false, without changing anything, if no shim was placed.
+     * Each successful call must be paired with ``end_shim`` once the
+     * ckernel is built, use ``kernels::ckernel_profile_scope``.
+     */
+    bool begin_shim(ckernel_builder *ckb, intptr_t &inout_ckb_offset,
+                    kernel_request_t kernreq, const std::string& label);
+
+    /** Finishes the node started by the last ``begin_shim`` */
+    void end_shim();
+};
+
+inline std::ostream& operator<<(std::ostream& o, const ckernel_profiler& p)
+{
+    p.print(o);
+    return o;
+}
+
+namespace kernels {
+
+/**
+ * Scoped helper to profile the ckernel built at ``inout_ckb_offset``
+ * during its lifetime, if ``ectx`` has a profiler. Construct it
+ * before building the ckernel, with the offset variable that is then
+ * used to build it.
+ *
+ *      ckernel_profile_scope prof(ckb, ckb_offset, kernreq, "label", ectx);
+ *      return make_the_ckernel(ckb, ckb_offset, ..., kernreq, ectx);
+ */
+class ckernel_profile_scope {
+    ckernel_profiler *m_profiler;
+
+    void begin(ckernel_profiler *profiler, ckernel_builder *ckb,
+               intptr_t &inout_ckb_offset, kernel_request_t kernreq,
+               const char *label, const ndt::type *dst_tp,
+               intptr_t src_count, const ndt::type *src_tp);
+
+    // Non-copyable
+    ckernel_profile_scope(const ckernel_profile_scope&);
+    ckernel_profile_scope& operator=(const ckernel_profile_scope&);
+
+public:
+    inline ckernel_profile_scope(ckernel_builder *ckb,
+                                 intptr_t &inout_ckb_offset,
+                                 kernel_request_t kernreq, const char *label,
+                                 const eval::eval_context *ectx)
+        : m_profiler(NULL)
+    {
+        ckernel_profiler *profiler = (ectx != NULL) ? ectx->profiler : NULL;
+        if (profiler != NULL) {
+            begin(profiler, ckb, inout_ckb_offset, kernreq, label, NULL, 0,
+                  NULL);
+        }
+    }
+
+    /**
+     * Like the other constructor, but appends the destination and
+     * source types to the label, as "label (src0, src1) -> dst". The
+     * label is only formatted when profiling.
+     */
+    inline ckernel_profile_scope(ckernel_builder *ckb,
+                                 intptr_t &inout_ckb_offset,
+                                 kernel_request_t kernreq, const char *label,
+                                 const ndt::type &dst_tp, intptr_t src_count,
+                                 const ndt::type *src_tp,
+                                 const eval::eval_context *ectx)
+        : m_profiler(NULL)
+    {
+        ckernel_profiler *profiler = (ectx != NULL) ? ectx->profiler : NULL;
+        if (profiler != NULL) {
+            begin(profiler, ckb, inout_ckb_offset, kernreq, label, &dst_tp,
+                  src_count, src_tp);
+        }
+    }
+
+    inline ~ckernel_profile_scope()
+    {
+        if (m_profiler != NULL) {
+            m_profiler->end_shim();
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace dynd
+
+#endif // _DYND__CKERNEL_PROFILER_HPP_
@@ -8,6 +8,7 @@
 
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/types/date_type.hpp>
+#include <dynd/types/tz_database.hpp>
 
 namespace dynd {
 
@@ -29,6 +30,29 @@ size_t make_datetime_to_string_assignment_kernel(
     const char *src_arrmeta, kernel_request_t kernreq,
     const eval::eval_context *ectx);
 
+/**
+ * Makes a kernel which converts UTC datetime ticks to the wall clock
+ * ticks of the time zone ``tz``. The strided kernel remembers the
+ * transition interval of the previous value, and only searches the
+ * zone's table when a value falls outside it, so mostly sorted input
+ * converts with two comparisons per element.
+ */
+size_t make_datetime_utc_to_local_kernel(ckernel_builder *ckb,
+                                         intptr_t ckb_offset,
+                                         const tz_info *tz,
+                                         kernel_request_t kernreq);
+
+/**
+ * Makes a kernel which converts wall clock datetime ticks in the time
+ * zone ``tz`` to UTC ticks, with the same interval caching as
+ * make_datetime_utc_to_local_kernel. A wall clock time which is skipped
+ * or repeated by a transition uses the offset before the transition.
+ */
+size_t make_datetime_local_to_utc_kernel(ckernel_builder *ckb,
+                                         intptr_t ckb_offset,
+                                         const tz_info *tz,
+                                         kernel_request_t kernreq);
+
 } // namespace dynd
 
 #endif // _DYND__DATETIME_ASSIGNMENT_KERNELS_HPP_
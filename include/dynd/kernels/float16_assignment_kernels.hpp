@@ -0,0 +1,47 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__FLOAT16_ASSIGNMENT_KERNELS_HPP_
+#define _DYND__FLOAT16_ASSIGNMENT_KERNELS_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/typed_data_assign.hpp>
+
+namespace dynd {
+
+/**
+ * Returns true if the CPU has the F16C half precision conversion
+ * instructions, and the OS saves the AVX registers they use. This is
+ * checked once, on the first call.
+ */
+bool float16_has_hardware_conversion();
+
+/**
+ * Strided conversions between float16 and float32/float64, the bulk
+ * equivalents of halfbits_to_float, float_to_halfbits, etc. They use
+ * F16C when float16_has_hardware_conversion() says so, working in blocks
+ * which are gathered/scattered through a buffer when not contiguous.
+ *
+ * Conversions to float16 check the error mode once per block, and redo
+ * a block which fails the check with float_to_halfbits or
+ * double_to_halfbits, which raise the error for the offending value.
+ * Where the hardware path is used, NaN results are quiet NaNs.
+ */
+void float16_to_float32_strided(char *dst, intptr_t dst_stride,
+                                const char *src, intptr_t src_stride,
+                                size_t count);
+void float16_to_float64_strided(char *dst, intptr_t dst_stride,
+                                const char *src, intptr_t src_stride,
+                                size_t count);
+void float32_to_float16_strided(char *dst, intptr_t dst_stride,
+                                const char *src, intptr_t src_stride,
+                                size_t count, assign_error_mode errmode);
+void float64_to_float16_strided(char *dst, intptr_t dst_stride,
+                                const char *src, intptr_t src_stride,
+                                size_t count, assign_error_mode errmode);
+
+} // namespace dynd
+
+#endif // _DYND__FLOAT16_ASSIGNMENT_KERNELS_HPP_
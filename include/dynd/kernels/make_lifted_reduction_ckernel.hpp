@@ -57,6 +57,30 @@ size_t make_lifted_reduction_ckernel(
     dynd::kernel_request_t kernreq,
     const eval::eval_context *ectx = &eval::default_eval_context);
 
+/**
+ * Lifts the provided reduction ckernel into an accumulation, which
+ * produces the running reduction along one dimension, with the same
+ * shape as the source. Each output element is the reduction of the
+ * source elements up to and including it, so with a sum reduction,
+ * this is a cumulative sum.
+ *
+ * The parameters are as for make_lifted_reduction_ckernel, except
+ * that exactly one dimension must be flagged in ``reduction_dimflags``,
+ * and the destination keeps all the dimensions. Large accumulations of
+ * scalars are split across threads, which requires the reduction to be
+ * associative and commutative, with the same source and destination type,
+ * and no ``dst_initialization``.
+ */
+size_t make_lifted_accumulation_ckernel(
+    const arrfunc_type_data *elwise_reduction,
+    const arrfunc_type_data *dst_initialization, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    const ndt::type &src_tp, const char *src_arrmeta, intptr_t reduction_ndim,
+    const bool *reduction_dimflags, bool associative, bool commutative,
+    bool right_associative, const nd::array &reduction_identity,
+    dynd::kernel_request_t kernreq,
+    const eval::eval_context *ectx = &eval::default_eval_context);
+
 } // namespace dynd
 
 #endif // _DYND__MAKE_LIFTED_CKERNEL_HPP_
@@ -48,6 +48,12 @@ inline nd::arrfunc make_builtin_sum_reduction_arrfunc(type_id_t tid)
  */
 nd::arrfunc make_builtin_sum1d_arrfunc(type_id_t tid);
 
+/**
+ * Makes a 1D cumulative sum arrfunc.
+ * (strided * <tid>) -> strided * <tid>
+ */
+nd::arrfunc make_builtin_cumsum1d_arrfunc(type_id_t tid);
+
 /**
  * Makes a 1D mean arrfunc.
  * (strided * <tid>) -> <tid>
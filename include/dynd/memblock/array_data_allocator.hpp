@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__ARRAY_DATA_ALLOCATOR_HPP_
+#define _DYND__ARRAY_DATA_ALLOCATOR_HPP_
+
+#include <dynd/config.hpp>
+
+/**
+ * Array data of at least this many bytes is aligned to this many bytes,
+ * a cache line and the widest SIMD registers.
+ */
+#define DYND_ARRAY_DATA_ALIGNMENT 64
+
+/**
+ * The default size from which the system allocator maps memory
+ * directly from the OS, with transparent huge pages where available.
+ */
+#define DYND_ARRAY_HUGE_PAGE_THRESHOLD (2 * 1024 * 1024)
+
+namespace dynd {
+
+/**
+ * A struct of function pointers for allocating the memory blocks which
+ * hold nd::array arrmeta together with its data, as done by nd::empty,
+ * nd::typed_empty and the other array constructors.
+ */
+struct array_data_allocator {
+    /**
+     * Allocates ``size`` bytes aligned to ``alignment``, a power of two.
+     * Returns NULL on failure.
+     *
+     * \param self  The allocator, so implementations can embed it in a
+     *              larger struct with their own settings.
+     * \param out_cookie  A value the allocator can use to record how the
+     *                    memory was allocated, passed back to deallocate.
+     */
+    void *(*allocate)(const array_data_allocator *self, size_t size,
+                      size_t alignment, uintptr_t *out_cookie);
+    /**
+     * Frees memory from a previous allocate call with the same size.
+     */
+    void (*deallocate)(const array_data_allocator *self, void *ptr,
+                       size_t size, uintptr_t cookie);
+};
+
+enum array_numa_policy_t {
+    /**
+     * Pages go on the NUMA node of the thread which first writes them,
+     * the OS default. Initialize large arrays from the threads that
+     * will use them.
+     */
+    array_numa_first_touch,
+    /** Pages are spread round-robin across all the NUMA nodes */
+    array_numa_interleave
+};
+
+/**
+ * The allocator used by default. Small allocations come from malloc
+ * (aligned as requested), and allocations of at least
+ * ``huge_page_threshold`` bytes are mapped from the OS aligned to the
+ * huge page size and marked for transparent huge pages. On Linux, the
+ * mapped memory can also be interleaved across NUMA nodes with mbind,
+ * without needing libnuma.
+ */
+struct system_array_data_allocator {
+    array_data_allocator base;
+    /** Size from which to map memory directly, 0 to never do it */
+    size_t huge_page_threshold;
+    array_numa_policy_t numa_policy;
+};
+
+/**
+ * Initializes a system allocator with the given settings.
+ */
+void init_system_array_data_allocator(system_array_data_allocator *out_alloc,
+                                      size_t huge_page_threshold,
+                                      array_numa_policy_t numa_policy);
+
+/**
+ * Returns the allocator used for new arrays.
+ */
+const array_data_allocator *get_array_data_allocator();
+
+/**
+ * Sets the allocator used for new arrays, returning the previous one.
+ * Passing NULL restores the default system allocator. An allocator must
+ * stay alive until every array allocated with it is freed.
+ *
+ * NOTE: This is not synchronized with array creation on other threads.
+ */
+const array_data_allocator *
+set_array_data_allocator(const array_data_allocator *alloc);
+
+/**
+ * Allocates a memory block of ``size`` bytes from the current array data
+ * allocator, placed so that the returned pointer is 16-byte aligned and
+ * the returned pointer plus ``data_offset`` is aligned to ``alignment``.
+ * The allocator is recorded in a small header in front of the block.
+ *
+ * \param size  The size of the block.
+ * \param data_offset  The offset of the data within the block, which
+ *                     must be a multiple of 16.
+ * \param alignment  The alignment of the data, a power of two.
+ */
+char *allocate_array_block(size_t size, size_t data_offset, size_t alignment);
+
+/**
+ * Frees a block from allocate_array_block.
+ */
+void free_array_block(char *block);
+
+} // namespace dynd
+
+#endif // _DYND__ARRAY_DATA_ALLOCATOR_HPP_
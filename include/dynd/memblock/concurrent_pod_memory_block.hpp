@@ -0,0 +1,45 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__CONCURRENT_POD_MEMORY_BLOCK_HPP_
+#define _DYND__CONCURRENT_POD_MEMORY_BLOCK_HPP_
+
+#include <iostream>
+#include <string>
+
+#include <dynd/memblock/memory_block.hpp>
+
+namespace dynd {
+
+/**
+ * Creates a memory block which can be used to allocate POD output memory
+ * for blockref types from multiple threads at once, for example by a
+ * kernel producing strings which runs on several threads.
+ *
+ * Each thread allocating from the block gets its own sub-arena, carved
+ * from chunks shared by all the threads. Allocations, and resizes of a
+ * thread's most recent allocation, bump a pointer in the calling
+ * thread's sub-arena without taking any lock. Only carving a new
+ * sub-arena or allocating a new chunk takes the block's lock.
+ *
+ * Like with the pod memory block, ``resize`` must be called only with
+ * the most recent allocation, but here that is per thread. ``finalize``
+ * must be called after all the threads are done allocating.
+ *
+ * \param initial_capacity_bytes  The size of the first shared chunk.
+ * \param subarena_bytes  The size of the first sub-arena each thread
+ *                        carves, later ones double up to the chunk size.
+ */
+memory_block_ptr
+make_concurrent_pod_memory_block(intptr_t initial_capacity_bytes = 65536,
+                                 intptr_t subarena_bytes = 1024);
+
+void concurrent_pod_memory_block_debug_print(const memory_block_data *memblock,
+                                             std::ostream &o,
+                                             const std::string &indent);
+
+} // namespace dynd
+
+#endif // _DYND__CONCURRENT_POD_MEMORY_BLOCK_HPP_
@@ -21,6 +21,15 @@ namespace dynd {
  */
 memory_block_ptr make_pod_memory_block(intptr_t initial_capacity_bytes = 2048);
 
+/**
+ * Creates a POD memory block which also holds a reference to
+ * ``data_reference``, so the blockref data can point either into memory
+ * allocated from this block or into the referenced memory. This is how
+ * parsed strings can refer directly to the buffer they were parsed from.
+ */
+memory_block_ptr make_pod_memory_block(const memory_block_ptr& data_reference,
+                                       intptr_t initial_capacity_bytes = 2048);
+
 void pod_memory_block_debug_print(const memory_block_data *memblock, std::ostream& o, const std::string& indent);
 
 } // namespace dynd
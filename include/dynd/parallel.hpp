@@ -0,0 +1,47 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__PARALLEL_HPP_
+#define _DYND__PARALLEL_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/eval/eval_context.hpp>
+
+namespace dynd { namespace parallel {
+
+/**
+ * Returns the number of threads the hardware can run
+ * concurrently, at least 1.
+ */
+intptr_t get_hardware_thread_count();
+
+/**
+ * Returns the number of threads to use for a parallel operation
+ * under the evaluation context ``ectx``. If ``ectx->thread_count``
+ * is 0, this is the hardware thread count.
+ */
+intptr_t get_thread_count(const eval::eval_context *ectx);
+
+/**
+ * A task function for run_tasks, called once for each task index.
+ */
+typedef void (*task_fn_t)(intptr_t task_index, void *data);
+
+/**
+ * Runs ``task(i, data)`` for every ``i`` in ``[0, task_count)``,
+ * spreading the tasks over up to ``thread_count`` threads, one of
+ * which is the calling thread. Returns once all the tasks are done.
+ * If any task throws, the first exception is rethrown here after the
+ * remaining threads have finished.
+ *
+ * When dynd is built without thread support, the tasks are run
+ * in order on the calling thread.
+ */
+void run_tasks(intptr_t task_count, intptr_t thread_count, task_fn_t task,
+               void *data);
+
+}} // namespace dynd::parallel
+
+#endif // _DYND__PARALLEL_HPP_
@@ -146,6 +146,77 @@
                         DYND_PP_META_NAME_RANGE(src, N),                       \
                         DYND_PP_META_NAME_RANGE(src_stride, N));
 
+/**
+ * Tests whether ``dst``, ``src0``, etc. all step by exactly the size of
+ * their types, from ``dst_stride``, ``src_stride0``, etc.
+ *
+ * (dst_stride == (intptr_t)sizeof(DST_TYPE) &&
+ *  src_stride0 == (intptr_t)sizeof(TYPE0) && ...)
+ */
+#define DYND_PP_IS_UNIT_STRIDED(DST_TYPE, TYPE, N)                             \
+  (dst_stride == static_cast<intptr_t>(sizeof(DST_TYPE)) &&                    \
+   DYND_PP_JOIN_ELWISE_1(                                                      \
+       DYND_PP_META_EQ, (&&), DYND_PP_META_NAME_RANGE(src_stride, N),          \
+       DYND_PP_ELWISE_1(DYND_PP_META_STATIC_CAST,                              \
+                        DYND_PP_REPEAT_1(intptr_t, N),                         \
+                        DYND_PP_MAP_1(DYND_PP_META_SIZEOF,                     \
+                                      DYND_PP_META_NAME_RANGE(TYPE, N)))))
+
+/**
+ * Tests whether the ``count`` elements at ``dst`` and those at one source,
+ * with the given stride, are in separate memory.
+ */
+#define DYND_PP_META_DISJOINT_FROM_DST(ARG_NAME, ARG_STRIDE)                   \
+  (dst + count * dst_stride <= ARG_NAME ||                                     \
+   ARG_NAME + count * ARG_STRIDE <= dst)
+
+/**
+ * Tests whether ``dst`` overlaps none of ``src0``, ``src1``, etc. over
+ * ``count`` elements. The restrict-qualified loops need this, as
+ * in-place or shifted operations otherwise write to their inputs.
+ *
+ * ((dst + count * dst_stride <= src0 ||
+ *   src0 + count * src_stride0 <= dst) && ...)
+ */
+#define DYND_PP_IS_DISJOINT_FROM_DST(N)                                        \
+  (DYND_PP_JOIN_ELWISE_1(DYND_PP_META_DISJOINT_FROM_DST, (&&),                 \
+                         DYND_PP_META_NAME_RANGE(src, N),                      \
+                         DYND_PP_META_NAME_RANGE(src_stride, N)))
+
+/**
+ * Declares a range of restrict-qualified pointer parameters, for loops
+ * over contiguous data which the compiler should vectorize.
+ *
+ * const TYPE0 *DYND_RESTRICT ARG_NAME0, const TYPE1 *DYND_RESTRICT ARG_NAME1, ...
+ */
+#define DYND_PP_RESTRICT_PTR_PARAMS_1(TYPE, ARG_NAME, N)                       \
+  DYND_PP_JOIN_ELWISE_1(DYND_PP_META_DECL, (, ),                               \
+                        DYND_PP_MAP_1(DYND_PP_META_MAKE_CONST_RESTRICT_PTR,    \
+                                      DYND_PP_META_NAME_RANGE(TYPE, N)),       \
+                        DYND_PP_META_NAME_RANGE(ARG_NAME, N))
+
+/**
+ * Casts each ``ARG_NAME#`` to a pointer to ``const TYPE#``, output with a
+ * comma separator.
+ *
+ * reinterpret_cast<const TYPE0 *>(ARG_NAME0), ...
+ */
+#define DYND_PP_CAST_ARGRANGE_1(TYPE, ARG_NAME, N)                             \
+  DYND_PP_JOIN_ELWISE_1(DYND_PP_META_REINTERPRET_CAST, (, ),                   \
+                        DYND_PP_MAP_1(DYND_PP_META_MAKE_CONST_PTR,             \
+                                      DYND_PP_META_NAME_RANGE(TYPE, N)),       \
+                        DYND_PP_META_NAME_RANGE(ARG_NAME, N))
+
+/**
+ * Indexes each ``ARG_NAME#`` with ``INDEX``, output with a comma separator.
+ *
+ * ARG_NAME0[INDEX], ARG_NAME1[INDEX], ...
+ */
+#define DYND_PP_INDEX_ARGRANGE_1(ARG_NAME, INDEX, N)                           \
+  DYND_PP_JOIN_ELWISE_1(DYND_PP_META_AT, (, ),                                 \
+                        DYND_PP_META_NAME_RANGE(ARG_NAME, N),                  \
+                        DYND_PP_REPEAT_1(INDEX, N))
+
 /**
  * Create ``dst_tp`` and ``src_tp[N]``, etc. from the types DST_TYPE, SRC_TYPE0,
  * etc.
@@ -41,6 +41,7 @@
 
 #define DYND_PP_META_MAKE_PTR(TYPE) TYPE *
 #define DYND_PP_META_MAKE_CONST_PTR(TYPE) DYND_PP_META_MAKE_CONST(DYND_PP_META_MAKE_PTR(TYPE))
+#define DYND_PP_META_MAKE_CONST_RESTRICT_PTR(TYPE) DYND_PP_META_MAKE_CONST_PTR(TYPE) DYND_RESTRICT
 
 #define DYND_PP_META_MAKE_REF(TYPE) TYPE &
 #define DYND_PP_META_MAKE_CONST_REF(TYPE) DYND_PP_META_MAKE_CONST(DYND_PP_META_MAKE_REF(TYPE))
@@ -48,6 +49,7 @@
 #define DYND_PP_META_AT(NAME, INDEX) NAME[INDEX]
 #define DYND_PP_META_DEREFERENCE(NAME) *NAME
 #define DYND_PP_META_ADDRESS(NAME) &NAME
+#define DYND_PP_META_SIZEOF(TYPE) sizeof(TYPE)
 
 #define DYND_PP_META_IF(CONDITION, A) if (CONDITION) {A}
 #define DYND_PP_META_IF_ELSE(CONDITION, A, B) if (CONDITION) {A} else {B}
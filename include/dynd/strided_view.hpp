@@ -0,0 +1,198 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__STRIDED_VIEW_HPP_
+#define _DYND__STRIDED_VIEW_HPP_
+
+#include <sstream>
+
+#include <dynd/array.hpp>
+#include <dynd/shape_tools.hpp>
+
+namespace dynd { namespace nd {
+
+template <class T, int N>
+class strided_view;
+
+namespace detail {
+    /** What subscripting one dimension of a strided_view<T, N> gives */
+    template <class T, int N>
+    struct strided_view_subscript {
+        typedef strided_view<T, N - 1> type;
+        static inline type make(char *data, const size_stride_t *ss) {
+            return type(data, ss);
+        }
+    };
+
+    template <class T>
+    struct strided_view_subscript<T, 1> {
+        typedef T& type;
+        static inline type make(char *data, const size_stride_t *DYND_UNUSED(ss)) {
+            return *reinterpret_cast<T *>(data);
+        }
+    };
+
+    /** The data pointer of an array, writable unless the view is of const */
+    template <bool Const>
+    struct strided_view_originptr {
+        static inline char *get(const nd::array& a) {
+            return a.get_readwrite_originptr();
+        }
+    };
+
+    template <>
+    struct strided_view_originptr<true> {
+        static inline char *get(const nd::array& a) {
+            return const_cast<char *>(a.get_readonly_originptr());
+        }
+    };
+} // namespace detail
+
+/**
+ * A non-owning view of ``N`` strided dimensions of builtin type ``T``,
+ * for tight loops in C++ which would otherwise pay for a new nd::array
+ * (memory block, arrmeta and types) on every ``a(i)``. It is just a data
+ * pointer and the sizes and strides, so copying it, indexing it, and
+ * taking subviews or slices never allocates.
+ *
+ * Use ``strided_view<const T, N>`` for read only access. Element access
+ * does no bounds checking and takes no negative indices. The view holds
+ * no reference, so the array it came from must outlive it.
+ *
+ * Example:
+ *     nd::strided_view<const double, 2> v(a);
+ *     for (intptr_t i = 0; i < v.get_dim_size(0); ++i) {
+ *         for (intptr_t j = 0; j < v.get_dim_size(1); ++j) {
+ *             total += v(i, j);
+ *         }
+ *     }
+ */
+template <class T, int N>
+class strided_view {
+    char *m_data;
+    size_stride_t m_ss[N];
+
+public:
+    typedef T value_type;
+    typedef typename detail::strided_view_subscript<T, N>::type subscript_type;
+
+    /** Views the data at ``data``, with ``N`` sizes and strides in ``ss`` */
+    strided_view(char *data, const size_stride_t *ss)
+        : m_data(data)
+    {
+        for (int i = 0; i < N; ++i) {
+            m_ss[i] = ss[i];
+        }
+    }
+
+    /**
+     * Views an array which has exactly ``N`` strided dimensions (strided,
+     * fixed or cfixed) and dtype ``T``. Throws a type_error otherwise,
+     * for example if the array is an unevaluated expression.
+     */
+    explicit strided_view(const nd::array& a)
+    {
+        const size_stride_t *size_stride = NULL;
+        ndt::type el_tp;
+        const char *el_arrmeta;
+        if (a.is_null() ||
+                !a.get_type().get_as_strided(a.get_arrmeta(), N, &size_stride,
+                                             &el_tp, &el_arrmeta) ||
+                el_tp != ndt::make_type<typename remove_const<T>::type>()) {
+            std::stringstream ss;
+            ss << "cannot make a strided_view of " << N << " dimensions of ";
+            ss << ndt::make_type<typename remove_const<T>::type>();
+            if (a.is_null()) {
+                ss << " from a NULL dynd array";
+            } else {
+                ss << " from dynd array of type " << a.get_type();
+            }
+            throw type_error(ss.str());
+        }
+        m_data = detail::strided_view_originptr<is_const<T>::value>::get(a);
+        for (int i = 0; i < N; ++i) {
+            m_ss[i] = size_stride[i];
+        }
+    }
+
+    inline static int get_ndim() {
+        return N;
+    }
+
+    inline intptr_t get_dim_size(int i = 0) const {
+        return m_ss[i].dim_size;
+    }
+
+    inline intptr_t get_stride(int i = 0) const {
+        return m_ss[i].stride;
+    }
+
+    inline const size_stride_t *get_size_stride() const {
+        return m_ss;
+    }
+
+    inline T *data() const {
+        return reinterpret_cast<T *>(m_data);
+    }
+
+    /**
+     * Indexes the first dimension, giving an element reference when
+     * ``N`` is 1, and a strided_view of the remaining dimensions otherwise.
+     */
+    inline subscript_type operator[](intptr_t i0) const {
+        return detail::strided_view_subscript<T, N>::make(
+            m_data + i0 * m_ss[0].stride, m_ss + 1);
+    }
+
+    inline T& operator()(intptr_t i0) const {
+        DYND_STATIC_ASSERT(N == 1, "strided_view requires N indices");
+        return *reinterpret_cast<T *>(m_data + i0 * m_ss[0].stride);
+    }
+
+    inline T& operator()(intptr_t i0, intptr_t i1) const {
+        DYND_STATIC_ASSERT(N == 2, "strided_view requires N indices");
+        return *reinterpret_cast<T *>(m_data + i0 * m_ss[0].stride +
+                                      i1 * m_ss[1].stride);
+    }
+
+    inline T& operator()(intptr_t i0, intptr_t i1, intptr_t i2) const {
+        DYND_STATIC_ASSERT(N == 3, "strided_view requires N indices");
+        return *reinterpret_cast<T *>(m_data + i0 * m_ss[0].stride +
+                                      i1 * m_ss[1].stride +
+                                      i2 * m_ss[2].stride);
+    }
+
+    inline T& operator()(intptr_t i0, intptr_t i1, intptr_t i2,
+                         intptr_t i3) const {
+        DYND_STATIC_ASSERT(N == 4, "strided_view requires N indices");
+        return *reinterpret_cast<T *>(m_data + i0 * m_ss[0].stride +
+                                      i1 * m_ss[1].stride +
+                                      i2 * m_ss[2].stride +
+                                      i3 * m_ss[3].stride);
+    }
+
+    /**
+     * Restricts dimension ``axis`` to the range ``idx``, keeping the
+     * dimension even when ``idx`` is a single index. This follows the
+     * indexing rules of nd::array, including negative indices, and
+     * throws if the range is out of bounds.
+     */
+    strided_view slice(const irange& idx, int axis = 0) const {
+        bool remove_dimension;
+        intptr_t start_index, index_stride, dim_size;
+        apply_single_linear_index(idx, m_ss[axis].dim_size, axis, NULL,
+                                  remove_dimension, start_index,
+                                  index_stride, dim_size);
+        strided_view result(*this);
+        result.m_data += start_index * m_ss[axis].stride;
+        result.m_ss[axis].dim_size = dim_size;
+        result.m_ss[axis].stride = index_stride * m_ss[axis].stride;
+        return result;
+    }
+};
+
+}} // namespace dynd::nd
+
+#endif // _DYND__STRIDED_VIEW_HPP_
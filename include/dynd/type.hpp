@@ -214,9 +214,17 @@ public:
     }
 
     inline bool operator==(const type& rhs) const {
-        return m_extended == rhs.m_extended ||
-               (!is_builtin() && !rhs.is_builtin() &&
-                *m_extended == *rhs.m_extended);
+        if (m_extended == rhs.m_extended) {
+            return true;
+        } else if (is_builtin() || rhs.is_builtin()) {
+            return false;
+        } else if (m_extended->is_interned() && rhs.m_extended->is_interned()) {
+            // Equal interned types are always the same instance
+            return false;
+        } else {
+            return m_extended->get_hash() == rhs.m_extended->get_hash() &&
+                   *m_extended == *rhs.m_extended;
+        }
     }
     inline bool operator!=(const type& rhs) const {
         return !(operator==(rhs));
@@ -401,6 +409,18 @@ public:
         return get_base_type_alignment(m_extended);
     }
 
+    /**
+     * A hash of the type, consistent with operator==, which is
+     * computed once and stored with the type.
+     */
+    inline size_t get_hash() const {
+        if (is_builtin()) {
+            return reinterpret_cast<uintptr_t>(m_extended);
+        } else {
+            return m_extended->get_hash();
+        }
+    }
+
     /** The element size of the type */
     inline size_t get_data_size() const {
         return get_base_type_data_size(m_extended);
@@ -21,6 +21,8 @@ class base_dim_type : public base_type {
 protected:
     ndt::type m_element_tp;
     size_t m_element_arrmeta_offset;
+
+    size_t compute_hash() const;
 public:
   inline base_dim_type(type_id_t type_id, const ndt::type &element_tp,
                                size_t data_size, size_t alignment,
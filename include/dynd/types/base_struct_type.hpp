@@ -24,6 +24,13 @@ namespace dynd {
 class base_struct_type : public base_tuple_type {
 protected:
     nd::array m_field_names;
+    /**
+     * Open addressed hash table of the field indices, -1 for an empty slot.
+     * Only built for structs with enough fields that it beats a scan.
+     */
+    std::vector<intptr_t> m_field_index_table;
+
+    size_t compute_hash() const;
 public:
     base_struct_type(type_id_t type_id, const nd::array &field_names,
                      const nd::array &field_types, flags_type flags,
@@ -57,6 +64,26 @@ public:
     }
     intptr_t get_field_index(const char *field_name_begin,
                              const char *field_name_end) const;
+    /**
+     * Gets the field indices for a list of names in one call, with -1
+     * for names the struct doesn't have.
+     *
+     * \param name_count  The number of names.
+     * \param field_names  The names of the fields.
+     * \param out_field_indices  An array of ``name_count`` which
+     *                           receives the field indices.
+     */
+    void get_field_indices(intptr_t name_count, const std::string *field_names,
+                           intptr_t *out_field_indices) const;
+    inline std::vector<intptr_t>
+    get_field_indices(const std::vector<std::string> &field_names) const
+    {
+        std::vector<intptr_t> result(field_names.size());
+        if (!field_names.empty()) {
+            get_field_indices(field_names.size(), &field_names[0], &result[0]);
+        }
+        return result;
+    }
 
     ndt::type apply_linear_index(intptr_t nindices, const irange *indices,
                                  size_t current_i, const ndt::type &root_tp,
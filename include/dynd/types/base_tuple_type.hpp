@@ -29,6 +29,8 @@ protected:
     virtual uintptr_t *get_arrmeta_data_offsets(char *DYND_UNUSED(arrmeta)) const {
         return NULL;
     }
+
+    size_t compute_hash() const;
 public:
     base_tuple_type(type_id_t type_id, const nd::array &field_types,
                     flags_type flags, bool variable_layout);
@@ -39,6 +39,16 @@ class base_type;
 
 struct iterdata_common;
 
+namespace detail {
+    struct type_intern_access;
+
+    /** Mixes the hash ``value`` into ``seed`` */
+    inline size_t hash_combine(size_t seed, size_t value)
+    {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+} // namespace detail
+
 /** This is the callback function type used by the base_type::foreach function */
 typedef void (*foreach_fn_t)(const ndt::type &dt, const char *arrmeta,
                              char *data, void *callback_data);
@@ -130,10 +140,22 @@ struct base_type_members {
 class base_type {
     /** Embedded reference counting */
     mutable atomic_refcount m_use_count;
+    /** Cached result of compute_hash, 0 until it is computed */
+    mutable size_t m_hash;
+    /** True if this is the shared instance in the type intern table */
+    bool m_interned;
 protected:
     /// Standard dynd type data
     base_type_members m_members;
-    
+
+    /**
+     * Computes a hash of the type, which must be equal for types which
+     * compare equal with operator==. The default combines the type id,
+     * kind, data size and number of dimensions, types which can have
+     * different parameters with the same values of these should
+     * combine the parameters as well.
+     */
+    virtual size_t compute_hash() const;
 
 protected:
     // Helper function for array dimension types
@@ -149,7 +171,7 @@ public:
     inline base_type(type_id_t type_id, type_kind_t kind, size_t data_size,
                      size_t alignment, flags_type flags, size_t arrmeta_size,
                      size_t ndim, size_t strided_ndim)
-        : m_use_count(1),
+        : m_use_count(1), m_hash(0), m_interned(false),
           m_members(static_cast<uint16_t>(type_id), static_cast<uint8_t>(kind),
                     static_cast<uint8_t>(alignment), flags, data_size,
                     arrmeta_size, static_cast<uint8_t>(ndim),
@@ -163,6 +185,28 @@ public:
         return m_use_count;
     }
 
+    /**
+     * The hash of the type, consistent with operator==. Interned types
+     * compute it when they are interned, others on first use.
+     */
+    inline size_t get_hash() const {
+        if (m_hash == 0) {
+            size_t h = compute_hash();
+            // Zero marks the hash as not computed yet
+            m_hash = (h != 0) ? h : 1;
+        }
+        return m_hash;
+    }
+
+    /**
+     * True if this is the one instance of the type shared through the
+     * type intern table, so that any other type equal to it is the
+     * same pointer. See ``ndt::intern_type``.
+     */
+    inline bool is_interned() const {
+        return m_interned;
+    }
+
     /** Returns the struct of data common to all types. */
     inline const base_type_members& get_base_type_members() const {
         return m_members;
@@ -691,6 +735,7 @@ public:
 
     friend void base_type_incref(const base_type *ed);
     friend void base_type_decref(const base_type *ed);
+    friend struct detail::type_intern_access;
 };
 
 /**
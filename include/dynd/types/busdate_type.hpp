@@ -8,36 +8,18 @@
 
 #include <dynd/type.hpp>
 #include <dynd/array.hpp>
+#include <dynd/types/busdate_util.hpp>
 
 namespace dynd {
 
-enum busdate_roll_t {
-    // Go forward in time to the following business day.
-    busdate_roll_following,
-    // Go backward in time to the preceding business day.
-    busdate_roll_preceding,
-    // Go forward in time to the following business day, unless it
-    // crosses a month boundary, in which case go backward
-    busdate_roll_modifiedfollowing,
-    // Go backward in time to the preceding business day, unless it
-    // crosses a month boundary, in which case go forward.
-    busdate_roll_modifiedpreceding,
-    // Produce a NaT for non-business days.
-    busdate_roll_nat,
-    // Raise an exception for non-business days.
-    busdate_roll_throw
-};
-
 class busdate_type : public base_type {
     /** Strategy for handling dates that are not business dates */
     busdate_roll_t m_roll;
-    /** Which days of the week are work days vs weekend */
-    bool m_workweek[7];
-    /** Cache of the non-weekend day count in the weekmask */
-    int m_busdays_in_weekmask;
+    /** The weekmask and holidays, indexed for business day arithmetic */
+    busdate_calendar m_calendar;
     /**
      * If non-NULL, a one-dimensional contiguous array of day unit date_type
-     * which has no duplicates or holidays falling on a weekend.
+     * which is sorted and has no duplicates or holidays falling on a weekend.
      */
     nd::array m_holidays;
 
@@ -51,11 +33,15 @@ public:
     }
 
     const bool *get_weekmask() const {
-        return m_workweek;
+        return m_calendar.get_weekmask();
     }
 
     int get_busdays_in_weekmask() const {
-        return m_busdays_in_weekmask;
+        return m_calendar.get_busdays_in_weekmask();
+    }
+
+    const busdate_calendar& get_calendar() const {
+        return m_calendar;
     }
 
     nd::array get_holidays() const {
@@ -63,8 +49,9 @@ public:
     }
 
     bool is_default_workweek() const {
-        return m_workweek[0] && m_workweek[1] && m_workweek[2] && m_workweek[3] &&
-                m_workweek[4] && !m_workweek[5] && !m_workweek[6];
+        const bool *workweek = m_calendar.get_weekmask();
+        return workweek[0] && workweek[1] && workweek[2] && workweek[3] &&
+                workweek[4] && !workweek[5] && !workweek[6];
     }
 
     void print_workweek(std::ostream& o) const;
@@ -0,0 +1,156 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__BUSDATE_UTIL_HPP_
+#define _DYND__BUSDATE_UTIL_HPP_
+
+#include <vector>
+#include <algorithm>
+
+#include <dynd/config.hpp>
+#include <dynd/types/date_util.hpp>
+
+namespace dynd {
+
+namespace nd {
+    class array;
+} // namespace nd
+
+enum busdate_roll_t {
+    // Go forward in time to the following business day.
+    busdate_roll_following,
+    // Go backward in time to the preceding business day.
+    busdate_roll_preceding,
+    // Go forward in time to the following business day, unless it
+    // crosses a month boundary, in which case go backward
+    busdate_roll_modifiedfollowing,
+    // Go backward in time to the preceding business day, unless it
+    // crosses a month boundary, in which case go forward.
+    busdate_roll_modifiedpreceding,
+    // Produce a NaT for non-business days.
+    busdate_roll_nat,
+    // Raise an exception for non-business days.
+    busdate_roll_throw
+};
+
+/**
+ * A business day calendar, made of a weekmask and a list of holidays,
+ * set up so that offsetting and counting business days takes constant
+ * time for the weekmask and a binary search for the holidays, no matter
+ * how many days are spanned.
+ *
+ * Every day is given the ordinal of the business days, numbering the
+ * first business day on or after Monday, January 5, 1970 as 0. The
+ * weekmask part of the ordinal comes from the number of whole weeks
+ * and a prefix count within the week, and the holidays before the day
+ * are subtracted with a binary search. Going back from an ordinal to a
+ * day uses a second sorted index, the weekmask ordinal of each holiday
+ * minus its position in the list, which says how many holidays come
+ * before the business day with a given ordinal.
+ */
+class busdate_calendar {
+    bool m_weekmask[7];
+    int m_busdays_in_weekmask;
+    /** The number of business days in the first i days of the week */
+    int m_week_prefix[8];
+    /** The day of the week of the i-th business day of the week */
+    int m_week_busday[7];
+    /** The holidays, sorted, with only those on business days */
+    std::vector<int32_t> m_holidays;
+    /** The weekmask ordinal of each holiday, minus its index */
+    std::vector<int64_t> m_holiday_keys;
+
+    /** The business days in [Monday January 5 1970, days) by weekmask */
+    inline int64_t weekmask_ordinal(int32_t days) const {
+        int64_t d = (int64_t)days - 4;
+        int64_t weeks = d >= 0 ? d / 7 : -((6 - d) / 7);
+        return weeks * m_busdays_in_weekmask + m_week_prefix[d - weeks * 7];
+    }
+
+public:
+    /**
+     * Makes a calendar from the weekmask, seven flags for the business
+     * days from Monday to Sunday, or NULL for Monday to Friday, and the
+     * holidays, a one-dimensional array convertible to date, or NULL.
+     * Holidays which are NA, repeated, or fall on the weekend are dropped.
+     */
+    busdate_calendar(const bool *weekmask = NULL);
+    busdate_calendar(const bool *weekmask, const nd::array& holidays);
+
+    inline const bool *get_weekmask() const {
+        return m_weekmask;
+    }
+
+    inline int get_busdays_in_weekmask() const {
+        return m_busdays_in_weekmask;
+    }
+
+    /** The holidays as days since the epoch, sorted */
+    inline const std::vector<int32_t>& get_holidays() const {
+        return m_holidays;
+    }
+
+    /** The day of the week of ``days``, with Monday as 0 */
+    static inline int weekday(int32_t days) {
+        int result = (int)(((int64_t)days - 4) % 7);
+        return result < 0 ? result + 7 : result;
+    }
+
+    inline bool is_busday(int32_t days) const {
+        return m_weekmask[weekday(days)] &&
+               !std::binary_search(m_holidays.begin(), m_holidays.end(), days);
+    }
+
+    /**
+     * The ordinal of ``days`` among the business days, or for a day
+     * which isn't a business day, that of the following business day.
+     */
+    inline int64_t ordinal(int32_t days) const {
+        return weekmask_ordinal(days) -
+               (std::lower_bound(m_holidays.begin(), m_holidays.end(), days) -
+                m_holidays.begin());
+    }
+
+    /**
+     * The business day with the given ordinal. Throws an overflow_error
+     * if it's outside the range of date.
+     */
+    int32_t from_ordinal(int64_t ord) const;
+
+    /**
+     * Applies the roll policy to ``days``, returning it unchanged
+     * if it is a business day.
+     */
+    int32_t roll(int32_t days, busdate_roll_t roll) const;
+
+    /**
+     * Rolls ``days`` to a business day, then moves ``offset`` business
+     * days from it. NA stays NA.
+     */
+    inline int32_t offset(int32_t days, int64_t offset,
+                          busdate_roll_t roll) const {
+        if (days == DYND_DATE_NA) {
+            return DYND_DATE_NA;
+        }
+        if (!is_busday(days)) {
+            days = this->roll(days, roll);
+            if (days == DYND_DATE_NA) {
+                return DYND_DATE_NA;
+            }
+        }
+        return from_ordinal(ordinal(days) + offset);
+    }
+
+    /**
+     * The number of business days in [begin, end), or the negative
+     * of the number in [end, begin) when end is before begin. Throws
+     * for NA dates.
+     */
+    int64_t count(int32_t begin, int32_t end) const;
+};
+
+} // namespace dynd
+
+#endif // _DYND__BUSDATE_UTIL_HPP_
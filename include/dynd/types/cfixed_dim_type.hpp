@@ -11,6 +11,7 @@
 #include <dynd/types/view_type.hpp>
 #include <dynd/types/base_dim_type.hpp>
 #include <dynd/array.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -25,6 +26,8 @@ struct cfixed_dim_type_iterdata {
 
 class cfixed_dim_type : public base_dim_type {
     intptr_t m_stride, m_dim_size;
+
+    size_t compute_hash() const;
     std::vector<std::pair<std::string, gfunc::callable> > m_array_properties, m_array_functions;
 
 public:
@@ -126,11 +129,11 @@ public:
 
 namespace ndt {
     inline ndt::type make_cfixed_dim(size_t size, const ndt::type& element_tp) {
-        return ndt::type(new cfixed_dim_type(size, element_tp), false);
+        return ndt::intern_type(new cfixed_dim_type(size, element_tp));
     }
 
     inline ndt::type make_cfixed_dim(size_t size, const ndt::type& element_tp, intptr_t stride) {
-        return ndt::type(new cfixed_dim_type(size, element_tp, stride), false);
+        return ndt::intern_type(new cfixed_dim_type(size, element_tp, stride));
     }
 
     ndt::type make_cfixed_dim(intptr_t ndim, const intptr_t *shape,
@@ -13,6 +13,7 @@
 #include <dynd/types/base_struct_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/memblock/memory_block.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -106,7 +107,7 @@ namespace ndt {
     inline ndt::type make_cstruct(const nd::array &field_names,
                                  const nd::array &field_types)
     {
-        return ndt::type(new cstruct_type(field_names, field_types), false);
+        return ndt::intern_type(new cstruct_type(field_names, field_types));
     }
 
 
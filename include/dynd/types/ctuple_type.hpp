@@ -13,6 +13,7 @@
 #include <dynd/types/base_tuple_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/memblock/memory_block.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -80,7 +81,7 @@ public:
 namespace ndt {
     /** Makes a ctuple type with the specified types */
     inline ndt::type make_ctuple(const nd::array& field_types) {
-        return ndt::type(new ctuple_type(field_types), false);
+        return ndt::intern_type(new ctuple_type(field_types));
     }
 
     /** Makes a ctuple type with the specified types */
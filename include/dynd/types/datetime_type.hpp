@@ -11,6 +11,7 @@
 #include <dynd/types/view_type.hpp>
 #include <dynd/string_encodings.hpp>
 #include <dynd/types/datetime_util.hpp>
+#include <dynd/types/tz_database.hpp>
 #include <dynd/types/static_type_instances.hpp>
 
 namespace dynd {
@@ -28,9 +29,13 @@ std::ostream& operator<<(std::ostream& o, datetime_unit_t unit);
 
 class datetime_type : public base_type {
     datetime_tz_t m_timezone;
+    /** The tz database zone when m_timezone is tz_named, otherwise NULL */
+    const tz_info *m_tzinfo;
 
 public:
     datetime_type(datetime_tz_t timezone);
+    /** A datetime in the named time zone ``tzinfo`` */
+    datetime_type(const tz_info *tzinfo);
 
     virtual ~datetime_type();
 
@@ -38,6 +43,10 @@ public:
         return m_timezone;
     }
 
+    inline const tz_info *get_tzinfo() const {
+        return m_tzinfo;
+    }
+
     void set_cal(const char *arrmeta, char *data, assign_error_mode errmode,
                     int32_t year, int32_t month, int32_t day,
                     int32_t hour, int32_t min=0, int32_t sec=0, int32_t tick=0) const;
@@ -117,6 +126,11 @@ namespace ndt {
   {
     return ndt::type(new datetime_type(timezone), false);
   }
+  /**
+   * Returns type "datetime[tz=<name>]", where ``name`` is "UTC",
+   * "abstract", or a time zone in the tz database like "Europe/Paris".
+   */
+  ndt::type make_datetime(const std::string &tz_name);
 } // namespace ndt
 
 } // namespace dynd
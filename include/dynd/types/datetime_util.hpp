@@ -26,8 +26,9 @@ enum datetime_tz_t {
     // the leap seconds UTC cannot, but converting to/from UTC is not
     // lossless.
     //tz_tai,
-    // TODO: other time zones based on a time zone database
-    // tz_other
+    // A time zone from the Olson tz database, see tz_database.hpp.
+    // Values are stored as UTC, like tz_utc.
+    tz_named
 };
 
 struct datetime_struct {
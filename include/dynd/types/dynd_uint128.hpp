@@ -62,6 +62,15 @@ public:
     DYND_CUDA_HOST_DEVICE dynd_uint128(const dynd_int128& value);
     DYND_CUDA_HOST_DEVICE dynd_uint128(const dynd_float16& value);
     DYND_CUDA_HOST_DEVICE dynd_uint128(const dynd_float128& value);
+#ifdef DYND_HAS_NATIVE_INT128
+    inline dynd_uint128(dynd_native_uint128 value)
+        : m_lo((uint64_t)value), m_hi((uint64_t)(value >> 64)) {}
+
+    /** The value as the compiler's 128-bit integer */
+    inline dynd_native_uint128 native() const {
+        return ((dynd_native_uint128)m_hi << 64) | m_lo;
+    }
+#endif
 
     DYND_CUDA_HOST_DEVICE inline bool operator==(const dynd_uint128& rhs) const {
         return m_hi == rhs.m_hi && m_lo == rhs.m_lo;
@@ -104,13 +113,21 @@ public:
     }
 
     DYND_CUDA_HOST_DEVICE inline bool operator<(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return native() < rhs.native();
+#else
         return m_hi < rhs.m_hi ||
                         (m_hi == rhs.m_hi && m_lo < rhs.m_lo);
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE inline bool operator<=(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return native() <= rhs.native();
+#else
         return m_hi < rhs.m_hi ||
                         (m_hi == rhs.m_hi && m_lo <= rhs.m_lo);
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE inline bool operator>(const dynd_uint128& rhs) const {
@@ -122,8 +139,12 @@ public:
     }
 
     DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator+(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return dynd_uint128(native() + rhs.native());
+#else
         uint64_t lo = m_lo + rhs.m_lo;
         return dynd_uint128(m_hi + rhs.m_hi + (lo < m_lo), lo);
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator+(uint64_t rhs) const {
@@ -137,8 +158,12 @@ public:
     }
 
     DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator-(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return dynd_uint128(native() - rhs.native());
+#else
         uint64_t lo = m_lo + ~rhs.m_lo + 1;
         return dynd_uint128(m_hi + ~rhs.m_hi + (lo < m_lo), lo);
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator-(uint64_t rhs) const {
@@ -146,17 +171,70 @@ public:
         return dynd_uint128(m_hi + 0xffffffffffffffffULL + (lo < m_lo), lo);
     }
 
-    DYND_CUDA_HOST_DEVICE dynd_uint128 operator*(uint32_t rhs) const;
-    DYND_CUDA_HOST_DEVICE dynd_uint128 operator/(uint32_t rhs) const;
+    /**
+     * Multiplication and division with remainder in 64-bit pieces,
+     * for when there is no native 128-bit integer. Division by zero
+     * faults the same way as builtin integer division.
+     */
+    DYND_CUDA_HOST_DEVICE static dynd_uint128 mul_portable(const dynd_uint128& lhs,
+                                                          const dynd_uint128& rhs);
+    DYND_CUDA_HOST_DEVICE static void divrem_portable(const dynd_uint128& lhs,
+                                                      const dynd_uint128& rhs,
+                                                      dynd_uint128& out_div,
+                                                      dynd_uint128& out_rem);
+
+    DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator*(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return dynd_uint128(native() * rhs.native());
+#else
+        return mul_portable(*this, rhs);
+#endif
+    }
+
+    DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator/(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return dynd_uint128(native() / rhs.native());
+#else
+        dynd_uint128 result, rem;
+        divrem_portable(*this, rhs, result, rem);
+        return result;
+#endif
+    }
+
+    DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator%(const dynd_uint128& rhs) const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return dynd_uint128(native() % rhs.native());
+#else
+        dynd_uint128 result, rem;
+        divrem_portable(*this, rhs, result, rem);
+        return rem;
+#endif
+    }
+
+    DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator*(uint32_t rhs) const {
+        return *this * dynd_uint128(rhs);
+    }
+
+    DYND_CUDA_HOST_DEVICE inline dynd_uint128 operator/(uint32_t rhs) const {
+        return *this / dynd_uint128(rhs);
+    }
 
     DYND_CUDA_HOST_DEVICE void divrem(uint32_t rhs, uint32_t& out_rem);
 
     DYND_CUDA_HOST_DEVICE operator float() const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return (float)native();
+#else
         return m_lo + m_hi * 18446744073709551616.f;
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE operator double() const {
+#ifdef DYND_HAS_NATIVE_INT128
+        return (double)native();
+#else
         return m_lo + m_hi * 18446744073709551616.0;
+#endif
     }
 
     DYND_CUDA_HOST_DEVICE operator char() const {
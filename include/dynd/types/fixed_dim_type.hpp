@@ -10,6 +10,7 @@
 #include <dynd/types/base_dim_type.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/view_type.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -24,6 +25,8 @@ struct fixed_dim_type_iterdata {
 
 class fixed_dim_type : public base_dim_type {
     intptr_t m_dim_size;
+
+    size_t compute_hash() const;
     std::vector<std::pair<std::string, gfunc::callable> > m_array_properties, m_array_functions;
 public:
     fixed_dim_type(intptr_t dim_size, const ndt::type& element_tp);
@@ -127,7 +130,7 @@ public:
 
 namespace ndt {
     inline ndt::type make_fixed_dim(size_t dim_size, const ndt::type& element_tp) {
-        return ndt::type(new fixed_dim_type(dim_size, element_tp), false);
+        return ndt::intern_type(new fixed_dim_type(dim_size, element_tp));
     }
 
     ndt::type make_fixed_dim(intptr_t ndim, const intptr_t *shape,
@@ -13,6 +13,7 @@
 #include <dynd/types/base_struct_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/memblock/memory_block.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -36,8 +37,6 @@ public:
 
     virtual ~struct_type();
 
-    intptr_t get_field_index(const std::string& field_name) const;
-
     inline const uintptr_t *get_data_offsets(const char *arrmeta) const {
         return reinterpret_cast<const uintptr_t *>(arrmeta);
     }
@@ -83,7 +82,7 @@ namespace ndt {
     inline ndt::type make_struct(const nd::array &field_names,
                                  const nd::array &field_types)
     {
-        return ndt::type(new struct_type(field_names, field_types), false);
+        return ndt::intern_type(new struct_type(field_names, field_types));
     }
 
 
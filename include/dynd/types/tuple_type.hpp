@@ -14,6 +14,7 @@
 #include <dynd/types/type_type.hpp>
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/memblock/memory_block.hpp>
+#include <dynd/types/type_intern.hpp>
 
 namespace dynd {
 
@@ -70,7 +71,7 @@ public:
 namespace ndt {
     /** Makes a tuple type with the specified types */
     inline ndt::type make_tuple(const nd::array& field_types) {
-        return ndt::type(new tuple_type(field_types), false);
+        return ndt::intern_type(new tuple_type(field_types));
     }
 
     /** Makes a tuple type with the specified types */
@@ -0,0 +1,40 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__TYPE_INTERN_HPP_
+#define _DYND__TYPE_INTERN_HPP_
+
+#include <dynd/config.hpp>
+#include <dynd/type.hpp>
+
+namespace dynd {
+
+namespace ndt {
+    /**
+     * Returns the shared instance of the type equal to ``tp``, so that
+     * structurally equal types are one base_type, and comparing two
+     * interned types is a pointer comparison. Takes ownership of the
+     * reference to ``tp``, which is released if an equal type was
+     * already interned, or otherwise becomes the shared instance.
+     *
+     * The intern table holds no references, a type is removed from it
+     * when it is destroyed. It is safe to use from multiple threads.
+     *
+     *      return ndt::intern_type(new var_dim_type(element_tp));
+     */
+    ndt::type intern_type(const base_type *tp);
+
+    /** The number of types currently in the intern table */
+    intptr_t get_interned_type_count();
+} // namespace ndt
+
+namespace detail {
+    /** Removes ``tp`` from the intern table, called as it is destroyed */
+    void unintern_type(const base_type *tp);
+} // namespace detail
+
+} // namespace dynd
+
+#endif // _DYND__TYPE_INTERN_HPP_
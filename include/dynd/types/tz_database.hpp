@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#ifndef _DYND__TZ_DATABASE_HPP_
+#define _DYND__TZ_DATABASE_HPP_
+
+#include <string>
+#include <vector>
+
+#include <dynd/config.hpp>
+#include <dynd/types/time_util.hpp>
+
+namespace dynd {
+
+/**
+ * A span of time in which a time zone has a fixed offset from UTC,
+ * half open as [begin, end). Depending on how it was looked up, the
+ * bounds are either UTC ticks or local wall clock ticks.
+ */
+struct tz_interval {
+    int64_t begin, end;
+    /** The offset added to UTC ticks to get local ticks */
+    int64_t offset;
+
+    /** An empty interval, so the first lookup always misses */
+    tz_interval()
+        : begin(0), end(0), offset(0)
+    {
+    }
+
+    inline bool contains(int64_t ticks) const {
+        return begin <= ticks && ticks < end;
+    }
+};
+
+/**
+ * The transition table of one time zone from the Olson tz database,
+ * read from a compiled TZif file in the system zoneinfo directory.
+ * Obtain instances with get_tz_info(), which loads each zone once
+ * and keeps it for the life of the process.
+ */
+class tz_info {
+    std::string m_name;
+    /** The UTC ticks at which each offset change happens, sorted */
+    std::vector<int64_t> m_utc_transitions;
+    /**
+     * The same transitions on the local wall clock, at the later
+     * of the two sides. A skipped or repeated wall clock time
+     * thus resolves to the offset in effect before the transition.
+     */
+    std::vector<int64_t> m_local_transitions;
+    /**
+     * The UTC offset in ticks of each interval, with one more entry
+     * than there are transitions. Entry 0 applies before the first one.
+     */
+    std::vector<int64_t> m_offsets;
+
+    // Non-copyable
+    tz_info(const tz_info&);
+    tz_info& operator=(const tz_info&);
+
+    void get_interval(const std::vector<int64_t>& transitions, int64_t ticks,
+                      tz_interval &out_interval) const;
+
+public:
+    /**
+     * Parses the contents of a TZif file (versions 1 through 3). Rules
+     * in the POSIX TZ footer of version 2+ files extend the table
+     * through the year 2100.
+     */
+    tz_info(const std::string& name, const char *tzif_begin,
+            const char *tzif_end);
+
+    inline const std::string& get_name() const {
+        return m_name;
+    }
+
+    inline intptr_t get_transition_count() const {
+        return (intptr_t)m_utc_transitions.size();
+    }
+
+    /** Looks up the interval containing the UTC ticks ``utc`` */
+    inline void get_utc_interval(int64_t utc, tz_interval &out_interval) const {
+        get_interval(m_utc_transitions, utc, out_interval);
+    }
+
+    /**
+     * Looks up the interval containing the local wall clock ticks
+     * ``local``. The bounds of the result are local ticks.
+     */
+    inline void get_local_interval(int64_t local,
+                                   tz_interval &out_interval) const {
+        get_interval(m_local_transitions, local, out_interval);
+    }
+
+    /** The UTC offset in ticks at the UTC ticks ``utc`` */
+    inline int64_t get_utc_offset(int64_t utc) const {
+        tz_interval iv;
+        get_utc_interval(utc, iv);
+        return iv.offset;
+    }
+
+    inline int64_t utc_to_local(int64_t utc) const {
+        return utc + get_utc_offset(utc);
+    }
+
+    inline int64_t local_to_utc(int64_t local) const {
+        tz_interval iv;
+        get_local_interval(local, iv);
+        return local - iv.offset;
+    }
+};
+
+/**
+ * Returns the time zone named ``name`` (e.g. "America/New_York"),
+ * loading it from the zoneinfo directory on first use. The directory
+ * is $TZDIR if set, otherwise /usr/share/zoneinfo. Throws if there is
+ * no such zone. Safe to call from multiple threads.
+ */
+const tz_info *get_tz_info(const std::string& name);
+
+/** Formats a UTC offset in ticks as ISO 8601, e.g. "+05:30" */
+std::string tz_offset_to_str(int64_t offset);
+
+} // namespace dynd
+
+#endif // _DYND__TZ_DATABASE_HPP_
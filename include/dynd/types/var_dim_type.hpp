@@ -147,6 +147,54 @@ namespace ndt {
      */
     void var_dim_element_resize(const type& tp,
             const char *arrmeta, char *data, intptr_t count);
+
+    /**
+     * Checks whether the rows of `count` var dim elements, `stride` bytes
+     * apart starting at `data`, are laid out back to back as one run of
+     * values, which is how parse_json and var dim assignment lay them out.
+     * When they are, the rows are just offsets into that run, and work
+     * which doesn't care about row boundaries can be done with a single
+     * strided call over all the values instead of one call per row.
+     *
+     * \param arrmeta  Arrmeta for a var_dim type.
+     * \param data  The first var dim element.
+     * \param stride  The stride between the var dim elements.
+     * \param count  The number of var dim elements.
+     * \param out_values  Filled with the address of the first value.
+     * \param out_total  Filled with the number of values in all the rows.
+     *
+     * \returns  True if the rows are consecutive. An uninitialized row
+     *           makes this false.
+     */
+    bool var_dim_rows_consecutive(const char *arrmeta, const char *data,
+            intptr_t stride, intptr_t count, char **out_values,
+            intptr_t *out_total);
+
+    /**
+     * The destination side of var_dim_rows_consecutive. Sets up `count`
+     * var dim elements as consecutive rows with the same sizes as the
+     * consecutive source rows, so one strided call can fill them all.
+     * Rows which are all uninitialized are allocated in one piece, and
+     * rows which are all initialized must already be consecutive with
+     * the same sizes.
+     *
+     * \param arrmeta  Arrmeta for a var_dim type.
+     * \param data  The first var dim element.
+     * \param stride  The stride between the var dim elements.
+     * \param count  The number of var dim elements.
+     * \param alignment  The alignment for allocating the values.
+     * \param src_data  The first source var dim element.
+     * \param src_stride  The stride between the source var dim elements.
+     * \param total  The number of values in all the source rows.
+     * \param out_values  Filled with the address of the first value.
+     *
+     * eturns  True if the rows were set up. When false, nothing was
+     *           changed, and the rows have to be processed one by one.
+     */
+    bool var_dim_rows_make_consecutive(const char *arrmeta, char *data,
+            intptr_t stride, intptr_t count, size_t alignment,
+            const char *src_data, intptr_t src_stride, intptr_t total,
+            char **out_values);
 } // namespace ndt
 
 } // namespace dynd
@@ -38,15 +38,78 @@ namespace {
         }
     };
 
+    /**
+     * Whether ``count`` elements at ``dst`` are separate from those at
+     * ``src``, so the restrict-qualified loops may be used.
+     */
+    inline bool disjoint(const char *dst, const char *src, size_t count,
+                         intptr_t unit)
+    {
+        return dst + count * unit <= src || src + count * unit <= dst;
+    }
+
     template<class OP>
     struct binary_strided_kernel {
+        typedef typename OP::type T;
+
+        // The unit-stride loops, separate functions so the restrict
+        // qualifiers let the compiler vectorize them
+        static void contiguous(T *DYND_RESTRICT dst, const T *DYND_RESTRICT src0,
+                               const T *DYND_RESTRICT src1, size_t count)
+        {
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = OP::operate(src0[i], src1[i]);
+            }
+        }
+
+        static void broadcast0(T *DYND_RESTRICT dst, const T s0,
+                               const T *DYND_RESTRICT src1, size_t count)
+        {
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = OP::operate(s0, src1[i]);
+            }
+        }
+
+        static void broadcast1(T *DYND_RESTRICT dst, const T *DYND_RESTRICT src0,
+                               const T s1, size_t count)
+        {
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = OP::operate(src0[i], s1);
+            }
+        }
+
         static void func(char *dst, intptr_t dst_stride,
                         const char * const *src, const intptr_t *src_stride,
                         size_t count, ckernel_prefix *DYND_UNUSED(self))
         {
-            typedef typename OP::type T;
             const char *src0 = src[0], *src1 = src[1];
             intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+            const intptr_t unit = sizeof(T);
+
+            // In-place or shifted operations, like a[1:] = a[:-1] + b,
+            // take the general loop
+            if (dst_stride == unit) {
+                if (src0_stride == unit && src1_stride == unit &&
+                        disjoint(dst, src0, count, unit) &&
+                        disjoint(dst, src1, count, unit)) {
+                    contiguous(reinterpret_cast<T *>(dst),
+                               reinterpret_cast<const T *>(src0),
+                               reinterpret_cast<const T *>(src1), count);
+                    return;
+                } else if (src0_stride == 0 && src1_stride == unit &&
+                        disjoint(dst, src1, count, unit)) {
+                    broadcast0(reinterpret_cast<T *>(dst),
+                               *reinterpret_cast<const T *>(src0),
+                               reinterpret_cast<const T *>(src1), count);
+                    return;
+                } else if (src0_stride == unit && src1_stride == 0 &&
+                        disjoint(dst, src0, count, unit)) {
+                    broadcast1(reinterpret_cast<T *>(dst),
+                               reinterpret_cast<const T *>(src0),
+                               *reinterpret_cast<const T *>(src1), count);
+                    return;
+                }
+            }
 
             for (size_t i = 0; i != count; ++i) {
                 T s0, s1, r;
@@ -167,20 +230,6 @@ namespace {
     };
 } // anonymous namespace
 
-#ifdef DYND_HAS_INT128
-#define DYND_INT128_BINARY_OP_PAIR(operation) \
-    {&binary_single_kernel<operation<dynd_int128> >::func, &binary_strided_kernel<operation<dynd_int128> >::func}
-#else
-#define DYND_INT128_BINARY_OP_PAIR(operation) {NULL, NULL}
-#endif
-
-#ifdef DYND_HAS_UINT128
-#define DYND_UINT128_BINARY_OP_PAIR(operation) \
-    {&binary_single_kernel<operation<dynd_uint128> >::func, &binary_strided_kernel<operation<dynd_uint128> >::func}
-#else
-#define DYND_UINT128_BINARY_OP_PAIR(operation) {NULL, NULL}
-#endif
-
 #ifdef DYND_HAS_FLOAT128
 #define DYND_FLOAT128_BINARY_OP_PAIR(operation) \
     {&binary_single_kernel<operation<dynd_float128> >::func, &binary_strided_kernel<operation<dynd_float128> >::func}
@@ -191,10 +240,10 @@ namespace {
 #define DYND_BUILTIN_DTYPE_BINARY_OP_TABLE(operation) { \
     {&binary_single_kernel<operation<int32_t> >::func, &binary_strided_kernel<operation<int32_t> >::func}, \
     {&binary_single_kernel<operation<int64_t> >::func, &binary_strided_kernel<operation<int64_t> >::func}, \
-    DYND_INT128_BINARY_OP_PAIR(operation), \
-    {&binary_single_kernel<operation<int32_t> >::func, &binary_strided_kernel<operation<uint32_t> >::func}, \
+    {&binary_single_kernel<operation<dynd_int128> >::func, &binary_strided_kernel<operation<dynd_int128> >::func}, \
+    {&binary_single_kernel<operation<uint32_t> >::func, &binary_strided_kernel<operation<uint32_t> >::func}, \
     {&binary_single_kernel<operation<uint64_t> >::func, &binary_strided_kernel<operation<uint64_t> >::func}, \
-    DYND_UINT128_BINARY_OP_PAIR(operation), \
+    {&binary_single_kernel<operation<dynd_uint128> >::func, &binary_strided_kernel<operation<dynd_uint128> >::func}, \
     {&binary_single_kernel<operation<float> >::func, &binary_strided_kernel<operation<float> >::func}, \
     {&binary_single_kernel<operation<double> >::func, &binary_strided_kernel<operation<double> >::func}, \
     DYND_FLOAT128_BINARY_OP_PAIR(operation), \
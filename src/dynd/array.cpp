@@ -1847,6 +1847,24 @@ nd::array nd::memmap(const std::string& filename,
     return result;
 }
 
+/**
+ * Gets the size and stride of the leading dimension for binary_search,
+ * which works with any dimension that can be viewed as strided.
+ */
+static void get_binary_search_strides(const nd::array& n, intptr_t *out_size,
+                                      intptr_t *out_stride)
+{
+    ndt::type el_tp;
+    const char *el_arrmeta;
+    if (!n.get_type().get_as_strided(n.get_arrmeta(), out_size, out_stride,
+                                     &el_tp, &el_arrmeta)) {
+        stringstream ss;
+        ss << "binary_search on array with type " << n.get_type();
+        ss << " requires a strided leading dimension";
+        throw type_error(ss.str());
+    }
+}
+
 intptr_t nd::binary_search(const nd::array& n, const char *arrmeta, const char *data)
 {
     if (n.get_ndim() == 0) {
@@ -1867,16 +1885,9 @@ intptr_t nd::binary_search(const nd::array& n, const char *arrmeta, const char *
                         comparison_type_sorting_less,
                         &eval::default_eval_context);
 
-        // TODO: support any type of array dimension
-        if (n.get_type().get_type_id() != strided_dim_type_id) {
-            stringstream ss;
-            ss << "TODO: binary_search on array with type " << n.get_type() << " is not implemented";
-            throw runtime_error(ss.str());
-        }
-
         const char *n_data = n.get_readonly_originptr();
-        intptr_t n_stride = reinterpret_cast<const strided_dim_type_arrmeta *>(n.get_arrmeta())->stride;
-        intptr_t first = 0, last = n.get_dim_size();
+        intptr_t first = 0, last, n_stride;
+        get_binary_search_strides(n, &last, &n_stride);
         while (first < last) {
             intptr_t trial = first + (last - first) / 2;
             const char *trial_data = n_data + trial * n_stride;
@@ -1909,16 +1920,9 @@ intptr_t nd::binary_search(const nd::array& n, const char *arrmeta, const char *
                         comparison_type_sorting_less,
                         &eval::default_eval_context);
 
-        // TODO: support any type of array dimension
-        if (n.get_type().get_type_id() != strided_dim_type_id) {
-            stringstream ss;
-            ss << "TODO: binary_search on array with type " << n.get_type() << " is not implemented";
-            throw runtime_error(ss.str());
-        }
-
         const char *n_data = n.get_readonly_originptr();
-        intptr_t n_stride = reinterpret_cast<const strided_dim_type_arrmeta *>(n.get_arrmeta())->stride;
-        intptr_t first = 0, last = n.get_dim_size();
+        intptr_t first = 0, last, n_stride;
+        get_binary_search_strides(n, &last, &n_stride);
         while (first < last) {
             intptr_t trial = first + (last - first) / 2;
             const char *trial_data = n_data + trial * n_stride;
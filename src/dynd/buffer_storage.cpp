@@ -0,0 +1,162 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/buffer_storage.hpp>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+// Used if the cache sizes can't be detected
+#define DYND_DEFAULT_L1_CACHE_SIZE (32 * 1024)
+#define DYND_DEFAULT_L2_CACHE_SIZE (256 * 1024)
+
+#if defined(_WIN32)
+static intptr_t detect_cpu_cache_size(int level)
+{
+  DWORD buffer_size = 0;
+  GetLogicalProcessorInformation(NULL, &buffer_size);
+  if (buffer_size == 0) {
+    return 0;
+  }
+  vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(
+      buffer_size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+  if (!GetLogicalProcessorInformation(&info[0], &buffer_size)) {
+    return 0;
+  }
+  for (size_t i = 0; i != info.size(); ++i) {
+    if (info[i].Relationship == RelationCache &&
+        info[i].Cache.Level == level &&
+        (info[i].Cache.Type == CacheData ||
+         info[i].Cache.Type == CacheUnified)) {
+      return info[i].Cache.Size;
+    }
+  }
+  return 0;
+}
+#elif defined(__APPLE__)
+static intptr_t detect_cpu_cache_size(int level)
+{
+  int64_t size = 0;
+  size_t len = sizeof(size);
+  const char *name = (level == 1) ? "hw.l1dcachesize" : "hw.l2cachesize";
+  if (sysctlbyname(name, &size, &len, NULL, 0) != 0) {
+    return 0;
+  }
+  return static_cast<intptr_t>(size);
+}
+#else
+static intptr_t detect_cpu_cache_size(int level)
+{
+  long size = 0;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+  size = sysconf(level == 1 ? _SC_LEVEL1_DCACHE_SIZE : _SC_LEVEL2_CACHE_SIZE);
+#endif
+  if (size > 0) {
+    return size;
+  }
+  // Fall back to the sysfs cache description, looking for a data
+  // or unified cache at the requested level
+  for (int index = 0; index < 8; ++index) {
+    stringstream dir;
+    dir << "/sys/devices/system/cpu/cpu0/cache/index" << index << "/";
+    ifstream level_file((dir.str() + "level").c_str());
+    int file_level = 0;
+    if (!(level_file >> file_level)) {
+      break;
+    }
+    if (file_level != level) {
+      continue;
+    }
+    ifstream type_file((dir.str() + "type").c_str());
+    string type_name;
+    type_file >> type_name;
+    if (type_name != "Data" && type_name != "Unified") {
+      continue;
+    }
+    ifstream size_file((dir.str() + "size").c_str());
+    long value = 0;
+    char suffix = 0;
+    if (size_file >> value) {
+      size_file >> suffix;
+      if (suffix == 'K') {
+        value *= 1024;
+      } else if (suffix == 'M') {
+        value *= 1024 * 1024;
+      }
+      return value;
+    }
+  }
+  return 0;
+}
+#endif
+
+intptr_t dynd::get_cpu_cache_size(int level)
+{
+  static intptr_t l1_size = 0, l2_size = 0;
+  if (level == 1) {
+    if (l1_size == 0) {
+      intptr_t size = detect_cpu_cache_size(1);
+      l1_size = (size > 0) ? size : DYND_DEFAULT_L1_CACHE_SIZE;
+    }
+    return l1_size;
+  } else if (level == 2) {
+    if (l2_size == 0) {
+      intptr_t size = detect_cpu_cache_size(2);
+      l2_size = (size > 0) ? size : DYND_DEFAULT_L2_CACHE_SIZE;
+    }
+    return l2_size;
+  } else {
+    stringstream ss;
+    ss << "get_cpu_cache_size: unsupported cache level " << level;
+    throw invalid_argument(ss.str());
+  }
+}
+
+intptr_t dynd::get_buffer_chunk_size(intptr_t nbuffers,
+                                     const intptr_t *element_sizes,
+                                     const eval::eval_context *ectx)
+{
+  if (ectx != NULL && ectx->buffer_chunk_size > 0) {
+    return ectx->buffer_chunk_size;
+  }
+
+  intptr_t bytes_per_element = 0;
+  for (intptr_t i = 0; i < nbuffers; ++i) {
+    bytes_per_element += max(element_sizes[i], (intptr_t)1);
+  }
+  if (bytes_per_element == 0) {
+    return DYND_BUFFER_CHUNK_SIZE;
+  }
+
+  // Aim to keep one chunk of all the buffers in half the L1 data cache,
+  // leaving the other half for the source and destination streams. When
+  // the elements are so wide that this gives tiny chunks, fall back to
+  // sizing against the L2 cache instead.
+  intptr_t chunk_size = get_cpu_cache_size(1) / 2 / bytes_per_element;
+  if (chunk_size < DYND_BUFFER_CHUNK_SIZE_MIN) {
+    chunk_size = get_cpu_cache_size(2) / 2 / bytes_per_element;
+  }
+  chunk_size = max(chunk_size, (intptr_t)DYND_BUFFER_CHUNK_SIZE_MIN);
+  chunk_size = min(chunk_size, (intptr_t)DYND_BUFFER_CHUNK_SIZE_MAX);
+  // Keep it a multiple of the minimum, so unrolled inner loops
+  // see whole blocks
+  return chunk_size - chunk_size % DYND_BUFFER_CHUNK_SIZE_MIN;
+}
@@ -6,6 +6,7 @@
 #include <dynd/func/arrfunc.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/ckernel_common_functions.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
 #include <dynd/kernels/expr_kernels.hpp>
 #include <dynd/types/expr_type.hpp>
 #include <dynd/types/base_struct_type.hpp>
@@ -201,8 +202,12 @@ nd::array nd::arrfunc::call(intptr_t arg_count, const nd::array *args,
 
   // Generate and evaluate the ckernel
   ckernel_builder ckb;
-  af->instantiate(af, &ckb, 0, dst_tp, result.get_arrmeta(), &src_tp[0],
-                  &src_arrmeta[0], kernel_request_single, ectx);
+  intptr_t ckb_offset = 0;
+  kernels::ckernel_profile_scope prof(&ckb, ckb_offset, kernel_request_single,
+                                      "arrfunc", dst_tp, arg_count,
+                                      arg_count ? &src_tp[0] : NULL, ectx);
+  af->instantiate(af, &ckb, ckb_offset, dst_tp, result.get_arrmeta(),
+                  &src_tp[0], &src_arrmeta[0], kernel_request_single, ectx);
   expr_single_t fn = ckb.get()->get_function<expr_single_t>();
   fn(result.get_readwrite_originptr(), src_data.empty() ? NULL : &src_data[0],
      ckb.get());
@@ -236,8 +241,12 @@ void nd::arrfunc::call_out(intptr_t arg_count, const nd::array *args,
 
   // Generate and evaluate the ckernel
   ckernel_builder ckb;
-  af->instantiate(af, &ckb, 0, out.get_type(), out.get_arrmeta(), &src_tp[0],
-                  &src_arrmeta[0], kernel_request_single, ectx);
+  intptr_t ckb_offset = 0;
+  kernels::ckernel_profile_scope prof(&ckb, ckb_offset, kernel_request_single,
+                                      "arrfunc", out.get_type(), arg_count,
+                                      arg_count ? &src_tp[0] : NULL, ectx);
+  af->instantiate(af, &ckb, ckb_offset, out.get_type(), out.get_arrmeta(),
+                  &src_tp[0], &src_arrmeta[0], kernel_request_single, ectx);
   expr_single_t fn = ckb.get()->get_function<expr_single_t>();
   fn(out.get_readwrite_originptr(), src_data.empty() ? NULL : &src_data[0],
      ckb.get());
@@ -6,6 +6,7 @@
 #include <dynd/func/chain_arrfunc.hpp>
 #include <dynd/buffer_storage.hpp>
 #include <dynd/arrmeta_holder.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -54,7 +55,8 @@ struct unary_heap_chain_ck : public kernels::general_ck<unary_heap_chain_ck> {
     const char *src0 = src[0];
     intptr_t src0_stride = src_stride[0];
 
-    size_t chunk_size = std::min(count, (size_t)DYND_BUFFER_CHUNK_SIZE);
+    size_t buf_chunk_size = self->m_buf_shape[0];
+    size_t chunk_size = std::min(count, buf_chunk_size);
     first_fn(buf_data, buf_stride, &src0, src_stride, chunk_size, first);
     second_fn(dst, dst_stride, &buf_data, &buf_stride, chunk_size, second);
     count -= chunk_size;
@@ -62,7 +64,7 @@ struct unary_heap_chain_ck : public kernels::general_ck<unary_heap_chain_ck> {
       src0 += chunk_size * src0_stride;
       dst += chunk_size * dst_stride;
       reset_strided_buffer_array(buf);
-      chunk_size = std::min(count, (size_t)DYND_BUFFER_CHUNK_SIZE);
+      chunk_size = std::min(count, buf_chunk_size);
       first_fn(buf_data, buf_stride, &src0, src_stride, chunk_size, first);
       second_fn(dst, dst_stride, &buf_data, &buf_stride, chunk_size, second);
       count -= chunk_size;
@@ -81,6 +83,10 @@ struct unary_heap_chain_ck : public kernels::general_ck<unary_heap_chain_ck> {
     // The second child ckernel
     base.destroy_child_ckernel(m_second_offset);
   }
+
+  // The children refer to m_buf_arrmeta, which would have to be
+  // copied for them as well
+  static ckernel_prefix::clone_fn_t get_clone_function() { return NULL; }
 };
 
 struct instantiate_chain_data {
@@ -101,29 +107,41 @@ intptr_t dynd::make_chain_buf_tp_ckernel(
     unary_heap_chain_ck *self = unary_heap_chain_ck::create(ckb, kernreq, ckb_offset);
     self->m_buf_tp = buf_tp;
     arrmeta_holder(buf_tp).swap(self->m_buf_arrmeta);
+    // The element sizes of the dst, buffer, and src, for choosing a
+    // chunk size that keeps them in cache together
+    intptr_t element_sizes[3] = {(intptr_t)dst_tp.get_data_size(),
+                                 (intptr_t)buf_tp.get_data_size(),
+                                 (intptr_t)src_tp[0].get_data_size()};
     if (buf_tp.get_ndim() == 0 || first->resolve_dst_shape == NULL) {
       self->m_buf_arrmeta.arrmeta_default_construct(0, NULL, true);
-      self->m_buf_shape.push_back(DYND_BUFFER_CHUNK_SIZE);
+      self->m_buf_shape.push_back(
+          get_buffer_chunk_size(3, element_sizes, ectx));
     } else {
       intptr_t ndim = buf_tp.get_ndim();
       vector<intptr_t> shape(ndim + 1);
-      shape[0] = DYND_BUFFER_CHUNK_SIZE;
       first->resolve_dst_shape(first, &shape[0] + 1, buf_tp, src_tp,
                                src_arrmeta, NULL);
+      element_sizes[1] =
+          buf_tp.extended()->get_default_data_size(ndim, &shape[0] + 1);
+      shape[0] = get_buffer_chunk_size(3, element_sizes, ectx);
       self->m_buf_arrmeta.arrmeta_default_construct(ndim, &shape[0] + 1, true);
       self->m_buf_shape.swap(shape);
     }
-    ckb_offset = first->instantiate(first, ckb, ckb_offset, buf_tp,
-                                    self->m_buf_arrmeta.get(), src_tp,
-                                    src_arrmeta, kernreq, ectx);
+    {
+      kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernreq, "chain",
+                                          buf_tp, 1, src_tp, ectx);
+      ckb_offset = first->instantiate(first, ckb, ckb_offset, buf_tp,
+                                      self->m_buf_arrmeta.get(), src_tp,
+                                      src_arrmeta, kernreq, ectx);
+    }
     ckb->ensure_capacity(ckb_offset);
     self = ckb->get_at<unary_heap_chain_ck>(root_ckb_offset);
     self->m_second_offset = ckb_offset - root_ckb_offset;
     const char *buf_arrmeta = self->m_buf_arrmeta.get();
-    ckb_offset =
-        second->instantiate(second, ckb, ckb_offset, dst_tp, dst_arrmeta,
-                            &buf_tp, &buf_arrmeta, kernreq, ectx);
-    return ckb_offset;
+    kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernreq, "chain",
+                                        dst_tp, 1, &buf_tp, ectx);
+    return second->instantiate(second, ckb, ckb_offset, dst_tp, dst_arrmeta,
+                               &buf_tp, &buf_arrmeta, kernreq, ectx);
   } else {
     throw runtime_error("Multi-parameter arrfunc chaining is not implemented");
   }
@@ -0,0 +1,341 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/func/comparison_arrfunc.hpp>
+#include <dynd/kernels/expr_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+////////////////////////////////////////////////////////////////
+// Comparison ckernels
+
+template <class T>
+struct cmp_less {
+    static inline bool f(T a, T b) { return a < b; }
+};
+
+template <class T>
+struct cmp_less_equal {
+    static inline bool f(T a, T b) { return a <= b; }
+};
+
+template <class T>
+struct cmp_equal {
+    static inline bool f(T a, T b) { return a == b; }
+};
+
+template <class T>
+struct cmp_not_equal {
+    static inline bool f(T a, T b) { return a != b; }
+};
+
+template <class T>
+struct cmp_greater_equal {
+    static inline bool f(T a, T b) { return a >= b; }
+};
+
+template <class T>
+struct cmp_greater {
+    static inline bool f(T a, T b) { return a > b; }
+};
+
+/**
+ * Compares two values of the same builtin type, writing a bool.
+ */
+template <class T, class Op>
+struct typed_comparison_ck
+    : public kernels::expr_ck<typed_comparison_ck<T, Op>, 2> {
+    inline void single(char *dst, const char *const *src)
+    {
+        *dst = Op::f(*reinterpret_cast<const T *>(src[0]),
+                     *reinterpret_cast<const T *>(src[1]));
+    }
+
+    inline void strided(char *dst, intptr_t dst_stride,
+                        const char *const *src, const intptr_t *src_stride,
+                        size_t count)
+    {
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+        if (dst_stride == 1 && src0_stride == (intptr_t)sizeof(T)) {
+            const T *a = reinterpret_cast<const T *>(src0);
+            if (src1_stride == (intptr_t)sizeof(T)) {
+                const T *b = reinterpret_cast<const T *>(src1);
+                for (size_t i = 0; i != count; ++i) {
+                    dst[i] = Op::f(a[i], b[i]);
+                }
+                return;
+            } else if (src1_stride == 0) {
+                const T b = *reinterpret_cast<const T *>(src1);
+                for (size_t i = 0; i != count; ++i) {
+                    dst[i] = Op::f(a[i], b);
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i != count; ++i, dst += dst_stride,
+                                            src0 += src0_stride,
+                                            src1 += src1_stride) {
+            *dst = Op::f(*reinterpret_cast<const T *>(src0),
+                         *reinterpret_cast<const T *>(src1));
+        }
+    }
+};
+
+/**
+ * Writes the result of a comparison child ckernel as a bool.
+ */
+struct generic_comparison_ck
+    : public kernels::expr_ck<generic_comparison_ck, 2> {
+    inline void single(char *dst, const char *const *src)
+    {
+        ckernel_prefix *child = get_child_ckernel();
+        expr_predicate_t child_fn = child->get_function<expr_predicate_t>();
+        *dst = child_fn(src, child) != 0;
+    }
+
+    inline void destruct_children()
+    {
+        get_child_ckernel()->destroy();
+    }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
+};
+
+template <class T>
+intptr_t instantiate_typed_comparison(ckernel_builder *ckb,
+                                      intptr_t ckb_offset,
+                                      kernel_request_t kernreq,
+                                      comparison_type_t comptype)
+{
+    switch (comptype) {
+        case comparison_type_less:
+            typed_comparison_ck<T, cmp_less<T> >::create_leaf(ckb, kernreq,
+                                                              ckb_offset);
+            break;
+        case comparison_type_less_equal:
+            typed_comparison_ck<T, cmp_less_equal<T> >::create_leaf(
+                ckb, kernreq, ckb_offset);
+            break;
+        case comparison_type_equal:
+            typed_comparison_ck<T, cmp_equal<T> >::create_leaf(ckb, kernreq,
+                                                               ckb_offset);
+            break;
+        case comparison_type_not_equal:
+            typed_comparison_ck<T, cmp_not_equal<T> >::create_leaf(
+                ckb, kernreq, ckb_offset);
+            break;
+        case comparison_type_greater_equal:
+            typed_comparison_ck<T, cmp_greater_equal<T> >::create_leaf(
+                ckb, kernreq, ckb_offset);
+            break;
+        case comparison_type_greater:
+            typed_comparison_ck<T, cmp_greater<T> >::create_leaf(ckb, kernreq,
+                                                                 ckb_offset);
+            break;
+        default:
+            throw runtime_error("unsupported comparison type in comparison arrfunc");
+    }
+    return ckb_offset;
+}
+
+} // anonymous namespace
+
+static int resolve_comparison_dst_type(const arrfunc_type_data *DYND_UNUSED(af_self),
+                                       ndt::type &out_dst_tp,
+                                       const ndt::type *DYND_UNUSED(src_tp),
+                                       int DYND_UNUSED(throw_on_error))
+{
+    out_dst_tp = ndt::make_type<dynd_bool>();
+    return 1;
+}
+
+static intptr_t instantiate_comparison(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp,
+    const char *DYND_UNUSED(dst_arrmeta), const ndt::type *src_tp,
+    const char *const *src_arrmeta, kernel_request_t kernreq,
+    const eval::eval_context *ectx)
+{
+    comparison_type_t comptype = *af_self->get_data_as<comparison_type_t>();
+    if (dst_tp.get_type_id() != bool_type_id) {
+        stringstream ss;
+        ss << "comparison arrfunc: expected a bool destination, not " << dst_tp;
+        throw type_error(ss.str());
+    }
+
+    if (src_tp[0] == src_tp[1]) {
+        switch (src_tp[0].get_type_id()) {
+#define DYND_INSTANTIATE_TYPED_COMPARISON(T)                                   \
+    case type_id_of<T>::value:                                                 \
+        return instantiate_typed_comparison<T>(ckb, ckb_offset, kernreq,       \
+                                               comptype)
+            DYND_INSTANTIATE_TYPED_COMPARISON(int8_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(int16_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(int32_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(int64_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(uint8_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(uint16_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(uint32_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(uint64_t);
+            DYND_INSTANTIATE_TYPED_COMPARISON(float);
+            DYND_INSTANTIATE_TYPED_COMPARISON(double);
+#undef DYND_INSTANTIATE_TYPED_COMPARISON
+            default:
+                break;
+        }
+    }
+
+    generic_comparison_ck::create(ckb, kernreq, ckb_offset);
+    return make_comparison_kernel(ckb, ckb_offset, src_tp[0], src_arrmeta[0],
+                                  src_tp[1], src_arrmeta[1], comptype, ectx);
+}
+
+void kernels::make_comparison_arrfunc(arrfunc_type_data *out_af,
+                                      comparison_type_t comptype)
+{
+    if (comptype == comparison_type_sorting_less) {
+        throw runtime_error("the comparison arrfunc does not support sorting_less");
+    }
+    static ndt::type func_proto("(T, S) -> bool");
+    *out_af->get_data_as<comparison_type_t>() = comptype;
+    out_af->free_func = NULL;
+    out_af->func_proto = func_proto;
+    out_af->resolve_dst_type = &resolve_comparison_dst_type;
+    out_af->resolve_dst_shape = NULL;
+    out_af->instantiate = &instantiate_comparison;
+}
+
+////////////////////////////////////////////////////////////////
+// Logical ckernels
+
+namespace {
+
+// A dynd_bool is always stored as 0 or 1, so the bitwise operations on
+// the bytes give the logical results
+struct bool_and {
+    static inline char f(char a, char b) { return a & b; }
+};
+
+struct bool_or {
+    static inline char f(char a, char b) { return a | b; }
+};
+
+struct bool_xor {
+    static inline char f(char a, char b) { return a ^ b; }
+};
+
+template <class Op>
+struct logical_binary_ck : public kernels::expr_ck<logical_binary_ck<Op>, 2> {
+    inline void single(char *dst, const char *const *src)
+    {
+        *dst = Op::f(*src[0], *src[1]);
+    }
+
+    inline void strided(char *dst, intptr_t dst_stride,
+                        const char *const *src, const intptr_t *src_stride,
+                        size_t count)
+    {
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+        if (dst_stride == 1 && src0_stride == 1 && src1_stride == 1) {
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = Op::f(src0[i], src1[i]);
+            }
+        } else {
+            for (size_t i = 0; i != count; ++i, dst += dst_stride,
+                                                src0 += src0_stride,
+                                                src1 += src1_stride) {
+                *dst = Op::f(*src0, *src1);
+            }
+        }
+    }
+};
+
+struct logical_not_ck : public kernels::expr_ck<logical_not_ck, 1> {
+    inline void single(char *dst, const char *const *src)
+    {
+        *dst = *src[0] ^ 1;
+    }
+
+    inline void strided(char *dst, intptr_t dst_stride,
+                        const char *const *src, const intptr_t *src_stride,
+                        size_t count)
+    {
+        const char *src0 = src[0];
+        intptr_t src0_stride = src_stride[0];
+        if (dst_stride == 1 && src0_stride == 1) {
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = src0[i] ^ 1;
+            }
+        } else {
+            for (size_t i = 0; i != count;
+                    ++i, dst += dst_stride, src0 += src0_stride) {
+                *dst = *src0 ^ 1;
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+static intptr_t instantiate_logical(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp,
+    const char *DYND_UNUSED(dst_arrmeta), const ndt::type *src_tp,
+    const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+    const eval::eval_context *DYND_UNUSED(ectx))
+{
+    kernels::logical_op_t op = *af_self->get_data_as<kernels::logical_op_t>();
+    intptr_t nsrc = (op == kernels::logical_not) ? 1 : 2;
+    bool all_bool = dst_tp.get_type_id() == bool_type_id;
+    for (intptr_t i = 0; i < nsrc; ++i) {
+        all_bool = all_bool && src_tp[i].get_type_id() == bool_type_id;
+    }
+    if (!all_bool) {
+        stringstream ss;
+        ss << "logical arrfunc: expected bool arguments, not (";
+        for (intptr_t i = 0; i < nsrc; ++i) {
+            ss << (i == 0 ? "" : ", ") << src_tp[i];
+        }
+        ss << ") -> " << dst_tp;
+        throw type_error(ss.str());
+    }
+
+    switch (op) {
+        case kernels::logical_and:
+            logical_binary_ck<bool_and>::create_leaf(ckb, kernreq, ckb_offset);
+            return ckb_offset;
+        case kernels::logical_or:
+            logical_binary_ck<bool_or>::create_leaf(ckb, kernreq, ckb_offset);
+            return ckb_offset;
+        case kernels::logical_xor:
+            logical_binary_ck<bool_xor>::create_leaf(ckb, kernreq, ckb_offset);
+            return ckb_offset;
+        case kernels::logical_not:
+            logical_not_ck::create_leaf(ckb, kernreq, ckb_offset);
+            return ckb_offset;
+        default:
+            throw runtime_error("unknown logical operation in logical arrfunc");
+    }
+}
+
+void kernels::make_logical_arrfunc(arrfunc_type_data *out_af, logical_op_t op)
+{
+    static ndt::type binary_proto("(bool, bool) -> bool");
+    static ndt::type unary_proto("(bool) -> bool");
+    *out_af->get_data_as<logical_op_t>() = op;
+    out_af->free_func = NULL;
+    out_af->func_proto = (op == logical_not) ? unary_proto : binary_proto;
+    out_af->resolve_dst_type = NULL;
+    out_af->resolve_dst_shape = NULL;
+    out_af->instantiate = &instantiate_logical;
+}
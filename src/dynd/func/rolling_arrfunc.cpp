@@ -49,6 +49,13 @@ struct strided_rolling_ck : public kernels::unary_ck<strided_rolling_ck> {
         // The window op
         base.destroy_child_ckernel(m_window_op_offset);
     }
+
+    // The children refer to m_src_winop_meta, which would have to be
+    // copied for them as well
+    static ckernel_prefix::clone_fn_t get_clone_function()
+    {
+        return NULL;
+    }
 };
 
 struct var_rolling_ck : public kernels::unary_ck<var_rolling_ck> {
@@ -99,6 +106,12 @@ struct var_rolling_ck : public kernels::unary_ck<var_rolling_ck> {
         // The NA filler
         base.destroy_child_ckernel(sizeof(self_type));
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[2] = {m_window_op_offset, sizeof(self_type)};
+        base.clone_child_ckernels(&src->base, 2, offsets);
+    }
 };
 
 struct rolling_arrfunc_data {
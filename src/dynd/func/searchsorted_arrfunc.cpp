@@ -0,0 +1,880 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+
+#include <dynd/func/searchsorted_arrfunc.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+////////////////////////////////////////////////////////////////
+// Typed comparisons matching sorting_less
+
+template <class T>
+struct typed_less {
+    static inline bool f(T a, T b) { return a < b; }
+};
+
+// NaNs go after all other values
+template <>
+struct typed_less<float> {
+    static inline bool f(float a, float b) {
+        return a < b || (DYND_ISNAN(b) && !DYND_ISNAN(a));
+    }
+};
+
+template <>
+struct typed_less<double> {
+    static inline bool f(double a, double b) {
+        return a < b || (DYND_ISNAN(b) && !DYND_ISNAN(a));
+    }
+};
+
+template <class T>
+inline T typed_at(const char *data, intptr_t stride, intptr_t i)
+{
+    return *reinterpret_cast<const T *>(data + i * stride);
+}
+
+/**
+ * Whether a haystack value goes before the needle ``x``. For the left
+ * side that is ``h < x``, for the right side ``h <= x``.
+ */
+template <class T>
+inline bool typed_before(T h, T x, bool right)
+{
+    return right ? !typed_less<T>::f(x, h) : typed_less<T>::f(h, x);
+}
+
+/**
+ * Branchless binary search, returning the number of haystack values
+ * which go before ``x``. The loop always runs ceil(log2(n)) times, and
+ * the selects compile to conditional moves instead of branches the
+ * predictor can't learn.
+ */
+template <class T>
+inline intptr_t typed_search(const char *hay, intptr_t hay_stride, intptr_t n,
+                             T x, bool right)
+{
+    if (n == 0) {
+        return 0;
+    }
+    intptr_t base = 0;
+    while (n > 1) {
+        intptr_t half = n / 2;
+        base = typed_before(typed_at<T>(hay, hay_stride, base + half), x, right)
+                   ? base + half
+                   : base;
+        n -= half;
+    }
+    return base +
+           (typed_before(typed_at<T>(hay, hay_stride, base), x, right) ? 1 : 0);
+}
+
+/**
+ * CKernel which searches for builtin needles in a haystack of the same
+ * type. The first source is the haystack, the second the needles.
+ */
+template <class T>
+struct typed_searchsorted_ck
+    : public kernels::expr_ck<typed_searchsorted_ck<T>, 2> {
+    bool m_right;
+    intptr_t m_hay_size, m_hay_stride;
+    intptr_t m_needle_size, m_needle_stride;
+    intptr_t m_dst_stride;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        const char *hay = src[0], *needles = src[1];
+        intptr_t n = m_hay_size, m = m_needle_size;
+
+        // With sorted needles, one merge walk costs n + m comparisons
+        // instead of about m * log2(n)
+        bool merge_walk = false;
+        if (m > 1) {
+            intptr_t log2n = 0;
+            while ((intptr_t(1) << log2n) < n) {
+                ++log2n;
+            }
+            if (m * log2n > n + m) {
+                merge_walk = true;
+                for (intptr_t i = 1; i < m; ++i) {
+                    if (typed_less<T>::f(
+                            typed_at<T>(needles, m_needle_stride, i),
+                            typed_at<T>(needles, m_needle_stride, i - 1))) {
+                        merge_walk = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (merge_walk) {
+            intptr_t j = 0;
+            for (intptr_t i = 0; i < m; ++i, dst += m_dst_stride) {
+                T x = typed_at<T>(needles, m_needle_stride, i);
+                while (j < n &&
+                       typed_before(typed_at<T>(hay, m_hay_stride, j), x,
+                                    m_right)) {
+                    ++j;
+                }
+                *reinterpret_cast<intptr_t *>(dst) = j;
+            }
+        } else {
+            for (intptr_t i = 0; i < m; ++i, dst += m_dst_stride) {
+                *reinterpret_cast<intptr_t *>(dst) = typed_search<T>(
+                    hay, m_hay_stride, n,
+                    typed_at<T>(needles, m_needle_stride, i), m_right);
+            }
+        }
+    }
+};
+
+/**
+ * CKernel which searches with a sorting_less comparison child ckernel.
+ * For the left side the child compares (haystack, needle), for the
+ * right side it compares (needle, haystack).
+ */
+struct compare_searchsorted_ck
+    : public kernels::expr_ck<compare_searchsorted_ck, 2> {
+    bool m_right;
+    intptr_t m_hay_size, m_hay_stride;
+    intptr_t m_needle_size, m_needle_stride;
+    intptr_t m_dst_stride;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        ckernel_prefix *less = get_child_ckernel();
+        expr_predicate_t less_fn = less->get_function<expr_predicate_t>();
+        const char *needle = src[1];
+        for (intptr_t i = 0; i < m_needle_size;
+                ++i, dst += m_dst_stride, needle += m_needle_stride) {
+            intptr_t first = 0, count = m_hay_size;
+            while (count > 0) {
+                intptr_t half = count / 2;
+                const char *trial = src[0] + (first + half) * m_hay_stride;
+                bool before;
+                if (m_right) {
+                    const char *child_src[2] = {needle, trial};
+                    before = !less_fn(child_src, less);
+                } else {
+                    const char *child_src[2] = {trial, needle};
+                    before = less_fn(child_src, less) != 0;
+                }
+                if (before) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            *reinterpret_cast<intptr_t *>(dst) = first;
+        }
+    }
+
+    inline void destruct_children()
+    {
+        get_child_ckernel()->destroy();
+    }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
+};
+
+template <class T>
+intptr_t instantiate_typed_searchsorted(ckernel_builder *ckb,
+                                        intptr_t ckb_offset,
+                                        kernel_request_t kernreq, bool right,
+                                        const intptr_t *sizes,
+                                        const intptr_t *strides,
+                                        intptr_t dst_stride)
+{
+    typed_searchsorted_ck<T> *self =
+        typed_searchsorted_ck<T>::create_leaf(ckb, kernreq, ckb_offset);
+    self->m_right = right;
+    self->m_hay_size = sizes[0];
+    self->m_hay_stride = strides[0];
+    self->m_needle_size = sizes[1];
+    self->m_needle_stride = strides[1];
+    self->m_dst_stride = dst_stride;
+    return ckb_offset;
+}
+
+/**
+ * Gets the size, stride, element type and element arrmeta of each
+ * one-dimensional source.
+ */
+inline void get_strided_sources(const char *funcname, intptr_t nsrc,
+                                const ndt::type *src_tp,
+                                const char *const *src_arrmeta,
+                                intptr_t *out_sizes, intptr_t *out_strides,
+                                ndt::type *out_el_tp,
+                                const char **out_el_arrmeta)
+{
+    for (intptr_t i = 0; i < nsrc; ++i) {
+        if (!src_tp[i].get_as_strided(src_arrmeta[i], &out_sizes[i],
+                                      &out_strides[i], &out_el_tp[i],
+                                      &out_el_arrmeta[i])) {
+            stringstream ss;
+            ss << funcname << " arrfunc: could not process type " << src_tp[i];
+            ss << " as a strided dimension";
+            throw type_error(ss.str());
+        }
+    }
+}
+
+} // anonymous namespace
+
+static int resolve_searchsorted_dst_type(const arrfunc_type_data *DYND_UNUSED(af_self),
+                                         ndt::type &out_dst_tp,
+                                         const ndt::type *DYND_UNUSED(src_tp),
+                                         int DYND_UNUSED(throw_on_error))
+{
+    out_dst_tp = ndt::make_strided_dim(ndt::make_type<intptr_t>());
+    return 1;
+}
+
+static void resolve_searchsorted_dst_shape(
+    const arrfunc_type_data *DYND_UNUSED(af_self), intptr_t *out_shape,
+    const ndt::type &DYND_UNUSED(dst_tp), const ndt::type *src_tp,
+    const char *const *src_arrmeta, const char *const *src_data)
+{
+    src_tp[1].extended()->get_shape(1, 0, out_shape, src_arrmeta[1],
+                                    src_data[1]);
+}
+
+static intptr_t instantiate_searchsorted(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    const ndt::type *src_tp, const char *const *src_arrmeta,
+    kernel_request_t kernreq, const eval::eval_context *ectx)
+{
+    bool right =
+        *af_self->get_data_as<kernels::searchsorted_side_t>() ==
+        kernels::searchsorted_right;
+
+    intptr_t sizes[2], strides[2], dst_dim_size, dst_stride;
+    ndt::type el_tp[2], dst_el_tp;
+    const char *el_meta[2], *dst_el_meta;
+    get_strided_sources("searchsorted", 2, src_tp, src_arrmeta, sizes, strides,
+                        el_tp, el_meta);
+    if (!dst_tp.get_as_strided(dst_arrmeta, &dst_dim_size, &dst_stride,
+                               &dst_el_tp, &dst_el_meta) ||
+            dst_el_tp.get_type_id() !=
+                (type_id_t)type_id_of<intptr_t>::value) {
+        stringstream ss;
+        ss << "searchsorted arrfunc: the destination type should be a";
+        ss << " strided dimension of intptr, not " << dst_tp;
+        throw type_error(ss.str());
+    }
+    if (dst_dim_size != sizes[1]) {
+        stringstream ss;
+        ss << "searchsorted arrfunc: expected a destination of size ";
+        ss << sizes[1] << ", got " << dst_dim_size;
+        throw invalid_argument(ss.str());
+    }
+
+    if (el_tp[0] == el_tp[1]) {
+        switch (el_tp[0].get_type_id()) {
+#define DYND_INSTANTIATE_TYPED_SEARCHSORTED(T) \
+            case type_id_of<T>::value: \
+                return instantiate_typed_searchsorted<T>(ckb, ckb_offset, \
+                        kernreq, right, sizes, strides, dst_stride)
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(dynd_bool);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(int8_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(int16_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(int32_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(int64_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(uint8_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(uint16_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(uint32_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(uint64_t);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(float);
+            DYND_INSTANTIATE_TYPED_SEARCHSORTED(double);
+#undef DYND_INSTANTIATE_TYPED_SEARCHSORTED
+            default:
+                break;
+        }
+    }
+
+    compare_searchsorted_ck *self =
+        compare_searchsorted_ck::create(ckb, kernreq, ckb_offset);
+    self->m_right = right;
+    self->m_hay_size = sizes[0];
+    self->m_hay_stride = strides[0];
+    self->m_needle_size = sizes[1];
+    self->m_needle_stride = strides[1];
+    self->m_dst_stride = dst_stride;
+    if (right) {
+        return make_comparison_kernel(ckb, ckb_offset, el_tp[1], el_meta[1],
+                                      el_tp[0], el_meta[0],
+                                      comparison_type_sorting_less, ectx);
+    } else {
+        return make_comparison_kernel(ckb, ckb_offset, el_tp[0], el_meta[0],
+                                      el_tp[1], el_meta[1],
+                                      comparison_type_sorting_less, ectx);
+    }
+}
+
+void kernels::make_searchsorted_arrfunc(arrfunc_type_data *out_af,
+                                        searchsorted_side_t side)
+{
+    static ndt::type param_types[2] = {ndt::type("M * T"),
+                                       ndt::type("N * S")};
+    static ndt::type func_proto =
+        ndt::make_funcproto(param_types, ndt::type("N * intptr"));
+    *out_af->get_data_as<searchsorted_side_t>() = side;
+    out_af->free_func = NULL;
+    out_af->func_proto = func_proto;
+    out_af->resolve_dst_type = &resolve_searchsorted_dst_type;
+    out_af->resolve_dst_shape = &resolve_searchsorted_dst_shape;
+    out_af->instantiate = &instantiate_searchsorted;
+}
+
+////////////////////////////////////////////////////////////////
+// Sorted set operations
+
+namespace {
+
+/**
+ * Returns the first index in [first, last) where ``pred`` is false,
+ * given that ``pred`` is true up to some index and false from there
+ * on. This probes at exponentially growing steps and then does a
+ * binary search, so it costs O(log(distance)) calls.
+ */
+template <class Pred>
+intptr_t gallop(intptr_t first, intptr_t last, const Pred& pred)
+{
+    if (first == last || !pred(first)) {
+        return first;
+    }
+    // pred(lo - 1) is always true
+    intptr_t lo = first + 1, step = 1;
+    while (lo + step - 1 < last && pred(lo + step - 1)) {
+        lo += step;
+        step *= 2;
+    }
+    intptr_t hi = min(lo + step - 1, last);
+    while (lo < hi) {
+        intptr_t mid = lo + (hi - lo) / 2;
+        if (pred(mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Galloping predicates, in terms of the comparisons an Ops class provides
+
+template <class Ops>
+struct a_equal_a {
+    const Ops& ops;
+    intptr_t i;
+    a_equal_a(const Ops& o, intptr_t i_) : ops(o), i(i_) {}
+    inline bool operator()(intptr_t k) const { return !ops.a_less_a(i, k); }
+};
+
+template <class Ops>
+struct b_equal_b {
+    const Ops& ops;
+    intptr_t j;
+    b_equal_b(const Ops& o, intptr_t j_) : ops(o), j(j_) {}
+    inline bool operator()(intptr_t k) const { return !ops.b_less_b(j, k); }
+};
+
+template <class Ops>
+struct a_before_b {
+    const Ops& ops;
+    intptr_t j;
+    a_before_b(const Ops& o, intptr_t j_) : ops(o), j(j_) {}
+    inline bool operator()(intptr_t k) const { return ops.a_less_b(k, j); }
+};
+
+template <class Ops>
+struct b_before_a {
+    const Ops& ops;
+    intptr_t i;
+    b_before_a(const Ops& o, intptr_t i_) : ops(o), i(i_) {}
+    inline bool operator()(intptr_t k) const { return ops.b_less_a(k, i); }
+};
+
+template <class Ops>
+struct b_not_after_a {
+    const Ops& ops;
+    intptr_t i;
+    b_not_after_a(const Ops& o, intptr_t i_) : ops(o), i(i_) {}
+    inline bool operator()(intptr_t k) const { return !ops.a_less_b(i, k); }
+};
+
+/**
+ * Runs a set operation on sorted inputs ``a`` and ``b``, calling
+ * ``out.emit_a(i)`` or ``out.emit_b(j)`` for each value of the result
+ * in order.
+ */
+template <class Ops, class Out>
+void run_sorted_set_op(kernels::sorted_set_op_t op, const Ops& ops,
+                       intptr_t na, intptr_t nb, Out& out)
+{
+    intptr_t i = 0, j = 0;
+    switch (op) {
+        case kernels::sorted_set_unique:
+            while (i < na) {
+                out.emit_a(i);
+                i = gallop(i + 1, na, a_equal_a<Ops>(ops, i));
+            }
+            break;
+        case kernels::sorted_set_intersect:
+            while (i < na && j < nb) {
+                if (ops.a_less_b(i, j)) {
+                    i = gallop(i + 1, na, a_before_b<Ops>(ops, j));
+                } else if (ops.b_less_a(j, i)) {
+                    j = gallop(j + 1, nb, b_before_a<Ops>(ops, i));
+                } else {
+                    out.emit_a(i);
+                    j = gallop(j + 1, nb, b_not_after_a<Ops>(ops, i));
+                    i = gallop(i + 1, na, a_equal_a<Ops>(ops, i));
+                }
+            }
+            break;
+        case kernels::sorted_set_union:
+            while (i < na && j < nb) {
+                if (ops.a_less_b(i, j)) {
+                    out.emit_a(i);
+                    i = gallop(i + 1, na, a_equal_a<Ops>(ops, i));
+                } else if (ops.b_less_a(j, i)) {
+                    out.emit_b(j);
+                    j = gallop(j + 1, nb, b_equal_b<Ops>(ops, j));
+                } else {
+                    out.emit_a(i);
+                    j = gallop(j + 1, nb, b_not_after_a<Ops>(ops, i));
+                    i = gallop(i + 1, na, a_equal_a<Ops>(ops, i));
+                }
+            }
+            while (i < na) {
+                out.emit_a(i);
+                i = gallop(i + 1, na, a_equal_a<Ops>(ops, i));
+            }
+            while (j < nb) {
+                out.emit_b(j);
+                j = gallop(j + 1, nb, b_equal_b<Ops>(ops, j));
+            }
+            break;
+    }
+}
+
+template <class T>
+struct typed_set_ops {
+    const char *a, *b;
+    intptr_t a_stride, b_stride;
+
+    inline T a_at(intptr_t i) const { return typed_at<T>(a, a_stride, i); }
+    inline T b_at(intptr_t j) const { return typed_at<T>(b, b_stride, j); }
+    inline bool a_less_a(intptr_t i, intptr_t k) const {
+        return typed_less<T>::f(a_at(i), a_at(k));
+    }
+    inline bool b_less_b(intptr_t j, intptr_t k) const {
+        return typed_less<T>::f(b_at(j), b_at(k));
+    }
+    inline bool a_less_b(intptr_t i, intptr_t j) const {
+        return typed_less<T>::f(a_at(i), b_at(j));
+    }
+    inline bool b_less_a(intptr_t j, intptr_t i) const {
+        return typed_less<T>::f(b_at(j), a_at(i));
+    }
+};
+
+/**
+ * Set operation comparisons through sorting_less ckernels, one for
+ * each combination of operands. Only ``aa`` is needed for unique.
+ */
+struct compare_set_ops {
+    const char *a, *b;
+    intptr_t a_stride, b_stride;
+    ckernel_prefix *aa, *bb, *ab, *ba;
+
+    static inline bool call(ckernel_prefix *ck, const char *x, const char *y) {
+        const char *src[2] = {x, y};
+        return ck->get_function<expr_predicate_t>()(src, ck) != 0;
+    }
+    inline bool a_less_a(intptr_t i, intptr_t k) const {
+        return call(aa, a + i * a_stride, a + k * a_stride);
+    }
+    inline bool b_less_b(intptr_t j, intptr_t k) const {
+        return call(bb, b + j * b_stride, b + k * b_stride);
+    }
+    inline bool a_less_b(intptr_t i, intptr_t j) const {
+        return call(ab, a + i * a_stride, b + j * b_stride);
+    }
+    inline bool b_less_a(intptr_t j, intptr_t i) const {
+        return call(ba, b + j * b_stride, a + i * a_stride);
+    }
+};
+
+/**
+ * Writes the values of the result one after another. The destination
+ * has room for as many values as the operation can produce.
+ */
+struct var_output {
+    char *dst;
+    intptr_t dst_stride, count;
+    var_output(char *d, intptr_t ds) : dst(d), dst_stride(ds), count(0) {}
+
+    inline char *next() {
+        char *result = dst;
+        dst += dst_stride;
+        ++count;
+        return result;
+    }
+};
+
+template <class T>
+struct typed_output : public var_output {
+    const typed_set_ops<T>& ops;
+    typed_output(const typed_set_ops<T>& o, char *d, intptr_t ds)
+        : var_output(d, ds), ops(o) {}
+    inline void emit_a(intptr_t i) {
+        *reinterpret_cast<T *>(next()) = ops.a_at(i);
+    }
+    inline void emit_b(intptr_t j) {
+        *reinterpret_cast<T *>(next()) = ops.b_at(j);
+    }
+};
+
+struct assign_output : public var_output {
+    const compare_set_ops& ops;
+    ckernel_prefix *assign_a, *assign_b;
+    assign_output(const compare_set_ops& o, char *d, intptr_t ds,
+                  ckernel_prefix *aa, ckernel_prefix *ab)
+        : var_output(d, ds), ops(o), assign_a(aa), assign_b(ab) {}
+    inline void emit_a(intptr_t i) {
+        const char *src = ops.a + i * ops.a_stride;
+        assign_a->get_function<expr_single_t>()(next(), &src, assign_a);
+    }
+    inline void emit_b(intptr_t j) {
+        const char *src = ops.b + j * ops.b_stride;
+        assign_b->get_function<expr_single_t>()(next(), &src, assign_b);
+    }
+};
+
+/**
+ * The var dim destination of a sorted set operation. Each call starts
+ * the element with room for the most values the operation can produce,
+ * then shrinks it to fit the values it did produce.
+ */
+struct sorted_set_dst {
+    ndt::type tp;
+    const char *arrmeta;
+    intptr_t stride;
+
+    inline char *begin(char *dst, kernels::sorted_set_op_t op,
+                       const intptr_t *sizes) const
+    {
+        intptr_t capacity;
+        switch (op) {
+            case kernels::sorted_set_unique:
+                capacity = sizes[0];
+                break;
+            case kernels::sorted_set_intersect:
+                capacity = min(sizes[0], sizes[1]);
+                break;
+            default:
+                capacity = sizes[0] + sizes[1];
+                break;
+        }
+        ndt::var_dim_element_initialize(tp, arrmeta, dst, capacity);
+        return reinterpret_cast<var_dim_type_data *>(dst)->begin;
+    }
+
+    inline void finish(char *dst, intptr_t count) const
+    {
+        ndt::var_dim_element_resize(tp, arrmeta, dst, count);
+    }
+};
+
+/**
+ * CKernel for a sorted set operation on builtin values of one type.
+ */
+template <class T, int N>
+struct typed_sorted_set_ck : public kernels::expr_ck<typed_sorted_set_ck<T, N>, N> {
+    kernels::sorted_set_op_t m_op;
+    intptr_t m_sizes[2], m_strides[2];
+    sorted_set_dst m_dst;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        typed_set_ops<T> ops = {src[0], N > 1 ? src[N - 1] : NULL,
+                                m_strides[0], m_strides[1]};
+        typed_output<T> out(ops, m_dst.begin(dst, m_op, m_sizes),
+                            m_dst.stride);
+        run_sorted_set_op(m_op, ops, m_sizes[0], m_sizes[1], out);
+        m_dst.finish(dst, out.count);
+    }
+};
+
+/**
+ * CKernel for a sorted set operation through comparison ckernels. The
+ * first child is the (a, a) comparison, followed by the (b, b), (a, b)
+ * and (b, a) comparisons when there are two operands, then the
+ * assignments from a and b to the destination element.
+ */
+template <int N>
+struct compare_sorted_set_ck : public kernels::expr_ck<compare_sorted_set_ck<N>, N> {
+    kernels::sorted_set_op_t m_op;
+    intptr_t m_sizes[2], m_strides[2];
+    sorted_set_dst m_dst;
+    intptr_t m_bb_offset, m_ab_offset, m_ba_offset;
+    intptr_t m_assign_a_offset, m_assign_b_offset;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        compare_set_ops ops;
+        ops.a = src[0];
+        ops.b = N > 1 ? src[N - 1] : NULL;
+        ops.a_stride = m_strides[0];
+        ops.b_stride = m_strides[1];
+        ops.aa = this->get_child_ckernel();
+        ops.bb = m_bb_offset ? this->get_child_ckernel(m_bb_offset) : NULL;
+        ops.ab = m_ab_offset ? this->get_child_ckernel(m_ab_offset) : NULL;
+        ops.ba = m_ba_offset ? this->get_child_ckernel(m_ba_offset) : NULL;
+        assign_output out(
+            ops, m_dst.begin(dst, m_op, m_sizes), m_dst.stride,
+            this->get_child_ckernel(m_assign_a_offset),
+            m_assign_b_offset ? this->get_child_ckernel(m_assign_b_offset)
+                              : NULL);
+        run_sorted_set_op(m_op, ops, m_sizes[0], m_sizes[1], out);
+        m_dst.finish(dst, out.count);
+    }
+
+    inline void destruct_children()
+    {
+        this->get_child_ckernel()->destroy();
+        this->base.destroy_child_ckernel(m_bb_offset);
+        this->base.destroy_child_ckernel(m_ab_offset);
+        this->base.destroy_child_ckernel(m_ba_offset);
+        this->base.destroy_child_ckernel(m_assign_a_offset);
+        this->base.destroy_child_ckernel(m_assign_b_offset);
+    }
+
+    inline void clone_children(const compare_sorted_set_ck *src)
+    {
+        const size_t offsets[6] = {
+            sizeof(compare_sorted_set_ck), (size_t)m_bb_offset,
+            (size_t)m_ab_offset, (size_t)m_ba_offset, (size_t)m_assign_a_offset,
+            (size_t)m_assign_b_offset};
+        this->base.clone_child_ckernels(&src->base, 6, offsets);
+    }
+};
+
+template <class T>
+intptr_t instantiate_typed_sorted_set(ckernel_builder *ckb, intptr_t ckb_offset,
+                                      kernel_request_t kernreq,
+                                      kernels::sorted_set_op_t op,
+                                      const intptr_t *sizes,
+                                      const intptr_t *strides,
+                                      const sorted_set_dst &dst)
+{
+    if (op == kernels::sorted_set_unique) {
+        typed_sorted_set_ck<T, 1> *self =
+            typed_sorted_set_ck<T, 1>::create_leaf(ckb, kernreq, ckb_offset);
+        self->m_op = op;
+        memcpy(self->m_sizes, sizes, sizeof(self->m_sizes));
+        memcpy(self->m_strides, strides, sizeof(self->m_strides));
+        self->m_dst = dst;
+    } else {
+        typed_sorted_set_ck<T, 2> *self =
+            typed_sorted_set_ck<T, 2>::create_leaf(ckb, kernreq, ckb_offset);
+        self->m_op = op;
+        memcpy(self->m_sizes, sizes, sizeof(self->m_sizes));
+        memcpy(self->m_strides, strides, sizeof(self->m_strides));
+        self->m_dst = dst;
+    }
+    return ckb_offset;
+}
+
+template <int N>
+intptr_t instantiate_compare_sorted_set(
+    ckernel_builder *ckb, intptr_t ckb_offset, kernel_request_t kernreq,
+    kernels::sorted_set_op_t op, const intptr_t *sizes,
+    const intptr_t *strides, const ndt::type *el_tp, const char **el_meta,
+    const sorted_set_dst &dst, const eval::eval_context *ectx)
+{
+    typedef compare_sorted_set_ck<N> self_type;
+    intptr_t root_ckb_offset = ckb_offset;
+    self_type *self = self_type::create(ckb, kernreq, ckb_offset);
+    self->m_op = op;
+    memcpy(self->m_sizes, sizes, sizeof(self->m_sizes));
+    memcpy(self->m_strides, strides, sizeof(self->m_strides));
+    self->m_dst = dst;
+    self->m_bb_offset = 0;
+    self->m_ab_offset = 0;
+    self->m_ba_offset = 0;
+    self->m_assign_a_offset = 0;
+    self->m_assign_b_offset = 0;
+
+    ndt::type dst_el_tp = dst.tp.tcast<var_dim_type>()->get_element_type();
+    const char *dst_el_meta = dst.arrmeta + sizeof(var_dim_type_arrmeta);
+
+    ckb_offset = make_comparison_kernel(ckb, ckb_offset, el_tp[0], el_meta[0],
+                                        el_tp[0], el_meta[0],
+                                        comparison_type_sorting_less, ectx);
+    if (N > 1) {
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_bb_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_comparison_kernel(
+            ckb, ckb_offset, el_tp[1], el_meta[1], el_tp[1], el_meta[1],
+            comparison_type_sorting_less, ectx);
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_ab_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_comparison_kernel(
+            ckb, ckb_offset, el_tp[0], el_meta[0], el_tp[1], el_meta[1],
+            comparison_type_sorting_less, ectx);
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_ba_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_comparison_kernel(
+            ckb, ckb_offset, el_tp[1], el_meta[1], el_tp[0], el_meta[0],
+            comparison_type_sorting_less, ectx);
+    }
+    ckb->ensure_capacity(ckb_offset);
+    self = ckb->get_at<self_type>(root_ckb_offset);
+    self->m_assign_a_offset = ckb_offset - root_ckb_offset;
+    ckb_offset = make_assignment_kernel(ckb, ckb_offset, dst_el_tp, dst_el_meta,
+                                        el_tp[0], el_meta[0],
+                                        kernel_request_single, ectx);
+    if (N > 1) {
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_assign_b_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_assignment_kernel(
+            ckb, ckb_offset, dst_el_tp, dst_el_meta, el_tp[1], el_meta[1],
+            kernel_request_single, ectx);
+    }
+    return ckb_offset;
+}
+
+} // anonymous namespace
+
+static int resolve_sorted_set_dst_type(const arrfunc_type_data *DYND_UNUSED(af_self),
+                                       ndt::type &out_dst_tp,
+                                       const ndt::type *src_tp,
+                                       int DYND_UNUSED(throw_on_error))
+{
+    out_dst_tp = ndt::make_var_dim(
+        src_tp[0].get_type_at_dimension(NULL, 1).get_canonical_type());
+    return 1;
+}
+
+static void resolve_sorted_set_dst_shape(const arrfunc_type_data *DYND_UNUSED(af_self),
+                                         intptr_t *out_shape,
+                                         const ndt::type &dst_tp,
+                                         const ndt::type *src_tp,
+                                         const char *const *src_arrmeta,
+                                         const char *const *DYND_UNUSED(src_data))
+{
+    // The size of the result depends on the values
+    out_shape[0] = -1;
+    if (dst_tp.get_ndim() > 1) {
+        // If the elements themselves have dimensions, also initialize their
+        // shape
+        const char *el_arrmeta = src_arrmeta[0];
+        ndt::type el_tp = src_tp[0].get_type_at_dimension(
+            const_cast<char **>(&el_arrmeta), 1);
+        el_tp.extended()->get_shape(dst_tp.get_ndim() - 1, 0, out_shape + 1,
+                                    el_arrmeta, NULL);
+    }
+}
+
+static intptr_t instantiate_sorted_set(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    const ndt::type *src_tp, const char *const *src_arrmeta,
+    kernel_request_t kernreq, const eval::eval_context *ectx)
+{
+    kernels::sorted_set_op_t op =
+        *af_self->get_data_as<kernels::sorted_set_op_t>();
+    intptr_t nsrc = af_self->get_param_count();
+    intptr_t sizes[2] = {0, 0}, strides[2] = {0, 0};
+    ndt::type el_tp[2];
+    const char *el_meta[2] = {NULL, NULL};
+    get_strided_sources("sorted set", nsrc, src_tp, src_arrmeta, sizes,
+                        strides, el_tp, el_meta);
+    if (dst_tp.get_type_id() != var_dim_type_id) {
+        stringstream ss;
+        ss << "sorted set arrfunc: could not process type " << dst_tp;
+        ss << " as a var dimension";
+        throw type_error(ss.str());
+    }
+    sorted_set_dst dst;
+    dst.tp = dst_tp;
+    dst.arrmeta = dst_arrmeta;
+    dst.stride =
+        reinterpret_cast<const var_dim_type_arrmeta *>(dst_arrmeta)->stride;
+    const ndt::type &dst_el_tp =
+        dst_tp.tcast<var_dim_type>()->get_element_type();
+
+    if (el_tp[0].is_builtin() && dst_el_tp == el_tp[0] &&
+            (nsrc == 1 || el_tp[0] == el_tp[1])) {
+        switch (el_tp[0].get_type_id()) {
+#define DYND_INSTANTIATE_TYPED_SORTED_SET(T) \
+            case type_id_of<T>::value: \
+                return instantiate_typed_sorted_set<T>(ckb, ckb_offset, \
+                        kernreq, op, sizes, strides, dst)
+            DYND_INSTANTIATE_TYPED_SORTED_SET(dynd_bool);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(int8_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(int16_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(int32_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(int64_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(uint8_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(uint16_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(uint32_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(uint64_t);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(float);
+            DYND_INSTANTIATE_TYPED_SORTED_SET(double);
+#undef DYND_INSTANTIATE_TYPED_SORTED_SET
+            default:
+                break;
+        }
+    }
+
+    if (nsrc == 1) {
+        return instantiate_compare_sorted_set<1>(
+            ckb, ckb_offset, kernreq, op, sizes, strides, el_tp, el_meta,
+            dst, ectx);
+    } else {
+        return instantiate_compare_sorted_set<2>(
+            ckb, ckb_offset, kernreq, op, sizes, strides, el_tp, el_meta,
+            dst, ectx);
+    }
+}
+
+void kernels::make_sorted_set_arrfunc(arrfunc_type_data *out_af,
+                                      sorted_set_op_t op)
+{
+    static ndt::type unary_param_types[1] = {ndt::type("M * T")};
+    static ndt::type binary_param_types[2] = {ndt::type("M * T"),
+                                              ndt::type("N * T")};
+    static ndt::type unary_proto =
+        ndt::make_funcproto(unary_param_types, ndt::type("var * T"));
+    static ndt::type binary_proto =
+        ndt::make_funcproto(binary_param_types, ndt::type("var * T"));
+    *out_af->get_data_as<sorted_set_op_t>() = op;
+    out_af->free_func = NULL;
+    out_af->func_proto = (op == sorted_set_unique) ? unary_proto : binary_proto;
+    out_af->resolve_dst_type = &resolve_sorted_set_dst_type;
+    out_af->resolve_dst_shape = &resolve_sorted_set_dst_shape;
+    out_af->instantiate = &instantiate_sorted_set;
+}
@@ -0,0 +1,730 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <vector>
+
+#include <dynd/func/sort_arrfunc.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/fixedstring_type.hpp>
+#include <dynd/shape_tools.hpp>
+#include <dynd/parallel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// Below this many elements, a comparison sort beats the radix passes
+#define DYND_RADIX_SORT_THRESHOLD 64
+// From this many elements on, sorts are split across threads
+#define DYND_PARALLEL_SORT_THRESHOLD (1 << 16)
+
+namespace {
+
+////////////////////////////////////////////////////////////////
+// Order preserving mappings from builtin values to unsigned keys
+
+template <class T>
+struct radix_key;
+
+template <>
+struct radix_key<dynd_bool> {
+    typedef uint8_t type;
+    static inline uint8_t to_key(dynd_bool v) { return v ? 1 : 0; }
+    static inline dynd_bool from_key(uint8_t k) { return k != 0; }
+};
+
+template <class T, class K>
+struct unsigned_radix_key {
+    typedef K type;
+    static inline K to_key(T v) { return v; }
+    static inline T from_key(K k) { return k; }
+};
+
+// Flipping the sign bit puts negative values first
+template <class T, class K>
+struct signed_radix_key {
+    typedef K type;
+    static inline K to_key(T v) {
+        return static_cast<K>(static_cast<K>(v) ^
+                              (K(1) << (sizeof(K) * 8 - 1)));
+    }
+    static inline T from_key(K k) {
+        return static_cast<T>(static_cast<K>(k ^
+                              (K(1) << (sizeof(K) * 8 - 1))));
+    }
+};
+
+// Positive values get the sign bit set, negative values get all
+// their bits flipped. NaNs are made positive so they sort last.
+template <class T, class K>
+struct float_radix_key {
+    typedef K type;
+    static inline K to_key(T v) {
+        K bits;
+        if (DYND_ISNAN(v)) {
+            v = numeric_limits<T>::quiet_NaN();
+        }
+        memcpy(&bits, &v, sizeof(K));
+        const K sign = K(1) << (sizeof(K) * 8 - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+    static inline T from_key(K k) {
+        const K sign = K(1) << (sizeof(K) * 8 - 1);
+        K bits = (k & sign) ? (k ^ sign) : ~k;
+        T v;
+        memcpy(&v, &bits, sizeof(K));
+        return v;
+    }
+};
+
+template <> struct radix_key<int8_t> : signed_radix_key<int8_t, uint8_t> {};
+template <> struct radix_key<int16_t> : signed_radix_key<int16_t, uint16_t> {};
+template <> struct radix_key<int32_t> : signed_radix_key<int32_t, uint32_t> {};
+template <> struct radix_key<int64_t> : signed_radix_key<int64_t, uint64_t> {};
+template <> struct radix_key<uint8_t> : unsigned_radix_key<uint8_t, uint8_t> {};
+template <> struct radix_key<uint16_t> : unsigned_radix_key<uint16_t, uint16_t> {};
+template <> struct radix_key<uint32_t> : unsigned_radix_key<uint32_t, uint32_t> {};
+template <> struct radix_key<uint64_t> : unsigned_radix_key<uint64_t, uint64_t> {};
+template <> struct radix_key<float> : float_radix_key<float, uint32_t> {};
+template <> struct radix_key<double> : float_radix_key<double, uint64_t> {};
+
+template <class K>
+struct keyed_index {
+    K key;
+    intptr_t index;
+};
+
+template <class K>
+inline K get_key(K k) { return k; }
+
+template <class K>
+inline K get_key(const keyed_index<K>& e) { return e.key; }
+
+template <class K, class E>
+struct key_less {
+    inline bool operator()(const E& a, const E& b) const {
+        return get_key<K>(a) < get_key<K>(b);
+    }
+};
+
+/**
+ * Stable LSD radix sort of ``data`` by key, one byte per pass, with
+ * ``tmp`` as scratch space of the same size. Passes where all the keys
+ * have the same byte value are skipped.
+ */
+template <class K, class E>
+void radix_sort(E *data, E *tmp, intptr_t n)
+{
+    E *src = data, *dst = tmp;
+    for (size_t shift = 0; shift < sizeof(K) * 8; shift += 8) {
+        intptr_t offsets[256];
+        memset(offsets, 0, sizeof(offsets));
+        for (intptr_t i = 0; i < n; ++i) {
+            ++offsets[(get_key<K>(src[i]) >> shift) & 0xff];
+        }
+        if (offsets[(get_key<K>(src[0]) >> shift) & 0xff] == n) {
+            continue;
+        }
+        intptr_t total = 0;
+        for (int d = 0; d < 256; ++d) {
+            intptr_t count = offsets[d];
+            offsets[d] = total;
+            total += count;
+        }
+        for (intptr_t i = 0; i < n; ++i) {
+            dst[offsets[(get_key<K>(src[i]) >> shift) & 0xff]++] = src[i];
+        }
+        swap(src, dst);
+    }
+    if (src != data) {
+        copy(src, src + n, data);
+    }
+}
+
+template <class K, class E>
+struct radix_block_sorter {
+    inline void operator()(E *begin, E *end) const {
+        intptr_t n = end - begin;
+        if (n < DYND_RADIX_SORT_THRESHOLD) {
+            stable_sort(begin, end, key_less<K, E>());
+        } else {
+            vector<E> tmp(n);
+            radix_sort<K, E>(begin, &tmp[0], n);
+        }
+    }
+};
+
+template <class Less, class E>
+struct stable_block_sorter {
+    Less m_less;
+    stable_block_sorter(const Less& less) : m_less(less) {}
+    inline void operator()(E *begin, E *end) const {
+        stable_sort(begin, end, m_less);
+    }
+};
+
+/**
+ * Returns how many elements of ``a`` are among the first ``k``
+ * outputs of the stable merge of ``a`` and ``b``.
+ */
+template <class E, class Less>
+intptr_t merge_corank(intptr_t k, const E *a, intptr_t na, const E *b,
+                      intptr_t nb, const Less& less)
+{
+    intptr_t lo = max((intptr_t)0, k - nb), hi = min(k, na);
+    while (lo < hi) {
+        intptr_t i = lo + (hi - lo) / 2, j = k - i;
+        // a[i] comes before b[j - 1], so more of a is needed
+        if (i < na && j > 0 && !less(b[j - 1], a[i])) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Sorts an array by splitting it into one block per thread, sorting
+ * the blocks in parallel, then merging runs of blocks pairwise. Each
+ * merge is itself split across threads by co-ranking, so the final
+ * merges keep all the threads busy too. Stable when the block
+ * sorter is stable.
+ */
+template <class E, class Less, class BlockSorter>
+class parallel_sorter {
+    E *m_data;
+    intptr_t m_size;
+    Less m_less;
+    BlockSorter m_sort_block;
+    vector<intptr_t> m_bounds;
+    // State of the current merge round
+    const E *m_src;
+    E *m_dst;
+    intptr_t m_width, m_parts_per_merge;
+
+    static void sort_task(intptr_t i, void *data)
+    {
+        parallel_sorter *self = reinterpret_cast<parallel_sorter *>(data);
+        self->m_sort_block(self->m_data + self->m_bounds[i],
+                           self->m_data + self->m_bounds[i + 1]);
+    }
+
+    static void merge_task(intptr_t t, void *data)
+    {
+        parallel_sorter *self = reinterpret_cast<parallel_sorter *>(data);
+        intptr_t nblocks = self->m_bounds.size() - 1;
+        intptr_t merge_index = t / self->m_parts_per_merge;
+        intptr_t part = t % self->m_parts_per_merge;
+        intptr_t first = merge_index * 2 * self->m_width;
+        intptr_t mid = min(first + self->m_width, nblocks);
+        intptr_t last = min(first + 2 * self->m_width, nblocks);
+        intptr_t a_begin = self->m_bounds[first], b_begin = self->m_bounds[mid];
+        intptr_t na = b_begin - a_begin, nb = self->m_bounds[last] - b_begin;
+        const E *a = self->m_src + a_begin, *b = self->m_src + b_begin;
+        // This part's slice of the merged output
+        intptr_t out_begin = (na + nb) * part / self->m_parts_per_merge;
+        intptr_t out_end = (na + nb) * (part + 1) / self->m_parts_per_merge;
+        intptr_t i0 = merge_corank(out_begin, a, na, b, nb, self->m_less);
+        intptr_t i1 = merge_corank(out_end, a, na, b, nb, self->m_less);
+        std::merge(a + i0, a + i1, b + (out_begin - i0), b + (out_end - i1),
+              self->m_dst + a_begin + out_begin, self->m_less);
+    }
+
+public:
+    parallel_sorter(E *data, intptr_t size, const Less& less,
+                    const BlockSorter& sort_block)
+        : m_data(data), m_size(size), m_less(less), m_sort_block(sort_block)
+    {
+    }
+
+    void run(intptr_t thread_count)
+    {
+        intptr_t nblocks = thread_count;
+        m_bounds.resize(nblocks + 1);
+        for (intptr_t i = 0; i <= nblocks; ++i) {
+            m_bounds[i] = m_size * i / nblocks;
+        }
+        parallel::run_tasks(nblocks, thread_count, &sort_task, this);
+
+        vector<E> tmp(m_size);
+        E *src = m_data, *dst = &tmp[0];
+        for (m_width = 1; m_width < nblocks; m_width *= 2) {
+            intptr_t merge_count = (nblocks + 2 * m_width - 1) / (2 * m_width);
+            m_parts_per_merge = max((intptr_t)1, thread_count / merge_count);
+            m_src = src;
+            m_dst = dst;
+            parallel::run_tasks(merge_count * m_parts_per_merge, thread_count,
+                                &merge_task, this);
+            swap(src, dst);
+        }
+        if (src != m_data) {
+            copy(src, src + m_size, m_data);
+        }
+    }
+};
+
+/**
+ * Puts the elements in the order requested by ``mode``.
+ */
+template <class E, class Less, class BlockSorter>
+void order_elements(E *data, intptr_t n, kernels::sort_mode_t mode, intptr_t k,
+                    intptr_t thread_count, const Less& less,
+                    const BlockSorter& sort_block)
+{
+    switch (mode) {
+        case kernels::sort_mode_sort:
+        case kernels::sort_mode_argsort:
+            if (thread_count > 1) {
+                parallel_sorter<E, Less, BlockSorter>(data, n, less, sort_block)
+                    .run(thread_count);
+            } else {
+                sort_block(data, data + n);
+            }
+            break;
+        case kernels::sort_mode_partition:
+            if (k < n) {
+                nth_element(data, data + k, data + n, less);
+            }
+            break;
+        case kernels::sort_mode_topk:
+            partial_sort(data, data + min(k, n), data + n, less);
+            break;
+    }
+}
+
+/**
+ * CKernel which sorts builtin values by radix key.
+ */
+template <class T>
+struct radix_sort_ck : public kernels::expr_ck<radix_sort_ck<T>, 1> {
+    typedef typename radix_key<T>::type K;
+
+    kernels::sort_mode_t m_mode;
+    intptr_t m_k, m_thread_count;
+    intptr_t m_src_dim_size, m_src_stride;
+    intptr_t m_dst_dim_size, m_dst_stride;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        const char *src0 = src[0];
+        intptr_t n = m_src_dim_size;
+        if (m_mode == kernels::sort_mode_argsort) {
+            vector<keyed_index<K> > items(n);
+            for (intptr_t i = 0; i < n; ++i, src0 += m_src_stride) {
+                items[i].key = radix_key<T>::to_key(
+                    *reinterpret_cast<const T *>(src0));
+                items[i].index = i;
+            }
+            if (n > 0) {
+                order_elements(&items[0], n, m_mode, m_k, m_thread_count,
+                               key_less<K, keyed_index<K> >(),
+                               radix_block_sorter<K, keyed_index<K> >());
+            }
+            for (intptr_t i = 0; i < m_dst_dim_size; ++i, dst += m_dst_stride) {
+                *reinterpret_cast<intptr_t *>(dst) = items[i].index;
+            }
+        } else {
+            vector<K> keys(n);
+            for (intptr_t i = 0; i < n; ++i, src0 += m_src_stride) {
+                keys[i] = radix_key<T>::to_key(*reinterpret_cast<const T *>(src0));
+            }
+            if (n > 0) {
+                order_elements(&keys[0], n, m_mode, m_k, m_thread_count,
+                               key_less<K, K>(), radix_block_sorter<K, K>());
+            }
+            for (intptr_t i = 0; i < m_dst_dim_size; ++i, dst += m_dst_stride) {
+                *reinterpret_cast<T *>(dst) = radix_key<T>::from_key(keys[i]);
+            }
+        }
+    }
+};
+
+/**
+ * An index into the source, with the first bytes of its string
+ * packed big-endian so that integer order matches byte order.
+ */
+struct prefixed_index {
+    uint64_t prefix;
+    intptr_t index;
+};
+
+inline uint64_t make_string_prefix(const char *begin, const char *end)
+{
+    uint64_t prefix = 0;
+    intptr_t size = min(end - begin, (intptr_t)sizeof(uint64_t));
+    for (intptr_t i = 0; i < (intptr_t)sizeof(uint64_t); ++i) {
+        prefix <<= 8;
+        if (i < size) {
+            prefix |= static_cast<uint8_t>(begin[i]);
+        }
+    }
+    return prefix;
+}
+
+/**
+ * Less than on source indices, calling the sorting_less
+ * comparison ckernel.
+ *
+ * NOTE: In the parallel mode, this calls the comparison ckernel
+ *       from several threads at once. Comparisons of expression
+ *       types buffer their operands inside the ckernel, so
+ *       instantiate_sort only enables that mode for types which
+ *       aren't expressions.
+ */
+struct index_less {
+    const char *m_src;
+    intptr_t m_src_stride;
+    expr_predicate_t m_less;
+    ckernel_prefix *m_less_self;
+
+    inline bool operator()(intptr_t a, intptr_t b) const {
+        const char *s[2] = {m_src + a * m_src_stride, m_src + b * m_src_stride};
+        return m_less(s, m_less_self) != 0;
+    }
+
+    inline bool operator()(const prefixed_index& a,
+                           const prefixed_index& b) const {
+        if (a.prefix != b.prefix) {
+            return a.prefix < b.prefix;
+        } else {
+            return (*this)(a.index, b.index);
+        }
+    }
+};
+
+enum string_prefix_kind_t {
+    string_prefix_none,
+    string_prefix_string,
+    string_prefix_fixedstring
+};
+
+/**
+ * CKernel which sorts by comparison, with a key prefix sort for strings.
+ * The first child is the sorting_less comparison ckernel, and if the
+ * mode outputs values, there is a second child single assignment ckernel
+ * for copying them.
+ */
+struct compare_sort_ck : public kernels::expr_ck<compare_sort_ck, 1> {
+    kernels::sort_mode_t m_mode;
+    intptr_t m_k, m_thread_count;
+    intptr_t m_src_dim_size, m_src_stride;
+    intptr_t m_dst_dim_size, m_dst_stride;
+    string_prefix_kind_t m_prefix_kind;
+    intptr_t m_fixedstring_size;
+    intptr_t m_assign_offset;
+
+    template <class E>
+    inline void write_output(char *dst, const char *src0, const E *order)
+    {
+        if (m_mode == kernels::sort_mode_argsort) {
+            for (intptr_t i = 0; i < m_dst_dim_size; ++i, dst += m_dst_stride) {
+                *reinterpret_cast<intptr_t *>(dst) = get_index(order[i]);
+            }
+        } else {
+            ckernel_prefix *assign = get_child_ckernel(m_assign_offset);
+            expr_single_t assign_fn = assign->get_function<expr_single_t>();
+            for (intptr_t i = 0; i < m_dst_dim_size; ++i, dst += m_dst_stride) {
+                const char *child_src = src0 + get_index(order[i]) * m_src_stride;
+                assign_fn(dst, &child_src, assign);
+            }
+        }
+    }
+
+    static inline intptr_t get_index(intptr_t i) { return i; }
+    static inline intptr_t get_index(const prefixed_index& e) { return e.index; }
+
+    inline void single(char *dst, const char *const *src)
+    {
+        const char *src0 = src[0];
+        intptr_t n = m_src_dim_size;
+        ckernel_prefix *less_ck = get_child_ckernel();
+        index_less less = {src0, m_src_stride,
+                           less_ck->get_function<expr_predicate_t>(), less_ck};
+        if (m_prefix_kind == string_prefix_none) {
+            vector<intptr_t> order(n);
+            for (intptr_t i = 0; i < n; ++i) {
+                order[i] = i;
+            }
+            if (n > 0) {
+                order_elements(&order[0], n, m_mode, m_k, m_thread_count, less,
+                               stable_block_sorter<index_less, intptr_t>(less));
+            }
+            write_output(dst, src0, order.empty() ? NULL : &order[0]);
+        } else {
+            vector<prefixed_index> order(n);
+            const char *s = src0;
+            for (intptr_t i = 0; i < n; ++i, s += m_src_stride) {
+                if (m_prefix_kind == string_prefix_string) {
+                    const string_type_data *sd =
+                        reinterpret_cast<const string_type_data *>(s);
+                    order[i].prefix = make_string_prefix(sd->begin, sd->end);
+                } else {
+                    // The fixedstring comparison stops at the first NUL
+                    const char *end = s;
+                    const char *s_end = s + m_fixedstring_size;
+                    while (end != s_end && *end != 0) {
+                        ++end;
+                    }
+                    order[i].prefix = make_string_prefix(s, end);
+                }
+                order[i].index = i;
+            }
+            if (n > 0) {
+                order_elements(
+                    &order[0], n, m_mode, m_k, m_thread_count, less,
+                    stable_block_sorter<index_less, prefixed_index>(less));
+            }
+            write_output(dst, src0, order.empty() ? NULL : &order[0]);
+        }
+    }
+
+    inline void destruct_children()
+    {
+        // The comparison ckernel
+        get_child_ckernel()->destroy();
+        // The assignment ckernel
+        base.destroy_child_ckernel(m_assign_offset);
+    }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[2] = {sizeof(self_type), (size_t)m_assign_offset};
+        base.clone_child_ckernels(&src->base, 2, offsets);
+    }
+};
+
+struct sort_arrfunc_data {
+    kernels::sort_mode_t mode;
+    intptr_t k;
+};
+
+template <class CKT>
+inline void init_sort_ck(CKT *self, const sort_arrfunc_data *sad, intptr_t k,
+                         intptr_t src_dim_size, intptr_t src_stride,
+                         intptr_t dst_dim_size, intptr_t dst_stride,
+                         const eval::eval_context *ectx)
+{
+    self->m_mode = sad->mode;
+    self->m_k = k;
+    self->m_src_dim_size = src_dim_size;
+    self->m_src_stride = src_stride;
+    self->m_dst_dim_size = dst_dim_size;
+    self->m_dst_stride = dst_stride;
+    if ((sad->mode == kernels::sort_mode_sort ||
+         sad->mode == kernels::sort_mode_argsort) &&
+            src_dim_size >= DYND_PARALLEL_SORT_THRESHOLD) {
+        self->m_thread_count = parallel::get_thread_count(ectx);
+    } else {
+        self->m_thread_count = 1;
+    }
+}
+
+template <class T>
+intptr_t instantiate_radix_sort(ckernel_builder *ckb, intptr_t ckb_offset,
+                                kernel_request_t kernreq,
+                                const sort_arrfunc_data *sad, intptr_t k,
+                                intptr_t src_dim_size, intptr_t src_stride,
+                                intptr_t dst_dim_size, intptr_t dst_stride,
+                                const eval::eval_context *ectx)
+{
+    radix_sort_ck<T> *self = radix_sort_ck<T>::create_leaf(ckb, kernreq, ckb_offset);
+    init_sort_ck(self, sad, k, src_dim_size, src_stride, dst_dim_size,
+                 dst_stride, ectx);
+    return ckb_offset;
+}
+
+} // anonymous namespace
+
+static int resolve_sort_dst_type(const arrfunc_type_data *af_self,
+                                 ndt::type &out_dst_tp, const ndt::type *src_tp,
+                                 int DYND_UNUSED(throw_on_error))
+{
+    const sort_arrfunc_data *sad = af_self->get_data_as<sort_arrfunc_data>();
+    if (sad->mode == kernels::sort_mode_argsort) {
+        out_dst_tp = ndt::make_strided_dim(ndt::make_type<intptr_t>());
+    } else {
+        out_dst_tp = ndt::make_strided_dim(
+            src_tp[0].get_type_at_dimension(NULL, 1).get_canonical_type());
+    }
+    return 1;
+}
+
+static void resolve_sort_dst_shape(const arrfunc_type_data *af_self,
+                                   intptr_t *out_shape, const ndt::type &dst_tp,
+                                   const ndt::type *src_tp,
+                                   const char *const *src_arrmeta,
+                                   const char *const *src_data)
+{
+    const sort_arrfunc_data *sad = af_self->get_data_as<sort_arrfunc_data>();
+    src_tp[0].extended()->get_shape(1, 0, out_shape, src_arrmeta[0],
+                                    src_data[0]);
+    if (sad->mode == kernels::sort_mode_topk) {
+        out_shape[0] = min(out_shape[0], sad->k);
+    }
+    if (dst_tp.get_ndim() > 1) {
+        // If the elements themselves have dimensions, also initialize their
+        // shape
+        const char *el_arrmeta = src_arrmeta[0];
+        ndt::type el_tp = src_tp[0].get_type_at_dimension(
+            const_cast<char **>(&el_arrmeta), 1);
+        el_tp.extended()->get_shape(dst_tp.get_ndim() - 1, 0, out_shape + 1,
+                                    el_arrmeta, NULL);
+    }
+}
+
+static intptr_t
+instantiate_sort(const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+                 intptr_t ckb_offset, const ndt::type &dst_tp,
+                 const char *dst_arrmeta, const ndt::type *src_tp,
+                 const char *const *src_arrmeta, kernel_request_t kernreq,
+                 const eval::eval_context *ectx)
+{
+    const sort_arrfunc_data *sad = af_self->get_data_as<sort_arrfunc_data>();
+
+    intptr_t src_dim_size, src_stride, dst_dim_size, dst_stride;
+    ndt::type src_el_tp, dst_el_tp;
+    const char *src_el_meta, *dst_el_meta;
+    if (!src_tp[0].get_as_strided(src_arrmeta[0], &src_dim_size, &src_stride,
+                                  &src_el_tp, &src_el_meta)) {
+        stringstream ss;
+        ss << "sort arrfunc: could not process type " << src_tp[0];
+        ss << " as a strided dimension";
+        throw type_error(ss.str());
+    }
+    if (!dst_tp.get_as_strided(dst_arrmeta, &dst_dim_size, &dst_stride,
+                               &dst_el_tp, &dst_el_meta)) {
+        stringstream ss;
+        ss << "sort arrfunc: could not process type " << dst_tp;
+        ss << " as a strided dimension";
+        throw type_error(ss.str());
+    }
+
+    intptr_t k = sad->k;
+    intptr_t expected_dst_dim_size = src_dim_size;
+    if (sad->mode == kernels::sort_mode_partition && src_dim_size > 0) {
+        // Handle Python-style negative index, bounds checking
+        k = apply_single_index(k, src_dim_size, NULL);
+    } else if (sad->mode == kernels::sort_mode_topk) {
+        expected_dst_dim_size = min(k, src_dim_size);
+    }
+    if (dst_dim_size != expected_dst_dim_size) {
+        stringstream ss;
+        ss << "sort arrfunc: expected a destination of size ";
+        ss << expected_dst_dim_size << ", got " << dst_dim_size;
+        throw invalid_argument(ss.str());
+    }
+    if (sad->mode == kernels::sort_mode_argsort &&
+            dst_el_tp.get_type_id() != (type_id_t)type_id_of<intptr_t>::value) {
+        stringstream ss;
+        ss << "argsort arrfunc: destination type should be intptr, not ";
+        ss << dst_el_tp;
+        throw type_error(ss.str());
+    }
+
+    // Builtin values go through the radix sort when no conversion is needed
+    if (sad->mode == kernels::sort_mode_argsort || dst_el_tp == src_el_tp) {
+        switch (src_el_tp.get_type_id()) {
+#define DYND_INSTANTIATE_RADIX_SORT(T) \
+            case type_id_of<T>::value: \
+                return instantiate_radix_sort<T>(ckb, ckb_offset, kernreq, \
+                        sad, k, src_dim_size, src_stride, dst_dim_size, \
+                        dst_stride, ectx)
+            DYND_INSTANTIATE_RADIX_SORT(dynd_bool);
+            DYND_INSTANTIATE_RADIX_SORT(int8_t);
+            DYND_INSTANTIATE_RADIX_SORT(int16_t);
+            DYND_INSTANTIATE_RADIX_SORT(int32_t);
+            DYND_INSTANTIATE_RADIX_SORT(int64_t);
+            DYND_INSTANTIATE_RADIX_SORT(uint8_t);
+            DYND_INSTANTIATE_RADIX_SORT(uint16_t);
+            DYND_INSTANTIATE_RADIX_SORT(uint32_t);
+            DYND_INSTANTIATE_RADIX_SORT(uint64_t);
+            DYND_INSTANTIATE_RADIX_SORT(float);
+            DYND_INSTANTIATE_RADIX_SORT(double);
+#undef DYND_INSTANTIATE_RADIX_SORT
+            default:
+                break;
+        }
+    }
+
+    typedef compare_sort_ck self_type;
+    intptr_t root_ckb_offset = ckb_offset;
+    self_type *self = self_type::create(ckb, kernreq, ckb_offset);
+    init_sort_ck(self, sad, k, src_dim_size, src_stride, dst_dim_size,
+                 dst_stride, ectx);
+    if (!src_el_tp.is_builtin() && src_el_tp.is_expression()) {
+        // The comparison ckernel writes to its own buffers,
+        // so it can't be shared between threads
+        self->m_thread_count = 1;
+    }
+    self->m_prefix_kind = string_prefix_none;
+    self->m_fixedstring_size = 0;
+    self->m_assign_offset = 0;
+    // Strings in single byte encodings compare bytewise, so
+    // their leading bytes work as a sort key prefix
+    if (src_el_tp.get_type_id() == string_type_id) {
+        string_encoding_t enc = src_el_tp.tcast<string_type>()->get_encoding();
+        if (enc == string_encoding_ascii || enc == string_encoding_utf_8) {
+            self->m_prefix_kind = string_prefix_string;
+        }
+    } else if (src_el_tp.get_type_id() == fixedstring_type_id) {
+        string_encoding_t enc =
+            src_el_tp.tcast<fixedstring_type>()->get_encoding();
+        if (enc == string_encoding_ascii || enc == string_encoding_utf_8) {
+            self->m_prefix_kind = string_prefix_fixedstring;
+            self->m_fixedstring_size = src_el_tp.get_data_size();
+        }
+    }
+
+    ckb_offset = make_comparison_kernel(ckb, ckb_offset, src_el_tp,
+                                        src_el_meta, src_el_tp, src_el_meta,
+                                        comparison_type_sorting_less, ectx);
+    if (sad->mode != kernels::sort_mode_argsort) {
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_assign_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_assignment_kernel(ckb, ckb_offset, dst_el_tp,
+                                            dst_el_meta, src_el_tp, src_el_meta,
+                                            kernel_request_single, ectx);
+    }
+    return ckb_offset;
+}
+
+void kernels::make_sort_arrfunc(arrfunc_type_data *out_af, sort_mode_t mode,
+                                intptr_t k)
+{
+    static ndt::type param_types[1] = {ndt::type("M * T")};
+    static ndt::type sort_proto =
+        ndt::make_funcproto(param_types, ndt::type("M * T"));
+    static ndt::type argsort_proto =
+        ndt::make_funcproto(param_types, ndt::type("M * intptr"));
+    static ndt::type topk_proto =
+        ndt::make_funcproto(param_types, ndt::type("K * T"));
+    if (mode == sort_mode_topk && k < 0) {
+        stringstream ss;
+        ss << "top-k arrfunc: the count must be non-negative, got " << k;
+        throw invalid_argument(ss.str());
+    }
+    sort_arrfunc_data *sad = out_af->get_data_as<sort_arrfunc_data>();
+    sad->mode = mode;
+    sad->k = k;
+    out_af->free_func = NULL;
+    switch (mode) {
+        case sort_mode_argsort:
+            out_af->func_proto = argsort_proto;
+            break;
+        case sort_mode_topk:
+            out_af->func_proto = topk_proto;
+            break;
+        default:
+            out_af->func_proto = sort_proto;
+            break;
+    }
+    out_af->resolve_dst_type = &resolve_sort_dst_type;
+    out_af->resolve_dst_shape = &resolve_sort_dst_shape;
+    out_af->instantiate = &instantiate_sort;
+}
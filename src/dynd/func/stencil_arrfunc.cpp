@@ -0,0 +1,452 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <vector>
+#include <cstring>
+
+#include <dynd/func/stencil_arrfunc.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/typevar_dim_type.hpp>
+#include <dynd/arrmeta_holder.hpp>
+#include <dynd/shortvector.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// The cache budget for the source rows under one tile of the interior
+#define DYND_STENCIL_TILE_BYTES (256 * 1024)
+
+namespace {
+/**
+ * Advances ``index`` through the box ``[begin, end)`` in C order,
+ * returning false once it wraps around.
+ */
+inline bool next_index(intptr_t ndim, intptr_t *index, const intptr_t *begin,
+                       const intptr_t *end)
+{
+    for (intptr_t k = ndim - 1; k >= 0; --k) {
+        if (++index[k] != end[k]) {
+            return true;
+        }
+        index[k] = begin[k];
+    }
+    return false;
+}
+
+/**
+ * Maps the index ``j`` into ``[0, size)`` for the boundary mode, or
+ * returns -1 when it should be filled with the constant.
+ */
+inline intptr_t boundary_index(intptr_t j, intptr_t size,
+                               stencil_boundary_t boundary)
+{
+    if (j >= 0 && j < size) {
+        return j;
+    }
+    switch (boundary) {
+        case stencil_boundary_nearest:
+            return j < 0 ? 0 : size - 1;
+        case stencil_boundary_reflect:
+            j %= 2 * size;
+            if (j < 0) {
+                j += 2 * size;
+            }
+            return j < size ? j : 2 * size - j - 1;
+        case stencil_boundary_wrap:
+            j %= size;
+            return j < 0 ? j + size : j;
+        default:
+            return -1;
+    }
+}
+
+struct stencil_ck : public kernels::unary_ck<stencil_ck> {
+    intptr_t m_ndim;
+    stencil_boundary_t m_boundary;
+    /**
+     * Storage for the per-dimension arrays below. The ckernel builder
+     * moves the kernel with memcpy, so they live on the heap rather
+     * than in a dimvector, whose short storage points into itself.
+     */
+    std::vector<intptr_t> m_dims;
+    intptr_t *m_shape, *m_dst_stride, *m_src_stride;
+    intptr_t *m_nh_shape, *m_nh_offset;
+    /** The range of indices whose neighborhoods are inside the array */
+    intptr_t *m_interior_begin, *m_interior_end;
+    /** The number of interior elements of a row handed out per call */
+    intptr_t m_tile_size;
+    /** Scratch space for the element and neighborhood indices */
+    intptr_t *m_index, *m_nh_index, *m_zeros;
+    size_t m_data_size;
+    std::vector<char> m_constant, m_buffer;
+    size_t m_border_offset;
+    arrmeta_holder m_interior_meta, m_border_meta;
+
+    inline char *dst_at(char *dst, const intptr_t *index) const
+    {
+        for (intptr_t k = 0; k < m_ndim; ++k) {
+            dst += index[k] * m_dst_stride[k];
+        }
+        return dst;
+    }
+
+    /** Copies the neighborhood of ``m_index`` into ``m_buffer`` */
+    void gather(const char *src)
+    {
+        intptr_t ndim = m_ndim;
+        char *buf = &m_buffer[0];
+        for (intptr_t k = 0; k < ndim; ++k) {
+            m_nh_index[k] = 0;
+        }
+        do {
+            const char *s = src;
+            for (intptr_t k = 0; k < ndim && s != NULL; ++k) {
+                intptr_t j = boundary_index(
+                    m_index[k] + m_nh_offset[k] + m_nh_index[k], m_shape[k],
+                    m_boundary);
+                s = (j >= 0) ? s + j * m_src_stride[k] : NULL;
+            }
+            memcpy(buf, s != NULL ? s : &m_constant[0], m_data_size);
+            buf += m_data_size;
+        } while (next_index(ndim, m_nh_index, m_zeros, m_nh_shape));
+    }
+
+    inline void single(char *dst, const char *src)
+    {
+        ckernel_prefix *interior = get_child_ckernel();
+        ckernel_prefix *border = get_child_ckernel(m_border_offset);
+        expr_strided_t interior_fn = interior->get_function<expr_strided_t>();
+        expr_strided_t border_fn = border->get_function<expr_strided_t>();
+        intptr_t ndim = m_ndim, last = ndim - 1;
+        bool has_interior = true;
+        for (intptr_t k = 0; k < ndim; ++k) {
+            if (m_shape[k] == 0) {
+                return;
+            }
+            has_interior = has_interior &&
+                           m_interior_begin[k] < m_interior_end[k];
+        }
+
+        // The interior, one column tile at a time, walking down the rows
+        // under it so each row of source is reused by the neighborhoods
+        // of the following rows while it is still in cache
+        if (has_interior) {
+            for (intptr_t col = m_interior_begin[last];
+                    col < m_interior_end[last]; col += m_tile_size) {
+                intptr_t count =
+                    min(m_tile_size, m_interior_end[last] - col);
+                for (intptr_t k = 0; k < last; ++k) {
+                    m_index[k] = m_interior_begin[k];
+                }
+                m_index[last] = col;
+                do {
+                    const char *s = src;
+                    for (intptr_t k = 0; k < ndim; ++k) {
+                        s += (m_index[k] + m_nh_offset[k]) * m_src_stride[k];
+                    }
+                    interior_fn(dst_at(dst, m_index), m_dst_stride[last],
+                                &s, &m_src_stride[last], count, interior);
+                } while (next_index(last, m_index, m_interior_begin,
+                                    m_interior_end));
+            }
+        }
+
+        // Everything else, gathering each neighborhood into the buffer
+        const char *buf = &m_buffer[0];
+        intptr_t zero_stride = 0;
+        for (intptr_t k = 0; k < ndim; ++k) {
+            m_index[k] = 0;
+        }
+        do {
+            bool row_interior = has_interior;
+            for (intptr_t k = 0; k < last && row_interior; ++k) {
+                row_interior = m_index[k] >= m_interior_begin[k] &&
+                               m_index[k] < m_interior_end[k];
+            }
+            for (intptr_t col = 0; col < m_shape[last]; ++col) {
+                if (row_interior && col == m_interior_begin[last]) {
+                    // Skip over the part already done
+                    col = m_interior_end[last] - 1;
+                    continue;
+                }
+                m_index[last] = col;
+                gather(src);
+                border_fn(dst_at(dst, m_index), 0, &buf, &zero_stride,
+                          1, border);
+            }
+            m_index[last] = 0;
+        } while (next_index(last, m_index, m_zeros, m_shape));
+    }
+
+    inline void destruct_children()
+    {
+        // The interior window op
+        get_child_ckernel()->destroy();
+        // The border window op
+        base.destroy_child_ckernel(m_border_offset);
+    }
+
+    // The children refer to m_interior_meta and m_border_meta, which
+    // would have to be copied for them as well
+    static ckernel_prefix::clone_fn_t get_clone_function()
+    {
+        return NULL;
+    }
+};
+
+struct stencil_arrfunc_data {
+    intptr_t ndim;
+    dimvector nh_shape, nh_offset;
+    stencil_boundary_t boundary;
+    nd::array constant;
+    // The window op
+    nd::arrfunc window_op;
+};
+
+static void free_stencil_arrfunc_data(arrfunc_type_data *self_af) {
+    delete *self_af->get_data_as<stencil_arrfunc_data *>();
+}
+
+/**
+ * Makes arrmeta for ``ndim`` strided dimensions of POD ``el_tp``,
+ * with the neighborhood shape and the given strides
+ */
+void make_window_arrmeta(arrmeta_holder &out, const ndt::type &el_tp,
+                         intptr_t ndim, const intptr_t *nh_shape,
+                         const intptr_t *strides)
+{
+    arrmeta_holder(ndt::make_strided_dim(el_tp, ndim)).swap(out);
+    for (intptr_t k = 0; k < ndim; ++k) {
+        strided_dim_type_arrmeta *md = out.get_at<strided_dim_type_arrmeta>(
+            k * sizeof(strided_dim_type_arrmeta));
+        md->dim_size = nh_shape[k];
+        md->stride = strides[k];
+    }
+}
+} // anonymous namespace
+
+static int resolve_stencil_dst_type(const arrfunc_type_data *af_self,
+                                    ndt::type &out_dst_tp,
+                                    const ndt::type *src_tp, int throw_on_error)
+{
+    stencil_arrfunc_data *data = *af_self->get_data_as<stencil_arrfunc_data *>();
+    const arrfunc_type_data *child_af = data->window_op.get();
+    // First get the type for the child arrfunc
+    ndt::type child_dst_tp;
+    if (child_af->resolve_dst_type) {
+        ndt::type child_src_tp = ndt::make_strided_dim(
+            src_tp[0].get_type_at_dimension(NULL, data->ndim), data->ndim);
+        if (!child_af->resolve_dst_type(child_af, child_dst_tp, &child_src_tp,
+                                        throw_on_error)) {
+            return 0;
+        }
+    } else {
+        child_dst_tp = child_af->get_return_type();
+    }
+    if (child_dst_tp.get_ndim() != 0) {
+        if (throw_on_error) {
+            stringstream ss;
+            ss << "stencil arrfunc: the window op must return a scalar, got "
+               << child_dst_tp;
+            throw type_error(ss.str());
+        }
+        return 0;
+    }
+
+    out_dst_tp = ndt::make_strided_dim(child_dst_tp, data->ndim);
+    return 1;
+}
+
+static void resolve_stencil_dst_shape(const arrfunc_type_data *af_self,
+                                      intptr_t *out_shape,
+                                      const ndt::type &DYND_UNUSED(dst_tp),
+                                      const ndt::type *src_tp,
+                                      const char *const *src_arrmeta,
+                                      const char *const *src_data)
+{
+    stencil_arrfunc_data *data = *af_self->get_data_as<stencil_arrfunc_data *>();
+    src_tp[0].extended()->get_shape(data->ndim, 0, out_shape, src_arrmeta[0],
+                                    src_data[0]);
+}
+
+static intptr_t
+instantiate_stencil(const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+                    intptr_t ckb_offset, const ndt::type &dst_tp,
+                    const char *dst_arrmeta, const ndt::type *src_tp,
+                    const char *const *src_arrmeta, kernel_request_t kernreq,
+                    const eval::eval_context *ectx)
+{
+    typedef stencil_ck self_type;
+    stencil_arrfunc_data *data = *af_self->get_data_as<stencil_arrfunc_data *>();
+    intptr_t ndim = data->ndim;
+
+    const size_stride_t *dst_ss, *src_ss;
+    ndt::type dst_el_tp, src_el_tp;
+    const char *dst_el_arrmeta, *src_el_arrmeta;
+    if (!dst_tp.get_as_strided(dst_arrmeta, ndim, &dst_ss, &dst_el_tp,
+                               &dst_el_arrmeta)) {
+        stringstream ss;
+        ss << "stencil ckernel: could not process type " << dst_tp;
+        ss << " as " << ndim << " strided dimensions";
+        throw type_error(ss.str());
+    }
+    if (!src_tp[0].get_as_strided(src_arrmeta[0], ndim, &src_ss, &src_el_tp,
+                                  &src_el_arrmeta)) {
+        stringstream ss;
+        ss << "stencil ckernel: could not process type " << src_tp[0];
+        ss << " as " << ndim << " strided dimensions";
+        throw type_error(ss.str());
+    }
+    if (!src_el_tp.is_pod() || src_el_tp.get_arrmeta_size() != 0) {
+        stringstream ss;
+        ss << "stencil ckernel: the element type must be POD without arrmeta,"
+              " got " << src_el_tp;
+        throw type_error(ss.str());
+    }
+    for (intptr_t k = 0; k < ndim; ++k) {
+        if (src_ss[k].dim_size != dst_ss[k].dim_size) {
+            stringstream ss;
+            ss << "stencil ckernel: source type " << src_tp[0]
+               << " does not match the shape of dest type " << dst_tp;
+            throw type_error(ss.str());
+        }
+    }
+
+    intptr_t root_ckb_offset = ckb_offset;
+    self_type *self = self_type::create(ckb, kernreq, ckb_offset);
+    self->m_ndim = ndim;
+    self->m_boundary = data->boundary;
+    self->m_dims.resize(10 * ndim);
+    intptr_t *dims = &self->m_dims[0];
+    intptr_t **dim_arrays[10] = {
+        &self->m_shape, &self->m_dst_stride, &self->m_src_stride,
+        &self->m_nh_shape, &self->m_nh_offset, &self->m_interior_begin,
+        &self->m_interior_end, &self->m_index, &self->m_nh_index,
+        &self->m_zeros};
+    for (int i = 0; i < 10; ++i) {
+        *dim_arrays[i] = dims + i * ndim;
+    }
+    intptr_t nh_size = 1, outer_nh_size = 1;
+    for (intptr_t k = 0; k < ndim; ++k) {
+        intptr_t size = src_ss[k].dim_size, nh = data->nh_shape[k];
+        intptr_t offset = data->nh_offset[k];
+        self->m_shape[k] = size;
+        self->m_dst_stride[k] = dst_ss[k].stride;
+        self->m_src_stride[k] = src_ss[k].stride;
+        self->m_interior_begin[k] = max(-offset, (intptr_t)0);
+        self->m_interior_end[k] = min(size - offset - nh + 1, size);
+        self->m_nh_shape[k] = nh;
+        self->m_nh_offset[k] = offset;
+        self->m_zeros[k] = 0;
+        nh_size *= nh;
+        if (k < ndim - 1) {
+            outer_nh_size *= nh;
+        }
+    }
+    size_t data_size = src_el_tp.get_data_size();
+    self->m_data_size = data_size;
+    self->m_tile_size = max(
+        DYND_STENCIL_TILE_BYTES / (intptr_t)(data_size * outer_nh_size),
+        (intptr_t)1);
+    self->m_buffer.resize(nh_size * data_size);
+    self->m_constant.resize(data_size);
+    if (!data->constant.is_null()) {
+        nd::array c = nd::empty(src_el_tp);
+        c.vals() = data->constant;
+        memcpy(&self->m_constant[0], c.get_readonly_originptr(), data_size);
+    }
+
+    // The interior window op reads the source in place, and the border
+    // one reads the buffer, which is C contiguous
+    const arrfunc_type_data *window_af = data->window_op.get();
+    make_window_arrmeta(self->m_interior_meta, src_el_tp, ndim,
+                        self->m_nh_shape, self->m_src_stride);
+    dimvector buffer_strides(ndim);
+    for (intptr_t k = ndim - 1, stride = data_size; k >= 0; --k) {
+        buffer_strides[k] = stride;
+        stride *= data->nh_shape[k];
+    }
+    make_window_arrmeta(self->m_border_meta, src_el_tp, ndim,
+                        self->m_nh_shape, buffer_strides.get());
+
+    const char *child_arrmeta = self->m_interior_meta.get();
+    ckb_offset = window_af->instantiate(
+        window_af, ckb, ckb_offset, dst_el_tp, dst_el_arrmeta,
+        &self->m_interior_meta.get_type(), &child_arrmeta,
+        kernel_request_strided, ectx);
+    // Re-retrieve the self pointer, because it may be at a new memory location now
+    self = ckb->get_at<self_type>(root_ckb_offset);
+    self->m_border_offset = ckb_offset - root_ckb_offset;
+    child_arrmeta = self->m_border_meta.get();
+    return window_af->instantiate(
+        window_af, ckb, ckb_offset, dst_el_tp, dst_el_arrmeta,
+        &self->m_border_meta.get_type(), &child_arrmeta,
+        kernel_request_strided, ectx);
+}
+
+void dynd::make_stencil_arrfunc(arrfunc_type_data *out_af,
+                                const nd::arrfunc &window_op, intptr_t ndim,
+                                const intptr_t *nh_shape,
+                                const intptr_t *nh_offset,
+                                stencil_boundary_t boundary,
+                                const nd::array &constant)
+{
+    // Validate the input arrfunc
+    if (window_op.is_null()) {
+        throw invalid_argument("make_stencil_arrfunc() 'window_op' cannot be null");
+    }
+    const arrfunc_type_data *window_af = window_op.get();
+    if (window_af->get_param_count() != 1) {
+        stringstream ss;
+        ss << "To make a stencil arrfunc, an operation with one "
+              "argument is required, got " << window_af->func_proto;
+        throw invalid_argument(ss.str());
+    }
+    const ndt::type &window_src_tp = window_af->get_param_type(0);
+    if (ndim < 1 || window_src_tp.get_ndim() < ndim) {
+        stringstream ss;
+        ss << "To make a stencil arrfunc of " << ndim << " dimensions, an "
+              "operation which accepts that many dimensions is required, got "
+           << window_af->func_proto;
+        throw invalid_argument(ss.str());
+    }
+    for (intptr_t k = 0; k < ndim; ++k) {
+        if (nh_shape[k] < 1) {
+            stringstream ss;
+            ss << "make_stencil_arrfunc() neighborhood shape " << nh_shape[k]
+               << " in dimension " << k << " is not positive";
+            throw invalid_argument(ss.str());
+        }
+    }
+
+    ndt::type stencil_src_tp = window_src_tp.get_type_at_dimension(NULL, ndim);
+    ndt::type stencil_dst_tp = window_af->get_return_type();
+    for (intptr_t k = ndim - 1; k >= 0; --k) {
+        stringstream dimname;
+        dimname << "StencilDim" << k;
+        nd::string name(dimname.str());
+        stencil_src_tp = ndt::make_typevar_dim(name, stencil_src_tp);
+        stencil_dst_tp = ndt::make_typevar_dim(name, stencil_dst_tp);
+    }
+
+    // Create the data for the arrfunc
+    stencil_arrfunc_data *data = new stencil_arrfunc_data;
+    *out_af->get_data_as<stencil_arrfunc_data *>() = data;
+    out_af->free_func = &free_stencil_arrfunc_data;
+    out_af->func_proto = ndt::make_funcproto(stencil_src_tp, stencil_dst_tp);
+    out_af->resolve_dst_type = &resolve_stencil_dst_type;
+    out_af->resolve_dst_shape = &resolve_stencil_dst_shape;
+    out_af->instantiate = &instantiate_stencil;
+    data->ndim = ndim;
+    data->nh_shape.init(ndim, nh_shape);
+    data->nh_offset.init(ndim);
+    for (intptr_t k = 0; k < ndim; ++k) {
+        data->nh_offset[k] = nh_offset ? nh_offset[k] : 0;
+    }
+    data->boundary = boundary;
+    data->constant = constant;
+    data->window_op = window_op;
+}
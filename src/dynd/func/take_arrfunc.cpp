@@ -67,6 +67,11 @@ struct masked_take_ck : public kernels::expr_ck<masked_take_ck, 2> {
         // The child copy ckernel
         get_child_ckernel()->destroy();
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
 };
 
 /**
@@ -104,6 +109,11 @@ struct indexed_take_ck : public kernels::expr_ck<indexed_take_ck, 2> {
         // The child copy ckernel
         get_child_ckernel()->destroy();
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
 };
 } // anonymous namespace
 
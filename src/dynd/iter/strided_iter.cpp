@@ -0,0 +1,166 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <sstream>
+
+#include <dynd/iter/strided_iter.hpp>
+#include <dynd/shape_tools.hpp>
+#include <dynd/exceptions.hpp>
+
+using namespace std;
+using namespace dynd;
+
+iter::strided_iter::strided_iter(int nwrite, int nread, const nd::array *ops)
+    : m_noperands(nwrite + nread)
+{
+    std::vector<ndt::type> tp(m_noperands);
+    shortvector<const char *> arrmeta(m_noperands);
+    shortvector<char *> data(m_noperands);
+    for (int iop = 0; iop < m_noperands; ++iop) {
+        tp[iop] = ops[iop].get_type();
+        arrmeta[iop] = ops[iop].get_arrmeta();
+        if (iop < nwrite) {
+            data[iop] = ops[iop].get_readwrite_originptr();
+        } else {
+            data[iop] = const_cast<char *>(ops[iop].get_readonly_originptr());
+        }
+    }
+    init(m_noperands ? &tp[0] : NULL, arrmeta.get(), data.get(), nwrite);
+}
+
+iter::strided_iter::strided_iter(int nwrite, int nread, const ndt::type *tp,
+                                 const char *const *arrmeta,
+                                 char *const *data)
+    : m_noperands(nwrite + nread)
+{
+    init(tp, arrmeta, data, nwrite);
+}
+
+void iter::strided_iter::init(const ndt::type *tp, const char *const *arrmeta,
+                              char *const *data, int nwrite)
+{
+    int nop = m_noperands;
+    m_uniform_tp.resize(nop);
+    m_arrmeta.init(nop);
+    m_data.init(nop);
+
+    // Get the sizes and strides of all the operands
+    intptr_t ndim = 0;
+    shortvector<const size_stride_t *> op_ss(nop);
+    shortvector<intptr_t> op_ndim(nop);
+    for (int iop = 0; iop < nop; ++iop) {
+        op_ndim[iop] = tp[iop].get_ndim();
+        m_data[iop] = data[iop];
+        if (op_ndim[iop] == 0) {
+            op_ss[iop] = NULL;
+            m_uniform_tp[iop] = tp[iop];
+            m_arrmeta[iop] = arrmeta[iop];
+        } else if (!tp[iop].get_as_strided(arrmeta[iop], op_ndim[iop],
+                                           &op_ss[iop], &m_uniform_tp[iop],
+                                           &m_arrmeta[iop])) {
+            stringstream ss;
+            ss << "strided_iter requires strided dimensions, but operand ";
+            ss << iop << " has type " << tp[iop];
+            throw type_error(ss.str());
+        }
+        ndim = max(ndim, op_ndim[iop]);
+    }
+
+    // Broadcast the shapes together, with the write operands required
+    // to have the full shape
+    dimvector shape(ndim), op_shape(ndim);
+    for (intptr_t k = 0; k < ndim; ++k) {
+        shape[k] = 1;
+    }
+    for (int iop = 0; iop < nop; ++iop) {
+        for (intptr_t k = 0; k < op_ndim[iop]; ++k) {
+            op_shape[k] = op_ss[iop][k].dim_size;
+        }
+        incremental_broadcast(ndim, shape.get(), op_ndim[iop], op_shape.get());
+    }
+    for (int iop = 0; iop < nwrite; ++iop) {
+        bool matches = (op_ndim[iop] == ndim);
+        for (intptr_t k = 0; matches && k < ndim; ++k) {
+            op_shape[k] = op_ss[iop][k].dim_size;
+            matches = (op_shape[k] == shape[k]);
+        }
+        if (!matches) {
+            for (intptr_t k = 0; k < op_ndim[iop]; ++k) {
+                op_shape[k] = op_ss[iop][k].dim_size;
+            }
+            throw broadcast_error(ndim, shape.get(), op_ndim[iop],
+                                  op_shape.get());
+        }
+    }
+
+    // The strides of each operand, broadcast to the full shape
+    dimvector all_strides(nop * ndim), op_strides(ndim);
+    shortvector<const intptr_t *> operstrides(nop);
+    for (int iop = 0; iop < nop; ++iop) {
+        for (intptr_t k = 0; k < op_ndim[iop]; ++k) {
+            op_shape[k] = op_ss[iop][k].dim_size;
+            op_strides[k] = op_ss[iop][k].stride;
+        }
+        broadcast_to_shape(ndim, shape.get(), op_ndim[iop], op_shape.get(),
+                           op_strides.get(), all_strides.get() + iop * ndim);
+        operstrides[iop] = all_strides.get() + iop * ndim;
+    }
+
+    // Order the axes from the smallest strides to the largest
+    shortvector<int> axis_perm(ndim);
+    multistrides_to_axis_perm(ndim, nop, operstrides.get(), axis_perm.get());
+
+    // Fill in the dimensions in that order, dropping the ones of size
+    // one, and merging each one into the previous if it continues it
+    // for every operand
+    m_itersize = 1;
+    for (intptr_t k = 0; k < ndim; ++k) {
+        m_itersize *= shape[k];
+    }
+    intptr_t alloc_ndim = max(ndim, (intptr_t)1);
+    m_shape.init(alloc_ndim);
+    m_strides.init(alloc_ndim * nop);
+    m_index.init(alloc_ndim);
+    intptr_t n = 0;
+    if (m_itersize != 0) {
+        for (intptr_t k = 0; k < ndim; ++k) {
+            int axis = axis_perm[k];
+            intptr_t size = shape[axis];
+            if (size == 1) {
+                continue;
+            }
+            if (n > 0) {
+                const intptr_t *prev_strides = m_strides.get() + (n - 1) * nop;
+                bool can_coalesce = true;
+                for (int iop = 0; iop < nop && can_coalesce; ++iop) {
+                    can_coalesce = (operstrides[iop][axis] ==
+                                    prev_strides[iop] * m_shape[n - 1]);
+                }
+                if (can_coalesce) {
+                    m_shape[n - 1] *= size;
+                    continue;
+                }
+            }
+            m_shape[n] = size;
+            for (int iop = 0; iop < nop; ++iop) {
+                m_strides[n * nop + iop] = operstrides[iop][axis];
+            }
+            ++n;
+        }
+    }
+    if (n == 0) {
+        // A single inner loop, of one element, or none when empty
+        m_shape[0] = m_itersize;
+        for (int iop = 0; iop < nop; ++iop) {
+            m_strides[iop] = 0;
+        }
+        n = 1;
+    }
+    m_ndim = n;
+    for (intptr_t idim = 0; idim < n; ++idim) {
+        m_index[idim] = 0;
+    }
+}
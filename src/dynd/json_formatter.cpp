@@ -356,10 +356,11 @@ static void format_json(output_data& out, const ndt::type& dt, const char *arrme
   }
 }
 
-nd::array dynd::format_json(const nd::array& n, bool struct_as_list)
+static nd::array format_json_as(const nd::array& n, const ndt::type& result_tp,
+                                bool struct_as_list)
 {
-  // Create a UTF-8 string
-  nd::array result = nd::empty(ndt::make_string());
+  // Create a UTF-8 string, json_type shares string_type's layout
+  nd::array result = nd::empty(result_tp);
 
   // Initialize the output with some memory
   output_data out;
@@ -394,3 +395,13 @@ nd::array dynd::format_json(const nd::array& n, bool struct_as_list)
 
   return result;
 }
+
+nd::array dynd::format_json(const nd::array& n, bool struct_as_list)
+{
+  return format_json_as(n, ndt::make_string(), struct_as_list);
+}
+
+nd::array dynd::format_json_value(const nd::array& n, bool struct_as_list)
+{
+  return format_json_as(n, ndt::make_json(), struct_as_list);
+}
@@ -10,13 +10,18 @@
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/cfixed_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/base_dim_type.hpp>
 #include <dynd/types/cstruct_type.hpp>
 #include <dynd/types/date_type.hpp>
 #include <dynd/types/datetime_type.hpp>
 #include <dynd/types/time_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/bytes_type.hpp>
 #include <dynd/kernels/string_numeric_assignment_kernels.hpp>
+#include <dynd/memblock/concurrent_pod_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/parser_util.hpp>
+#include <dynd/parallel.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -98,13 +103,32 @@ nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json,
     return parse_json(tp, json_begin, json_end, ectx);
 }
 
-static void parse_json(const ndt::type &tp, const char *arrmeta,
+nd::array dynd::parse_json_lines(const ndt::type &tp, const nd::array &json,
+                                 const eval::eval_context *ectx)
+{
+    const char *json_begin = NULL, *json_end = NULL;
+    nd::array tmp_ref;
+    json_as_buffer(json, tmp_ref, json_begin, json_end);
+    return parse_json_lines(tp, json_begin, json_end, ectx);
+}
+
+namespace dynd { namespace detail {
+    struct json_parse_node;
+}} // namespace dynd::detail
+
+static void parse_json(detail::json_parse_node *node, const char *arrmeta,
                        char *out_data, const char *&json_begin,
                        const char *json_end, const eval::eval_context *ectx);
 
+static inline bool is_json_whitespace(char c)
+{
+    // The same characters as isspace in the C locale, without the call
+    return c == ' ' || ('\t' <= c && c <= '\r');
+}
+
 static const char *skip_whitespace(const char *begin, const char *end)
 {
-    while (begin < end && isspace(*begin)) {
+    while (begin < end && is_json_whitespace(*begin)) {
         ++begin;
     }
 
@@ -208,21 +232,177 @@ static void skip_json_value(const char *&begin, const char *end)
     }
 }
 
-static void parse_strided_dim_json(const ndt::type& tp, const char *arrmeta, char *out_data,
+namespace dynd { namespace detail {
+    enum json_parse_node_kind_t {
+        json_strided_dim_node,
+        json_var_dim_node,
+        json_struct_node,
+        json_bool_node,
+        json_number_node,
+        json_string_node,
+        // A UTF-8 string which points into the input when not escaped
+        json_string_ref_node,
+        json_datetime_node,
+        json_option_node,
+        json_jsonstring_node,
+        // Reported when the parse reaches a value of this type
+        json_unsupported_node
+    };
+
+    /**
+     * One node of a compiled JSON parse plan, holding everything about
+     * its type that the parser would otherwise look up per value.
+     */
+    struct json_parse_node {
+        json_parse_node_kind_t kind;
+        ndt::type tp;
+        // The element for dimensions, the fields for structs
+        vector<json_parse_node *> children;
+
+        // Struct field names, for checking the predicted field
+        vector<const char *> field_name_begins;
+        vector<intptr_t> field_name_sizes;
+        // The field which followed field i in the last object,
+        // next_field[field_count] is the field which came first
+        vector<intptr_t> next_field;
+        // Which fields have been seen in the current object, as the
+        // generation counter value when they were seen
+        vector<uint32_t> seen_generation;
+        uint32_t generation;
+
+        json_parse_node()
+            : generation(0)
+        {
+        }
+
+        ~json_parse_node() {
+            for (size_t i = 0; i < children.size(); ++i) {
+                delete children[i];
+            }
+        }
+    };
+}} // namespace dynd::detail
+
+using dynd::detail::json_parse_node;
+
+static json_parse_node *compile_json_parse_node(const ndt::type& tp,
+                                                json_string_policy_t string_policy)
+{
+    json_parse_node *node = new json_parse_node;
+    node->tp = tp;
+    try {
+        switch (tp.get_kind()) {
+            case dim_kind:
+                switch (tp.get_type_id()) {
+                    case fixed_dim_type_id:
+                    case cfixed_dim_type_id:
+                    case strided_dim_type_id:
+                        node->kind = detail::json_strided_dim_node;
+                        break;
+                    case var_dim_type_id:
+                        node->kind = detail::json_var_dim_node;
+                        break;
+                    default:
+                        node->kind = detail::json_unsupported_node;
+                        return node;
+                }
+                node->children.push_back(compile_json_parse_node(
+                    tp.tcast<base_dim_type>()->get_element_type(), string_policy));
+                return node;
+            case struct_kind: {
+                node->kind = detail::json_struct_node;
+                const base_struct_type *fsd = tp.tcast<base_struct_type>();
+                intptr_t field_count = fsd->get_field_count();
+                for (intptr_t i = 0; i < field_count; ++i) {
+                    const string_type_data& fn = fsd->get_field_name_raw(i);
+                    node->field_name_begins.push_back(fn.begin);
+                    node->field_name_sizes.push_back(fn.end - fn.begin);
+                    node->children.push_back(compile_json_parse_node(
+                        fsd->get_field_type(i), string_policy));
+                }
+                // Start by predicting the fields in the type's order
+                node->next_field.resize(field_count + 1);
+                for (intptr_t i = 0; i < field_count; ++i) {
+                    node->next_field[i] = i + 1;
+                }
+                node->next_field[field_count] = 0;
+                node->seen_generation.resize(field_count, 0);
+                return node;
+            }
+            case bool_kind:
+                node->kind = detail::json_bool_node;
+                return node;
+            case int_kind:
+            case uint_kind:
+            case real_kind:
+            case complex_kind:
+                node->kind = detail::json_number_node;
+                return node;
+            case string_kind:
+                if (string_policy == json_reference_strings &&
+                        tp.get_type_id() == string_type_id &&
+                        tp.tcast<string_type>()->get_encoding() == string_encoding_utf_8) {
+                    node->kind = detail::json_string_ref_node;
+                } else {
+                    node->kind = detail::json_string_node;
+                }
+                return node;
+            case datetime_kind:
+                node->kind = detail::json_datetime_node;
+                return node;
+            case option_kind:
+                node->kind = detail::json_option_node;
+                return node;
+            case dynamic_kind:
+                if (tp.get_type_id() == json_type_id) {
+                    node->kind = detail::json_jsonstring_node;
+                    return node;
+                }
+                break;
+            default:
+                break;
+        }
+    } catch(...) {
+        delete node;
+        throw;
+    }
+    node->kind = detail::json_unsupported_node;
+    return node;
+}
+
+/**
+ * Finds the field with the given name, checking the predicted field
+ * first. Returns -1 if there is no such field.
+ */
+static intptr_t lookup_json_field(const json_parse_node *node, intptr_t predicted,
+                                  const char *name_begin, const char *name_end)
+{
+    intptr_t size = name_end - name_begin;
+    if (predicted < (intptr_t)node->field_name_sizes.size() &&
+            node->field_name_sizes[predicted] == size &&
+            memcmp(node->field_name_begins[predicted], name_begin, size) == 0) {
+        return predicted;
+    }
+    return node->tp.tcast<base_struct_type>()->get_field_index(name_begin, name_end);
+}
+
+static void parse_strided_dim_json(json_parse_node *node, const char *arrmeta, char *out_data,
                 const char *&begin, const char *end, const eval::eval_context *ectx)
 {
+    const ndt::type& tp = node->tp;
     intptr_t dim_size, stride;
     ndt::type el_tp;
     const char *el_arrmeta;
     if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
         throw json_parse_error(begin, "expected a strided dimension", tp);
     }
+    json_parse_node *el_node = node->children[0];
 
     if (!parse_token(begin, end, "[")) {
         throw json_parse_error(begin, "expected list starting with '['", tp);
     }
     for (intptr_t i = 0; i < dim_size; ++i) {
-        parse_json(el_tp, el_arrmeta, out_data + i * stride, begin, end, ectx);
+        parse_json(el_node, el_arrmeta, out_data + i * stride, begin, end, ectx);
         if (i < dim_size-1 && !parse_token(begin, end, ",")) {
             throw json_parse_error(begin, "array is too short, expected ',' list item separator", tp);
         }
@@ -232,13 +412,15 @@ static void parse_strided_dim_json(const ndt::type& tp, const char *arrmeta, cha
     }
 }
 
-static void parse_var_dim_json(const ndt::type& tp, const char *arrmeta, char *out_data,
+static void parse_var_dim_json(json_parse_node *node, const char *arrmeta, char *out_data,
                 const char *&begin, const char *end, const eval::eval_context *ectx)
 {
+    const ndt::type& tp = node->tp;
     const var_dim_type *vad = tp.tcast<var_dim_type>();
     const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
     intptr_t stride = md->stride;
     const ndt::type& element_tp = vad->get_element_type();
+    json_parse_node *el_node = node->children[0];
 
     var_dim_type_data *out = reinterpret_cast<var_dim_type_data *>(out_data);
     char *out_end = NULL;
@@ -261,7 +443,7 @@ static void parse_var_dim_json(const ndt::type& tp, const char *arrmeta, char *o
             }
             ++size;
             out->size = size;
-            parse_json(element_tp, arrmeta + sizeof(var_dim_type_arrmeta),
+            parse_json(el_node, arrmeta + sizeof(var_dim_type_arrmeta),
                             out->begin + (size-1) * stride, begin, end, ectx);
             if (!parse_token(begin, end, ",")) {
                 break;
@@ -277,7 +459,7 @@ static void parse_var_dim_json(const ndt::type& tp, const char *arrmeta, char *o
     out->size = size;
 }
 
-static bool parse_struct_json_from_object(const ndt::type &tp,
+static bool parse_struct_json_from_object(json_parse_node *node,
                                           const char *arrmeta, char *out_data,
                                           const char *&begin, const char *end,
                                           const eval::eval_context *ectx)
@@ -287,14 +469,22 @@ static bool parse_struct_json_from_object(const ndt::type &tp,
         return false;
     }
 
+    const ndt::type& tp = node->tp;
     const base_struct_type *fsd = tp.tcast<base_struct_type>();
     intptr_t field_count = fsd->get_field_count();
     const size_t *data_offsets = fsd->get_data_offsets(arrmeta);
     const size_t *arrmeta_offsets = fsd->get_arrmeta_offsets_raw();
 
-    // Keep track of which fields we've seen
-    shortvector<bool> populated_fields(field_count);
-    memset(populated_fields.get(), 0, sizeof(bool) * field_count);
+    // Keep track of which fields we've seen, with a new generation
+    // per object instead of clearing flags
+    uint32_t generation = ++node->generation;
+    if (generation == 0) {
+        memset(&node->seen_generation[0], 0, sizeof(uint32_t) * field_count);
+        generation = node->generation = 1;
+    }
+    intptr_t populated_count = 0;
+    // The previous field, or field_count at the start of the object
+    intptr_t prev = field_count;
 
     // If it's not an empty object, start the loop parsing the elements
     if (!parse_token(begin, end, "}")) {
@@ -313,18 +503,25 @@ static bool parse_struct_json_from_object(const ndt::type &tp,
             if (escaped) {
                 string name;
                 parse::unescape_string(strbegin, strend, name);
-                i = fsd->get_field_index(name);
+                i = lookup_json_field(node, node->next_field[prev], name.data(),
+                                      name.data() + name.size());
             } else {
-                i = fsd->get_field_index(strbegin, strend);
+                i = lookup_json_field(node, node->next_field[prev], strbegin, strend);
             }
             if (i == -1) {
                 // TODO: Add an error policy to this parser of whether to throw an error
                 //       or not. For now, just throw away fields not in the destination.
                 skip_json_value(begin, end);
             } else {
-                parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i],
+                parse_json(node->children[i], arrmeta + arrmeta_offsets[i],
                            out_data + data_offsets[i], begin, end, ectx);
-                populated_fields[i] = true;
+                if (node->seen_generation[i] != generation) {
+                    node->seen_generation[i] = generation;
+                    ++populated_count;
+                }
+                // Predict the same key order for the next object
+                node->next_field[prev] = i;
+                prev = i;
             }
             if (!parse_token(begin, end, ",")) {
                 break;
@@ -335,20 +532,22 @@ static bool parse_struct_json_from_object(const ndt::type &tp,
         }
     }
 
-    for (intptr_t i = 0; i < field_count; ++i) {
-        if (!populated_fields[i]) {
-            stringstream ss;
-            ss << "object dict does not contain the field ";
-            print_escaped_utf8_string(ss, fsd->get_field_name(i));
-            ss << " as required by the data type";
-            throw json_parse_error(skip_whitespace(saved_begin, end), ss.str(), tp);
+    if (populated_count != field_count) {
+        for (intptr_t i = 0; i < field_count; ++i) {
+            if (node->seen_generation[i] != generation) {
+                stringstream ss;
+                ss << "object dict does not contain the field ";
+                print_escaped_utf8_string(ss, fsd->get_field_name(i));
+                ss << " as required by the data type";
+                throw json_parse_error(skip_whitespace(saved_begin, end), ss.str(), tp);
+            }
         }
     }
 
     return true;
 }
 
-static bool parse_struct_json_from_list(const ndt::type &tp,
+static bool parse_struct_json_from_list(json_parse_node *node,
                                         const char *arrmeta, char *out_data,
                                         const char *&begin, const char *end,
                                         const eval::eval_context *ectx)
@@ -357,6 +556,7 @@ static bool parse_struct_json_from_list(const ndt::type &tp,
         return false;
     }
 
+    const ndt::type& tp = node->tp;
     const base_struct_type *fsd = tp.tcast<base_struct_type>();
     intptr_t field_count = fsd->get_field_count();
     const size_t *data_offsets = fsd->get_data_offsets(arrmeta);
@@ -365,7 +565,7 @@ static bool parse_struct_json_from_list(const ndt::type &tp,
     // Loop through all the fields
     for (intptr_t i = 0; i != field_count; ++i) {
         begin = skip_whitespace(begin, end);
-        parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i],
+        parse_json(node->children[i], arrmeta + arrmeta_offsets[i],
                    out_data + data_offsets[i], begin, end, ectx);
         if (i != field_count - 1 && !parse_token(begin, end, ",")) {
             throw json_parse_error(begin, "expected list item separator ','",
@@ -380,15 +580,15 @@ static bool parse_struct_json_from_list(const ndt::type &tp,
     return true;
 }
 
-static void parse_struct_json(const ndt::type& tp, const char *arrmeta, char *out_data,
+static void parse_struct_json(json_parse_node *node, const char *arrmeta, char *out_data,
                 const char *&begin, const char *end, const eval::eval_context *ectx)
 {
-    if (parse_struct_json_from_object(tp, arrmeta, out_data, begin, end, ectx)) {
-    } else if (parse_struct_json_from_list(tp, arrmeta, out_data, begin, end, ectx)) {
+    if (parse_struct_json_from_object(node, arrmeta, out_data, begin, end, ectx)) {
+    } else if (parse_struct_json_from_list(node, arrmeta, out_data, begin, end, ectx)) {
     } else {
         throw json_parse_error(
             begin, "expected object dict starting with '{' or list with '['",
-            tp);
+            node->tp);
     }
 }
 
@@ -496,8 +696,12 @@ static void parse_jsonstring_json(const ndt::type &tp, const char *arrmeta,
     const char *saved_begin = skip_whitespace(begin, end);
     skip_json_value(begin, end);
     const base_string_type *bsd = tp.tcast<base_string_type>();
-    // The skipped JSON value gets copied verbatim into the json string
-    bsd->set_from_utf8_string(arrmeta, out_data, saved_begin, begin, ectx);
+    // The skipped JSON value gets copied verbatim into the json string,
+    // skipping it just validated it so the json type needn't again
+    eval::eval_context nocheck_ectx(*ectx);
+    nocheck_ectx.errmode = assign_error_nocheck;
+    bsd->set_from_utf8_string(arrmeta, out_data, saved_begin, begin,
+                              &nocheck_ectx);
 }
 
 static void parse_string_json(const ndt::type &tp, const char *arrmeta,
@@ -529,6 +733,59 @@ static void parse_string_json(const ndt::type &tp, const char *arrmeta,
     rbegin = begin;
 }
 
+/**
+ * Parses a string into a UTF-8 string_type, pointing it directly at the
+ * JSON input if it has no escapes. The caller is responsible for the
+ * string blockref keeping the input alive.
+ */
+static void parse_string_ref_json(const ndt::type &tp, const char *arrmeta,
+                                  char *out_data, const char *&rbegin,
+                                  const char *end, const eval::eval_context *ectx)
+{
+    const char *begin = rbegin;
+    begin = skip_whitespace(begin, end);
+    const char *strbegin, *strend;
+    bool escaped;
+    if (!parse::parse_doublequote_string_no_ws(begin, end, strbegin, strend,
+                                               escaped)) {
+        throw json_parse_error(begin, "expected a string", tp);
+    }
+    if (escaped) {
+        string val;
+        parse::unescape_string(strbegin, strend, val);
+        try {
+            tp.tcast<base_string_type>()->set_from_utf8_string(arrmeta, out_data,
+                                                               val, ectx);
+        } catch (const std::exception& e) {
+            throw json_parse_error(skip_whitespace(rbegin, begin), e.what(), tp);
+        }
+    } else {
+        if (ectx->errmode != assign_error_nocheck) {
+            // Validate the UTF-8 the copy would have validated, skipping
+            // the decoding for plain ASCII
+            const char *p = strbegin;
+            while (p != strend && (*p & 0x80) == 0) {
+                ++p;
+            }
+            if (p != strend) {
+                next_unicode_codepoint_t next_fn = get_next_unicode_codepoint_function(
+                    string_encoding_utf_8, ectx->errmode);
+                try {
+                    while (p < strend) {
+                        next_fn(p, strend);
+                    }
+                } catch (const std::exception& e) {
+                    throw json_parse_error(skip_whitespace(rbegin, begin), e.what(), tp);
+                }
+            }
+        }
+        string_type_data *d = reinterpret_cast<string_type_data *>(out_data);
+        d->begin = const_cast<char *>(strbegin);
+        d->end = const_cast<char *>(strend);
+    }
+    rbegin = begin;
+}
+
 static void parse_datetime_json(const ndt::type &tp, const char *arrmeta,
                                 char *out_data, const char *&rbegin,
                                 const char *end, bool option,
@@ -576,26 +833,6 @@ static void parse_datetime_json(const ndt::type &tp, const char *arrmeta,
     rbegin = begin;
 }
 
-static void parse_dim_json(const ndt::type& tp, const char *arrmeta, char *out_data,
-                const char *&begin, const char *end, const eval::eval_context *ectx)
-{
-    switch (tp.get_type_id()) {
-        case fixed_dim_type_id:
-        case cfixed_dim_type_id:
-        case strided_dim_type_id:
-            parse_strided_dim_json(tp, arrmeta, out_data, begin, end, ectx);
-            break;
-        case var_dim_type_id:
-            parse_var_dim_json(tp, arrmeta, out_data, begin, end, ectx);
-            break;
-        default: {
-            stringstream ss;
-            ss << "parse_json: unsupported dynd array type " << tp;
-            throw runtime_error(ss.str());
-        }
-    }
-}
-
 static void parse_option_json(const ndt::type &tp, const char *arrmeta,
                               char *out_data, const char *&begin,
                               const char *end, const eval::eval_context *ectx)
@@ -671,53 +908,57 @@ static void parse_option_json(const ndt::type &tp, const char *arrmeta,
     throw runtime_error(ss.str());
 }
 
-static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data,
+static void parse_json(json_parse_node *node, const char *arrmeta, char *out_data,
                        const char *&begin, const char *end,
                        const eval::eval_context *ectx)
 {
     begin = skip_whitespace(begin, end);
-    switch (tp.get_kind()) {
-        case dim_kind:
-            parse_dim_json(tp, arrmeta, out_data, begin, end, ectx);
+    switch (node->kind) {
+        case detail::json_strided_dim_node:
+            parse_strided_dim_json(node, arrmeta, out_data, begin, end, ectx);
+            return;
+        case detail::json_var_dim_node:
+            parse_var_dim_json(node, arrmeta, out_data, begin, end, ectx);
             return;
-        case struct_kind:
-            parse_struct_json(tp, arrmeta, out_data, begin, end, ectx);
+        case detail::json_struct_node:
+            parse_struct_json(node, arrmeta, out_data, begin, end, ectx);
             return;
-        case bool_kind:
-            parse_bool_json(tp, arrmeta, out_data, begin, end,
+        case detail::json_bool_node:
+            parse_bool_json(node->tp, arrmeta, out_data, begin, end,
                             false, ectx);
             return;
-        case int_kind:
-        case uint_kind:
-        case real_kind:
-        case complex_kind:
-            parse_number_json(tp, arrmeta, out_data, begin, end,
+        case detail::json_number_node:
+            parse_number_json(node->tp, arrmeta, out_data, begin, end,
                                false, ectx);
             return;
-        case string_kind:
-            parse_string_json(tp, arrmeta, out_data, begin, end, ectx);
+        case detail::json_string_node:
+            parse_string_json(node->tp, arrmeta, out_data, begin, end, ectx);
             return;
-        case datetime_kind:
-            parse_datetime_json(tp, arrmeta, out_data, begin, end,
+        case detail::json_string_ref_node:
+            parse_string_ref_json(node->tp, arrmeta, out_data, begin, end, ectx);
+            return;
+        case detail::json_datetime_node:
+            parse_datetime_json(node->tp, arrmeta, out_data, begin, end,
                                 false, ectx);
             return;
-        case option_kind:
-            parse_option_json(tp, arrmeta, out_data, begin, end, ectx);
+        case detail::json_option_node:
+            parse_option_json(node->tp, arrmeta, out_data, begin, end, ectx);
+            return;
+        case detail::json_jsonstring_node:
+            // The json type is a special string type that contains JSON directly
+            // Copy the JSON verbatim in this case.
+            parse_jsonstring_json(node->tp, arrmeta, out_data, begin, end, ectx);
             return;
-        case dynamic_kind:
-            if (tp.get_type_id() == json_type_id) {
-                // The json type is a special string type that contains JSON directly
-                // Copy the JSON verbatim in this case.
-                parse_jsonstring_json(tp, arrmeta, out_data, begin, end, ectx);
-                return;
-            }
-            break;
         default:
             break;
     }
 
     stringstream ss;
-    ss << "parse_json: unsupported dynd type " << tp;
+    if (node->tp.get_kind() == dim_kind) {
+        ss << "parse_json: unsupported dynd array type " << node->tp;
+    } else {
+        ss << "parse_json: unsupported dynd type " << node->tp;
+    }
     throw runtime_error(ss.str());
 }
 
@@ -808,50 +1049,384 @@ void dynd::validate_json(const char *json_begin, const char *json_end)
     }
 }
 
-void dynd::parse_json(nd::array &out, const char *json_begin,
-                      const char *json_end, const eval::eval_context *ectx)
+intptr_t dynd::validate_json_strings(const char *data, intptr_t stride,
+                                     intptr_t count)
+{
+    for (intptr_t i = 0; i < count; ++i, data += stride) {
+        const string_type_data *d =
+            reinterpret_cast<const string_type_data *>(data);
+        try {
+            const char *begin = d->begin, *end = d->end;
+            ::skip_json_value(begin, end);
+            if (skip_whitespace(begin, end) != end) {
+                return i;
+            }
+        } catch (const parse::parse_error&) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * Formats a parse error with the line and column of its position
+ * in the JSON buffer.
+ */
+static string format_json_parse_error(const char *json_begin, const char *json_end,
+                                      const parse::parse_error& e)
+{
+    stringstream ss;
+    string line_prev, line_cur;
+    int line, column;
+    get_error_line_column(json_begin, json_end, e.get_position(),
+                    line_prev, line_cur, line, column);
+    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+    const json_parse_error *jpe = dynamic_cast<const json_parse_error *>(&e);
+    if (jpe != NULL) {
+        ss << "DyND Type: " << jpe->get_type() << "\n";
+    }
+    ss << "Message: " << e.what() << "\n";
+    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
+    return ss.str();
+}
+
+json_parse_plan::json_parse_plan(const ndt::type& tp, json_string_policy_t string_policy)
+    : m_type(tp), m_string_policy(string_policy),
+      m_root(compile_json_parse_node(tp, string_policy))
 {
+}
+
+json_parse_plan::~json_parse_plan()
+{
+    delete m_root;
+}
+
+void json_parse_plan::parse(nd::array &out, const char *json_begin,
+                            const char *json_end, const eval::eval_context *ectx)
+{
+    if (out.get_type() != m_type) {
+        stringstream ss;
+        ss << "Cannot use a JSON parse plan for type " << m_type;
+        ss << " to parse into an array of type " << out.get_type();
+        throw type_error(ss.str());
+    }
     try {
         const char *begin = json_begin, *end = json_end;
-        ndt::type tp = out.get_type();
-        ::parse_json(tp, out.get_arrmeta(), out.get_readwrite_originptr(), begin, end, ectx);
+        ::parse_json(m_root, out.get_arrmeta(), out.get_readwrite_originptr(), begin, end, ectx);
         begin = skip_whitespace(begin, end);
         if (begin != end) {
-            throw json_parse_error(begin, "unexpected trailing JSON text", tp);
+            throw json_parse_error(begin, "unexpected trailing JSON text", m_type);
         }
-    } catch (const json_parse_error& e) {
-        stringstream ss;
-        string line_prev, line_cur;
-        int line, column;
-        get_error_line_column(json_begin, json_end, e.get_position(),
-                        line_prev, line_cur, line, column);
-        ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-        ss << "DyND Type: " << e.get_type() << "\n";
-        ss << "Message: " << e.what() << "\n";
-        print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-        throw invalid_argument(ss.str());
     } catch (const parse::parse_error& e) {
-        stringstream ss;
-        string line_prev, line_cur;
-        int line, column;
-        get_error_line_column(json_begin, json_end, e.get_position(),
-                        line_prev, line_cur, line, column);
-        ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-        ss << "Message: " << e.what() << "\n";
-        print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-        throw invalid_argument(ss.str());
+        throw invalid_argument(format_json_parse_error(json_begin, json_end, e));
     }
 }
 
+nd::array json_parse_plan::parse(const char *json_begin, const char *json_end,
+                                 const eval::eval_context *ectx)
+{
+    nd::array result;
+    result = nd::empty(m_type);
+    parse(result, json_begin, json_end, ectx);
+    if (!m_type.is_builtin()) {
+        m_type.extended()->arrmeta_finalize_buffers(result.get_arrmeta());
+    }
+    result.flag_as_immutable();
+    return result;
+}
+
+void dynd::parse_json(nd::array &out, const char *json_begin,
+                      const char *json_end, const eval::eval_context *ectx)
+{
+    json_parse_plan plan(out.get_type());
+    plan.parse(out, json_begin, json_end, ectx);
+}
+
 nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin,
                            const char *json_end, const eval::eval_context *ectx)
 {
-    nd::array result;
-    result = nd::empty(tp);
-    parse_json(result, json_begin, json_end, ectx);
+    json_parse_plan plan(tp);
+    return plan.parse(json_begin, json_end, ectx);
+}
+
+/**
+ * Called for each blockref in the arrmeta of the types the JSON parser
+ * supports, with the type which owns the blockref. Returns false if the
+ * blockref can't be handled.
+ */
+typedef bool (*json_blockref_visitor_t)(const ndt::type& tp, memory_block_data **blockref,
+                                        void *extra);
+
+static bool visit_json_blockrefs(const ndt::type& tp, char *arrmeta,
+                                 json_blockref_visitor_t visitor, void *extra)
+{
+    if (tp.get_arrmeta_size() == 0) {
+        return true;
+    }
+    switch (tp.get_type_id()) {
+        case string_type_id:
+        case json_type_id:
+        case bytes_type_id:
+            // These all have a blockref at the start of the arrmeta
+            return visitor(tp, &reinterpret_cast<string_type_arrmeta *>(arrmeta)->blockref,
+                           extra);
+        case var_dim_type_id:
+            return visitor(tp, &reinterpret_cast<var_dim_type_arrmeta *>(arrmeta)->blockref,
+                           extra) &&
+                   visit_json_blockrefs(tp.tcast<var_dim_type>()->get_element_type(),
+                                        arrmeta + sizeof(var_dim_type_arrmeta), visitor, extra);
+        case fixed_dim_type_id:
+        case cfixed_dim_type_id:
+        case strided_dim_type_id: {
+            intptr_t dim_size, stride;
+            ndt::type el_tp;
+            const char *el_arrmeta;
+            if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
+                return false;
+            }
+            return visit_json_blockrefs(el_tp, arrmeta + (el_arrmeta - arrmeta),
+                                        visitor, extra);
+        }
+        case cstruct_type_id:
+        case struct_type_id: {
+            const base_struct_type *fsd = tp.tcast<base_struct_type>();
+            const size_t *arrmeta_offsets = fsd->get_arrmeta_offsets_raw();
+            for (intptr_t i = 0, i_end = fsd->get_field_count(); i != i_end; ++i) {
+                if (!visit_json_blockrefs(fsd->get_field_type(i),
+                                arrmeta + arrmeta_offsets[i], visitor, extra)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case option_type_id:
+            return visit_json_blockrefs(tp.tcast<option_type>()->get_value_type(),
+                                        arrmeta, visitor, extra);
+        default:
+            return false;
+    }
+}
+
+static void replace_blockref(memory_block_data **blockref, memory_block_ptr new_blockref)
+{
+    if (*blockref != NULL) {
+        memory_block_decref(*blockref);
+    }
+    *blockref = new_blockref.release();
+}
+
+/**
+ * Replaces a blockref with a concurrent POD memory block, so multiple
+ * threads can parse into one array.
+ */
+static bool make_blockref_concurrent(const ndt::type& tp, memory_block_data **blockref,
+                                     void *DYND_UNUSED(extra))
+{
+    if (tp.get_type_id() == var_dim_type_id &&
+            (tp.tcast<var_dim_type>()->get_element_type().get_flags()&type_flag_destructor)) {
+        return false;
+    }
+    replace_blockref(blockref, make_concurrent_pod_memory_block());
+    return true;
+}
+
+/**
+ * Replaces the blockref of UTF-8 strings with a POD memory block which
+ * references the JSON input, so strings can point into the input.
+ */
+static bool make_blockref_reference_input(const ndt::type& tp, memory_block_data **blockref,
+                                          void *extra)
+{
+    if (tp.get_type_id() == string_type_id &&
+            tp.tcast<string_type>()->get_encoding() == string_encoding_utf_8) {
+        replace_blockref(blockref, make_pod_memory_block(
+                             *reinterpret_cast<const memory_block_ptr *>(extra)));
+    }
+    return true;
+}
+
+static inline bool is_blank_json_line(const char *begin, const char *end)
+{
+    return skip_whitespace(begin, end) == end;
+}
+
+static const char *next_json_line(const char *begin, const char *end)
+{
+    const char *nl = (const char *)memchr(begin, '\n', end - begin);
+    return nl != NULL ? nl + 1 : end;
+}
+
+namespace {
+    struct json_lines_chunk {
+        const char *begin, *end;
+        intptr_t record_offset, record_count;
+        // The first parse error in the chunk, if any
+        const char *error_position;
+        string error_message;
+    };
+
+    struct json_lines_data {
+        const char *json_begin, *json_end;
+        vector<json_lines_chunk> chunks;
+        ndt::type tp;
+        const char *el_arrmeta;
+        char *out_data;
+        intptr_t stride;
+        const eval::eval_context *ectx;
+    };
+
+    void count_json_lines_task(intptr_t task, void *data)
+    {
+        json_lines_chunk& chunk = reinterpret_cast<json_lines_data *>(data)->chunks[task];
+        intptr_t count = 0;
+        for (const char *line = chunk.begin; line != chunk.end;) {
+            const char *line_end = next_json_line(line, chunk.end);
+            if (!is_blank_json_line(line, line_end)) {
+                ++count;
+            }
+            line = line_end;
+        }
+        chunk.record_count = count;
+    }
+
+    void parse_json_lines_task(intptr_t task, void *data)
+    {
+        json_lines_data *jld = reinterpret_cast<json_lines_data *>(data);
+        json_lines_chunk& chunk = jld->chunks[task];
+        if (chunk.record_count == 0) {
+            return;
+        }
+        // Each thread needs its own plan for the key order predictions
+        json_parse_plan plan(jld->tp);
+        detail::json_parse_node *root = plan.get_root();
+        char *out_data = jld->out_data + chunk.record_offset * jld->stride;
+        const char *line = chunk.begin;
+        try {
+            while (line != chunk.end) {
+                const char *line_end = next_json_line(line, chunk.end);
+                const char *begin = skip_whitespace(line, line_end);
+                if (begin != line_end) {
+                    ::parse_json(root, jld->el_arrmeta, out_data, begin, line_end, jld->ectx);
+                    begin = skip_whitespace(begin, line_end);
+                    if (begin != line_end) {
+                        throw json_parse_error(begin, "unexpected trailing JSON text", jld->tp);
+                    }
+                    out_data += jld->stride;
+                }
+                line = line_end;
+            }
+        } catch (const parse::parse_error& e) {
+            chunk.error_position = e.get_position();
+            chunk.error_message = format_json_parse_error(jld->json_begin, jld->json_end, e);
+        }
+    }
+} // anonymous namespace
+
+nd::array dynd::parse_json_lines(const ndt::type &tp, const char *json_begin,
+                                 const char *json_end, const eval::eval_context *ectx)
+{
+    nd::array result = nd::empty(ndt::make_var_dim(tp));
+    char *el_arrmeta = result.get_arrmeta() + sizeof(var_dim_type_arrmeta);
+    intptr_t thread_count = parallel::get_thread_count(ectx);
+    if (thread_count > 1 &&
+            !visit_json_blockrefs(tp, el_arrmeta, &make_blockref_concurrent, NULL)) {
+        thread_count = 1;
+    }
+
+    // Split the input at line boundaries, into a few chunks per thread
+    // so uneven lines balance out, but no smaller than 64KB
+    json_lines_data jld;
+    jld.json_begin = json_begin;
+    jld.json_end = json_end;
+    intptr_t chunk_count = thread_count > 1 ? 4 * thread_count : 1;
+    intptr_t chunk_size = max((json_end - json_begin) / chunk_count, (intptr_t)65536);
+    for (const char *begin = json_begin; begin != json_end;) {
+        const char *end = json_end;
+        if (json_end - begin > chunk_size) {
+            end = next_json_line(begin + chunk_size, json_end);
+        }
+        json_lines_chunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunk.record_offset = 0;
+        chunk.record_count = 0;
+        chunk.error_position = NULL;
+        jld.chunks.push_back(chunk);
+        begin = end;
+    }
+    chunk_count = jld.chunks.size();
+
+    // Count the records of every chunk, to find where each goes
+    parallel::run_tasks(chunk_count, thread_count, &count_json_lines_task, &jld);
+    intptr_t record_count = 0;
+    for (intptr_t i = 0; i < chunk_count; ++i) {
+        jld.chunks[i].record_offset = record_count;
+        record_count += jld.chunks[i].record_count;
+    }
+
+    // Allocate all the records at once, and parse every chunk
+    // straight into its place
+    var_dim_type_arrmeta *md = reinterpret_cast<var_dim_type_arrmeta *>(result.get_arrmeta());
+    var_dim_type_data *out = reinterpret_cast<var_dim_type_data *>(result.get_readwrite_originptr());
+    char *out_end = NULL;
+    get_memory_block_pod_allocator_api(md->blockref)->allocate(md->blockref,
+                    record_count * md->stride, tp.get_data_alignment(), &out->begin, &out_end);
+    out->size = record_count;
+    jld.tp = tp;
+    jld.el_arrmeta = el_arrmeta;
+    jld.out_data = out->begin;
+    jld.stride = md->stride;
+    jld.ectx = ectx;
+    parallel::run_tasks(chunk_count, thread_count, &parse_json_lines_task, &jld);
+
+    // Report the error closest to the start
+    for (intptr_t i = 0; i < chunk_count; ++i) {
+        if (jld.chunks[i].error_position != NULL) {
+            throw invalid_argument(jld.chunks[i].error_message);
+        }
+    }
+
+    result.get_type().extended()->arrmeta_finalize_buffers(result.get_arrmeta());
+    result.flag_as_immutable();
+    return result;
+}
+
+nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json,
+                           json_string_policy_t string_policy,
+                           const eval::eval_context *ectx)
+{
+    if (string_policy == json_copy_strings) {
+        return parse_json(tp, json, ectx);
+    }
+    const char *json_begin = NULL, *json_end = NULL;
+    nd::array tmp_ref;
+    json_as_buffer(json, tmp_ref, json_begin, json_end);
+    // The memory block holding the JSON text, the blockref of the string
+    // or bytes if it has one
+    memory_block_ptr input_ref;
+    const ndt::type& json_tp = tmp_ref.get_type();
+    if (json_tp.get_arrmeta_size() > 0 &&
+            reinterpret_cast<const string_type_arrmeta *>(tmp_ref.get_arrmeta())->blockref != NULL) {
+        input_ref = reinterpret_cast<const string_type_arrmeta *>(tmp_ref.get_arrmeta())->blockref;
+    } else {
+        input_ref = tmp_ref.get_data_memblock();
+    }
+
+    nd::array result = nd::empty(tp);
+    if (!visit_json_blockrefs(tp, result.get_arrmeta(), &make_blockref_reference_input,
+                              &input_ref)) {
+        // A type the parser would reject anyway, let it report the error
+        return parse_json(tp, json_begin, json_end, ectx);
+    }
+    json_parse_plan plan(tp, json_reference_strings);
+    plan.parse(result, json_begin, json_end, ectx);
     if (!tp.is_builtin()) {
         tp.extended()->arrmeta_finalize_buffers(result.get_arrmeta());
     }
-    result.flag_as_immutable();
+    // The strings share memory with the input, so are only
+    // immutable if it is
+    if ((tmp_ref.get_access_flags()&nd::write_access_flag) == 0) {
+        result.flag_as_immutable();
+    }
     return result;
 }
@@ -5,6 +5,9 @@
 
 #include <dynd/type.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/ckernel_common_functions.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
+#include <dynd/kernels/float16_assignment_kernels.hpp>
 #include <dynd/shortvector.hpp>
 #include "single_assigner_builtin.hpp"
 
@@ -119,6 +122,8 @@ size_t dynd::make_assignment_kernel(
     const char *dst_arrmeta, const ndt::type &src_tp, const char *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx)
 {
+    kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernreq, "assign",
+                                        dst_tp, 1, &src_tp, ectx);
     if (dst_tp.is_builtin()) {
         if (src_tp.is_builtin()) {
             if (dst_tp.extended() == src_tp.extended()) {
@@ -351,6 +356,30 @@ namespace {
     };
     template<typename dst_type, typename src_type>
     struct multiple_assignment_builtin<dst_type, src_type, assign_error_nocheck> {
+        // The unit-stride loops, separate functions so the restrict
+        // qualifiers let the compiler vectorize them
+        DYND_CUDA_HOST_DEVICE static void contiguous_assign(
+                        dst_type *DYND_RESTRICT dst,
+                        const src_type *DYND_RESTRICT src, size_t count)
+        {
+            for (size_t i = 0; i != count; ++i) {
+                single_assigner_builtin<dst_type, src_type, assign_error_nocheck>::
+                    assign(dst + i, src + i);
+            }
+        }
+
+        DYND_CUDA_HOST_DEVICE static void broadcast_assign(
+                        dst_type *DYND_RESTRICT dst, const src_type *src,
+                        size_t count)
+        {
+            dst_type value;
+            single_assigner_builtin<dst_type, src_type, assign_error_nocheck>::
+                assign(&value, src);
+            for (size_t i = 0; i != count; ++i) {
+                dst[i] = value;
+            }
+        }
+
          DYND_CUDA_HOST_DEVICE static void strided_assign(
                         char *dst, intptr_t dst_stride,
                         const char *const *src, const intptr_t *src_stride,
@@ -358,6 +387,22 @@ namespace {
         {
             const char *src0 = src[0];
             intptr_t src0_stride = src_stride[0];
+            if (dst_stride == (intptr_t)sizeof(dst_type)) {
+                // Contiguous without overlap, or broadcasting a scalar
+                if (src0_stride == (intptr_t)sizeof(src_type) &&
+                        (dst + count * sizeof(dst_type) <= src0 ||
+                         src0 + count * sizeof(src_type) <= dst)) {
+                    contiguous_assign(reinterpret_cast<dst_type *>(dst),
+                                      reinterpret_cast<const src_type *>(src0),
+                                      count);
+                    return;
+                } else if (src0_stride == 0) {
+                    broadcast_assign(reinterpret_cast<dst_type *>(dst),
+                                     reinterpret_cast<const src_type *>(src0),
+                                     count);
+                    return;
+                }
+            }
             for (size_t i = 0; i != count; ++i) {
                 single_assigner_builtin<dst_type, src_type, assign_error_nocheck>::
                     assign(reinterpret_cast<dst_type *>(dst),
@@ -367,6 +412,49 @@ namespace {
             }
         }
     };
+
+#ifndef __CUDACC__
+    // The float16 <-> float32/float64 conversions go through the bulk
+    // routines, which use the F16C instructions when available
+#define DYND_FLOAT16_STRIDED_ASSIGN(dst_type, src_type, errmode, func) \
+    template<> \
+    struct multiple_assignment_builtin<dst_type, src_type, errmode> { \
+        static void strided_assign( \
+                        char *dst, intptr_t dst_stride, \
+                        const char *const *src, const intptr_t *src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(self)) \
+        { \
+            func(dst, dst_stride, src[0], src_stride[0], count); \
+        } \
+    };
+#define DYND_TO_FLOAT16_STRIDED_ASSIGN(src_type, errmode, func) \
+    template<> \
+    struct multiple_assignment_builtin<dynd_float16, src_type, errmode> { \
+        static void strided_assign( \
+                        char *dst, intptr_t dst_stride, \
+                        const char *const *src, const intptr_t *src_stride, \
+                        size_t count, ckernel_prefix *DYND_UNUSED(self)) \
+        { \
+            func(dst, dst_stride, src[0], src_stride[0], count, errmode); \
+        } \
+    };
+#define DYND_FLOAT16_ERROR_MODES(errmode) \
+    DYND_FLOAT16_STRIDED_ASSIGN(float, dynd_float16, errmode, \
+                                float16_to_float32_strided) \
+    DYND_FLOAT16_STRIDED_ASSIGN(double, dynd_float16, errmode, \
+                                float16_to_float64_strided) \
+    DYND_TO_FLOAT16_STRIDED_ASSIGN(float, errmode, float32_to_float16_strided) \
+    DYND_TO_FLOAT16_STRIDED_ASSIGN(double, errmode, float64_to_float16_strided)
+
+    DYND_FLOAT16_ERROR_MODES(assign_error_nocheck)
+    DYND_FLOAT16_ERROR_MODES(assign_error_overflow)
+    DYND_FLOAT16_ERROR_MODES(assign_error_fractional)
+    DYND_FLOAT16_ERROR_MODES(assign_error_inexact)
+
+#undef DYND_FLOAT16_ERROR_MODES
+#undef DYND_TO_FLOAT16_STRIDED_ASSIGN
+#undef DYND_FLOAT16_STRIDED_ASSIGN
+#endif // __CUDACC__
 } // anonymous namespace
 
 static expr_strided_t assign_table_strided_kernel[builtin_type_id_count-2][builtin_type_id_count-2][4] =
@@ -540,6 +628,11 @@ struct wrap_single_as_strided_ck {
   {
     self->destroy_child_ckernel(sizeof(self_type));
   }
+
+  static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+  {
+    dst->clone_child_ckernel(src, sizeof(self_type));
+  }
 };
 
 } // anonymous namespace
@@ -559,12 +652,14 @@ size_t dynd::make_kernreq_to_single_kernel_adapter(ckernel_builder *ckb,
       ckernel_prefix *e = ckb->alloc_ck<ckernel_prefix>(ckb_offset);
       e->set_function<expr_strided_t>(wrap_single_as_strided_fixedcount[nsrc]);
       e->destructor = &simple_wrapper_kernel_destruct;
+      e->clone = &kernels::clone_trivial_parent_ckernel;
       return ckb_offset;
     } else {
       wrap_single_as_strided_ck *e =
           ckb->alloc_ck<wrap_single_as_strided_ck>(ckb_offset);
       e->base.set_function<expr_strided_t>(&wrap_single_as_strided_ck::strided);
       e->base.destructor = &wrap_single_as_strided_ck::destruct;
+      e->base.clone = &wrap_single_as_strided_ck::clone;
       e->nsrc = nsrc;
       return ckb_offset;
     }
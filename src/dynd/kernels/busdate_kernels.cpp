@@ -0,0 +1,173 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/kernels/busdate_kernels.hpp>
+#include <dynd/kernels/expr_kernels.hpp>
+#include <dynd/types/date_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+struct busday_offset_ck : public kernels::expr_ck<busday_offset_ck, 2> {
+    const busdate_calendar *m_calendar;
+    busdate_roll_t m_roll;
+    // Holds the reference which keeps m_calendar alive
+    ndt::type m_busdate_tp;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        *reinterpret_cast<int32_t *>(dst) = m_calendar->offset(
+            *reinterpret_cast<const int32_t *>(src[0]),
+            *reinterpret_cast<const int64_t *>(src[1]), m_roll);
+    }
+
+    inline void strided(char *dst, intptr_t dst_stride,
+                        const char *const *src, const intptr_t *src_stride,
+                        size_t count)
+    {
+        const busdate_calendar *calendar = m_calendar;
+        busdate_roll_t roll = m_roll;
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+        for (size_t i = 0; i != count; ++i) {
+            *reinterpret_cast<int32_t *>(dst) = calendar->offset(
+                *reinterpret_cast<const int32_t *>(src0),
+                *reinterpret_cast<const int64_t *>(src1), roll);
+            dst += dst_stride;
+            src0 += src0_stride;
+            src1 += src1_stride;
+        }
+    }
+};
+
+struct busday_count_ck : public kernels::expr_ck<busday_count_ck, 2> {
+    const busdate_calendar *m_calendar;
+    // Holds the reference which keeps m_calendar alive
+    ndt::type m_busdate_tp;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        *reinterpret_cast<int64_t *>(dst) =
+            m_calendar->count(*reinterpret_cast<const int32_t *>(src[0]),
+                              *reinterpret_cast<const int32_t *>(src[1]));
+    }
+
+    inline void strided(char *dst, intptr_t dst_stride,
+                        const char *const *src, const intptr_t *src_stride,
+                        size_t count)
+    {
+        const busdate_calendar *calendar = m_calendar;
+        const char *src0 = src[0], *src1 = src[1];
+        intptr_t src0_stride = src_stride[0], src1_stride = src_stride[1];
+        for (size_t i = 0; i != count; ++i) {
+            *reinterpret_cast<int64_t *>(dst) =
+                calendar->count(*reinterpret_cast<const int32_t *>(src0),
+                                *reinterpret_cast<const int32_t *>(src1));
+            dst += dst_stride;
+            src0 += src0_stride;
+            src1 += src1_stride;
+        }
+    }
+};
+
+struct busday_arrfunc_data {
+    ndt::type busdate_tp;
+};
+
+static void free_busday_arrfunc_data(arrfunc_type_data *self_af) {
+    delete *self_af->get_data_as<busday_arrfunc_data *>();
+}
+
+inline void check_busday_types(const char *funcname, const ndt::type &dst_tp,
+                               const ndt::type *src_tp,
+                               const arrfunc_type_data *af_self)
+{
+    if (dst_tp != af_self->get_return_type() ||
+            src_tp[0] != af_self->get_param_type(0) ||
+            src_tp[1] != af_self->get_param_type(1)) {
+        stringstream ss;
+        ss << funcname << " arrfunc: expected types " << af_self->func_proto;
+        ss << ", got (" << src_tp[0] << ", " << src_tp[1] << ") -> " << dst_tp;
+        throw type_error(ss.str());
+    }
+}
+
+inline void check_busdate_type(const char *funcname,
+                               const ndt::type &busdate_tp)
+{
+    if (busdate_tp.get_type_id() != busdate_type_id) {
+        stringstream ss;
+        ss << "make_" << funcname << "_arrfunc: expected a busdate type, got ";
+        ss << busdate_tp;
+        throw type_error(ss.str());
+    }
+}
+} // anonymous namespace
+
+static intptr_t instantiate_busday_offset(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp,
+    const char *DYND_UNUSED(dst_arrmeta), const ndt::type *src_tp,
+    const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+    const eval::eval_context *DYND_UNUSED(ectx))
+{
+    check_busday_types("busday_offset", dst_tp, src_tp, af_self);
+    const ndt::type &busdate_tp =
+        (*af_self->get_data_as<busday_arrfunc_data *>())->busdate_tp;
+    const busdate_type *bd = static_cast<const busdate_type *>(
+        busdate_tp.extended());
+    busday_offset_ck *self =
+        busday_offset_ck::create_leaf(ckb, kernreq, ckb_offset);
+    self->m_calendar = &bd->get_calendar();
+    self->m_roll = bd->get_roll();
+    self->m_busdate_tp = busdate_tp;
+    return ckb_offset;
+}
+
+static intptr_t instantiate_busday_count(
+    const arrfunc_type_data *af_self, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp,
+    const char *DYND_UNUSED(dst_arrmeta), const ndt::type *src_tp,
+    const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+    const eval::eval_context *DYND_UNUSED(ectx))
+{
+    check_busday_types("busday_count", dst_tp, src_tp, af_self);
+    const ndt::type &busdate_tp =
+        (*af_self->get_data_as<busday_arrfunc_data *>())->busdate_tp;
+    busday_count_ck *self =
+        busday_count_ck::create_leaf(ckb, kernreq, ckb_offset);
+    self->m_calendar = &static_cast<const busdate_type *>(
+                            busdate_tp.extended())->get_calendar();
+    self->m_busdate_tp = busdate_tp;
+    return ckb_offset;
+}
+
+void kernels::make_busday_offset_arrfunc(arrfunc_type_data *out_af,
+                                         const ndt::type &busdate_tp)
+{
+    check_busdate_type("busday_offset", busdate_tp);
+    ndt::type param_types[2] = {ndt::make_date(), ndt::make_type<int64_t>()};
+    busday_arrfunc_data *data = new busday_arrfunc_data;
+    *out_af->get_data_as<busday_arrfunc_data *>() = data;
+    out_af->free_func = &free_busday_arrfunc_data;
+    out_af->func_proto = ndt::make_funcproto(param_types, ndt::make_date());
+    out_af->instantiate = &instantiate_busday_offset;
+    data->busdate_tp = busdate_tp;
+}
+
+void kernels::make_busday_count_arrfunc(arrfunc_type_data *out_af,
+                                        const ndt::type &busdate_tp)
+{
+    check_busdate_type("busday_count", busdate_tp);
+    ndt::type param_types[2] = {ndt::make_date(), ndt::make_date()};
+    busday_arrfunc_data *data = new busday_arrfunc_data;
+    *out_af->get_data_as<busday_arrfunc_data *>() = data;
+    out_af->free_func = &free_busday_arrfunc_data;
+    out_af->func_proto =
+        ndt::make_funcproto(param_types, ndt::make_type<int64_t>());
+    out_af->instantiate = &instantiate_busday_count;
+    data->busdate_tp = busdate_tp;
+}
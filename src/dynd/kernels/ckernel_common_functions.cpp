@@ -17,6 +17,12 @@ void kernels::destroy_trivial_parent_ckernel(ckernel_prefix *self)
     self->destroy_child_ckernel(sizeof(ckernel_prefix));
 }
 
+void kernels::clone_trivial_parent_ckernel(ckernel_prefix *dst,
+                                           const ckernel_prefix *src)
+{
+    dst->clone_child_ckernel(src, sizeof(ckernel_prefix));
+}
+
 namespace {
     struct constant_value_assignment_ck : public kernels::expr_ck<constant_value_assignment_ck, 0> {
         // Pointer to the array inside of `constant`
@@ -48,6 +54,11 @@ namespace {
             // Destroy the child ckernel
             get_child_ckernel()->destroy();
         }
+
+        inline void clone_children(const self_type *src)
+        {
+            get_child_ckernel()->clone_from(src->get_child_ckernel());
+        }
     };
 } // anonymous namespace
 
@@ -129,6 +140,7 @@ intptr_t kernels::wrap_binary_as_unary_reduction_ckernel(
   // kernel
   ckernel_prefix *ckp = ckb->alloc_ck<ckernel_prefix>(ckb_offset);
   ckp->destructor = &kernels::destroy_trivial_parent_ckernel;
+  ckp->clone = &kernels::clone_trivial_parent_ckernel;
   if (right_associative) {
     ckp->set_expr_function(
         kernreq,
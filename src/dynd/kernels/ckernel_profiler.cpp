@@ -0,0 +1,256 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#else
+#include <ctime>
+#endif
+
+#include <dynd/kernels/ckernel_profiler.hpp>
+
+using namespace std;
+using namespace dynd;
+
+/**
+ * Reads the cycle counter, or on platforms where we don't
+ * read it directly, a nanosecond clock.
+ */
+static inline uint64_t read_tick_counter()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+namespace {
+    /**
+     * The shim placed in front of a profiled ckernel, which forwards
+     * every call to it and records the call in its node.
+     */
+    struct profiling_shim_ck : public kernels::general_ck<profiling_shim_ck> {
+        ckernel_profiler::node *m_node;
+
+        inline void init_kernfunc(kernel_request_t kernreq)
+        {
+            if (kernreq == kernel_request_predicate) {
+                base.set_function<expr_predicate_t>(&profiling_shim_ck::predicate);
+            } else {
+                base.set_expr_function<profiling_shim_ck>(kernreq);
+            }
+        }
+
+        static void single(char *dst, const char *const *src,
+                           ckernel_prefix *rawself)
+        {
+            self_type *self = get_self(rawself);
+            ckernel_prefix *child = self->get_child_ckernel();
+            expr_single_t child_fn = child->get_function<expr_single_t>();
+            uint64_t start = read_tick_counter();
+            child_fn(dst, src, child);
+            uint64_t end = read_tick_counter();
+            ckernel_profiler::node *n = self->m_node;
+            ++n->calls;
+            ++n->elements;
+            n->ticks += end - start;
+        }
+
+        static void strided(char *dst, intptr_t dst_stride,
+                            const char *const *src, const intptr_t *src_stride,
+                            size_t count, ckernel_prefix *rawself)
+        {
+            self_type *self = get_self(rawself);
+            ckernel_prefix *child = self->get_child_ckernel();
+            expr_strided_t child_fn = child->get_function<expr_strided_t>();
+            uint64_t start = read_tick_counter();
+            child_fn(dst, dst_stride, src, src_stride, count, child);
+            uint64_t end = read_tick_counter();
+            ckernel_profiler::node *n = self->m_node;
+            ++n->calls;
+            n->elements += count;
+            n->ticks += end - start;
+        }
+
+        static int predicate(const char *const *src, ckernel_prefix *rawself)
+        {
+            self_type *self = get_self(rawself);
+            ckernel_prefix *child = self->get_child_ckernel();
+            expr_predicate_t child_fn = child->get_function<expr_predicate_t>();
+            uint64_t start = read_tick_counter();
+            int result = child_fn(src, child);
+            uint64_t end = read_tick_counter();
+            ckernel_profiler::node *n = self->m_node;
+            ++n->calls;
+            ++n->elements;
+            n->ticks += end - start;
+            return result;
+        }
+
+        inline void destruct_children()
+        {
+            get_child_ckernel()->destroy();
+        }
+
+        /**
+         * Replicas record into the same node, whose counters aren't
+         * synchronized, so profile with a single thread.
+         */
+        inline void clone_children(const self_type *src)
+        {
+            get_child_ckernel()->clone_from(src->get_child_ckernel());
+        }
+    };
+} // anonymous namespace
+
+void ckernel_profiler::reset_counts()
+{
+    for (deque<node>::iterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+        it->calls = 0;
+        it->elements = 0;
+        it->ticks = 0;
+    }
+}
+
+void ckernel_profiler::clear()
+{
+    if (!m_build_stack.empty()) {
+        throw runtime_error(
+            "cannot clear a ckernel_profiler while it is building ckernels");
+    }
+    m_nodes.clear();
+    m_roots.clear();
+}
+
+bool ckernel_profiler::begin_shim(ckernel_builder *ckb,
+                                  intptr_t &inout_ckb_offset,
+                                  kernel_request_t kernreq,
+                                  const std::string &label)
+{
+    if (kernreq != kernel_request_single &&
+            kernreq != kernel_request_strided &&
+            kernreq != kernel_request_predicate) {
+        return false;
+    }
+
+    node *parent = m_build_stack.empty() ? NULL : m_build_stack.back();
+    m_nodes.push_back(node());
+    node *n = &m_nodes.back();
+    n->label = label;
+    n->kernreq = kernreq;
+    n->calls = 0;
+    n->elements = 0;
+    n->ticks = 0;
+    n->parent = parent;
+    if (parent != NULL) {
+        parent->children.push_back(n);
+    } else {
+        m_roots.push_back(n);
+    }
+
+    profiling_shim_ck *self =
+        profiling_shim_ck::create(ckb, kernreq, inout_ckb_offset);
+    self->m_node = n;
+    m_build_stack.push_back(n);
+    return true;
+}
+
+void ckernel_profiler::end_shim()
+{
+    m_build_stack.pop_back();
+}
+
+static const char *kernreq_name(kernel_request_t kernreq)
+{
+    switch (kernreq) {
+        case kernel_request_single:
+            return "single";
+        case kernel_request_strided:
+            return "strided";
+        case kernel_request_predicate:
+            return "predicate";
+        default:
+            return "unknown";
+    }
+}
+
+static void print_node(std::ostream &o, const ckernel_profiler::node *n,
+                       int indent)
+{
+    uint64_t child_ticks = 0;
+    for (size_t i = 0; i < n->children.size(); ++i) {
+        child_ticks += n->children[i]->ticks;
+    }
+    // Children timed around a parent's call can slightly exceed it
+    uint64_t self_ticks = n->ticks > child_ticks ? n->ticks - child_ticks : 0;
+
+    stringstream ss;
+    ss << string(2 * indent, ' ') << n->label << " [" << kernreq_name(n->kernreq)
+       << "]";
+    o << left << setw(60) << ss.str() << right;
+    o << " calls=" << setw(10) << n->calls;
+    o << " elements=" << setw(12) << n->elements;
+    o << " ticks=" << setw(14) << n->ticks;
+    o << " self=" << setw(14) << self_ticks;
+    if (n->elements > 0) {
+        o << " ticks/element=" << fixed << setprecision(2)
+          << ((double)n->ticks / (double)n->elements);
+        o.unsetf(ios_base::floatfield);
+    }
+    o << "\n";
+
+    for (size_t i = 0; i < n->children.size(); ++i) {
+        print_node(o, n->children[i], indent + 1);
+    }
+}
+
+void ckernel_profiler::print(std::ostream &o) const
+{
+    for (size_t i = 0; i < m_roots.size(); ++i) {
+        print_node(o, m_roots[i], 0);
+    }
+}
+
+void kernels::ckernel_profile_scope::begin(ckernel_profiler *profiler,
+                                           ckernel_builder *ckb,
+                                           intptr_t &inout_ckb_offset,
+                                           kernel_request_t kernreq,
+                                           const char *label,
+                                           const ndt::type *dst_tp,
+                                           intptr_t src_count,
+                                           const ndt::type *src_tp)
+{
+    string full_label;
+    if (dst_tp != NULL) {
+        stringstream ss;
+        ss << label << " (";
+        for (intptr_t i = 0; i < src_count; ++i) {
+            if (i > 0) {
+                ss << ", ";
+            }
+            ss << src_tp[i];
+        }
+        ss << ") -> " << *dst_tp;
+        full_label = ss.str();
+    } else {
+        full_label = label;
+    }
+    if (profiler->begin_shim(ckb, inout_ckb_offset, kernreq, full_label)) {
+        m_profiler = profiler;
+    }
+}
@@ -5,6 +5,7 @@
 
 #include <dynd/type.hpp>
 #include <dynd/kernels/comparison_kernels.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
 #include "single_comparer_builtin.hpp"
 
 using namespace std;
@@ -18,6 +19,11 @@ size_t dynd::make_comparison_kernel(ckernel_builder *ckb, intptr_t ckb_offset,
                                     comparison_type_t comptype,
                                     const eval::eval_context *ectx)
 {
+    ndt::type src_dt[2] = {src0_dt, src1_dt};
+    kernels::ckernel_profile_scope prof(ckb, ckb_offset,
+                                        kernel_request_predicate, "compare",
+                                        ndt::make_type<dynd_bool>(), 2, src_dt,
+                                        ectx);
     if (src0_dt.is_builtin()) {
         if (src1_dt.is_builtin()) {
             return make_builtin_type_comparison_kernel(ckb, ckb_offset,
@@ -32,6 +32,17 @@ namespace {
             // TODO: properly distinguish "date" and "option[date]" with respect to NA support
             if (s == "NA") {
                 dts.set_to_na();
+            } else if (m_dst_datetime_tp.tcast<datetime_type>()
+                           ->get_timezone() != tz_abstract) {
+                // The type resolves the wall clock time or offset
+                // in the string against its time zone
+                eval::eval_context ectx;
+                ectx.errmode = m_errmode;
+                ectx.date_parse_order = m_date_parse_order;
+                ectx.century_window = m_century_window;
+                m_dst_datetime_tp.tcast<datetime_type>()->set_from_utf8_string(
+                    NULL, dst, s.data(), s.data() + s.size(), &ectx);
+                return;
             } else {
                 dts.set_from_str(s, m_date_parse_order, m_century_window);
             }
@@ -76,14 +87,20 @@ namespace {
 
         inline void single(char *dst, const char *src)
         {
+            const datetime_type *dt = m_src_datetime_tp.tcast<datetime_type>();
+            int64_t ticks = *reinterpret_cast<const int64_t *>(src), offset = 0;
+            if (dt->get_timezone() == tz_named && ticks != DYND_DATETIME_NA) {
+                offset = dt->get_tzinfo()->get_utc_offset(ticks);
+            }
             datetime_struct dts;
-            dts.set_from_ticks(*reinterpret_cast<const int64_t *>(src));
+            dts.set_from_ticks(ticks + offset);
             string s = dts.to_str();
             if (s.empty()) {
                 s = "NA";
-            } else if (m_src_datetime_tp.tcast<datetime_type>()
-                           ->get_timezone() == tz_utc) {
+            } else if (dt->get_timezone() == tz_utc) {
                 s += "Z";
+            } else if (dt->get_timezone() == tz_named) {
+                s += tz_offset_to_str(offset);
             }
             const base_string_type *bst = static_cast<const base_string_type *>(m_dst_string_tp.extended());
             bst->set_from_utf8_string(m_dst_arrmeta, dst, s, &m_ectx);
@@ -113,3 +130,89 @@ size_t dynd::make_datetime_to_string_assignment_kernel(
     return ckb_offset;
 }
 
+/////////////////////////////////////////
+// time zone conversions
+
+namespace {
+    struct datetime_utc_to_local_ck
+        : public kernels::unary_ck<datetime_utc_to_local_ck> {
+        const tz_info *m_tz;
+        // The UTC interval of the last value converted
+        tz_interval m_interval;
+
+        inline void single(char *dst, const char *src)
+        {
+            strided(dst, 0, src, 0, 1);
+        }
+
+        inline void strided(char *dst, intptr_t dst_stride, const char *src,
+                            intptr_t src_stride, size_t count)
+        {
+            tz_interval iv = m_interval;
+            for (size_t i = 0; i != count;
+                    ++i, dst += dst_stride, src += src_stride) {
+                int64_t ticks = *reinterpret_cast<const int64_t *>(src);
+                if (ticks != DYND_DATETIME_NA) {
+                    if (!iv.contains(ticks)) {
+                        m_tz->get_utc_interval(ticks, iv);
+                    }
+                    ticks += iv.offset;
+                }
+                *reinterpret_cast<int64_t *>(dst) = ticks;
+            }
+            m_interval = iv;
+        }
+    };
+
+    struct datetime_local_to_utc_ck
+        : public kernels::unary_ck<datetime_local_to_utc_ck> {
+        const tz_info *m_tz;
+        // The wall clock interval of the last value converted
+        tz_interval m_interval;
+
+        inline void single(char *dst, const char *src)
+        {
+            strided(dst, 0, src, 0, 1);
+        }
+
+        inline void strided(char *dst, intptr_t dst_stride, const char *src,
+                            intptr_t src_stride, size_t count)
+        {
+            tz_interval iv = m_interval;
+            for (size_t i = 0; i != count;
+                    ++i, dst += dst_stride, src += src_stride) {
+                int64_t ticks = *reinterpret_cast<const int64_t *>(src);
+                if (ticks != DYND_DATETIME_NA) {
+                    if (!iv.contains(ticks)) {
+                        m_tz->get_local_interval(ticks, iv);
+                    }
+                    ticks -= iv.offset;
+                }
+                *reinterpret_cast<int64_t *>(dst) = ticks;
+            }
+            m_interval = iv;
+        }
+    };
+} // anonymous namespace
+
+size_t dynd::make_datetime_utc_to_local_kernel(ckernel_builder *ckb,
+                                               intptr_t ckb_offset,
+                                               const tz_info *tz,
+                                               kernel_request_t kernreq)
+{
+    datetime_utc_to_local_ck *self =
+        datetime_utc_to_local_ck::create_leaf(ckb, kernreq, ckb_offset);
+    self->m_tz = tz;
+    return ckb_offset;
+}
+
+size_t dynd::make_datetime_local_to_utc_kernel(ckernel_builder *ckb,
+                                               intptr_t ckb_offset,
+                                               const tz_info *tz,
+                                               kernel_request_t kernreq)
+{
+    datetime_local_to_utc_ck *self =
+        datetime_local_to_utc_ck::create_leaf(ckb, kernreq, ckb_offset);
+    self->m_tz = tz;
+    return ckb_offset;
+}
@@ -62,6 +62,11 @@ struct strided_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 template <int N>
@@ -82,6 +87,7 @@ static size_t make_elwise_strided_dimension_expr_kernel_for_N(
       ckb->alloc_ck<strided_expr_kernel_extra<N> >(ckb_offset);
   e->base.template set_expr_function<strided_expr_kernel_extra<N> >(kernreq);
   e->base.destructor = strided_expr_kernel_extra<N>::destruct;
+  e->base.clone = strided_expr_kernel_extra<N>::clone;
   // The dst strided parameters
   if (!dst_tp.get_as_strided(dst_arrmeta, &e->size, &e->dst_stride,
                                  &dst_child_dt, &dst_child_arrmeta)) {
@@ -235,6 +241,11 @@ struct strided_or_var_to_strided_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 template <int N>
@@ -258,6 +269,7 @@ static size_t make_elwise_strided_or_var_to_strided_dimension_expr_kernel_for_N(
       strided_or_var_to_strided_expr_kernel_extra<N> >(kernreq);
   e->base.destructor =
       &strided_or_var_to_strided_expr_kernel_extra<N>::destruct;
+  e->base.clone = &strided_or_var_to_strided_expr_kernel_extra<N>::clone;
   // The dst strided parameters
   if (!dst_tp.get_as_strided(dst_arrmeta, &e->size, &e->dst_stride,
                              &dst_child_dt, &dst_child_arrmeta)) {
@@ -463,10 +475,75 @@ struct strided_or_var_to_var_expr_kernel_extra {
         opchild(modified_dst, modified_dst_stride, modified_src, modified_src_stride, dim_size, echild);
     }
 
+    /**
+     * When all the sources are var dims whose rows are back to back and
+     * of the same sizes, as they usually are, the values of all the rows
+     * go through one child call.
+     */
+    static bool strided_consecutive(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count, extra_type *e)
+    {
+        const char *src_values[N];
+        intptr_t total = 0;
+        for (int i = 0; i < N; ++i) {
+            if (!e->is_src_var[i]) {
+                return false;
+            }
+            var_dim_type_arrmeta src_md = {NULL, e->src_stride[i],
+                                           e->src_offset[i]};
+            char *values;
+            intptr_t src_total;
+            if (!ndt::var_dim_rows_consecutive(
+                    reinterpret_cast<const char *>(&src_md), src[i],
+                    src_stride[i], count, &values, &src_total)) {
+                return false;
+            }
+            if (i == 0) {
+                total = src_total;
+            } else if (src_total != total) {
+                return false;
+            } else {
+                // Rows of different sizes would broadcast
+                for (size_t j = 0; j != count; ++j) {
+                    if (reinterpret_cast<const var_dim_type_data *>(
+                                src[i] + j * src_stride[i])->size !=
+                            reinterpret_cast<const var_dim_type_data *>(
+                                src[0] + j * src_stride[0])->size) {
+                        return false;
+                    }
+                }
+            }
+            src_values[i] = values;
+        }
+        if (total == 0) {
+            return false;
+        }
+        var_dim_type_arrmeta dst_md = {e->dst_memblock, e->dst_stride,
+                                       e->dst_offset};
+        char *dst_values;
+        if (!ndt::var_dim_rows_make_consecutive(
+                reinterpret_cast<const char *>(&dst_md), dst, dst_stride,
+                count, e->dst_target_alignment, src[0], src_stride[0], total,
+                &dst_values)) {
+            return false;
+        }
+        ckernel_prefix *echild = e->base.get_child_ckernel(sizeof(extra_type));
+        expr_strided_t opchild = echild->get_function<expr_strided_t>();
+        opchild(dst_values, e->dst_stride, src_values, e->src_stride, total,
+                echild);
+        return true;
+    }
+
     static void strided(char *dst, intptr_t dst_stride,
                     const char * const *src, const intptr_t *src_stride,
                     size_t count, ckernel_prefix *extra)
     {
+        extra_type *e = reinterpret_cast<extra_type *>(extra);
+        if (count > 1 && dst_stride != 0 &&
+                strided_consecutive(dst, dst_stride, src, src_stride, count, e)) {
+            return;
+        }
         const char *src_loop[N];
         memcpy(src_loop, src, sizeof(src_loop));
         for (size_t i = 0; i != count; ++i) {
@@ -482,6 +559,11 @@ struct strided_or_var_to_var_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 template<int N>
@@ -503,6 +585,7 @@ static size_t make_elwise_strided_or_var_to_var_dimension_expr_kernel_for_N(
   e->base.template set_expr_function<strided_or_var_to_var_expr_kernel_extra<N> >(
       kernreq);
   e->base.destructor = &strided_or_var_to_var_expr_kernel_extra<N>::destruct;
+  e->base.clone = &strided_or_var_to_var_expr_kernel_extra<N>::clone;
   // The dst var parameters
   const var_dim_type *dst_vdd = dst_tp.tcast<var_dim_type>();
   const var_dim_type_arrmeta *dst_md =
@@ -6,6 +6,7 @@
 #include <algorithm>
 
 #include <dynd/type.hpp>
+#include <dynd/buffer_storage.hpp>
 #include <dynd/types/base_expr_type.hpp>
 #include <dynd/kernels/expression_assignment_kernels.hpp>
 
@@ -14,6 +15,20 @@ using namespace dynd;
 
 
 namespace {
+    /**
+     * Appends the element sizes of every stage along the expression
+     * chain of ``tp``, from its value type down to its storage type.
+     */
+    void append_chain_element_sizes(const ndt::type& tp, vector<intptr_t>& out_sizes)
+    {
+        ndt::type t = tp;
+        out_sizes.push_back(t.value_type().get_data_size());
+        while (t.get_kind() == expr_kind) {
+            t = t.tcast<base_expr_type>()->get_operand_type();
+            out_sizes.push_back(t.value_type().get_data_size());
+        }
+    }
+
     struct buffered_kernel_extra {
         typedef buffered_kernel_extra extra_type;
 
@@ -25,20 +40,31 @@ namespace {
         char *buffer_arrmeta;
         size_t buffer_data_offset, buffer_data_size;
         intptr_t buffer_stride;
+        // The number of elements processed per chunk
+        size_t chunk_size;
 
         // Initializes the type and arrmeta for the buffer
         // NOTE: This does NOT initialize the buffer_data_offset,
         //       just the buffer_data_size.
-        void init(const ndt::type& buffer_tp_, kernel_request_t kernreq) {
+        void init(const ndt::type& buffer_tp_, const ndt::type& dst_tp,
+                  const ndt::type& src_tp, kernel_request_t kernreq,
+                  const eval::eval_context *ectx) {
             size_t element_count = 1;
             switch (kernreq) {
                 case kernel_request_single:
                     base.set_function<expr_single_t>(&single);
                     break;
-                case kernel_request_strided:
+                case kernel_request_strided: {
                     base.set_function<expr_strided_t>(&strided);
-                    element_count = DYND_BUFFER_CHUNK_SIZE;
+                    // Size the chunks so that every buffered stage of the
+                    // whole chain, plus the src and dst elements, fits in cache
+                    vector<intptr_t> element_sizes;
+                    append_chain_element_sizes(dst_tp, element_sizes);
+                    append_chain_element_sizes(src_tp, element_sizes);
+                    element_count = get_buffer_chunk_size(
+                        element_sizes.size(), &element_sizes[0], ectx);
                     break;
+                }
                 default: {
                     stringstream ss;
                     ss << "buffered_kernel: unrecognized request " << (int)kernreq;
@@ -46,6 +72,7 @@ namespace {
                 }   
             }
             base.destructor = &destruct;
+            chunk_size = element_count;
             // The kernel data owns a reference in buffer_tp
             buffer_tp = ndt::type(buffer_tp_).release();
             if (!buffer_tp_.is_builtin()) {
@@ -109,6 +136,7 @@ namespace {
             char *buffer_arrmeta = e->buffer_arrmeta;
             char *buffer_data_ptr = eraw + e->buffer_data_offset;
             intptr_t buffer_stride = e->buffer_stride;
+            size_t buffer_chunk_size = e->chunk_size;
             echild_first = reinterpret_cast<ckernel_prefix *>(eraw + e->first_kernel_offset);
             echild_second = reinterpret_cast<ckernel_prefix *>(eraw + e->second_kernel_offset);
 
@@ -117,7 +145,7 @@ namespace {
             const char *src0 = src[0];
             intptr_t src0_stride = src_stride[0];
             while (count > 0) {
-                size_t chunk_size = min(count, (size_t)DYND_BUFFER_CHUNK_SIZE);
+                size_t chunk_size = min(count, buffer_chunk_size);
                 // If the type needs it, initialize the buffer data to zero
                 if (!is_builtin_type(buffer_tp) &&
                         (buffer_tp->get_flags() & type_flag_zeroinit) != 0) {
@@ -176,7 +204,7 @@ size_t dynd::make_expression_assignment_kernel(
                 const ndt::type& buffer_tp = static_cast<const base_expr_type *>(
                                     opdt.extended())->get_value_type();
                 buffered_kernel_extra *e = ckb->alloc_ck<buffered_kernel_extra>(ckb_offset);
-                e->init(buffer_tp, kernreq);
+                e->init(buffer_tp, dst_tp, src_tp, kernreq, ectx);
                 // Construct the first kernel (src -> buffer)
                 e->first_kernel_offset = ckb_offset - root_ckb_offset;
                 ckb_offset = dst_bed->make_value_to_operand_assignment_kernel(
@@ -211,7 +239,7 @@ size_t dynd::make_expression_assignment_kernel(
             }
             buffered_kernel_extra *e =
                 ckb->alloc_ck<buffered_kernel_extra>(ckb_offset);
-            e->init(buffer_tp, kernreq);
+            e->init(buffer_tp, dst_tp, src_tp, kernreq, ectx);
             // Construct the first kernel (src -> buffer)
             e->first_kernel_offset = ckb_offset - root_ckb_offset;
             ckb_offset = ::make_assignment_kernel(ckb, ckb_offset,
@@ -247,7 +275,7 @@ size_t dynd::make_expression_assignment_kernel(
                 const ndt::type& buffer_tp = static_cast<const base_expr_type *>(
                                 opdt.extended())->get_value_type();
                 buffered_kernel_extra *e = ckb->alloc_ck<buffered_kernel_extra>(ckb_offset);
-                e->init(buffer_tp, kernreq);
+                e->init(buffer_tp, dst_tp, src_tp, kernreq, ectx);
                 size_t buffer_data_size = e->buffer_data_size;
                 // Construct the first kernel (src -> buffer)
                 e->first_kernel_offset = ckb_offset - root_ckb_offset;
@@ -273,7 +301,7 @@ size_t dynd::make_expression_assignment_kernel(
             // to dst value type conversion
             const ndt::type& buffer_tp = src_tp.value_type();
             buffered_kernel_extra *e = ckb->alloc_ck<buffered_kernel_extra>(ckb_offset);
-            e->init(buffer_tp, kernreq);
+            e->init(buffer_tp, dst_tp, src_tp, kernreq, ectx);
             size_t buffer_data_size = e->buffer_data_size;
             // Construct the first kernel (src -> buffer)
             e->first_kernel_offset = ckb_offset - root_ckb_offset;
@@ -151,6 +151,9 @@ size_t dynd::make_expression_comparison_kernel(
         ckb_offset = make_assignment_kernel(
             ckb, ckb_offset, src0_dt.value_type(), e->buf[0].arrmeta,
             src0_dt, src0_arrmeta, kernel_request_single, ectx);
+        // The first kernel may have been a leaf, so make sure there is room
+        // for the next kernel's ckernel_prefix
+        ckb->ensure_capacity(ckb_offset);
         // Have to re-retrieve 'e', because creating another kernel may invalidate it
         e = ckb->get_at<buffered_kernel_extra>(root_ckb_offset);
     }
@@ -0,0 +1,345 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+
+#include <dynd/kernels/float16_assignment_kernels.hpp>
+#include <dynd/types/dynd_float16.hpp>
+
+// The F16C code is compiled with a per-function target, so the rest
+// of the library doesn't require the instructions
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__clang__) ||                                                     \
+     (defined(__GNUC__) &&                                                     \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+# define DYND_USE_F16C 1
+# define DYND_F16C_TARGET __attribute__((target("avx,f16c")))
+# include <immintrin.h>
+# include <cpuid.h>
+#elif defined(_MSC_VER) && _MSC_VER >= 1600 &&                                 \
+    (defined(_M_X64) || defined(_M_IX86))
+# define DYND_USE_F16C 1
+# define DYND_F16C_TARGET
+# include <immintrin.h>
+# include <intrin.h>
+#else
+# define DYND_USE_F16C 0
+#endif
+
+// The number of elements converted per block
+#define DYND_FLOAT16_BLOCK_SIZE 256
+// The smallest normal float16, values below it may lose bits
+#define DYND_FLOAT16_MIN_NORMAL (6.103515625e-05)
+
+using namespace std;
+using namespace dynd;
+
+#if DYND_USE_F16C
+
+static bool detect_f16c()
+{
+    unsigned int ecx;
+# if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    ecx = (unsigned int)regs[2];
+# else
+    unsigned int eax, ebx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+# endif
+    // F16C (bit 29), and AVX (bit 28) with OSXSAVE (bit 27)
+    const unsigned int needed = (1u << 29) | (1u << 28) | (1u << 27);
+    if ((ecx & needed) != needed) {
+        return false;
+    }
+    // The OS must save the XMM and YMM state
+# if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+# else
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    unsigned long long xcr0 = xcr0_lo;
+# endif
+    return (xcr0 & 6) == 6;
+}
+
+namespace {
+    // Contiguous conversions of up to DYND_FLOAT16_BLOCK_SIZE values,
+    // with the last partial vector going through a padded buffer
+
+    DYND_F16C_TARGET void hw_convert(float *dst, const uint16_t *src,
+                                     size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+        if (i < count) {
+            uint16_t htmp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            float ftmp[8];
+            std::copy(src + i, src + count, htmp);
+            __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(htmp));
+            _mm256_storeu_ps(ftmp, _mm256_cvtph_ps(h));
+            std::copy(ftmp, ftmp + (count - i), dst + i);
+        }
+    }
+
+    DYND_F16C_TARGET void hw_convert(double *dst, const uint16_t *src,
+                                     size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_cvtph_ps(h)));
+        }
+        if (i < count) {
+            uint16_t htmp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            double dtmp[4];
+            std::copy(src + i, src + count, htmp);
+            __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(htmp));
+            _mm256_storeu_pd(dtmp, _mm256_cvtps_pd(_mm_cvtph_ps(h)));
+            std::copy(dtmp, dtmp + (count - i), dst + i);
+        }
+    }
+
+    DYND_F16C_TARGET void hw_convert(uint16_t *dst, const float *src,
+                                     size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                        _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+        }
+        if (i < count) {
+            float ftmp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            uint16_t htmp[8];
+            std::copy(src + i, src + count, ftmp);
+            __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(ftmp),
+                                        _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(htmp), h);
+            std::copy(htmp, htmp + (count - i), dst + i);
+        }
+    }
+
+    /**
+     * There is no direct double to half instruction, so this goes
+     * through float. Rounding twice to nearest can differ from rounding
+     * once, so the first step rounds to odd instead, keeping a sticky
+     * bit which float has plenty of room for.
+     */
+    void hw_convert(uint16_t *dst, const double *src, size_t count)
+    {
+        float ftmp[DYND_FLOAT16_BLOCK_SIZE];
+        for (size_t i = 0; i != count; ++i) {
+            double d = src[i];
+            float f = static_cast<float>(d);
+            if (static_cast<double>(f) != d) {
+                // Truncate toward zero, then set the lowest bit
+                union { float f; uint32_t bits; } conv;
+                conv.f = f;
+                if ((f < 0 ? -f : f) > (d < 0 ? -d : d)) {
+                    --conv.bits;
+                }
+                conv.bits |= 1;
+                f = conv.f;
+            }
+            ftmp[i] = f;
+        }
+        hw_convert(dst, ftmp, count);
+    }
+} // anonymous namespace
+
+#endif // DYND_USE_F16C
+
+bool dynd::float16_has_hardware_conversion()
+{
+#if DYND_USE_F16C
+    // Racing first calls compute the same value, so no lock is needed
+    static int has_f16c = -1;
+    if (has_f16c < 0) {
+        has_f16c = detect_f16c() ? 1 : 0;
+    }
+    return has_f16c != 0;
+#else
+    return false;
+#endif
+}
+
+namespace {
+    inline uint16_t to_halfbits(float value, assign_error_mode errmode) {
+        return float_to_halfbits(value, errmode);
+    }
+    inline uint16_t to_halfbits(double value, assign_error_mode errmode) {
+        return double_to_halfbits(value, errmode);
+    }
+    inline void from_halfbits(uint16_t value, float &out) {
+        out = halfbits_to_float(value);
+    }
+    inline void from_halfbits(uint16_t value, double &out) {
+        out = halfbits_to_double(value);
+    }
+
+    /**
+     * Points ``out`` at ``count`` values of type T starting at ``src``,
+     * copying them into ``buf`` if they aren't contiguous.
+     */
+    template <class T>
+    inline const T *gather(const char *src, intptr_t src_stride, size_t count,
+                           T *buf)
+    {
+        if (src_stride == (intptr_t)sizeof(T)) {
+            return reinterpret_cast<const T *>(src);
+        }
+        for (size_t i = 0; i != count; ++i, src += src_stride) {
+            buf[i] = *reinterpret_cast<const T *>(src);
+        }
+        return buf;
+    }
+
+    template <class T>
+    inline void scatter(char *dst, intptr_t dst_stride, size_t count,
+                        const T *values)
+    {
+        if (dst == reinterpret_cast<const char *>(values)) {
+            return;
+        }
+        for (size_t i = 0; i != count; ++i, dst += dst_stride) {
+            *reinterpret_cast<T *>(dst) = values[i];
+        }
+    }
+
+    template <class T>
+    void from_float16_strided(char *dst, intptr_t dst_stride, const char *src,
+                              intptr_t src_stride, size_t count)
+    {
+#if DYND_USE_F16C
+        if (float16_has_hardware_conversion()) {
+            uint16_t hbuf[DYND_FLOAT16_BLOCK_SIZE];
+            T buf[DYND_FLOAT16_BLOCK_SIZE];
+            while (count > 0) {
+                size_t n = min(count, (size_t)DYND_FLOAT16_BLOCK_SIZE);
+                const uint16_t *h = gather(src, src_stride, n, hbuf);
+                T *out = (dst_stride == (intptr_t)sizeof(T))
+                             ? reinterpret_cast<T *>(dst)
+                             : buf;
+                hw_convert(out, h, n);
+                scatter(dst, dst_stride, n, out);
+                dst += n * dst_stride;
+                src += n * src_stride;
+                count -= n;
+            }
+            return;
+        }
+#endif
+        for (size_t i = 0; i != count;
+                ++i, dst += dst_stride, src += src_stride) {
+            from_halfbits(*reinterpret_cast<const uint16_t *>(src),
+                          *reinterpret_cast<T *>(dst));
+        }
+    }
+
+#if DYND_USE_F16C
+    /**
+     * Checks whether any of the ``count`` values in ``src`` would make
+     * float_to_halfbits/double_to_halfbits raise an error, given the
+     * hardware converted values ``h``. That is overflow to inf, or in
+     * inexact mode, losing bits below the smallest normal float16.
+     */
+    template <class T>
+    bool block_has_error(const T *src, const uint16_t *h, size_t count,
+                         assign_error_mode errmode)
+    {
+        bool error = false;
+        for (size_t i = 0; i != count; ++i) {
+            T x = src[i];
+            // x - x is 0 only for finite x
+            error |= ((h[i] & 0x7fffu) == 0x7c00u) && (x - x == 0);
+        }
+        if (!error && errmode >= assign_error_inexact) {
+            T back[DYND_FLOAT16_BLOCK_SIZE];
+            hw_convert(back, h, count);
+            for (size_t i = 0; i != count; ++i) {
+                T x = src[i];
+                error |= (x < (T)DYND_FLOAT16_MIN_NORMAL &&
+                          x > -(T)DYND_FLOAT16_MIN_NORMAL && back[i] != x);
+            }
+        }
+        return error;
+    }
+#endif
+
+    template <class T>
+    void to_float16_strided(char *dst, intptr_t dst_stride, const char *src,
+                            intptr_t src_stride, size_t count,
+                            assign_error_mode errmode)
+    {
+#if DYND_USE_F16C
+        if (float16_has_hardware_conversion()) {
+            T buf[DYND_FLOAT16_BLOCK_SIZE];
+            uint16_t hbuf[DYND_FLOAT16_BLOCK_SIZE];
+            while (count > 0) {
+                size_t n = min(count, (size_t)DYND_FLOAT16_BLOCK_SIZE);
+                const T *in = gather(src, src_stride, n, buf);
+                uint16_t *h = (dst_stride == (intptr_t)sizeof(uint16_t))
+                                  ? reinterpret_cast<uint16_t *>(dst)
+                                  : hbuf;
+                hw_convert(h, in, n);
+                if (errmode != assign_error_nocheck &&
+                        block_has_error(in, h, n, errmode)) {
+                    // Redo the block one value at a time, which raises
+                    // the error for the first offending value
+                    for (size_t i = 0; i != n; ++i) {
+                        h[i] = to_halfbits(in[i], errmode);
+                    }
+                }
+                scatter(dst, dst_stride, n, h);
+                dst += n * dst_stride;
+                src += n * src_stride;
+                count -= n;
+            }
+            return;
+        }
+#endif
+        for (size_t i = 0; i != count;
+                ++i, dst += dst_stride, src += src_stride) {
+            *reinterpret_cast<uint16_t *>(dst) =
+                to_halfbits(*reinterpret_cast<const T *>(src), errmode);
+        }
+    }
+} // anonymous namespace
+
+void dynd::float16_to_float32_strided(char *dst, intptr_t dst_stride,
+                                      const char *src, intptr_t src_stride,
+                                      size_t count)
+{
+    from_float16_strided<float>(dst, dst_stride, src, src_stride, count);
+}
+
+void dynd::float16_to_float64_strided(char *dst, intptr_t dst_stride,
+                                      const char *src, intptr_t src_stride,
+                                      size_t count)
+{
+    from_float16_strided<double>(dst, dst_stride, src, src_stride, count);
+}
+
+void dynd::float32_to_float16_strided(char *dst, intptr_t dst_stride,
+                                      const char *src, intptr_t src_stride,
+                                      size_t count, assign_error_mode errmode)
+{
+    to_float16_strided<float>(dst, dst_stride, src, src_stride, count,
+                              errmode);
+}
+
+void dynd::float64_to_float16_strided(char *dst, intptr_t dst_stride,
+                                      const char *src, intptr_t src_stride,
+                                      size_t count, assign_error_mode errmode)
+{
+    to_float16_strided<double>(dst, dst_stride, src, src_stride, count,
+                               errmode);
+}
@@ -5,6 +5,7 @@
 
 #include <dynd/kernels/make_lifted_ckernel.hpp>
 #include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/types/cfixed_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
@@ -65,6 +66,11 @@ struct strided_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 } // anonymous namespace
@@ -101,6 +107,7 @@ static size_t make_elwise_strided_dimension_expr_kernel_for_N(
   }
   }
   e->base.destructor = strided_expr_kernel_extra<N>::destruct;
+  e->base.clone = strided_expr_kernel_extra<N>::clone;
   if (!dst_tp.get_as_strided(dst_arrmeta, &e->size, &e->dst_stride,
                              &child_dst_tp, &child_dst_arrmeta)) {
     stringstream ss;
@@ -144,6 +151,9 @@ static size_t make_elwise_strided_dimension_expr_kernel_for_N(
         kernel_request_strided, ectx);
   }
   // Instantiate the elementwise handler
+  kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernel_request_strided,
+                                      "elwise", child_dst_tp, N, child_src_tp,
+                                      ectx);
   return elwise_handler->instantiate(
       elwise_handler, ckb, ckb_offset, child_dst_tp, child_dst_arrmeta,
       child_src_tp, child_src_arrmeta, kernel_request_strided, ectx);
@@ -256,6 +266,11 @@ struct strided_or_var_to_strided_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 } // anonymous namespace
@@ -294,6 +309,7 @@ static size_t make_elwise_strided_or_var_to_strided_dimension_expr_kernel_for_N(
   }
   }
   e->base.destructor = strided_or_var_to_strided_expr_kernel_extra<N>::destruct;
+  e->base.clone = strided_or_var_to_strided_expr_kernel_extra<N>::clone;
   if (!dst_tp.get_as_strided(dst_arrmeta, &e->size, &e->dst_stride,
                              &child_dst_tp, &child_dst_arrmeta)) {
     stringstream ss;
@@ -347,6 +363,9 @@ static size_t make_elwise_strided_or_var_to_strided_dimension_expr_kernel_for_N(
         kernel_request_strided, ectx);
   }
   // Instantiate the elementwise handler
+  kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernel_request_strided,
+                                      "elwise", child_dst_tp, N, child_src_tp,
+                                      ectx);
   return elwise_handler->instantiate(
       elwise_handler, ckb, ckb_offset, child_dst_tp, child_dst_arrmeta,
       child_src_tp, child_src_arrmeta, kernel_request_strided, ectx);
@@ -512,10 +531,75 @@ struct strided_or_var_to_var_expr_kernel_extra {
         opchild(modified_dst, modified_dst_stride, modified_src, modified_src_stride, dim_size, echild);
     }
 
+    /**
+     * When all the sources are var dims whose rows are back to back and
+     * of the same sizes, as they usually are, the values of all the rows
+     * go through one child call.
+     */
+    static bool strided_consecutive(char *dst, intptr_t dst_stride,
+                    const char * const *src, const intptr_t *src_stride,
+                    size_t count, extra_type *e)
+    {
+        const char *src_values[N];
+        intptr_t total = 0;
+        for (int i = 0; i < N; ++i) {
+            if (!e->is_src_var[i]) {
+                return false;
+            }
+            var_dim_type_arrmeta src_md = {NULL, e->src_stride[i],
+                                           e->src_offset[i]};
+            char *values;
+            intptr_t src_total;
+            if (!ndt::var_dim_rows_consecutive(
+                    reinterpret_cast<const char *>(&src_md), src[i],
+                    src_stride[i], count, &values, &src_total)) {
+                return false;
+            }
+            if (i == 0) {
+                total = src_total;
+            } else if (src_total != total) {
+                return false;
+            } else {
+                // Rows of different sizes would broadcast
+                for (size_t j = 0; j != count; ++j) {
+                    if (reinterpret_cast<const var_dim_type_data *>(
+                                src[i] + j * src_stride[i])->size !=
+                            reinterpret_cast<const var_dim_type_data *>(
+                                src[0] + j * src_stride[0])->size) {
+                        return false;
+                    }
+                }
+            }
+            src_values[i] = values;
+        }
+        if (total == 0) {
+            return false;
+        }
+        var_dim_type_arrmeta dst_md = {e->dst_memblock, e->dst_stride,
+                                       e->dst_offset};
+        char *dst_values;
+        if (!ndt::var_dim_rows_make_consecutive(
+                reinterpret_cast<const char *>(&dst_md), dst, dst_stride,
+                count, e->dst_target_alignment, src[0], src_stride[0], total,
+                &dst_values)) {
+            return false;
+        }
+        ckernel_prefix *echild = e->base.get_child_ckernel(sizeof(extra_type));
+        expr_strided_t opchild = echild->get_function<expr_strided_t>();
+        opchild(dst_values, e->dst_stride, src_values, e->src_stride, total,
+                echild);
+        return true;
+    }
+
     static void strided(char *dst, intptr_t dst_stride,
                     const char * const *src, const intptr_t *src_stride,
                     size_t count, ckernel_prefix *extra)
     {
+        extra_type *e = reinterpret_cast<extra_type *>(extra);
+        if (count > 1 && dst_stride != 0 &&
+                strided_consecutive(dst, dst_stride, src, src_stride, count, e)) {
+            return;
+        }
         const char *src_loop[N];
         memcpy(src_loop, src, sizeof(src_loop));
         for (size_t i = 0; i != count; ++i) {
@@ -531,6 +615,11 @@ struct strided_or_var_to_var_expr_kernel_extra {
     {
         self->destroy_child_ckernel(sizeof(extra_type));
     }
+
+    static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+    {
+        dst->clone_child_ckernel(src, sizeof(extra_type));
+    }
 };
 
 } // anonymous namespace
@@ -568,6 +657,7 @@ static size_t make_elwise_strided_or_var_to_var_dimension_expr_kernel_for_N(
   }
   }
   e->base.destructor = strided_or_var_to_var_expr_kernel_extra<N>::destruct;
+  e->base.clone = strided_or_var_to_var_expr_kernel_extra<N>::clone;
   // The dst var parameters
   const var_dim_type *dst_vdd = dst_tp.tcast<var_dim_type>();
   const var_dim_type_arrmeta *dst_md =
@@ -620,6 +710,9 @@ static size_t make_elwise_strided_or_var_to_var_dimension_expr_kernel_for_N(
         kernel_request_strided, ectx);
   }
   // All the types matched, so instantiate the elementwise handler
+  kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernel_request_strided,
+                                      "elwise", child_dst_tp, N, child_src_tp,
+                                      ectx);
   return elwise_handler->instantiate(
       elwise_handler, ckb, ckb_offset, child_dst_tp, child_dst_arrmeta,
       child_src_tp, child_src_arrmeta, kernel_request_strided, ectx);
@@ -672,6 +765,10 @@ size_t dynd::make_lifted_expr_ckernel(
 
 {
   intptr_t src_count = elwise_handler->get_param_count();
+  // Profile this dimension, or the elementwise ckernel if there are none
+  kernels::ckernel_profile_scope prof(ckb, ckb_offset, kernreq,
+                                      dst_ndim > 0 ? "lift" : "elwise", dst_tp,
+                                      src_count, src_tp, ectx);
 
   // Check if no lifting is required
   if (dst_ndim == 0) {
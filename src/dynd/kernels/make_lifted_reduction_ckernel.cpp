@@ -3,6 +3,8 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <vector>
+
 #include <dynd/kernels/make_lifted_reduction_ckernel.hpp>
 #include <dynd/kernels/ckernel_builder.hpp>
 #include <dynd/types/strided_dim_type.hpp>
@@ -10,10 +12,15 @@
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/kernels/expr_kernel_generator.hpp>
 #include <dynd/kernels/ckernel_common_functions.hpp>
+#include <dynd/kernels/expr_kernels.hpp>
+#include <dynd/parallel.hpp>
 
 using namespace std;
 using namespace dynd;
 
+// From this many elements on, accumulations are split across threads
+#define DYND_PARALLEL_SCAN_THRESHOLD (1 << 16)
+
 namespace {
 
 struct ckernel_reduction_prefix {
@@ -1153,3 +1160,469 @@ size_t dynd::make_lifted_reduction_ckernel(
                         "should have returned in the loop");
 }
  
+
+namespace {
+
+/**
+ * STRIDED BROADCAST DIMENSION BEFORE AN ACCUMULATION
+ * This ckernel handles one dimension outside of the dimension being
+ * accumulated, calling its child once with the whole dimension.
+ *
+ * Requirements:
+ *  - The child must be *strided*.
+ */
+struct strided_accumulation_broadcast_ck
+    : public kernels::expr_ck<strided_accumulation_broadcast_ck, 1> {
+    intptr_t m_size;
+    intptr_t m_dst_stride, m_src_stride;
+
+    inline void single(char *dst, const char *const *src)
+    {
+        ckernel_prefix *child = get_child_ckernel();
+        expr_strided_t child_fn = child->get_function<expr_strided_t>();
+        child_fn(dst, m_dst_stride, src, &m_src_stride, m_size, child);
+    }
+
+    inline void destruct_children()
+    {
+        get_child_ckernel()->destroy();
+    }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
+};
+
+/**
+ * STRIDED ACCUMULATION DIMENSION
+ * This ckernel computes the running reduction along one strided
+ * dimension, so that dst[i] is the reduction of src[0] through src[i].
+ * Each element is made by copying the previous accumulator value, then
+ * reducing the source value into it.
+ *
+ * When the accumulated elements are scalars, the children are the
+ * strided elwise reduction ckernel, followed by the single
+ * initialization ckernel at m_init_offset. When they have dimensions of
+ * their own, the first child is a lifted reduction ckernel which
+ * broadcasts over them, whose first call initializes and whose followup
+ * call reduces, and m_init_offset is 0. In both cases the single
+ * ckernel copying a dst element is at m_copy_offset.
+ *
+ * Large scalar accumulations with an associative and commutative
+ * reduction are done as a two pass parallel prefix. The blocks are
+ * accumulated independently, then the running total of the blocks
+ * before it is reduced into each block.
+ *
+ * NOTE: Child ckernels may keep state between calls, so each block
+ *       runs on its own replica of this ckernel, made with the clone
+ *       hook. That mode is only chosen for an associative and
+ *       commutative reduction of scalar POD accumulators, with src
+ *       and dst of the same type and no dst_initialization arrfunc,
+ *       so the accumulator copies are plain memcpy and the block
+ *       totals are reduced with the same elwise reduction ckernel as
+ *       the values. If the children can't be cloned, the scan runs on
+ *       one thread.
+ */
+struct strided_accumulation_ck
+    : public kernels::expr_ck<strided_accumulation_ck, 1> {
+    intptr_t m_size;
+    intptr_t m_dst_stride, m_src_stride;
+    size_t m_init_offset, m_copy_offset;
+    // If not NULL, each scan starts from this value
+    nd::array m_ident;
+    // The dst element size when it can be copied with memcpy, otherwise 0
+    size_t m_pod_size;
+    intptr_t m_thread_count;
+    // The size of this ckernel together with its children
+    size_t m_ckernel_size;
+
+    inline void init_value(char *dst, const char *src)
+    {
+        if (m_init_offset == 0) {
+            ckernel_prefix *child = get_child_ckernel();
+            child->get_function<expr_single_t>()(dst, &src, child);
+        } else {
+            ckernel_prefix *child = base.get_child_ckernel(m_init_offset);
+            expr_single_t child_fn = child->get_function<expr_single_t>();
+            if (m_ident.is_null()) {
+                child_fn(dst, &src, child);
+            } else {
+                const char *ident = m_ident.get_readonly_originptr();
+                child_fn(dst, &ident, child);
+                reduce(dst, 0, src, 0, 1);
+            }
+        }
+    }
+
+    inline void reduce(char *dst, intptr_t dst_stride, const char *src,
+                       intptr_t src_stride, size_t count)
+    {
+        ckernel_prefix *child = get_child_ckernel();
+        expr_strided_t child_fn;
+        if (m_init_offset == 0) {
+            child_fn = reinterpret_cast<ckernel_reduction_prefix *>(child)
+                           ->get_followup_call_function();
+        } else {
+            child_fn = child->get_function<expr_strided_t>();
+        }
+        child_fn(dst, dst_stride, &src, &src_stride, count, child);
+    }
+
+    inline void copy_value(char *dst, const char *src)
+    {
+        if (m_pod_size > 0) {
+            memcpy(dst, src, m_pod_size);
+        } else {
+            ckernel_prefix *child = base.get_child_ckernel(m_copy_offset);
+            child->get_function<expr_single_t>()(dst, &src, child);
+        }
+    }
+
+    void scan(char *dst, const char *src, intptr_t size)
+    {
+        if (size <= 0) {
+            return;
+        }
+        intptr_t dst_stride = m_dst_stride, src_stride = m_src_stride;
+        init_value(dst, src);
+        for (intptr_t i = 1; i < size; ++i) {
+            copy_value(dst + dst_stride, dst);
+            dst += dst_stride;
+            src += src_stride;
+            reduce(dst, 0, src, 0, 1);
+        }
+    }
+
+    struct parallel_scan_data {
+        // The ckernel each block runs on
+        vector<self_type *> blocks;
+        char *dst;
+        const char *src;
+        vector<intptr_t> bounds;
+        vector<char> carries;
+    };
+
+    static void scan_block_task(intptr_t b, void *data)
+    {
+        parallel_scan_data *d = reinterpret_cast<parallel_scan_data *>(data);
+        self_type *self = d->blocks[b];
+        intptr_t begin = d->bounds[b];
+        self->scan(d->dst + begin * self->m_dst_stride,
+                   d->src + begin * self->m_src_stride,
+                   d->bounds[b + 1] - begin);
+    }
+
+    static void fixup_block_task(intptr_t t, void *data)
+    {
+        parallel_scan_data *d = reinterpret_cast<parallel_scan_data *>(data);
+        // The first block is already final
+        intptr_t b = t + 1;
+        self_type *self = d->blocks[b];
+        intptr_t begin = d->bounds[b];
+        self->reduce(d->dst + begin * self->m_dst_stride, self->m_dst_stride,
+                     &d->carries[b * self->m_pod_size], 0,
+                     d->bounds[b + 1] - begin);
+    }
+
+    void parallel_scan(char *dst, const char *src)
+    {
+        intptr_t nblocks = m_thread_count;
+        size_t pod_size = m_pod_size;
+        // The first block runs on this ckernel, the others on replicas
+        vector<ckernel_builder> replicas(nblocks - 1);
+        parallel_scan_data d;
+        d.blocks.resize(nblocks);
+        d.blocks[0] = this;
+        try {
+            for (intptr_t b = 1; b < nblocks; ++b) {
+                replicas[b - 1].clone_from(&base, m_ckernel_size);
+                d.blocks[b] = replicas[b - 1].get_at<self_type>(0);
+            }
+        } catch (const runtime_error&) {
+            scan(dst, src, m_size);
+            return;
+        }
+        d.dst = dst;
+        d.src = src;
+        d.bounds.resize(nblocks + 1);
+        for (intptr_t b = 0; b <= nblocks; ++b) {
+            d.bounds[b] = m_size * b / nblocks;
+        }
+        // Accumulate each block on its own
+        parallel::run_tasks(nblocks, m_thread_count, &scan_block_task, &d);
+        // The total of all the blocks before each block
+        d.carries.resize(nblocks * pod_size);
+        for (intptr_t b = 1; b < nblocks; ++b) {
+            char *carry = &d.carries[b * pod_size];
+            const char *prev_last = dst + (d.bounds[b] - 1) * m_dst_stride;
+            if (b == 1) {
+                memcpy(carry, prev_last, pod_size);
+            } else {
+                memcpy(carry, carry - pod_size, pod_size);
+                reduce(carry, 0, prev_last, 0, 1);
+            }
+        }
+        // Reduce the totals into the blocks after the first
+        parallel::run_tasks(nblocks - 1, m_thread_count, &fixup_block_task,
+                            &d);
+    }
+
+    inline void single(char *dst, const char *const *src)
+    {
+        if (m_thread_count > 1 && m_size >= DYND_PARALLEL_SCAN_THRESHOLD) {
+            parallel_scan(dst, src[0]);
+        } else {
+            scan(dst, src[0], m_size);
+        }
+    }
+
+    inline void destruct_children()
+    {
+        // The reduction ckernel
+        get_child_ckernel()->destroy();
+        // The initialization ckernel
+        if (m_init_offset != 0) {
+            base.destroy_child_ckernel(m_init_offset);
+        }
+        // The copy ckernel
+        base.destroy_child_ckernel(m_copy_offset);
+    }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[3] = {sizeof(self_type), m_copy_offset,
+                                   m_init_offset};
+        base.clone_child_ckernels(&src->base, m_init_offset != 0 ? 3 : 2,
+                                  offsets);
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * Adds the ckernels for broadcasting a reduction over the dimensions
+ * inside of the one being accumulated, using the same ckernels as
+ * broadcast dimensions of a lifted reduction.
+ */
+static size_t make_accumulation_inner_broadcast_kernels(
+    const arrfunc_type_data *elwise_reduction,
+    const arrfunc_type_data *dst_initialization, ckernel_builder *ckb,
+    intptr_t ckb_offset, intptr_t inner_ndim, const ndt::type &dst_tp,
+    const char *dst_arrmeta, const ndt::type &src_tp, const char *src_arrmeta,
+    const nd::array &reduction_identity, const eval::eval_context *ectx)
+{
+    ndt::type dst_i_tp = dst_tp, src_i_tp = src_tp;
+    kernel_request_t kernreq = kernel_request_single;
+    for (intptr_t i = 0; i < inner_ndim; ++i) {
+        intptr_t dst_stride, dst_size, src_stride, src_size;
+        if (!src_i_tp.get_as_strided(src_arrmeta, &src_size, &src_stride,
+                                     &src_i_tp, &src_arrmeta)) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: type " << src_i_tp << " not supported as source";
+            throw type_error(ss.str());
+        }
+        if (!dst_i_tp.get_as_strided(dst_arrmeta, &dst_size, &dst_stride,
+                                     &dst_i_tp, &dst_arrmeta)) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: type " << dst_i_tp << " not supported as destination";
+            throw type_error(ss.str());
+        }
+        if (dst_size != src_size) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: the dst dimension size " << dst_size;
+            ss << " must equal the src dimension size " << src_size;
+            throw runtime_error(ss.str());
+        }
+        if (i < inner_ndim - 1) {
+            ckb_offset = make_strided_initial_broadcast_dimension_kernel(
+                ckb, ckb_offset, dst_stride, src_stride, src_size, kernreq);
+            kernreq = kernel_request_strided;
+        } else {
+            return make_strided_inner_broadcast_dimension_kernel(
+                elwise_reduction, dst_initialization, ckb, ckb_offset,
+                dst_stride, src_stride, src_size, dst_i_tp, dst_arrmeta,
+                src_i_tp, src_arrmeta, false, reduction_identity, kernreq,
+                ectx);
+        }
+    }
+    return ckb_offset;
+}
+
+size_t dynd::make_lifted_accumulation_ckernel(
+    const arrfunc_type_data *elwise_reduction,
+    const arrfunc_type_data *dst_initialization, dynd::ckernel_builder *ckb,
+    intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    const ndt::type &src_tp, const char *src_arrmeta, intptr_t reduction_ndim,
+    const bool *reduction_dimflags, bool associative, bool commutative,
+    bool right_associative, const nd::array &reduction_identity,
+    dynd::kernel_request_t kernreq, const eval::eval_context *ectx)
+{
+    // Find the dimension being accumulated
+    intptr_t axis = -1;
+    for (intptr_t i = 0; i < reduction_ndim; ++i) {
+        if (reduction_dimflags[i]) {
+            if (axis != -1) {
+                throw invalid_argument("make_lifted_accumulation_ckernel: only one"
+                                       " dimension may be flagged for accumulation");
+            }
+            axis = i;
+        }
+    }
+    if (axis == -1) {
+        throw invalid_argument("make_lifted_accumulation_ckernel: no dimension was"
+                               " flagged for accumulation");
+    }
+    if (right_associative) {
+        throw runtime_error("make_lifted_accumulation_ckernel: right_associative is not yet supported");
+    }
+    // Cannot have both a dst_initialization kernel and a reduction identity
+    if (dst_initialization != NULL && !reduction_identity.is_null()) {
+        throw invalid_argument(
+            "make_lifted_accumulation_ckernel: cannot specify"
+            " both a dst_initialization kernel and a reduction_identity");
+    }
+
+    ndt::type dst_el_tp = elwise_reduction->get_return_type();
+    ndt::type src_el_tp = elwise_reduction->get_param_type(0);
+    if (reduction_ndim != src_tp.get_ndim() - src_el_tp.get_ndim() ||
+            reduction_ndim != dst_tp.get_ndim() - dst_el_tp.get_ndim()) {
+        stringstream ss;
+        ss << "make_lifted_accumulation_ckernel: wrong number of accumulation dimensions, ";
+        ss << "requested " << reduction_ndim << ", but types have ";
+        ss << (src_tp.get_ndim() - src_el_tp.get_ndim()) << " and ";
+        ss << (dst_tp.get_ndim() - dst_el_tp.get_ndim());
+        throw runtime_error(ss.str());
+    }
+
+    ndt::type dst_i_tp = dst_tp, src_i_tp = src_tp;
+    for (intptr_t i = 0; i <= axis; ++i) {
+        intptr_t dst_stride, dst_size, src_stride, src_size;
+        if (!src_i_tp.get_as_strided(src_arrmeta, &src_size, &src_stride,
+                                     &src_i_tp, &src_arrmeta)) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: type " << src_i_tp << " not supported as source";
+            throw type_error(ss.str());
+        }
+        if (!dst_i_tp.get_as_strided(dst_arrmeta, &dst_size, &dst_stride,
+                                     &dst_i_tp, &dst_arrmeta)) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: type " << dst_i_tp << " not supported as destination";
+            throw type_error(ss.str());
+        }
+        if (dst_size != src_size) {
+            stringstream ss;
+            ss << "make_lifted_accumulation_ckernel: the dst dimension size " << dst_size;
+            ss << " must equal the src dimension size " << src_size;
+            throw runtime_error(ss.str());
+        }
+        if (i < axis) {
+            // A dimension outside the accumulation is broadcast
+            strided_accumulation_broadcast_ck *self =
+                strided_accumulation_broadcast_ck::create(ckb, kernreq,
+                                                          ckb_offset);
+            self->m_size = src_size;
+            self->m_dst_stride = dst_stride;
+            self->m_src_stride = src_stride;
+            kernreq = kernel_request_strided;
+            continue;
+        }
+
+        // The dimension being accumulated
+        typedef strided_accumulation_ck self_type;
+        intptr_t root_ckb_offset = ckb_offset;
+        self_type *self = self_type::create(ckb, kernreq, ckb_offset);
+        self->m_size = src_size;
+        self->m_dst_stride = dst_stride;
+        self->m_src_stride = src_stride;
+        self->m_init_offset = 0;
+        self->m_thread_count = 1;
+        intptr_t inner_ndim = reduction_ndim - axis - 1;
+        if (inner_ndim > 0) {
+            ckb_offset = make_accumulation_inner_broadcast_kernels(
+                elwise_reduction, dst_initialization, ckb, ckb_offset,
+                inner_ndim, dst_i_tp, dst_arrmeta, src_i_tp, src_arrmeta,
+                reduction_identity, ectx);
+        } else {
+            if (elwise_reduction->get_param_count() != 1 &&
+                    elwise_reduction->get_param_count() != 2) {
+                stringstream ss;
+                ss << "make_lifted_accumulation_ckernel: elwise reduction ckernel ";
+                ss << "funcproto must be unary or a binary expr with all equal types";
+                throw runtime_error(ss.str());
+            }
+            if (dst_initialization != NULL) {
+                check_dst_initialization(dst_initialization, dst_el_tp, src_el_tp);
+            }
+            if (elwise_reduction->get_param_count() == 2) {
+                ckb_offset = kernels::wrap_binary_as_unary_reduction_ckernel(
+                    ckb, ckb_offset, false, kernel_request_strided);
+                ndt::type src_tp_doubled[2] = {src_i_tp, src_i_tp};
+                const char *src_arrmeta_doubled[2] = {src_arrmeta, src_arrmeta};
+                ckb_offset = elwise_reduction->instantiate(
+                    elwise_reduction, ckb, ckb_offset, dst_i_tp, dst_arrmeta,
+                    src_tp_doubled, src_arrmeta_doubled, kernel_request_strided,
+                    ectx);
+            } else {
+                ckb_offset = elwise_reduction->instantiate(
+                    elwise_reduction, ckb, ckb_offset, dst_i_tp, dst_arrmeta,
+                    &src_i_tp, &src_arrmeta, kernel_request_strided, ectx);
+            }
+            // Make sure there's capacity for the next ckernel
+            ckb->ensure_capacity(ckb_offset);
+            // Need to retrieve 'self' again because it may have moved
+            self = ckb->get_at<self_type>(root_ckb_offset);
+            self->m_init_offset = ckb_offset - root_ckb_offset;
+            if (dst_initialization != NULL) {
+                ckb_offset = dst_initialization->instantiate(
+                    dst_initialization, ckb, ckb_offset, dst_i_tp, dst_arrmeta,
+                    &src_i_tp, &src_arrmeta, kernel_request_single, ectx);
+            } else if (reduction_identity.is_null()) {
+                ckb_offset = make_assignment_kernel(
+                    ckb, ckb_offset, dst_i_tp, dst_arrmeta, src_i_tp,
+                    src_arrmeta, kernel_request_single, ectx);
+            } else {
+                if (reduction_identity.get_type() != dst_i_tp) {
+                    stringstream ss;
+                    ss << "make_lifted_accumulation_ckernel: reduction identity type ";
+                    ss << reduction_identity.get_type() << " does not match dst type ";
+                    ss << dst_i_tp;
+                    throw runtime_error(ss.str());
+                }
+                ckb_offset = make_assignment_kernel(
+                    ckb, ckb_offset, dst_i_tp, dst_arrmeta,
+                    reduction_identity.get_type(),
+                    reduction_identity.get_arrmeta(), kernel_request_single,
+                    ectx);
+                self = ckb->get_at<self_type>(root_ckb_offset);
+                self->m_ident = reduction_identity;
+            }
+        }
+        // The ckernel copying the previous accumulator value
+        ckb->ensure_capacity(ckb_offset);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_copy_offset = ckb_offset - root_ckb_offset;
+        ckb_offset = make_assignment_kernel(ckb, ckb_offset, dst_i_tp,
+                                            dst_arrmeta, dst_i_tp, dst_arrmeta,
+                                            kernel_request_single, ectx);
+        self = ckb->get_at<self_type>(root_ckb_offset);
+        self->m_ckernel_size = ckb_offset - root_ckb_offset;
+        if (dst_i_tp.is_pod() && dst_i_tp.get_arrmeta_size() == 0) {
+            self->m_pod_size = dst_i_tp.get_data_size();
+        } else {
+            self->m_pod_size = 0;
+        }
+        // The two pass parallel prefix combines block totals with the
+        // reduction, so needs it to be associative and commutative, and
+        // to reduce values of the accumulator type
+        if (inner_ndim == 0 && self->m_pod_size > 0 && associative &&
+                commutative && dst_initialization == NULL &&
+                src_i_tp == dst_i_tp) {
+            self->m_thread_count = parallel::get_thread_count(ectx);
+        }
+        return ckb_offset;
+    }
+
+    throw runtime_error("make_lifted_accumulation_ckernel: internal error, "
+                        "should have returned in the loop");
+}
@@ -123,6 +123,13 @@ struct option_to_option_ck
         // value_assign
         base.destroy_child_ckernel(m_value_assign_offset);
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[3] = {sizeof(self_type), m_dst_assign_na_offset,
+                                   m_value_assign_offset};
+        base.clone_child_ckernels(&src->base, 3, offsets);
+    }
 };
 
 /**
@@ -189,6 +196,12 @@ struct option_to_value_ck
         // value_assign
         base.destroy_child_ckernel(m_value_assign_offset);
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[2] = {sizeof(self_type), m_value_assign_offset};
+        base.clone_child_ckernels(&src->base, 2, offsets);
+    }
 };
 
 } // anonymous namespace
@@ -321,6 +334,13 @@ struct string_to_option_tp_ck : public kernels::unary_ck<string_to_option_tp_ck>
         // dst_assign_na
         base.destroy_child_ckernel(m_dst_assign_na_offset);
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        const size_t offsets[2] = {sizeof(self_type),
+                                   (size_t)m_dst_assign_na_offset};
+        base.clone_child_ckernels(&src->base, 2, offsets);
+    }
 };
 }
 
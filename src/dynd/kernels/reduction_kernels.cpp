@@ -8,6 +8,7 @@
 #include <dynd/types/arrfunc_type.hpp>
 #include <dynd/types/strided_dim_type.hpp>
 #include <dynd/func/lift_reduction_arrfunc.hpp>
+#include <dynd/func/lift_accumulation_arrfunc.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -134,6 +135,15 @@ nd::arrfunc kernels::make_builtin_sum1d_arrfunc(type_id_t tid)
     return sum_1d;
 }
 
+nd::arrfunc kernels::make_builtin_cumsum1d_arrfunc(type_id_t tid)
+{
+    nd::arrfunc sum_ew = kernels::make_builtin_sum_reduction_arrfunc(tid);
+    bool reduction_dimflags[1] = {true};
+    return lift_accumulation_arrfunc(
+        sum_ew, ndt::make_strided_dim(ndt::type(tid)), nd::arrfunc(), 1,
+        reduction_dimflags, true, true, false, nd::array());
+}
+
 namespace {
     struct double_mean1d_ck : public kernels::unary_ck<double_mean1d_ck> {
         intptr_t m_minp;
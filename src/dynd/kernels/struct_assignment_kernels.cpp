@@ -49,6 +49,16 @@ struct tuple_unary_op_ck : public kernels::unary_ck<tuple_unary_op_ck> {
       base.destroy_child_ckernel(m_fields[i].child_kernel_offset);
     }
   }
+
+  inline void clone_children(const self_type *src)
+  {
+    vector<size_t> offsets(m_fields.size());
+    for (size_t i = 0; i < m_fields.size(); ++i) {
+      offsets[i] = m_fields[i].child_kernel_offset;
+    }
+    base.clone_child_ckernels(&src->base, offsets.size(),
+                              offsets.empty() ? NULL : &offsets[0]);
+  }
 };
 } // anonymous namespace
 
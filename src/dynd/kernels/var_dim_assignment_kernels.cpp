@@ -67,6 +67,11 @@ namespace {
         {
             get_child_ckernel()->destroy();
         }
+
+        void clone_children(const self_type *src)
+        {
+            get_child_ckernel()->clone_from(src->get_child_ckernel());
+        }
     };
 } // anonymous namespace
 
@@ -162,10 +167,60 @@ namespace {
             }
         }
 
+        /**
+         * When the source rows are back to back, as they usually are, the
+         * values of all the rows are assigned with one child call. The
+         * destination is either allocated in one piece here, or must have
+         * consecutive rows of the same sizes.
+         */
+        inline bool strided_consecutive(char *dst, intptr_t dst_stride,
+                                        const char *src, intptr_t src_stride,
+                                        size_t count)
+        {
+            char *src_values, *dst_values;
+            intptr_t src_total;
+            if (!ndt::var_dim_rows_consecutive(
+                    reinterpret_cast<const char *>(m_src_md), src, src_stride,
+                    count, &src_values, &src_total) || src_total == 0) {
+                return false;
+            }
+            if (!ndt::var_dim_rows_make_consecutive(
+                    reinterpret_cast<const char *>(m_dst_md), dst, dst_stride,
+                    count, m_dst_target_alignment, src, src_stride, src_total,
+                    &dst_values)) {
+                return false;
+            }
+            ckernel_prefix *child = get_child_ckernel();
+            expr_strided_t child_fn = child->get_function<expr_strided_t>();
+            const char *child_src = src_values;
+            child_fn(dst_values, m_dst_md->stride, &child_src,
+                     &m_src_md->stride, src_total, child);
+            return true;
+        }
+
+        inline void strided(char *dst, intptr_t dst_stride, const char *src,
+                            intptr_t src_stride, size_t count)
+        {
+            if (count > 1 && dst_stride != 0 &&
+                    strided_consecutive(dst, dst_stride, src, src_stride, count)) {
+                return;
+            }
+            for (size_t i = 0; i != count; ++i) {
+                single(dst, src);
+                dst += dst_stride;
+                src += src_stride;
+            }
+        }
+
         inline void destruct_children()
         {
             get_child_ckernel()->destroy();
         }
+
+        inline void clone_children(const self_type *src)
+        {
+            get_child_ckernel()->clone_from(src->get_child_ckernel());
+        }
     };
 } // anonymous namespace
 
@@ -267,6 +322,11 @@ namespace {
         {
             base.destroy_child_ckernel(sizeof(self_type));
         }
+
+        inline void clone_children(const self_type *src)
+        {
+            base.clone_child_ckernel(&src->base, sizeof(self_type));
+        }
     };
 } // anonymous namespace
 
@@ -336,6 +396,11 @@ namespace {
         {
             get_child_ckernel()->destroy();
         }
+
+        inline void clone_children(const self_type *src)
+        {
+            get_child_ckernel()->clone_from(src->get_child_ckernel());
+        }
     };
 } // anonymous namespace
 
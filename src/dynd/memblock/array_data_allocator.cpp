@@ -0,0 +1,270 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+#include <dynd/memblock/array_data_allocator.hpp>
+#include <dynd/type.hpp>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+    enum allocation_kind_t {
+        allocation_malloc,
+        allocation_aligned_malloc,
+        allocation_mmap
+    };
+
+    void *aligned_malloc(size_t size, size_t alignment)
+    {
+#if defined(_WIN32)
+        return _aligned_malloc(size, alignment);
+#else
+        void *result = NULL;
+        if (posix_memalign(&result, max(alignment, sizeof(void *)), size) != 0) {
+            return NULL;
+        }
+        return result;
+#endif
+    }
+
+    void aligned_free(void *ptr)
+    {
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    // From <numaif.h>, which comes with libnuma
+    const int mpol_interleave = 3;
+
+    /**
+     * Reads the online NUMA nodes from sysfs into a node mask, for
+     * example "0-1,3". Returns the number of nodes.
+     */
+    int get_numa_node_mask(vector<unsigned long>& out_mask)
+    {
+        out_mask.clear();
+        FILE *f = fopen("/sys/devices/system/node/online", "r");
+        if (f == NULL) {
+            return 0;
+        }
+        int count = 0;
+        unsigned long first, last;
+        const size_t bits = sizeof(unsigned long) * 8;
+        while (fscanf(f, "%lu", &first) == 1) {
+            last = first;
+            int c = fgetc(f);
+            if (c == '-') {
+                if (fscanf(f, "%lu", &last) != 1) {
+                    break;
+                }
+                c = fgetc(f);
+            }
+            for (unsigned long node = first; node <= last && node < 1024; ++node) {
+                if (out_mask.size() <= node / bits) {
+                    out_mask.resize(node / bits + 1, 0);
+                }
+                out_mask[node / bits] |= 1ul << (node % bits);
+                ++count;
+            }
+            if (c != ',') {
+                break;
+            }
+        }
+        fclose(f);
+        return count;
+    }
+
+    void interleave_numa_nodes(void *ptr, size_t size)
+    {
+        static vector<unsigned long> mask;
+        static int node_count = get_numa_node_mask(mask);
+        if (node_count > 1) {
+            // Best effort, the memory works either way
+            syscall(SYS_mbind, ptr, size, mpol_interleave, &mask[0],
+                    mask.size() * sizeof(unsigned long) * 8 + 1, 0);
+        }
+    }
+#else
+    void interleave_numa_nodes(void *, size_t)
+    {
+    }
+#endif
+
+#if !defined(_WIN32)
+    /**
+     * Maps memory from the OS aligned to the huge page size, so the
+     * kernel can back it with transparent huge pages.
+     */
+    void *map_huge_pages(size_t size, array_numa_policy_t numa_policy)
+    {
+        const size_t huge_page_size = DYND_ARRAY_HUGE_PAGE_THRESHOLD;
+        size_t map_size = size + huge_page_size;
+        char *ptr = reinterpret_cast<char *>(mmap(NULL, map_size,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (ptr == MAP_FAILED) {
+            return NULL;
+        }
+        // Trim the unaligned head and the tail
+        char *aligned = inc_to_alignment(ptr, huge_page_size);
+        if (aligned != ptr) {
+            munmap(ptr, aligned - ptr);
+        }
+        size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        char *end = aligned + ((size + page_size - 1) & ~(page_size - 1));
+        if (end < ptr + map_size) {
+            munmap(end, ptr + map_size - end);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(aligned, end - aligned, MADV_HUGEPAGE);
+#endif
+        if (numa_policy == array_numa_interleave) {
+            interleave_numa_nodes(aligned, end - aligned);
+        }
+        return aligned;
+    }
+#endif
+
+    void *system_allocate(const array_data_allocator *self, size_t size,
+                          size_t alignment, uintptr_t *out_cookie)
+    {
+        const system_array_data_allocator *sys =
+            reinterpret_cast<const system_array_data_allocator *>(self);
+#if !defined(_WIN32)
+        if (sys->huge_page_threshold != 0 && size >= sys->huge_page_threshold &&
+                alignment <= DYND_ARRAY_HUGE_PAGE_THRESHOLD) {
+            void *result = map_huge_pages(size, sys->numa_policy);
+            if (result != NULL) {
+                *out_cookie = allocation_mmap;
+                return result;
+            }
+        }
+#else
+        (void)sys;
+#endif
+        // malloc is assumed to provide 16-byte alignment
+        if (alignment <= 16) {
+            *out_cookie = allocation_malloc;
+            return malloc(size);
+        } else {
+            *out_cookie = allocation_aligned_malloc;
+            return aligned_malloc(size, alignment);
+        }
+    }
+
+    void system_deallocate(const array_data_allocator *DYND_UNUSED(self),
+                           void *ptr, size_t size, uintptr_t cookie)
+    {
+        switch (cookie) {
+            case allocation_malloc:
+                free(ptr);
+                break;
+            case allocation_aligned_malloc:
+                aligned_free(ptr);
+                break;
+#if !defined(_WIN32)
+            case allocation_mmap:
+                munmap(ptr, size);
+                break;
+#endif
+            default:
+                (void)size;
+                break;
+        }
+    }
+
+    system_array_data_allocator default_allocator = {
+        {&system_allocate, &system_deallocate},
+        DYND_ARRAY_HUGE_PAGE_THRESHOLD,
+        array_numa_first_touch
+    };
+
+    const array_data_allocator *current_allocator = &default_allocator.base;
+
+    /**
+     * Sits right in front of every array block, recording
+     * how to free it.
+     */
+    struct array_block_header {
+        const array_data_allocator *allocator;
+        char *base;
+        size_t size;
+        uintptr_t cookie;
+    };
+} // anonymous namespace
+
+void dynd::init_system_array_data_allocator(system_array_data_allocator *out_alloc,
+                                            size_t huge_page_threshold,
+                                            array_numa_policy_t numa_policy)
+{
+    out_alloc->base.allocate = &system_allocate;
+    out_alloc->base.deallocate = &system_deallocate;
+    out_alloc->huge_page_threshold = huge_page_threshold;
+    out_alloc->numa_policy = numa_policy;
+}
+
+const array_data_allocator *dynd::get_array_data_allocator()
+{
+    return current_allocator;
+}
+
+const array_data_allocator *dynd::set_array_data_allocator(const array_data_allocator *alloc)
+{
+    const array_data_allocator *prev = current_allocator;
+    current_allocator = (alloc != NULL) ? alloc : &default_allocator.base;
+    return prev;
+}
+
+char *dynd::allocate_array_block(size_t size, size_t data_offset, size_t alignment)
+{
+    alignment = max(alignment, (size_t)16);
+    // Offset of the block from the allocation, leaving room for the header
+    // and putting the data at the requested alignment
+    size_t block_offset = inc_to_alignment(
+        inc_to_alignment(sizeof(array_block_header), 16) + data_offset, alignment) -
+        data_offset;
+    size_t total_size = block_offset + size;
+    const array_data_allocator *alloc = current_allocator;
+    uintptr_t cookie = 0;
+    char *base = reinterpret_cast<char *>(
+        alloc->allocate(alloc, total_size, alignment, &cookie));
+    if (base == NULL) {
+        throw bad_alloc();
+    }
+    char *block = base + block_offset;
+    array_block_header *header = reinterpret_cast<array_block_header *>(block) - 1;
+    header->allocator = alloc;
+    header->base = base;
+    header->size = total_size;
+    header->cookie = cookie;
+    return block;
+}
+
+void dynd::free_array_block(char *block)
+{
+    array_block_header *header = reinterpret_cast<array_block_header *>(block) - 1;
+    header->allocator->deallocate(header->allocator, header->base, header->size,
+                                  header->cookie);
+}
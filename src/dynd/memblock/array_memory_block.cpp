@@ -4,6 +4,7 @@
 //
 
 #include <dynd/memblock/array_memory_block.hpp>
+#include <dynd/memblock/array_data_allocator.hpp>
 #include <dynd/types/base_memory_type.hpp>
 #include <dynd/array.hpp>
 #include <dynd/exceptions.hpp>
@@ -49,17 +50,15 @@ void free_array_memory_block(memory_block_data *memblock)
     }
 
     // Finally free the memory block itself
-    free(reinterpret_cast<void *>(memblock));
+    free_array_block(reinterpret_cast<char *>(memblock));
 }
 
 }} // namespace dynd::detail
 
 memory_block_ptr dynd::make_array_memory_block(size_t arrmeta_size)
 {
-    char *result = (char *)malloc(sizeof(memory_block_data) + sizeof(array_preamble) + arrmeta_size);
-    if (result == 0) {
-        throw bad_alloc();
-    }
+    char *result = allocate_array_block(sizeof(memory_block_data) + sizeof(array_preamble) + arrmeta_size,
+                                        0, 16);
     // Zero out all the arrmeta to start
     memset(result + sizeof(memory_block_data), 0, sizeof(array_preamble) + arrmeta_size);
     return memory_block_ptr(new (result) memory_block_data(1, array_memory_block_type), false);
@@ -68,12 +67,13 @@ memory_block_ptr dynd::make_array_memory_block(size_t arrmeta_size)
 memory_block_ptr dynd::make_array_memory_block(size_t arrmeta_size, size_t extra_size,
                     size_t extra_alignment, char **out_extra_ptr)
 {
-    size_t extra_offset = inc_to_alignment(sizeof(memory_block_data) + sizeof(array_preamble) + arrmeta_size,
-                                        extra_alignment);
-    char *result = (char *)malloc(extra_offset + extra_size);
-    if (result == 0) {
-        throw bad_alloc();
+    // Align the data of all but tiny arrays for SIMD and cache lines
+    if (extra_size >= DYND_ARRAY_DATA_ALIGNMENT && extra_alignment < DYND_ARRAY_DATA_ALIGNMENT) {
+        extra_alignment = DYND_ARRAY_DATA_ALIGNMENT;
     }
+    size_t extra_offset = inc_to_alignment(sizeof(memory_block_data) + sizeof(array_preamble) + arrmeta_size,
+                                        16);
+    char *result = allocate_array_block(extra_offset + extra_size, extra_offset, extra_alignment);
     // Zero out all the arrmeta to start
     memset(result + sizeof(memory_block_data), 0, sizeof(array_preamble) + arrmeta_size);
     // Return a pointer to the extra allocated memory
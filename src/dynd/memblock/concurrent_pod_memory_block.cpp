@@ -0,0 +1,371 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <stdexcept>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#include <dynd/memblock/concurrent_pod_memory_block.hpp>
+
+#ifdef DYND_USE_STD_THREAD
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+#ifdef DYND_USE_STD_THREAD
+    typedef mutex block_mutex;
+    typedef lock_guard<mutex> block_lock;
+    typedef thread::id thread_id_type;
+    inline thread_id_type get_thread_id() { return this_thread::get_id(); }
+    atomic<uint64_t> next_block_id(1);
+#else
+    // Without threads, all the allocations share one sub-arena
+    struct block_mutex {};
+    struct block_lock {
+        explicit block_lock(block_mutex&) {}
+    };
+    typedef int thread_id_type;
+    inline thread_id_type get_thread_id() { return 0; }
+    uint64_t next_block_id = 1;
+#endif
+
+    // Sub-arenas are carved at this alignment, which is also the
+    // most alignment allocate() can provide without padding
+    const intptr_t subarena_alignment = 16;
+
+    /**
+     * The part of a shared chunk one thread allocates from. Only
+     * the owning thread touches the pointers.
+     */
+    struct subarena {
+        thread_id_type m_owner;
+        char *m_begin, *m_current, *m_end;
+        /** How big the next sub-arena this thread carves should be */
+        intptr_t m_next_size;
+    };
+
+    struct concurrent_pod_memory_block {
+        /** Every memory block object needs this at the front */
+        memory_block_data m_mbd;
+        /**
+         * Identifies the current generation of sub-arenas, so threads'
+         * cached sub-arena pointers go stale after finalize or reset.
+         * Ids are never reused, even across memory blocks.
+         */
+        uint64_t m_id;
+        intptr_t m_total_allocated_capacity;
+        intptr_t m_initial_subarena_bytes, m_max_subarena_bytes;
+        /** The malloc'd memory */
+        vector<char *> m_memory_handles;
+        /** The current shared chunk, sub-arenas are carved from its front */
+        char *m_chunk_begin, *m_chunk_current, *m_chunk_end;
+        vector<subarena *> m_subarenas;
+        bool m_finalized;
+        /** Guards everything except the sub-arena pointers */
+        block_mutex m_mutex;
+
+        /**
+         * Allocates a new shared chunk. Adds it to the memory handles
+         * vector. The caller must hold the lock.
+         */
+        void append_memory(intptr_t capacity_bytes)
+        {
+            m_memory_handles.push_back(NULL);
+            m_chunk_begin = reinterpret_cast<char *>(malloc(capacity_bytes));
+            m_memory_handles.back() = m_chunk_begin;
+            if (m_chunk_begin == NULL) {
+                m_memory_handles.pop_back();
+                throw bad_alloc();
+            }
+            if (m_chunk_current < m_chunk_end) {
+                // The tail of the previous chunk is never used
+                m_total_allocated_capacity -= m_chunk_end - m_chunk_current;
+            }
+            m_chunk_current = m_chunk_begin;
+            m_chunk_end = m_chunk_begin + capacity_bytes;
+            m_total_allocated_capacity += capacity_bytes;
+        }
+
+        /**
+         * Drops all the sub-arenas, returning their unused tails,
+         * and makes the threads' cached sub-arenas stale. The caller
+         * must hold the lock.
+         */
+        void release_subarenas(bool count_unused)
+        {
+            for (size_t i = 0, i_end = m_subarenas.size(); i != i_end; ++i) {
+                subarena *sa = m_subarenas[i];
+                if (count_unused) {
+                    m_total_allocated_capacity -= sa->m_end - sa->m_current;
+                }
+                delete sa;
+            }
+            m_subarenas.clear();
+            m_id = next_block_id++;
+        }
+
+        concurrent_pod_memory_block(intptr_t initial_capacity_bytes,
+                                    intptr_t subarena_bytes)
+            : m_mbd(1, concurrent_pod_memory_block_type), m_id(next_block_id++),
+              m_total_allocated_capacity(0),
+              m_initial_subarena_bytes(subarena_bytes),
+              m_max_subarena_bytes(max(initial_capacity_bytes, subarena_bytes)),
+              m_memory_handles(), m_chunk_begin(NULL), m_chunk_current(NULL),
+              m_chunk_end(NULL), m_subarenas(), m_finalized(false)
+        {
+            append_memory(initial_capacity_bytes);
+        }
+
+        ~concurrent_pod_memory_block()
+        {
+            for (size_t i = 0, i_end = m_subarenas.size(); i != i_end; ++i) {
+                delete m_subarenas[i];
+            }
+            for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
+                free(m_memory_handles[i]);
+            }
+        }
+    };
+
+    /**
+     * Each thread caches its sub-arenas in the blocks it used last.
+     * Filling several blocks together, like the strings and var dims
+     * of a parse_json_lines result, then doesn't take the lock.
+     */
+    const int subarena_cache_size = 4;
+    struct subarena_cache {
+        uint64_t m_block_id[subarena_cache_size];
+        subarena *m_subarena[subarena_cache_size];
+        /** The entry to replace next */
+        int m_next;
+    };
+    DYND_THREAD_LOCAL subarena_cache tls_subarena_cache;
+
+    inline char *align_ptr(char *ptr, intptr_t alignment)
+    {
+        return reinterpret_cast<char *>(
+            (reinterpret_cast<uintptr_t>(ptr) + alignment - 1) &
+            ~(alignment - 1));
+    }
+
+    /**
+     * Finds or creates the calling thread's sub-arena, taking the lock.
+     */
+    subarena *find_subarena(concurrent_pod_memory_block *emb)
+    {
+        block_lock lock(emb->m_mutex);
+        if (emb->m_finalized) {
+            throw runtime_error("cannot allocate from a concurrent_pod_memory_block after it is finalized");
+        }
+        thread_id_type owner = get_thread_id();
+        subarena *sa = NULL;
+        for (size_t i = 0, i_end = emb->m_subarenas.size(); i != i_end; ++i) {
+            if (emb->m_subarenas[i]->m_owner == owner) {
+                sa = emb->m_subarenas[i];
+                break;
+            }
+        }
+        if (sa == NULL) {
+            sa = new subarena;
+            sa->m_owner = owner;
+            sa->m_begin = sa->m_current = sa->m_end = NULL;
+            sa->m_next_size = emb->m_initial_subarena_bytes;
+            try {
+                emb->m_subarenas.push_back(sa);
+            } catch (...) {
+                delete sa;
+                throw;
+            }
+        }
+        int entry = tls_subarena_cache.m_next;
+        tls_subarena_cache.m_block_id[entry] = emb->m_id;
+        tls_subarena_cache.m_subarena[entry] = sa;
+        tls_subarena_cache.m_next = (entry + 1) % subarena_cache_size;
+        return sa;
+    }
+
+    /**
+     * The lock-free fast path, which only reads the thread's cache.
+     */
+    inline subarena *get_subarena(concurrent_pod_memory_block *emb)
+    {
+        for (int i = 0; i < subarena_cache_size; ++i) {
+            if (tls_subarena_cache.m_block_id[i] == emb->m_id) {
+                return tls_subarena_cache.m_subarena[i];
+            }
+        }
+        return find_subarena(emb);
+    }
+
+    /**
+     * Carves a new sub-arena of at least ``min_bytes`` from the shared
+     * chunk for ``sa``, replacing its current one. The memory of the
+     * old sub-arena stays valid.
+     */
+    void carve_subarena(concurrent_pod_memory_block *emb, subarena *sa,
+                        intptr_t min_bytes)
+    {
+        block_lock lock(emb->m_mutex);
+        intptr_t size = max(sa->m_next_size, min_bytes);
+        sa->m_next_size = min(2 * sa->m_next_size, emb->m_max_subarena_bytes);
+        char *begin = align_ptr(emb->m_chunk_current, subarena_alignment);
+        if (emb->m_chunk_current == NULL || begin + size > emb->m_chunk_end) {
+            // Allocate a chunk to double the amount used so far, or the
+            // requested size, whichever is larger
+            // NOTE: We're assuming malloc produces memory which has good
+            //       enough alignment for anything
+            emb->append_memory(max(emb->m_total_allocated_capacity, size));
+            begin = emb->m_chunk_current;
+        }
+        if (sa->m_current < sa->m_end) {
+            emb->m_total_allocated_capacity -= sa->m_end - sa->m_current;
+        }
+        emb->m_total_allocated_capacity -= begin - emb->m_chunk_current;
+        sa->m_begin = sa->m_current = begin;
+        sa->m_end = begin + size;
+        emb->m_chunk_current = sa->m_end;
+    }
+} // anonymous namespace
+
+memory_block_ptr dynd::make_concurrent_pod_memory_block(intptr_t initial_capacity_bytes,
+                                                        intptr_t subarena_bytes)
+{
+    concurrent_pod_memory_block *pmb =
+        new concurrent_pod_memory_block(initial_capacity_bytes, subarena_bytes);
+    return memory_block_ptr(reinterpret_cast<memory_block_data *>(pmb), false);
+}
+
+namespace dynd { namespace detail {
+
+void free_concurrent_pod_memory_block(memory_block_data *memblock)
+{
+    concurrent_pod_memory_block *emb = reinterpret_cast<concurrent_pod_memory_block *>(memblock);
+    delete emb;
+}
+
+static void allocate(memory_block_data *self, intptr_t size_bytes, intptr_t alignment, char **out_begin, char **out_end)
+{
+    concurrent_pod_memory_block *emb = reinterpret_cast<concurrent_pod_memory_block *>(self);
+    subarena *sa = get_subarena(emb);
+    char *begin = align_ptr(sa->m_current, alignment);
+    char *end = begin + size_bytes;
+    if (sa->m_current == NULL || end > sa->m_end) {
+        carve_subarena(emb, sa, size_bytes + alignment - 1);
+        begin = align_ptr(sa->m_current, alignment);
+        end = begin + size_bytes;
+    }
+
+    // Indicate where to allocate the next memory
+    sa->m_current = end;
+
+    // Return the allocated memory
+    *out_begin = begin;
+    *out_end = end;
+}
+
+static void resize(memory_block_data *self, intptr_t size_bytes, char **inout_begin, char **inout_end)
+{
+    // Resizes the calling thread's previously allocated POD memory
+    concurrent_pod_memory_block *emb = reinterpret_cast<concurrent_pod_memory_block *>(self);
+    subarena *sa = get_subarena(emb);
+    if (*inout_end != sa->m_current) {
+        // Simple sanity check
+        throw runtime_error("concurrent_pod_memory_block resize must be called only using the memory most recently allocated by the same thread");
+    }
+    char *end = *inout_begin + size_bytes;
+    if (end <= sa->m_end) {
+        // If it fits, just adjust the current allocation point
+        sa->m_current = end;
+        *inout_end = end;
+    } else {
+        // If it doesn't fit, need to copy to a new sub-arena
+        char *old_begin = *inout_begin, *old_end = *inout_end;
+        carve_subarena(emb, sa, size_bytes);
+        memcpy(sa->m_begin, old_begin, old_end - old_begin);
+        end = sa->m_begin + size_bytes;
+        sa->m_current = end;
+        *inout_begin = sa->m_begin;
+        *inout_end = end;
+        block_lock lock(emb->m_mutex);
+        emb->m_total_allocated_capacity -= old_end - old_begin;
+    }
+}
+
+static void finalize(memory_block_data *self)
+{
+    // Finalizes the memory so there are no more allocations. All the
+    // threads must be done allocating, this gives the unused tails of
+    // the sub-arenas and shared chunk back to the accounting.
+    concurrent_pod_memory_block *emb = reinterpret_cast<concurrent_pod_memory_block *>(self);
+    block_lock lock(emb->m_mutex);
+    emb->release_subarenas(true);
+    if (emb->m_chunk_current < emb->m_chunk_end) {
+        emb->m_total_allocated_capacity -= emb->m_chunk_end - emb->m_chunk_current;
+    }
+    emb->m_chunk_begin = NULL;
+    emb->m_chunk_current = NULL;
+    emb->m_chunk_end = NULL;
+    emb->m_finalized = true;
+}
+
+static void reset(memory_block_data *self)
+{
+    // Resets the memory so it can reuse it from the start
+    concurrent_pod_memory_block *emb = reinterpret_cast<concurrent_pod_memory_block *>(self);
+    block_lock lock(emb->m_mutex);
+    emb->release_subarenas(false);
+
+    if (emb->m_chunk_begin == NULL) {
+        // After finalize, start over with a fresh chunk
+        for (size_t i = 0, i_end = emb->m_memory_handles.size(); i != i_end; ++i) {
+            free(emb->m_memory_handles[i]);
+        }
+        emb->m_memory_handles.clear();
+        emb->m_total_allocated_capacity = 0;
+        emb->m_finalized = false;
+        emb->append_memory(emb->m_max_subarena_bytes);
+        return;
+    }
+
+    if (emb->m_memory_handles.size() > 1) {
+        // If there are more than one allocated memory chunks,
+        // throw them all away except the last
+        for (size_t i = 0, i_end = emb->m_memory_handles.size() - 1; i != i_end; ++i) {
+            free(emb->m_memory_handles[i]);
+        }
+        emb->m_memory_handles.front() = emb->m_memory_handles.back();
+        emb->m_memory_handles.resize(1);
+    }
+
+    // Reset to use the whole chunk
+    emb->m_chunk_current = emb->m_chunk_begin;
+    emb->m_total_allocated_capacity = emb->m_chunk_end - emb->m_chunk_begin;
+}
+
+memory_block_pod_allocator_api concurrent_pod_memory_block_allocator_api = {
+    &allocate,
+    &resize,
+    &finalize,
+    &reset
+};
+
+}} // namespace dynd::detail
+
+void dynd::concurrent_pod_memory_block_debug_print(const memory_block_data *memblock, std::ostream& o, const std::string& indent)
+{
+    const concurrent_pod_memory_block *emb = reinterpret_cast<const concurrent_pod_memory_block *>(memblock);
+    if (!emb->m_finalized) {
+        o << indent << " allocated: " << emb->m_total_allocated_capacity << "\n";
+        o << indent << " sub-arenas: " << emb->m_subarenas.size() << "\n";
+    } else {
+        o << indent << " finalized: " << emb->m_total_allocated_capacity << "\n";
+    }
+}
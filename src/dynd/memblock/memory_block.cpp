@@ -6,6 +6,7 @@
 #include <dynd/memblock/memory_block.hpp>
 #include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/memblock/zeroinit_memory_block.hpp>
+#include <dynd/memblock/concurrent_pod_memory_block.hpp>
 #include <dynd/memblock/fixed_size_pod_memory_block.hpp>
 #include <dynd/memblock/executable_memory_block.hpp>
 #include <dynd/memblock/array_memory_block.hpp>
@@ -39,6 +40,10 @@ void free_pod_memory_block(memory_block_data *memblock);
  * This should only be called by the memory_block decref code.
  */
 void free_zeroinit_memory_block(memory_block_data *memblock);
+/**
+ * INTERNAL: Frees a memory_block created by make_concurrent_pod_memory_block.
+ */
+void free_concurrent_pod_memory_block(memory_block_data *memblock);
 /**
  * INTERNAL: Frees a memory_block created by make_executable_memory_block.
  * This should only be called by the memory_block decref code.
@@ -69,6 +74,10 @@ extern memory_block_pod_allocator_api pod_memory_block_allocator_api;
  * INTERNAL: Static instance of the pod allocator API for the zeroinit memory block.
  */
 extern memory_block_pod_allocator_api zeroinit_memory_block_allocator_api;
+/**
+ * INTERNAL: Static instance of the pod allocator API for the concurrent POD memory block.
+ */
+extern memory_block_pod_allocator_api concurrent_pod_memory_block_allocator_api;
 /**
  * INTERNAL: Static instance of the objectarray allocator API for the objectarray memory block.
  */
@@ -110,6 +119,9 @@ void dynd::detail::memory_block_free(memory_block_data *memblock)
         case memmap_memory_block_type:
             free_memmap_memory_block(memblock);
             return;
+        case concurrent_pod_memory_block_type:
+            free_concurrent_pod_memory_block(memblock);
+            return;
     }
 
     stringstream ss;
@@ -144,6 +156,9 @@ std::ostream& dynd::operator<<(std::ostream& o, memory_block_type_t mbt)
         case memmap_memory_block_type:
             o << "memmap";
             break;
+        case concurrent_pod_memory_block_type:
+            o << "concurrent_pod";
+            break;
         default:
             o << "unknown memory_block_type(" << (int)mbt << ")";
     }
@@ -181,6 +196,9 @@ void dynd::memory_block_debug_print(const memory_block_data *memblock, std::ostr
             case memmap_memory_block_type:
                 memmap_memory_block_debug_print(memblock, o, indent);
                 break;
+            case concurrent_pod_memory_block_type:
+                concurrent_pod_memory_block_debug_print(memblock, o, indent);
+                break;
         }
         o << indent << "------" << endl;
     } else {
@@ -199,6 +217,8 @@ memory_block_pod_allocator_api *dynd::get_memory_block_pod_allocator_api(memory_
             return &dynd::detail::pod_memory_block_allocator_api;
         case zeroinit_memory_block_type:
             return &dynd::detail::zeroinit_memory_block_allocator_api;
+        case concurrent_pod_memory_block_type:
+            return &dynd::detail::concurrent_pod_memory_block_allocator_api;
         case objectarray_memory_block_type:
             throw runtime_error("Cannot get a POD allocator API from an objectarray_memory_block");
         case executable_memory_block_type:
@@ -222,6 +242,8 @@ memory_block_objectarray_allocator_api *dynd::get_memory_block_objectarray_alloc
             throw runtime_error("Cannot get an objectarray allocator API from a pod_memory_block");
         case zeroinit_memory_block_type:
             throw runtime_error("Cannot get an objectarray allocator API from a zeroinit_memory_block");
+        case concurrent_pod_memory_block_type:
+            throw runtime_error("Cannot get an objectarray allocator API from a concurrent_pod_memory_block");
         case objectarray_memory_block_type:
             return &dynd::detail::objectarray_memory_block_allocator_api;
         case executable_memory_block_type:
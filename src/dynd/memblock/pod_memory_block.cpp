@@ -22,6 +22,8 @@ namespace {
         vector<char *> m_memory_handles;
         /** The current malloc'd memory being doled out */
         char *m_memory_begin, *m_memory_current, *m_memory_end;
+        /** Another memory block whose memory the data may also point into */
+        memory_block_data *m_data_reference;
 
         /**
          * Allocates some new memory from which to dole out
@@ -43,7 +45,7 @@ namespace {
 
         pod_memory_block(intptr_t initial_capacity_bytes)
             : m_mbd(1, pod_memory_block_type), m_total_allocated_capacity(0),
-                    m_memory_handles()
+                    m_memory_handles(), m_data_reference(NULL)
         {
             append_memory(initial_capacity_bytes);
         }
@@ -53,6 +55,9 @@ namespace {
             for (size_t i = 0, i_end = m_memory_handles.size(); i != i_end; ++i) {
                 free(m_memory_handles[i]);
             }
+            if (m_data_reference != NULL) {
+                memory_block_decref(m_data_reference);
+            }
         }
     };
 } // anonymous namespace
@@ -63,6 +68,17 @@ memory_block_ptr dynd::make_pod_memory_block(intptr_t initial_capacity_bytes)
     return memory_block_ptr(reinterpret_cast<memory_block_data *>(pmb), false);
 }
 
+memory_block_ptr dynd::make_pod_memory_block(const memory_block_ptr& data_reference,
+                                             intptr_t initial_capacity_bytes)
+{
+    pod_memory_block *pmb = new pod_memory_block(initial_capacity_bytes);
+    pmb->m_data_reference = data_reference.get();
+    if (pmb->m_data_reference != NULL) {
+        memory_block_incref(pmb->m_data_reference);
+    }
+    return memory_block_ptr(reinterpret_cast<memory_block_data *>(pmb), false);
+}
+
 namespace dynd { namespace detail {
 
 void free_pod_memory_block(memory_block_data *memblock)
@@ -178,4 +194,8 @@ void dynd::pod_memory_block_debug_print(const memory_block_data *memblock, std::
     } else {
         o << indent << " finalized: " << emb->m_total_allocated_capacity << "\n";
     } 
+    if (emb->m_data_reference != NULL) {
+        o << indent << " data reference:\n";
+        memory_block_debug_print(emb->m_data_reference, o, indent + "  ");
+    }
 }
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <vector>
+#include <algorithm>
+
+#include <dynd/parallel.hpp>
+
+#ifdef DYND_USE_STD_THREAD
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+intptr_t parallel::get_hardware_thread_count()
+{
+#ifdef DYND_USE_STD_THREAD
+  intptr_t count = thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+#else
+  return 1;
+#endif
+}
+
+intptr_t parallel::get_thread_count(const eval::eval_context *ectx)
+{
+  intptr_t count = (ectx != NULL) ? (intptr_t)ectx->thread_count : 0;
+  return count > 0 ? count : get_hardware_thread_count();
+}
+
+#ifdef DYND_USE_STD_THREAD
+namespace {
+struct task_runner {
+  intptr_t m_task_count;
+  parallel::task_fn_t m_task;
+  void *m_data;
+  atomic<intptr_t> m_next_task;
+  mutex m_error_mutex;
+  exception_ptr m_error;
+
+  task_runner(intptr_t task_count, parallel::task_fn_t task, void *data)
+      : m_task_count(task_count), m_task(task), m_data(data), m_next_task(0)
+  {
+  }
+
+  // Each thread pulls task indices until they run out, so uneven
+  // tasks still balance across the threads
+  void run()
+  {
+    intptr_t i;
+    while ((i = m_next_task.fetch_add(1)) < m_task_count) {
+      try {
+        m_task(i, m_data);
+      }
+      catch (...) {
+        lock_guard<mutex> lock(m_error_mutex);
+        if (!m_error) {
+          m_error = current_exception();
+        }
+        // Stop handing out the remaining tasks
+        m_next_task.store(m_task_count);
+      }
+    }
+  }
+};
+} // anonymous namespace
+#endif
+
+void parallel::run_tasks(intptr_t task_count, intptr_t thread_count,
+                         task_fn_t task, void *data)
+{
+#ifdef DYND_USE_STD_THREAD
+  thread_count = min(thread_count, task_count);
+  if (thread_count > 1) {
+    task_runner runner(task_count, task, data);
+    vector<thread> threads;
+    threads.reserve(thread_count - 1);
+    try {
+      for (intptr_t i = 1; i < thread_count; ++i) {
+        threads.push_back(thread(&task_runner::run, &runner));
+      }
+    }
+    catch (...) {
+      // Couldn't start all the threads, the ones that did
+      // start and the calling thread finish the work
+    }
+    runner.run();
+    for (size_t i = 0; i < threads.size(); ++i) {
+      threads[i].join();
+    }
+    if (runner.m_error) {
+      rethrow_exception(runner.m_error);
+    }
+    return;
+  }
+#else
+  (void)thread_count;
+#endif
+  for (intptr_t i = 0; i < task_count; ++i) {
+    task(i, data);
+  }
+}
@@ -258,7 +258,7 @@ bool ndt::type::get_as_strided(const char *arrmeta, intptr_t ndim,
 {
   if (get_strided_ndim() >= ndim) {
     *out_size_stride = reinterpret_cast<const size_stride_t *>(arrmeta);
-    *out_el_tp = tcast<base_dim_type>()->get_element_type();
+    *out_el_tp = get_type_at_dimension(NULL, ndim);
     *out_el_arrmeta = arrmeta + ndim * sizeof(strided_dim_type_arrmeta);
     return true;
   } else {
@@ -13,3 +13,9 @@ using namespace dynd;
 
 base_dim_type::~base_dim_type() {
 }
+
+size_t base_dim_type::compute_hash() const
+{
+    return detail::hash_combine(base_type::compute_hash(),
+                                m_element_tp.get_hash());
+}
@@ -18,6 +18,22 @@
 using namespace std;
 using namespace dynd;
 
+/**
+ * Structs with more fields than this get a hash table for
+ * looking up fields by name.
+ */
+#define DYND_STRUCT_FIELD_SCAN_MAX 8
+
+static inline size_t hash_field_name(const char *begin, const char *end)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (; begin != end; ++begin) {
+        h = (h ^ (unsigned char)*begin) * 16777619u;
+    }
+    return h;
+}
+
 base_struct_type::base_struct_type(type_id_t type_id,
                                    const nd::array &field_names,
                                    const nd::array &field_types,
@@ -43,16 +59,62 @@ base_struct_type::base_struct_type(type_id_t type_id,
     }
 
     m_members.kind = struct_kind;
+
+    if (m_field_count > DYND_STRUCT_FIELD_SCAN_MAX) {
+        size_t table_size = 16;
+        while (table_size < 2 * (size_t)m_field_count) {
+            table_size *= 2;
+        }
+        m_field_index_table.resize(table_size, -1);
+        for (intptr_t i = 0; i != m_field_count; ++i) {
+            const string_type_data& fn = get_field_name_raw(i);
+            // Leave out duplicate names, so the first one is found
+            if (get_field_index(fn.begin, fn.end) == -1) {
+                size_t slot = hash_field_name(fn.begin, fn.end) & (table_size - 1);
+                while (m_field_index_table[slot] != -1) {
+                    slot = (slot + 1) & (table_size - 1);
+                }
+                m_field_index_table[slot] = i;
+            }
+        }
+    }
 }
 
 base_struct_type::~base_struct_type() {
 }
 
+size_t base_struct_type::compute_hash() const
+{
+    size_t h = base_tuple_type::compute_hash();
+    for (intptr_t i = 0; i < m_field_count; ++i) {
+        const string_type_data& fn = get_field_name_raw(i);
+        h = detail::hash_combine(h, hash_field_name(fn.begin, fn.end));
+    }
+    return h;
+}
+
 intptr_t base_struct_type::get_field_index(const char *field_name_begin,
                                            const char *field_name_end) const
 {
     size_t size = field_name_end - field_name_begin;
-    if (size > 0) {
+    if (size == 0) {
+        return -1;
+    } else if (!m_field_index_table.empty()) {
+        size_t mask = m_field_index_table.size() - 1;
+        size_t slot = hash_field_name(field_name_begin, field_name_end) & mask;
+        for (;;) {
+            intptr_t i = m_field_index_table[slot];
+            if (i == -1) {
+                return -1;
+            }
+            const string_type_data& fn = get_field_name_raw(i);
+            if ((size_t)(fn.end - fn.begin) == size &&
+                    memcmp(fn.begin, field_name_begin, size) == 0) {
+                return i;
+            }
+            slot = (slot + 1) & mask;
+        }
+    } else {
         char firstchar = *field_name_begin;
         intptr_t field_count = get_field_count();
         const char *fn_ptr = m_field_names.get_readonly_originptr();
@@ -73,6 +135,16 @@ intptr_t base_struct_type::get_field_index(const char *field_name_begin,
     return -1;
 }
 
+void base_struct_type::get_field_indices(intptr_t name_count,
+                                         const std::string *field_names,
+                                         intptr_t *out_field_indices) const
+{
+    for (intptr_t i = 0; i != name_count; ++i) {
+        out_field_indices[i] = get_field_index(field_names[i].data(),
+                        field_names[i].data() + field_names[i].size());
+    }
+}
+
 ndt::type base_struct_type::apply_linear_index(intptr_t nindices,
                                                const irange *indices,
                                                size_t current_i,
@@ -262,6 +334,11 @@ struct struct_property_getter_ck
     {
         get_child_ckernel()->destroy();
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
 };
 } // anonymous namespace
 
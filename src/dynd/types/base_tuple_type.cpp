@@ -60,6 +60,15 @@ base_tuple_type::base_tuple_type(type_id_t type_id,
 base_tuple_type::~base_tuple_type() {
 }
 
+size_t base_tuple_type::compute_hash() const
+{
+    size_t h = base_type::compute_hash();
+    for (intptr_t i = 0; i < m_field_count; ++i) {
+        h = detail::hash_combine(h, get_field_type(i).get_hash());
+    }
+    return h;
+}
+
 void base_tuple_type::print_data(std::ostream &o, const char *arrmeta,
                                  const char *data) const
 {
@@ -6,13 +6,24 @@
 #include <dynd/type.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/types/builtin_type_properties.hpp>
+#include <dynd/types/type_intern.hpp>
 
 using namespace std;
 using namespace dynd;
 
-// Default destructor for the extended type does nothing
 base_type::~base_type()
 {
+    if (m_interned) {
+        detail::unintern_type(this);
+    }
+}
+
+size_t base_type::compute_hash() const
+{
+    size_t h = static_cast<size_t>(get_type_id());
+    h = detail::hash_combine(h, static_cast<size_t>(get_kind()));
+    h = detail::hash_combine(h, get_data_size());
+    return detail::hash_combine(h, static_cast<size_t>(get_ndim()));
 }
 
 bool base_type::is_type_subarray(const ndt::type& subarray_tp) const
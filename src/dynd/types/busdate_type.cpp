@@ -19,17 +19,18 @@ dynd::busdate_type::busdate_type(busdate_roll_t roll, const bool *weekmask,
                                  const nd::array &holidays)
     : base_type(busdate_type_id, datetime_kind, 4, 4, type_flag_scalar, 0, 0,
                 0),
-      m_roll(roll)
+      m_roll(roll), m_calendar(weekmask, holidays)
 {
-    memcpy(m_workweek, weekmask, sizeof(m_workweek));
-    m_busdays_in_weekmask = 0;
-    for (int i = 0; i < 7; ++i) {
-        m_busdays_in_weekmask += weekmask[i] ? 1 : 0;
-    }
     if (!holidays.is_null()) {
-        nd::array hol = holidays.ucast(ndt::make_date()).eval_immutable();
-        // TODO: Make sure hol is contiguous and one-dimensional
-        m_holidays = hol;
+        // The normalized holidays from the calendar, as a date array
+        const vector<int32_t>& hol = m_calendar.get_holidays();
+        nd::array a = nd::empty(hol.size(), ndt::make_date());
+        if (!hol.empty()) {
+            memcpy(a.get_readwrite_originptr(), &hol[0],
+                   hol.size() * sizeof(int32_t));
+        }
+        a.flag_as_immutable();
+        m_holidays = a;
     }
 }
 
@@ -39,18 +40,27 @@ busdate_type::~busdate_type()
 
 void dynd::busdate_type::print_workweek(std::ostream& o) const
 {
-    if (m_workweek[0]) o << "Mo";
-    if (m_workweek[1]) o << "Tu";
-    if (m_workweek[2]) o << "We";
-    if (m_workweek[3]) o << "Th";
-    if (m_workweek[4]) o << "Fr";
-    if (m_workweek[5]) o << "Sa";
-    if (m_workweek[6]) o << "Su";
+    const bool *workweek = m_calendar.get_weekmask();
+    if (workweek[0]) o << "Mo";
+    if (workweek[1]) o << "Tu";
+    if (workweek[2]) o << "We";
+    if (workweek[3]) o << "Th";
+    if (workweek[4]) o << "Fr";
+    if (workweek[5]) o << "Sa";
+    if (workweek[6]) o << "Su";
 }
 
-void dynd::busdate_type::print_holidays(std::ostream& /*o*/) const
+void dynd::busdate_type::print_holidays(std::ostream& o) const
 {
-    throw std::runtime_error("busdate_type::print_holidays to be implemented");
+    const vector<int32_t>& hol = m_calendar.get_holidays();
+    for (size_t i = 0; i < hol.size(); ++i) {
+        date_ymd ymd;
+        ymd.set_from_days(hol[i]);
+        if (i != 0) {
+            o << ", ";
+        }
+        o << "\"" << ymd.to_str() << "\"";
+    }
 }
 
 void dynd::busdate_type::print_data(std::ostream &o,
@@ -99,10 +109,10 @@ bool dynd::busdate_type::is_lossless_assignment(const ndt::type& dst_tp, const n
     if (dst_tp.extended() == this) {
         if (src_tp.extended() == this) {
             return true;
-        } else if (src_tp.get_type_id() == date_type_id) {
+        } else if (src_tp.get_type_id() == busdate_type_id) {
             const busdate_type *src_fs = static_cast<const busdate_type*>(src_tp.extended());
             // No need to compare the roll policy, just the weekmask and holidays determine this
-            return memcmp(m_workweek, src_fs->m_workweek, sizeof(m_workweek)) == 0 &&
+            return memcmp(get_weekmask(), src_fs->get_weekmask(), 7 * sizeof(bool)) == 0 &&
                     m_holidays.equals_exact(src_fs->m_holidays);
         } else {
             return false;
@@ -120,7 +130,7 @@ bool dynd::busdate_type::operator==(const base_type& rhs) const
         return false;
     } else {
         const busdate_type *dt = static_cast<const busdate_type*>(&rhs);
-        return m_roll == dt->m_roll && memcmp(m_workweek, dt->m_workweek, sizeof(m_workweek)) == 0 &&
+        return m_roll == dt->m_roll && memcmp(get_weekmask(), dt->get_weekmask(), 7 * sizeof(bool)) == 0 &&
                 m_holidays.equals_exact(dt->m_holidays);
     }
 }
@@ -0,0 +1,147 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/types/busdate_util.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/array.hpp>
+#include <dynd/exceptions.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static void init_weekmask(const bool *weekmask, bool *out_weekmask,
+                          int &out_busdays_in_weekmask, int *out_week_prefix,
+                          int *out_week_busday)
+{
+    static const bool default_weekmask[7] = {true, true, true, true,
+                                             true, false, false};
+    if (weekmask == NULL) {
+        weekmask = default_weekmask;
+    }
+    int count = 0;
+    out_week_prefix[0] = 0;
+    for (int i = 0; i < 7; ++i) {
+        out_weekmask[i] = weekmask[i];
+        if (weekmask[i]) {
+            out_week_busday[count++] = i;
+        }
+        out_week_prefix[i + 1] = count;
+    }
+    if (count == 0) {
+        throw invalid_argument(
+            "a business day weekmask must have at least one business day");
+    }
+    out_busdays_in_weekmask = count;
+}
+
+busdate_calendar::busdate_calendar(const bool *weekmask)
+{
+    init_weekmask(weekmask, m_weekmask, m_busdays_in_weekmask, m_week_prefix,
+                  m_week_busday);
+}
+
+busdate_calendar::busdate_calendar(const bool *weekmask,
+                                   const nd::array &holidays)
+{
+    init_weekmask(weekmask, m_weekmask, m_busdays_in_weekmask, m_week_prefix,
+                  m_week_busday);
+    if (holidays.is_null()) {
+        return;
+    }
+
+    nd::array hol = holidays.ucast(ndt::make_date()).eval();
+    intptr_t size, stride;
+    ndt::type el_tp;
+    const char *el_arrmeta;
+    if (hol.get_ndim() != 1 ||
+            !hol.get_type().get_as_strided(hol.get_arrmeta(), &size, &stride,
+                                           &el_tp, &el_arrmeta)) {
+        stringstream ss;
+        ss << "business day holidays must be a one-dimensional array of";
+        ss << " dates, got " << holidays.get_type();
+        throw type_error(ss.str());
+    }
+    const char *data = hol.get_readonly_originptr();
+    m_holidays.reserve(size);
+    for (intptr_t i = 0; i < size; ++i, data += stride) {
+        int32_t days = *reinterpret_cast<const int32_t *>(data);
+        // Holidays on days the weekmask already excludes don't matter,
+        // duplicates are removed after sorting
+        if (days != DYND_DATE_NA && m_weekmask[weekday(days)]) {
+            m_holidays.push_back(days);
+        }
+    }
+    sort(m_holidays.begin(), m_holidays.end());
+    m_holidays.erase(unique(m_holidays.begin(), m_holidays.end()),
+                     m_holidays.end());
+
+    m_holiday_keys.resize(m_holidays.size());
+    for (size_t i = 0; i < m_holidays.size(); ++i) {
+        m_holiday_keys[i] = weekmask_ordinal(m_holidays[i]) - (int64_t)i;
+    }
+}
+
+int32_t busdate_calendar::from_ordinal(int64_t ord) const
+{
+    // The holidays before the business day with this ordinal are those
+    // with at most this many business days before them
+    int64_t b = ord + (upper_bound(m_holiday_keys.begin(),
+                                   m_holiday_keys.end(), ord) -
+                       m_holiday_keys.begin());
+    int64_t n = m_busdays_in_weekmask;
+    int64_t weeks = b >= 0 ? b / n : -((n - 1 - b) / n);
+    int64_t days = 4 + weeks * 7 + m_week_busday[b - weeks * n];
+    if (days <= DYND_DATE_NA || days > numeric_limits<int32_t>::max()) {
+        throw overflow_error("business day offset overflowed the date range");
+    }
+    return static_cast<int32_t>(days);
+}
+
+int32_t busdate_calendar::roll(int32_t days, busdate_roll_t roll) const
+{
+    if (days == DYND_DATE_NA || is_busday(days)) {
+        return days;
+    }
+    // ordinal() is that of the following business day
+    switch (roll) {
+        case busdate_roll_following:
+            return from_ordinal(ordinal(days));
+        case busdate_roll_preceding:
+            return from_ordinal(ordinal(days) - 1);
+        case busdate_roll_modifiedfollowing:
+        case busdate_roll_modifiedpreceding: {
+            bool forward = (roll == busdate_roll_modifiedfollowing);
+            int32_t result = from_ordinal(ordinal(days) - (forward ? 0 : 1));
+            date_ymd ymd, result_ymd;
+            ymd.set_from_days(days);
+            result_ymd.set_from_days(result);
+            if (ymd.month != result_ymd.month) {
+                result = from_ordinal(ordinal(days) - (forward ? 1 : 0));
+            }
+            return result;
+        }
+        case busdate_roll_nat:
+            return DYND_DATE_NA;
+        default: {
+            date_ymd ymd;
+            ymd.set_from_days(days);
+            stringstream ss;
+            ss << "date " << ymd.to_str();
+            ss << " is not a business day";
+            throw invalid_argument(ss.str());
+        }
+    }
+}
+
+int64_t busdate_calendar::count(int32_t begin, int32_t end) const
+{
+    if (begin == DYND_DATE_NA || end == DYND_DATE_NA) {
+        throw invalid_argument("cannot count business days to or from NA");
+    }
+    return ordinal(end) - ordinal(begin);
+}
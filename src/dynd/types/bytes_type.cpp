@@ -82,7 +82,8 @@ bool bytes_type::is_unique_data_owner(const char *arrmeta) const
     const bytes_type_arrmeta *md = reinterpret_cast<const bytes_type_arrmeta *>(arrmeta);
     if (md->blockref != NULL &&
             (md->blockref->m_use_count != 1 ||
-             md->blockref->m_type != pod_memory_block_type)) {
+             (md->blockref->m_type != pod_memory_block_type &&
+              md->blockref->m_type != concurrent_pod_memory_block_type))) {
         return false;
     }
     return true;
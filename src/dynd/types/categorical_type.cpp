@@ -100,6 +100,13 @@ namespace {
             }
             self->destroy_child_ckernel(sizeof(extra_type));
         }
+
+        static void clone(ckernel_prefix *dst, const ckernel_prefix *src)
+        {
+            dst->clone_child_ckernel(src, sizeof(extra_type));
+            base_type_xincref(
+                reinterpret_cast<const extra_type *>(src)->src_cat_tp);
+        }
     };
 
     struct category_to_categorical_kernel_extra {
@@ -144,6 +151,13 @@ namespace {
                 base_type_decref(e->dst_cat_tp);
             }
         }
+
+        static void clone(ckernel_prefix *DYND_UNUSED(dst),
+                          const ckernel_prefix *src)
+        {
+            base_type_xincref(
+                reinterpret_cast<const self_type *>(src)->dst_cat_tp);
+        }
     };
 
     // struct assign_from_commensurate_category {
@@ -468,6 +482,7 @@ size_t categorical_type::make_assignment_kernel(
             "internal error in categorical_type::make_assignment_kernel");
       }
       e->base.destructor = &category_to_categorical_kernel_extra::destruct;
+      e->base.clone = &category_to_categorical_kernel_extra::clone;
       // The kernel type owns a reference to this type
       e->dst_cat_tp =
           static_cast<const categorical_type *>(ndt::type(dst_tp).release());
@@ -510,6 +525,7 @@ size_t categorical_type::make_assignment_kernel(
             "internal error in categorical_type::make_assignment_kernel");
       }
       e->base.destructor = &categorical_to_other_kernel_extra::destruct;
+      e->base.clone = &categorical_to_other_kernel_extra::clone;
       // The kernel type owns a reference to this type
       e->src_cat_tp =
           static_cast<const categorical_type *>(ndt::type(src_tp).release());
@@ -79,6 +79,13 @@ cfixed_dim_type::~cfixed_dim_type()
 {
 }
 
+size_t cfixed_dim_type::compute_hash() const
+{
+    size_t h = detail::hash_combine(base_dim_type::compute_hash(),
+                                    static_cast<size_t>(m_dim_size));
+    return detail::hash_combine(h, static_cast<size_t>(m_stride));
+}
+
 void cfixed_dim_type::print_data(std::ostream &o, const char *arrmeta,
                                  const char *data) const
 {
@@ -123,9 +130,9 @@ void cfixed_dim_type::transform_child_types(type_transform_fn_t transform_fn,
     transform_fn(m_element_tp, extra, tmp_tp, was_transformed);
     if (was_transformed) {
         if (tmp_tp.get_data_size() != 0) {
-            out_transformed_tp = ndt::type(new cfixed_dim_type(m_dim_size, tmp_tp), false);
+            out_transformed_tp = ndt::make_cfixed_dim(m_dim_size, tmp_tp);
         } else {
-            out_transformed_tp = ndt::type(new strided_dim_type(tmp_tp), false);
+            out_transformed_tp = ndt::make_strided_dim(tmp_tp);
         }
         out_was_transformed = true;
     } else {
@@ -140,9 +147,9 @@ ndt::type cfixed_dim_type::get_canonical_type() const
     // The transformed type may no longer have a fixed size, so check whether
     // we have to switch to the more flexible strided_dim_type
     if (canonical_element_dt.get_data_size() != 0) {
-        return ndt::type(new cfixed_dim_type(m_dim_size, canonical_element_dt), false);
+        return ndt::make_cfixed_dim(m_dim_size, canonical_element_dt);
     } else {
-        return ndt::type(new strided_dim_type(canonical_element_dt), false);
+        return ndt::make_strided_dim(canonical_element_dt);
     }
 }
 
@@ -155,15 +162,15 @@ ndt::type cfixed_dim_type::apply_linear_index(intptr_t nindices, const irange *i
         if (indices->step() == 0) {
             return m_element_tp;
         } else {
-            return ndt::type(new strided_dim_type(m_element_tp), false);
+            return ndt::make_strided_dim(m_element_tp);
         }
     } else {
         if (indices->step() == 0) {
             return m_element_tp.apply_linear_index(nindices-1, indices+1,
                             current_i+1, root_tp, leading_dimension);
         } else {
-            return ndt::type(new strided_dim_type(m_element_tp.apply_linear_index(nindices-1, indices+1,
-                            current_i+1, root_tp, false)), false);
+            return ndt::make_strided_dim(m_element_tp.apply_linear_index(nindices-1, indices+1,
+                            current_i+1, root_tp, false));
         }
     }
 }
@@ -652,7 +652,6 @@ static ndt::type parse_datetime_parameters(const char *&rbegin, const char *end)
 {
     const char *begin = rbegin;
     if (parse_token_ds(begin, end, '[')) {
-        datetime_tz_t timezone = tz_abstract;
         string unit_str;
         const char *saved_begin = begin;
         // Parse the timezone
@@ -667,11 +666,11 @@ static ndt::type parse_datetime_parameters(const char *&rbegin, const char *end)
         if (!parse_quoted_string(begin, end, timezone_str)) {
             throw datashape_parse_error(begin, "expected a time zone string");
         }
-        if (timezone_str == "abstract") {
-            timezone = tz_abstract;
-        } else if (timezone_str == "UTC") {
-            timezone = tz_utc;
-        } else {
+        ndt::type result;
+        try {
+            // "abstract", "UTC", or a name from the tz database
+            result = ndt::make_datetime(timezone_str);
+        } catch (const runtime_error&) {
             throw datashape_parse_error(saved_begin, "invalid time zone");
         }
         if (!parse_token_ds(begin, end, ']')) {
@@ -679,7 +678,7 @@ static ndt::type parse_datetime_parameters(const char *&rbegin, const char *end)
         }
 
         rbegin = begin;
-        return ndt::make_datetime(timezone);
+        return result;
     } else {
         return ndt::make_datetime();
     }
@@ -36,7 +36,14 @@ using namespace dynd;
 datetime_type::datetime_type(datetime_tz_t timezone)
     : base_type(datetime_type_id, datetime_kind, 8,
                 scalar_align_of<int64_t>::value, type_flag_scalar, 0, 0, 0),
-      m_timezone(timezone)
+      m_timezone(timezone), m_tzinfo(NULL)
+{
+}
+
+datetime_type::datetime_type(const tz_info *tzinfo)
+    : base_type(datetime_type_id, datetime_kind, 8,
+                scalar_align_of<int64_t>::value, type_flag_scalar, 0, 0, 0),
+      m_timezone(tz_named), m_tzinfo(tzinfo)
 {
 }
 
@@ -86,7 +93,39 @@ void datetime_type::set_cal(const char *DYND_UNUSED(arrmeta), char *data,
     dts.hmst.second = second;
     dts.hmst.tick = tick;
 
-    *reinterpret_cast<int64_t *>(data) = dts.to_ticks();
+    int64_t ticks = dts.to_ticks();
+    if (m_timezone == tz_named && ticks != DYND_DATETIME_NA) {
+        ticks = m_tzinfo->local_to_utc(ticks);
+    }
+    *reinterpret_cast<int64_t *>(data) = ticks;
+}
+
+/**
+ * Parses an ISO 8601 UTC offset like "+05", "-0800" or "+05:30"
+ * into ticks.
+ */
+static bool parse_utc_offset(const char *begin, const char *end,
+                             int64_t &out_offset)
+{
+    if (end - begin < 3 || (begin[0] != '+' && begin[0] != '-')) {
+        return false;
+    }
+    int64_t hours = (begin[1] - '0') * 10 + (begin[2] - '0'), minutes = 0;
+    const char *mbegin = begin + 3;
+    if (mbegin < end && *mbegin == ':') {
+        ++mbegin;
+    }
+    if (mbegin != end) {
+        if (end - mbegin != 2) {
+            return false;
+        }
+        minutes = (mbegin[0] - '0') * 10 + (mbegin[1] - '0');
+    }
+    out_offset = hours * DYND_TICKS_PER_HOUR + minutes * DYND_TICKS_PER_MINUTE;
+    if (begin[0] == '-') {
+        out_offset = -out_offset;
+    }
+    return true;
 }
 
 void datetime_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta),
@@ -98,27 +137,40 @@ void datetime_type::set_from_utf8_string(const char *DYND_UNUSED(arrmeta),
     const char *tz_begin = NULL, *tz_end = NULL;
     dts.set_from_str(utf8_begin, utf8_end, ectx->date_parse_order,
                      ectx->century_window, ectx->errmode, tz_begin, tz_end);
-    if (m_timezone != tz_abstract && tz_begin != tz_end) {
-        if (m_timezone == tz_utc &&
-                (parse::compare_range_to_literal(tz_begin, tz_end, "Z") ||
-                 parse::compare_range_to_literal(tz_begin, tz_end, "UTC"))) {
-            // It's a UTC time to a UTC time zone
-        } else {
-            stringstream ss;
-            ss << "DyND time zone support is partial, cannot handle ";
-            ss.write(tz_begin, tz_end - tz_begin);
-            throw runtime_error(ss.str());
+    int64_t ticks = dts.to_ticks(), offset;
+    if (m_timezone == tz_abstract || ticks == DYND_DATETIME_NA) {
+        // Any time zone in the string is thrown away
+    } else if (tz_begin == tz_end ||
+               (m_timezone == tz_named &&
+                std::string(tz_begin, tz_end) == m_tzinfo->get_name())) {
+        // A wall clock time in this time zone
+        if (m_timezone == tz_named) {
+            ticks = m_tzinfo->local_to_utc(ticks);
         }
+    } else if (parse::compare_range_to_literal(tz_begin, tz_end, "Z") ||
+               parse::compare_range_to_literal(tz_begin, tz_end, "UTC")) {
+        // It's a UTC time, which is what is stored
+    } else if (parse_utc_offset(tz_begin, tz_end, offset)) {
+        ticks -= offset;
+    } else {
+        stringstream ss;
+        ss << "DyND time zone support is partial, cannot handle ";
+        ss.write(tz_begin, tz_end - tz_begin);
+        throw runtime_error(ss.str());
     }
-    *reinterpret_cast<int64_t *>(data) = dts.to_ticks();
+    *reinterpret_cast<int64_t *>(data) = ticks;
 }
 
 void datetime_type::get_cal(const char *DYND_UNUSED(arrmeta), const char *data,
                 int32_t &out_year, int32_t &out_month, int32_t &out_day,
                 int32_t &out_hour, int32_t &out_min, int32_t &out_sec, int32_t &out_tick) const
 {
+    int64_t ticks = *reinterpret_cast<const int64_t *>(data);
+    if (m_timezone == tz_named && ticks != DYND_DATETIME_NA) {
+        ticks = m_tzinfo->utc_to_local(ticks);
+    }
     datetime_struct dts;
-    dts.set_from_ticks(*reinterpret_cast<const int64_t *>(data));
+    dts.set_from_ticks(ticks);
     out_year = dts.ymd.year;
     out_month = dts.ymd.month;
     out_day = dts.ymd.day;
@@ -131,8 +183,16 @@ void datetime_type::get_cal(const char *DYND_UNUSED(arrmeta), const char *data,
 void datetime_type::print_data(std::ostream& o,
                 const char *DYND_UNUSED(arrmeta), const char *data) const
 {
+    int64_t ticks = *reinterpret_cast<const int64_t *>(data);
     datetime_struct dts;
-    dts.set_from_ticks(*reinterpret_cast<const int64_t *>(data));
+    if (m_timezone == tz_named && ticks != DYND_DATETIME_NA) {
+        // The wall clock time, followed by its UTC offset
+        int64_t offset = m_tzinfo->get_utc_offset(ticks);
+        dts.set_from_ticks(ticks + offset);
+        o << dts.to_str() << tz_offset_to_str(offset);
+        return;
+    }
+    dts.set_from_ticks(ticks);
     o << dts.to_str();
     if (m_timezone == tz_utc) {
         o << "Z";
@@ -149,6 +209,9 @@ void datetime_type::print_type(std::ostream& o) const
             case tz_utc:
                 o << "UTC";
                 break;
+            case tz_named:
+                o << m_tzinfo->get_name();
+                break;
             default:
                 o << "(invalid " << (int32_t)m_timezone << ")";
                 break;
@@ -181,8 +244,7 @@ bool datetime_type::operator==(const base_type& rhs) const
         return false;
     } else {
         const datetime_type& r = static_cast<const datetime_type &>(rhs);
-        // TODO: When "other" timezone data is supported, need to compare them too
-        return m_timezone == r.m_timezone;
+        return m_timezone == r.m_timezone && m_tzinfo == r.m_tzinfo;
     }
 }
 
@@ -196,13 +258,17 @@ size_t datetime_type::make_assignment_kernel(
             return make_pod_typed_data_assignment_kernel(ckb, ckb_offset,
                             get_data_size(), get_data_alignment(), kernreq);
         } else if (src_tp.get_type_id() == datetime_type_id) {
-            if (src_tp.tcast<datetime_type>()->get_timezone() == tz_abstract) {
-                // TODO: If the destination timezone is not UTC, do an
-                //       appropriate transformation
+            const datetime_type *src_dt = src_tp.tcast<datetime_type>();
+            if (src_dt->get_timezone() == tz_abstract) {
+                // The source is a wall clock time in the destination
+                // time zone
                 if (get_timezone() == tz_utc) {
                     return make_pod_typed_data_assignment_kernel(
                         ckb, ckb_offset, get_data_size(), get_data_alignment(),
                         kernreq);
+                } else {
+                    return make_datetime_local_to_utc_kernel(
+                        ckb, ckb_offset, m_tzinfo, kernreq);
                 }
             } else if (get_timezone() != tz_abstract) {
                 // The value stored is independent of the time zone, so
@@ -211,12 +277,14 @@ size_t datetime_type::make_assignment_kernel(
                     ckb, ckb_offset, get_data_size(), get_data_alignment(),
                     kernreq);
             } else if (ectx->errmode == assign_error_nocheck) {
-                // TODO: If the source timezone is not UTC, do an appropriate
-                //       transformation
-                if (src_tp.tcast<datetime_type>()->get_timezone() == tz_utc) {
+                // Drop the time zone, keeping the source's wall clock time
+                if (src_dt->get_timezone() == tz_utc) {
                     return make_pod_typed_data_assignment_kernel(
                         ckb, ckb_offset, get_data_size(), get_data_alignment(),
                         kernreq);
+                } else {
+                    return make_datetime_utc_to_local_kernel(
+                        ckb, ckb_offset, src_dt->get_tzinfo(), kernreq);
                 }
             }
         } else if (src_tp.get_kind() == string_kind) {
@@ -434,6 +502,13 @@ namespace {
             extra_type *e = reinterpret_cast<extra_type *>(extra);
             base_type_xdecref(e->datetime_tp);
         }
+
+        static void clone(ckernel_prefix *DYND_UNUSED(dst),
+                          const ckernel_prefix *src)
+        {
+            base_type_xincref(
+                reinterpret_cast<const extra_type *>(src)->datetime_tp);
+        }
     };
 
     void get_property_kernel_struct_single(char *DYND_UNUSED(dst),
@@ -773,6 +848,7 @@ size_t datetime_type::make_elwise_property_getter_kernel(
     throw runtime_error(ss.str());
   }
   e->base.destructor = &datetime_property_kernel_extra::destruct;
+  e->base.clone = &datetime_property_kernel_extra::clone;
   e->datetime_tp =
       static_cast<const datetime_type *>(ndt::type(this, true).release());
   return ckb_offset;
@@ -799,6 +875,7 @@ size_t datetime_type::make_elwise_property_setter_kernel(
     throw runtime_error(ss.str());
   }
   e->base.destructor = &datetime_property_kernel_extra::destruct;
+  e->base.clone = &datetime_property_kernel_extra::clone;
   e->datetime_tp =
       static_cast<const datetime_type *>(ndt::type(this, true).release());
   return ckb_offset;
@@ -930,3 +1007,14 @@ bool datetime_type::reverse_adapt_type(const ndt::type &value_tp,
   return make_datetime_adapter_arrfunc(ndt::type(this, true), value_tp, op,
                                        out_reverse, out_forward);
 }
+
+ndt::type ndt::make_datetime(const std::string &tz_name)
+{
+    if (tz_name == "abstract") {
+        return ndt::make_datetime(tz_abstract);
+    } else if (tz_name == "UTC") {
+        return ndt::make_datetime(tz_utc);
+    } else {
+        return ndt::type(new datetime_type(get_tz_info(tz_name)), false);
+    }
+}
@@ -18,6 +18,9 @@ using namespace dynd;
 
 dynd::dynd_int128::dynd_int128(float value)
 {
+#ifdef DYND_HAS_NATIVE_INT128
+    *this = dynd_int128((dynd_native_int128)value);
+#else
     bool neg = (value < 0);
     if (value < 0) {
         value = -value;
@@ -32,10 +35,14 @@ dynd::dynd_int128::dynd_int128(float value)
     if (neg) {
         negate();
     }
+#endif
 }
 
 dynd::dynd_int128::dynd_int128(double value)
 {
+#ifdef DYND_HAS_NATIVE_INT128
+    *this = dynd_int128((dynd_native_int128)value);
+#else
     bool neg = (value < 0);
     if (value < 0) {
         value = -value;
@@ -50,6 +57,7 @@ dynd::dynd_int128::dynd_int128(double value)
     if (neg) {
         negate();
     }
+#endif
 }
 
 #if defined(DYND_HAS_INT128)
@@ -76,44 +84,35 @@ dynd::dynd_int128::dynd_int128(const dynd_float128& DYND_UNUSED(value))
 #endif
 }
 
-dynd_int128 dynd::dynd_int128::operator*(uint32_t rhs) const
+dynd_int128 dynd::dynd_int128::mul_portable(const dynd_int128& lhs,
+                                             const dynd_int128& rhs)
 {
-    if ((int64_t)m_hi < 0) {
-        // TODO: fix case for minimum int, which will recurse forever
-        return -(-(*this) * rhs);
-    } else {
-        // Split the multiplication into three
-        // First product
-        uint64_t lo_partial = (m_lo&0x00000000ffffffffULL) * rhs;
-        // Second product
-        uint64_t tmp = ((m_lo&0xffffffff00000000ULL) >> 32) * rhs;
-        uint64_t lo = lo_partial + (tmp << 32);
-        uint64_t hi = (tmp >> 32) + (lo < lo_partial);
-        // Third product
-        hi += m_hi * rhs;
-        return dynd_int128(hi, lo);
-    }
+    // The low 128 bits of a twos complement product are the same as
+    // for the unsigned product
+    dynd_uint128 result = dynd_uint128::mul_portable(
+        dynd_uint128(lhs.m_hi, lhs.m_lo), dynd_uint128(rhs.m_hi, rhs.m_lo));
+    return dynd_int128(result.m_hi, result.m_lo);
 }
 
-
-dynd_int128 dynd::dynd_int128::operator/(uint32_t rhs) const
+void dynd::dynd_int128::divrem_portable(const dynd_int128& lhs,
+                                        const dynd_int128& rhs,
+                                        dynd_int128& out_div,
+                                        dynd_int128& out_rem)
 {
-    if ((int64_t)m_hi < 0) {
-        // TODO: fix case for minimum int, which will recurse forever
-        return -(-(*this) / rhs);
-    } else {
-        // Split the division into three
-        // First division (bits 127..64)
-        uint64_t hi_div = m_hi / rhs;
-        uint64_t hi_rem = m_hi % rhs;
-        // Second division (bits 63..32)
-        uint64_t mid_val = (hi_rem << 32) | (m_lo >> 32);
-        uint64_t mid_div = mid_val / rhs;
-        uint64_t mid_rem = mid_val % rhs;
-        // Third division (bits 31..0)
-        uint64_t low_val = (mid_rem << 32) | (m_lo&0x00000000ffffffffULL);
-        uint64_t low_div = low_val / rhs;
-        return dynd_int128(hi_div, (mid_div << 32) | low_div);
+    // Divide the magnitudes as unsigned, where negating the minimum
+    // value gives the right answer
+    bool lhs_neg = lhs.is_negative(), rhs_neg = rhs.is_negative();
+    dynd_int128 a = lhs_neg ? -lhs : lhs, b = rhs_neg ? -rhs : rhs;
+    dynd_uint128 div, rem;
+    dynd_uint128::divrem_portable(dynd_uint128(a.m_hi, a.m_lo),
+                                  dynd_uint128(b.m_hi, b.m_lo), div, rem);
+    out_div = dynd_int128(div.m_hi, div.m_lo);
+    if (lhs_neg != rhs_neg) {
+        out_div.negate();
+    }
+    out_rem = dynd_int128(rem.m_hi, rem.m_lo);
+    if (lhs_neg) {
+        out_rem.negate();
     }
 }
 
@@ -18,6 +18,10 @@ using namespace dynd;
 
 dynd::dynd_uint128::dynd_uint128(float value)
 {
+#ifdef DYND_HAS_NATIVE_INT128
+    *this = dynd_uint128(value < 0 ? (dynd_native_uint128)0
+                                   : (dynd_native_uint128)value);
+#else
     if (value < 0) {
         m_hi = m_lo = 0;
     } else {
@@ -29,10 +33,15 @@ dynd::dynd_uint128::dynd_uint128(float value)
             m_lo = (uint64_t)value;
         }
     }
+#endif
 }
 
 dynd::dynd_uint128::dynd_uint128(double value)
 {
+#ifdef DYND_HAS_NATIVE_INT128
+    *this = dynd_uint128(value < 0 ? (dynd_native_uint128)0
+                                   : (dynd_native_uint128)value);
+#else
     if (value < 0) {
         m_hi = m_lo = 0;
     } else {
@@ -44,6 +53,7 @@ dynd::dynd_uint128::dynd_uint128(double value)
             m_lo = (uint64_t)value;
         }
     }
+#endif
 }
 
 #if defined(DYND_HAS_INT128)
@@ -70,35 +80,72 @@ dynd::dynd_uint128::dynd_uint128(const dynd_float128& DYND_UNUSED(value))
 #endif
 }
 
-dynd_uint128 dynd::dynd_uint128::operator*(uint32_t rhs) const
+dynd_uint128 dynd::dynd_uint128::mul_portable(const dynd_uint128& lhs,
+                                               const dynd_uint128& rhs)
 {
-    // Split the multiplication into three
-    // First product
-    uint64_t lo_partial = (m_lo&0x00000000ffffffffULL) * rhs;
-    // Second product
-    uint64_t tmp = ((m_lo&0xffffffff00000000ULL) >> 32) * rhs;
-    uint64_t lo = lo_partial + (tmp << 32);
-    uint64_t hi = (tmp >> 32) + (lo < lo_partial);
-    // Third product
-    hi += m_hi * rhs;
+    // The full product of the low words, from four 32x32 bit products
+    uint64_t a0 = lhs.m_lo & 0x00000000ffffffffULL, a1 = lhs.m_lo >> 32;
+    uint64_t b0 = rhs.m_lo & 0x00000000ffffffffULL, b1 = rhs.m_lo >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0x00000000ffffffffULL) +
+                   (p10 & 0x00000000ffffffffULL);
+    uint64_t lo = (mid << 32) | (p00 & 0x00000000ffffffffULL);
+    uint64_t hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    // The products involving a high word only reach the high word
+    hi += lhs.m_hi * rhs.m_lo + lhs.m_lo * rhs.m_hi;
     return dynd_uint128(hi, lo);
 }
 
+DYND_CUDA_HOST_DEVICE static inline int leading_zeros(const dynd_uint128& value)
+{
+    uint64_t word = value.m_hi;
+    int count = 0;
+    if (word == 0) {
+        word = value.m_lo;
+        count = 64;
+    }
+    while (count < 128 && (word & 0x8000000000000000ULL) == 0) {
+        word <<= 1;
+        ++count;
+    }
+    return count;
+}
 
-dynd_uint128 dynd::dynd_uint128::operator/(uint32_t rhs) const
+void dynd::dynd_uint128::divrem_portable(const dynd_uint128& lhs,
+                                         const dynd_uint128& rhs,
+                                         dynd_uint128& out_div,
+                                         dynd_uint128& out_rem)
 {
-    // Split the division into three
-    // First division (bits 127..64)
-    uint64_t hi_div = m_hi / rhs;
-    uint64_t hi_rem = m_hi % rhs;
-    // Second division (bits 63..32)
-    uint64_t mid_val = (hi_rem << 32) | (m_lo >> 32);
-    uint64_t mid_div = mid_val / rhs;
-    uint64_t mid_rem = mid_val % rhs;
-    // Third division (bits 31..0)
-    uint64_t low_val = (mid_rem << 32) | (m_lo&0x00000000ffffffffULL);
-    uint64_t low_div = low_val / rhs;
-    return dynd_uint128(hi_div, (mid_div << 32) | low_div);
+    if (rhs.m_hi == 0 && rhs.m_lo <= 0x00000000ffffffffULL) {
+        // A divisor of at most 32 bits (including zero) takes the
+        // faster path of three 64-bit divisions
+        uint32_t rem;
+        out_div = lhs;
+        out_div.divrem(static_cast<uint32_t>(rhs.m_lo), rem);
+        out_rem = dynd_uint128(0ULL, static_cast<uint64_t>(rem));
+        return;
+    }
+
+    // Shift and subtract long division, starting at the highest bit
+    // the quotient can have
+    dynd_uint128 div(0ULL, 0ULL), rem = lhs, d = rhs;
+    int shift = leading_zeros(rhs) - leading_zeros(lhs);
+    for (int i = 0; i < shift; ++i) {
+        d.m_hi = (d.m_hi << 1) | (d.m_lo >> 63);
+        d.m_lo <<= 1;
+    }
+    for (; shift >= 0; --shift) {
+        div.m_hi = (div.m_hi << 1) | (div.m_lo >> 63);
+        div.m_lo <<= 1;
+        if (d <= rem) {
+            rem = rem - d;
+            div.m_lo |= 1;
+        }
+        d.m_lo = (d.m_lo >> 1) | (d.m_hi << 63);
+        d.m_hi >>= 1;
+    }
+    out_div = div;
+    out_rem = rem;
 }
 
 void dynd::dynd_uint128::divrem(uint32_t rhs, uint32_t& out_rem)
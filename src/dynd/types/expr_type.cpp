@@ -326,6 +326,7 @@ static size_t make_src_deref_ckernel(ckernel_builder *ckb, intptr_t ckb_offset)
     ckernel_prefix *self = ckb->alloc_ck_leaf<ckernel_prefix>(ckb_offset);
     self->set_function<expr_single_t>(&src_deref_single);
     self->destructor = &kernels::destroy_trivial_parent_ckernel;
+    self->clone = &kernels::clone_trivial_parent_ckernel;
     return ckb_offset;
 }
 
@@ -36,6 +36,12 @@ fixed_dim_type::~fixed_dim_type()
 {
 }
 
+size_t fixed_dim_type::compute_hash() const
+{
+    return detail::hash_combine(base_dim_type::compute_hash(),
+                                static_cast<size_t>(m_dim_size));
+}
+
 size_t fixed_dim_type::get_default_data_size(intptr_t ndim, const intptr_t *shape) const
 {
     if (!m_element_tp.is_builtin()) {
@@ -87,7 +93,7 @@ void fixed_dim_type::transform_child_types(type_transform_fn_t transform_fn, voi
     bool was_transformed = false;
     transform_fn(m_element_tp, extra, tmp_tp, was_transformed);
     if (was_transformed) {
-        out_transformed_tp = ndt::type(new fixed_dim_type(m_dim_size, tmp_tp), false);
+        out_transformed_tp = ndt::make_fixed_dim(m_dim_size, tmp_tp);
         out_was_transformed = true;
     } else {
         out_transformed_tp = ndt::type(this, true);
@@ -97,7 +103,7 @@ void fixed_dim_type::transform_child_types(type_transform_fn_t transform_fn, voi
 
 ndt::type fixed_dim_type::get_canonical_type() const
 {
-    return ndt::type(new fixed_dim_type(m_dim_size, m_element_tp.get_canonical_type()), false);
+    return ndt::make_fixed_dim(m_dim_size, m_element_tp.get_canonical_type());
 }
 
 ndt::type fixed_dim_type::apply_linear_index(intptr_t nindices, const irange *indices,
@@ -94,7 +94,8 @@ bool json_type::is_unique_data_owner(const char *arrmeta) const
         reinterpret_cast<const json_type_arrmeta *>(arrmeta);
     if (md->blockref != NULL &&
         (md->blockref->m_use_count != 1 ||
-         md->blockref->m_type != pod_memory_block_type)) {
+         (md->blockref->m_type != pod_memory_block_type &&
+          md->blockref->m_type != concurrent_pod_memory_block_type))) {
         return false;
     }
     return true;
@@ -160,7 +161,9 @@ void json_type::arrmeta_reset_buffers(char *arrmeta) const
 {
     const json_type_arrmeta *md =
         reinterpret_cast<const json_type_arrmeta *>(arrmeta);
-    if (md->blockref != NULL && md->blockref->m_type == pod_memory_block_type) {
+    if (md->blockref != NULL &&
+        (md->blockref->m_type == pod_memory_block_type ||
+         md->blockref->m_type == concurrent_pod_memory_block_type)) {
         memory_block_pod_allocator_api *allocator =
             get_memory_block_pod_allocator_api(md->blockref);
         allocator->reset(md->blockref);
@@ -214,8 +217,9 @@ struct string_to_json_ck
         json_type_data *out_d = reinterpret_cast<json_type_data *>(dst);
         // First copy it as a string
         ckernel_prefix *child = get_child_ckernel();
-        expr_single_t child_fn = child->get_function<expr_single_t>();
-        child_fn(dst, &src, child);
+        expr_strided_t child_fn = child->get_function<expr_strided_t>();
+        intptr_t zero_stride = 0;
+        child_fn(dst, 0, &src, &zero_stride, 1, child);
         // Then validate that it's correct JSON
         if (m_validate) {
             try { validate_json(out_d->begin, out_d->end); }
@@ -233,11 +237,44 @@ struct string_to_json_ck
         }
     }
 
+    inline void strided(char *dst, intptr_t dst_stride, const char *src,
+                        intptr_t src_stride, size_t count)
+    {
+        // Copy all the strings, then validate them in one pass
+        ckernel_prefix *child = get_child_ckernel();
+        expr_strided_t child_fn = child->get_function<expr_strided_t>();
+        child_fn(dst, dst_stride, &src, &src_stride, count, child);
+        if (!m_validate) {
+            return;
+        }
+        intptr_t invalid = validate_json_strings(dst, dst_stride, count);
+        if (invalid != (intptr_t)count) {
+            // Like assigning one at a time, the values before the
+            // invalid one are kept and it and the rest are cleared
+            json_type_data *bad_d =
+                reinterpret_cast<json_type_data *>(dst + invalid * dst_stride);
+            const char *bad_begin = bad_d->begin, *bad_end = bad_d->end;
+            for (intptr_t i = invalid; i != (intptr_t)count; ++i) {
+                json_type_data *out_d =
+                    reinterpret_cast<json_type_data *>(dst + i * dst_stride);
+                out_d->begin = NULL;
+                out_d->end = NULL;
+            }
+            // Raises the detailed error for the invalid value
+            validate_json(bad_begin, bad_end);
+        }
+    }
+
     inline void destruct_children()
     {
         // Destroy the child ckernel
         get_child_ckernel()->destroy();
     }
+
+    inline void clone_children(const self_type *src)
+    {
+        get_child_ckernel()->clone_from(src->get_child_ckernel());
+    }
 };
 } // anonymous namespace
 
@@ -265,13 +302,13 @@ size_t json_type::make_assignment_kernel(
                         ckb, ckb_offset, dst_arrmeta, string_encoding_utf_8,
                         src_arrmeta,
                         src_tp.tcast<base_string_type>()->get_encoding(),
-                        kernel_request_single, ectx);
+                        kernel_request_strided, ectx);
                 } else {
                     return make_fixedstring_to_blockref_string_assignment_kernel(
                         ckb, ckb_offset, dst_arrmeta, string_encoding_utf_8,
                         src_tp.get_data_size(),
                         src_tp.tcast<base_string_type>()->get_encoding(),
-                        kernel_request_single, ectx);
+                        kernel_request_strided, ectx);
                 }
             }
             default: {
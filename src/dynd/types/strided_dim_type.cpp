@@ -13,6 +13,7 @@
 #include <dynd/func/make_callable.hpp>
 #include <dynd/types/builtin_type_properties.hpp>
 #include <dynd/kernels/string_assignment_kernels.hpp>
+#include <dynd/types/type_intern.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -91,7 +92,7 @@ void strided_dim_type::transform_child_types(type_transform_fn_t transform_fn,
     bool was_transformed = false;
     transform_fn(m_element_tp, extra, tmp_tp, was_transformed);
     if (was_transformed) {
-        out_transformed_tp = ndt::type(new strided_dim_type(tmp_tp), false);
+        out_transformed_tp = ndt::make_strided_dim(tmp_tp);
         out_was_transformed = true;
     } else {
         out_transformed_tp = ndt::type(this, true);
@@ -101,8 +102,7 @@ void strided_dim_type::transform_child_types(type_transform_fn_t transform_fn,
 
 ndt::type strided_dim_type::get_canonical_type() const
 {
-    return ndt::type(new strided_dim_type(m_element_tp.get_canonical_type()),
-                     false);
+    return ndt::make_strided_dim(m_element_tp.get_canonical_type());
 }
 
 ndt::type strided_dim_type::apply_linear_index(intptr_t nindices,
@@ -132,10 +132,8 @@ ndt::type strided_dim_type::apply_linear_index(intptr_t nindices,
             return m_element_tp.apply_linear_index(nindices-1, indices+1,
                             current_i+1, root_tp, leading_dimension);
         } else {
-            return ndt::type(
-                new strided_dim_type(m_element_tp.apply_linear_index(
-                    nindices - 1, indices + 1, current_i + 1, root_tp, false)),
-                false);
+            return ndt::make_strided_dim(m_element_tp.apply_linear_index(
+                nindices - 1, indices + 1, current_i + 1, root_tp, false));
         }
     }
 }
@@ -835,7 +833,7 @@ ndt::type ndt::make_strided_dim(const ndt::type& element_tp)
     if (element_tp.is_builtin()) {
         return ssd.static_builtins_instance[element_tp.get_type_id()];
     } else {
-        return ndt::type(new strided_dim_type(element_tp), false);
+        return ndt::intern_type(new strided_dim_type(element_tp));
     }
 }
 
@@ -131,7 +131,8 @@ bool string_type::is_unique_data_owner(const char *arrmeta) const
     const string_type_arrmeta *md = reinterpret_cast<const string_type_arrmeta *>(arrmeta);
     if (md->blockref != NULL &&
             (md->blockref->m_use_count != 1 ||
-             md->blockref->m_type != pod_memory_block_type)) {
+             (md->blockref->m_type != pod_memory_block_type &&
+              md->blockref->m_type != concurrent_pod_memory_block_type))) {
         return false;
     }
     return true;
@@ -200,7 +201,8 @@ void string_type::arrmeta_copy_construct(char *dst_arrmeta, const char *src_arrm
 void string_type::arrmeta_reset_buffers(char *arrmeta) const
 {
     const string_type_arrmeta *md = reinterpret_cast<const string_type_arrmeta *>(arrmeta);
-    if (md->blockref != NULL && md->blockref->m_type == pod_memory_block_type) {
+    if (md->blockref != NULL && (md->blockref->m_type == pod_memory_block_type ||
+                                 md->blockref->m_type == concurrent_pod_memory_block_type)) {
         memory_block_pod_allocator_api *allocator = get_memory_block_pod_allocator_api(md->blockref);
         allocator->reset(md->blockref);
     } else {
@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <vector>
+#include <algorithm>
+
+#include <dynd/types/type_intern.hpp>
+
+#ifdef DYND_USE_STD_THREAD
+#include <mutex>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+#ifdef DYND_USE_STD_THREAD
+    typedef mutex table_mutex;
+    typedef lock_guard<mutex> table_lock;
+#else
+    struct table_mutex {};
+    struct table_lock {
+        explicit table_lock(table_mutex&) {}
+    };
+#endif
+
+    /**
+     * Hash table of the interned types, chained by bucket. The buckets
+     * hold plain pointers, a type removes itself as it is destroyed.
+     */
+    struct type_intern_table {
+        table_mutex m_mutex;
+        std::vector<std::vector<const base_type *> > m_buckets;
+        intptr_t m_count;
+
+        type_intern_table()
+            : m_buckets(64), m_count(0)
+        {
+        }
+
+        inline std::vector<const base_type *>& get_bucket(size_t hash) {
+            return m_buckets[hash & (m_buckets.size() - 1)];
+        }
+
+        void insert(const base_type *tp)
+        {
+            if (m_count >= 2 * (intptr_t)m_buckets.size()) {
+                // Double the bucket count, keeping it a power of two
+                std::vector<std::vector<const base_type *> > buckets(
+                    2 * m_buckets.size());
+                buckets.swap(m_buckets);
+                for (size_t i = 0; i < buckets.size(); ++i) {
+                    for (size_t j = 0; j < buckets[i].size(); ++j) {
+                        get_bucket(buckets[i][j]->get_hash())
+                            .push_back(buckets[i][j]);
+                    }
+                }
+            }
+            get_bucket(tp->get_hash()).push_back(tp);
+            ++m_count;
+        }
+
+        void remove(const base_type *tp)
+        {
+            std::vector<const base_type *>& bucket = get_bucket(tp->get_hash());
+            std::vector<const base_type *>::iterator it =
+                std::find(bucket.begin(), bucket.end(), tp);
+            if (it != bucket.end()) {
+                *it = bucket.back();
+                bucket.pop_back();
+                --m_count;
+            }
+        }
+    };
+
+    /**
+     * The table is allocated once and never freed, so types in
+     * static storage can still remove themselves from it while
+     * the program exits.
+     */
+    type_intern_table& get_table()
+    {
+        static type_intern_table *table = new type_intern_table;
+        return *table;
+    }
+} // anonymous namespace
+
+namespace dynd { namespace detail {
+    struct type_intern_access {
+        /**
+         * Acquires a reference to ``tp`` unless it is already being
+         * destroyed. Must be called with the table locked, which
+         * keeps a dying type's memory alive, as its destructor
+         * removes it from the table.
+         */
+        static bool try_incref(const base_type *tp)
+        {
+            if (++tp->m_use_count == 1) {
+                // The count had reached zero, so the type is being
+                // destroyed, put the count back without freeing it
+                --tp->m_use_count;
+                return false;
+            }
+            return true;
+        }
+
+        static void set_interned(const base_type *tp)
+        {
+            const_cast<base_type *>(tp)->m_interned = true;
+        }
+    };
+}} // namespace dynd::detail
+
+ndt::type ndt::intern_type(const base_type *tp)
+{
+    if (is_builtin_type(tp) || tp->is_interned()) {
+        return ndt::type(tp, false);
+    }
+
+    // Compute the hash outside the lock, as it visits the child types
+    size_t hash = tp->get_hash();
+    type_id_t type_id = tp->get_type_id();
+    const base_type *found = NULL;
+    // References to the candidates already compared. These are held
+    // until the end so their addresses can't be reused by new types.
+    std::vector<const base_type *> checked;
+    type_intern_table& table = get_table();
+    while (found == NULL) {
+        std::vector<const base_type *> candidates;
+        {
+            table_lock lock(table.m_mutex);
+            std::vector<const base_type *>& bucket = table.get_bucket(hash);
+            for (size_t i = 0; i < bucket.size(); ++i) {
+                const base_type *candidate = bucket[i];
+                if (candidate->get_hash() == hash &&
+                        candidate->get_type_id() == type_id &&
+                        std::find(checked.begin(), checked.end(), candidate) ==
+                            checked.end() &&
+                        detail::type_intern_access::try_incref(candidate)) {
+                    candidates.push_back(candidate);
+                }
+            }
+            if (candidates.empty()) {
+                // No equal type was interned, so this becomes the one
+                detail::type_intern_access::set_interned(tp);
+                table.insert(tp);
+                break;
+            }
+        }
+        // Compare without the lock, as comparing types may build
+        // ckernels, which may create types
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (found == NULL && *candidates[i] == *tp) {
+                found = candidates[i];
+            } else {
+                checked.push_back(candidates[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < checked.size(); ++i) {
+        base_type_decref(checked[i]);
+    }
+    if (found != NULL) {
+        base_type_decref(tp);
+        return ndt::type(found, false);
+    } else {
+        return ndt::type(tp, false);
+    }
+}
+
+intptr_t ndt::get_interned_type_count()
+{
+    type_intern_table& table = get_table();
+    table_lock lock(table.m_mutex);
+    return table.m_count;
+}
+
+void detail::unintern_type(const base_type *tp)
+{
+    type_intern_table& table = get_table();
+    table_lock lock(table.m_mutex);
+    table.remove(tp);
+}
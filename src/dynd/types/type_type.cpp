@@ -130,6 +130,13 @@ namespace {
             extra_type *e = reinterpret_cast<extra_type *>(extra);
             base_type_xdecref(e->src_string_dt);
         }
+
+        static void clone(ckernel_prefix *DYND_UNUSED(dst),
+                          const ckernel_prefix *src)
+        {
+            base_type_xincref(
+                reinterpret_cast<const extra_type *>(src)->src_string_dt);
+        }
     };
 
     struct type_to_string_kernel_extra {
@@ -161,6 +168,13 @@ namespace {
             extra_type *e = reinterpret_cast<extra_type *>(extra);
             base_type_xdecref(e->dst_string_dt);
         }
+
+        static void clone(ckernel_prefix *DYND_UNUSED(dst),
+                          const ckernel_prefix *src)
+        {
+            base_type_xincref(
+                reinterpret_cast<const extra_type *>(src)->dst_string_dt);
+        }
     };
 } // anonymous namespace
 
@@ -183,6 +197,7 @@ size_t type_type::make_assignment_kernel(
           ckb->alloc_ck_leaf<string_to_type_kernel_extra>(ckb_offset);
       e->base.set_function<expr_single_t>(&string_to_type_kernel_extra::single);
       e->base.destructor = &string_to_type_kernel_extra::destruct;
+      e->base.clone = &string_to_type_kernel_extra::clone;
       // The kernel data owns a reference to this type
       e->src_string_dt =
           static_cast<const base_string_type *>(ndt::type(src_tp).release());
@@ -201,6 +216,7 @@ size_t type_type::make_assignment_kernel(
           ckb->alloc_ck_leaf<type_to_string_kernel_extra>(ckb_offset);
       e->base.set_function<expr_single_t>(&type_to_string_kernel_extra::single);
       e->base.destructor = &type_to_string_kernel_extra::destruct;
+      e->base.clone = &type_to_string_kernel_extra::clone;
       // The kernel data owns a reference to this type
       e->dst_string_dt =
           static_cast<const base_string_type *>(ndt::type(dst_tp).release());
@@ -0,0 +1,475 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <map>
+#include <limits>
+
+#include <dynd/types/tz_database.hpp>
+#include <dynd/types/date_util.hpp>
+
+#ifdef DYND_USE_STD_THREAD
+#include <mutex>
+#endif
+
+using namespace std;
+using namespace dynd;
+
+// Transitions further than this many seconds from the epoch are dropped,
+// so that they and their local equivalents fit in int64 ticks
+#define DYND_TZ_MAX_TRANSITION_SECONDS (900000000000LL)
+// The POSIX rules in the TZif footer are expanded through this year
+#define DYND_TZ_RULE_LAST_YEAR 2100
+
+namespace {
+    inline int64_t read_be(const char *p, int nbytes)
+    {
+        const unsigned char *up = reinterpret_cast<const unsigned char *>(p);
+        uint64_t result = 0;
+        for (int i = 0; i < nbytes; ++i) {
+            result = (result << 8) | up[i];
+        }
+        // Sign extend
+        if (nbytes < 8 && (up[0] & 0x80) != 0) {
+            result |= ~uint64_t(0) << (8 * nbytes);
+        }
+        return static_cast<int64_t>(result);
+    }
+
+    struct tzif_header {
+        char version;
+        int64_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt;
+
+        /** The size of the data block following the header */
+        int64_t get_data_size(int time_size) const {
+            return timecnt * time_size + timecnt + typecnt * 6 + charcnt +
+                   leapcnt * (time_size + 4) + isstdcnt + isutcnt;
+        }
+    };
+
+    void throw_invalid_tzif(const std::string& name, const char *reason)
+    {
+        stringstream ss;
+        ss << "invalid zoneinfo file for time zone " << name << ": " << reason;
+        throw runtime_error(ss.str());
+    }
+
+    const char *parse_tzif_header(const std::string &name, const char *begin,
+                                  const char *end, tzif_header &out_hdr)
+    {
+        if (end - begin < 44 || memcmp(begin, "TZif", 4) != 0) {
+            throw_invalid_tzif(name, "bad header");
+        }
+        out_hdr.version = begin[4];
+        out_hdr.isutcnt = read_be(begin + 20, 4);
+        out_hdr.isstdcnt = read_be(begin + 24, 4);
+        out_hdr.leapcnt = read_be(begin + 28, 4);
+        out_hdr.timecnt = read_be(begin + 32, 4);
+        out_hdr.typecnt = read_be(begin + 36, 4);
+        out_hdr.charcnt = read_be(begin + 40, 4);
+        if (out_hdr.isutcnt < 0 || out_hdr.isstdcnt < 0 ||
+                out_hdr.leapcnt < 0 || out_hdr.timecnt < 0 ||
+                out_hdr.typecnt <= 0 || out_hdr.charcnt < 0) {
+            throw_invalid_tzif(name, "bad header counts");
+        }
+        return begin + 44;
+    }
+
+    /** One transition rule of a POSIX TZ string, like "M3.2.0/2" */
+    struct posix_tz_rule {
+        // 'M' for month.week.weekday, 'J' for 1-based day of year
+        // skipping Feb 29, 'n' for 0-based day of year
+        char kind;
+        int month, week, weekday, day;
+        int32_t time;
+
+        /** The day of ``year`` the rule falls on, as days since 1970 */
+        int32_t get_days(int year) const
+        {
+            if (kind == 'M') {
+                int32_t first = date_ymd::to_days(year, month, 1);
+                // Jan 1, 1970 was a Thursday, weekday 4 counting from Sunday
+                int first_weekday = (first + 4) % 7;
+                if (first_weekday < 0) {
+                    first_weekday += 7;
+                }
+                int mday = 1 + (weekday - first_weekday + 7) % 7 + (week - 1) * 7;
+                int month_length = date_ymd::get_month_length(year, month);
+                while (mday > month_length) {
+                    mday -= 7;
+                }
+                return first + mday - 1;
+            } else if (kind == 'J') {
+                int yday = day - 1;
+                if (yday >= 59 && date_ymd::is_leap_year(year)) {
+                    ++yday;
+                }
+                return date_ymd::to_days(year, 1, 1) + yday;
+            } else {
+                return date_ymd::to_days(year, 1, 1) + day;
+            }
+        }
+    };
+
+    /** A POSIX TZ string, like "EST5EDT,M3.2.0,M11.1.0" */
+    struct posix_tz {
+        // UTC offsets in seconds, east positive
+        int32_t std_offset, dst_offset;
+        bool has_rules;
+        posix_tz_rule start, end;
+    };
+
+    bool parse_posix_number(const char *&begin, const char *end, int &out_val)
+    {
+        if (begin == end || *begin < '0' || *begin > '9') {
+            return false;
+        }
+        out_val = 0;
+        while (begin < end && *begin >= '0' && *begin <= '9') {
+            out_val = 10 * out_val + (*begin - '0');
+            ++begin;
+        }
+        return true;
+    }
+
+    bool parse_posix_name(const char *&begin, const char *end)
+    {
+        if (begin < end && *begin == '<') {
+            const char *close = std::find(begin, end, '>');
+            if (close == end) {
+                return false;
+            }
+            begin = close + 1;
+            return true;
+        }
+        const char *name_begin = begin;
+        while (begin < end && isalpha(*begin)) {
+            ++begin;
+        }
+        return begin - name_begin >= 3;
+    }
+
+    /** Parses [+-]hh[:mm[:ss]] as seconds */
+    bool parse_posix_time(const char *&begin, const char *end,
+                          int32_t &out_seconds)
+    {
+        int sign = 1;
+        if (begin < end && (*begin == '+' || *begin == '-')) {
+            sign = (*begin == '-') ? -1 : 1;
+            ++begin;
+        }
+        int h = 0, m = 0, s = 0;
+        if (!parse_posix_number(begin, end, h)) {
+            return false;
+        }
+        if (begin < end && *begin == ':') {
+            ++begin;
+            if (!parse_posix_number(begin, end, m)) {
+                return false;
+            }
+            if (begin < end && *begin == ':') {
+                ++begin;
+                if (!parse_posix_number(begin, end, s)) {
+                    return false;
+                }
+            }
+        }
+        out_seconds = sign * (h * 3600 + m * 60 + s);
+        return true;
+    }
+
+    bool parse_posix_rule(const char *&begin, const char *end,
+                          posix_tz_rule &out_rule)
+    {
+        if (begin == end) {
+            return false;
+        }
+        out_rule.month = out_rule.week = out_rule.weekday = out_rule.day = 0;
+        if (*begin == 'M') {
+            out_rule.kind = 'M';
+            ++begin;
+            if (!parse_posix_number(begin, end, out_rule.month) ||
+                    begin == end || *begin++ != '.' ||
+                    !parse_posix_number(begin, end, out_rule.week) ||
+                    begin == end || *begin++ != '.' ||
+                    !parse_posix_number(begin, end, out_rule.weekday) ||
+                    out_rule.month < 1 || out_rule.month > 12 ||
+                    out_rule.week < 1 || out_rule.week > 5 ||
+                    out_rule.weekday > 6) {
+                return false;
+            }
+        } else if (*begin == 'J') {
+            out_rule.kind = 'J';
+            ++begin;
+            if (!parse_posix_number(begin, end, out_rule.day) ||
+                    out_rule.day < 1 || out_rule.day > 365) {
+                return false;
+            }
+        } else {
+            out_rule.kind = 'n';
+            if (!parse_posix_number(begin, end, out_rule.day) ||
+                    out_rule.day > 365) {
+                return false;
+            }
+        }
+        out_rule.time = 2 * 3600;
+        if (begin < end && *begin == '/') {
+            ++begin;
+            return parse_posix_time(begin, end, out_rule.time);
+        }
+        return true;
+    }
+
+    bool parse_posix_tz(const char *begin, const char *end, posix_tz &out_tz)
+    {
+        int32_t seconds_west;
+        out_tz.has_rules = false;
+        if (!parse_posix_name(begin, end) ||
+                !parse_posix_time(begin, end, seconds_west)) {
+            return false;
+        }
+        out_tz.std_offset = out_tz.dst_offset = -seconds_west;
+        if (begin == end) {
+            return true;
+        }
+        if (!parse_posix_name(begin, end)) {
+            return false;
+        }
+        out_tz.dst_offset = out_tz.std_offset + 3600;
+        if (begin < end && *begin != ',') {
+            if (!parse_posix_time(begin, end, seconds_west)) {
+                return false;
+            }
+            out_tz.dst_offset = -seconds_west;
+        }
+        if (begin == end || *begin++ != ',' ||
+                !parse_posix_rule(begin, end, out_tz.start) ||
+                begin == end || *begin++ != ',' ||
+                !parse_posix_rule(begin, end, out_tz.end) || begin != end) {
+            return false;
+        }
+        out_tz.has_rules = true;
+        return true;
+    }
+
+    /**
+     * Appends the transitions of ``tz`` after the last one already
+     * in the table, through DYND_TZ_RULE_LAST_YEAR.
+     */
+    void append_posix_tz_transitions(const posix_tz &tz,
+                                     std::vector<int64_t> &transitions,
+                                     std::vector<int32_t> &offsets)
+    {
+        int first_year = 1970;
+        if (!transitions.empty()) {
+            date_ymd ymd;
+            ymd.set_from_days(static_cast<int32_t>(
+                transitions.back() / (24 * 60 * 60) - 1));
+            first_year = ymd.year;
+        }
+        for (int year = first_year; year <= DYND_TZ_RULE_LAST_YEAR; ++year) {
+            // The start is given in standard time, the end in daylight time
+            std::pair<int64_t, int32_t> year_transitions[2];
+            year_transitions[0].first =
+                tz.start.get_days(year) * 86400LL + tz.start.time -
+                tz.std_offset;
+            year_transitions[0].second = tz.dst_offset;
+            year_transitions[1].first =
+                tz.end.get_days(year) * 86400LL + tz.end.time - tz.dst_offset;
+            year_transitions[1].second = tz.std_offset;
+            std::sort(year_transitions, year_transitions + 2);
+            for (int i = 0; i < 2; ++i) {
+                if ((transitions.empty() ||
+                        year_transitions[i].first > transitions.back()) &&
+                        year_transitions[i].second != offsets.back()) {
+                    transitions.push_back(year_transitions[i].first);
+                    offsets.push_back(year_transitions[i].second);
+                }
+            }
+        }
+    }
+} // anonymous namespace
+
+tz_info::tz_info(const std::string& name, const char *tzif_begin,
+                 const char *tzif_end)
+    : m_name(name)
+{
+    tzif_header hdr;
+    const char *begin = parse_tzif_header(name, tzif_begin, tzif_end, hdr);
+    int time_size = 4;
+    if (hdr.version >= '2') {
+        // Skip the version 1 data, using the 64-bit data which follows
+        int64_t v1_size = hdr.get_data_size(4);
+        if (tzif_end - begin < v1_size) {
+            throw_invalid_tzif(name, "truncated data");
+        }
+        begin = parse_tzif_header(name, begin + v1_size, tzif_end, hdr);
+        time_size = 8;
+    }
+    if (tzif_end - begin < hdr.get_data_size(time_size)) {
+        throw_invalid_tzif(name, "truncated data");
+    }
+    const char *times = begin;
+    const char *type_indices = times + hdr.timecnt * time_size;
+    const char *types = type_indices + hdr.timecnt;
+    const char *footer = begin + hdr.get_data_size(time_size);
+
+    // Transitions in seconds and offsets in seconds, dropping transitions
+    // which don't change the offset, like abbreviation changes
+    std::vector<int64_t> transitions;
+    std::vector<int32_t> offsets;
+    offsets.push_back(static_cast<int32_t>(read_be(types, 4)));
+    for (int64_t i = 0; i < hdr.timecnt; ++i) {
+        int64_t t = read_be(times + i * time_size, time_size);
+        unsigned char type_index =
+            static_cast<unsigned char>(type_indices[i]);
+        if (type_index >= hdr.typecnt) {
+            throw_invalid_tzif(name, "bad local time type index");
+        }
+        int32_t offset =
+            static_cast<int32_t>(read_be(types + 6 * type_index, 4));
+        if (t < -DYND_TZ_MAX_TRANSITION_SECONDS) {
+            offsets.back() = offset;
+        } else if (t <= DYND_TZ_MAX_TRANSITION_SECONDS &&
+                       offset != offsets.back()) {
+            transitions.push_back(t);
+            offsets.push_back(offset);
+        }
+    }
+
+    // The footer is "\n<POSIX TZ string>\n", for times past the table
+    if (time_size == 8 && footer < tzif_end && *footer == '\n') {
+        const char *footer_end = std::find(footer + 1, tzif_end, '\n');
+        posix_tz tz;
+        if (footer_end != tzif_end &&
+                parse_posix_tz(footer + 1, footer_end, tz) && tz.has_rules) {
+            append_posix_tz_transitions(tz, transitions, offsets);
+        }
+    }
+
+    m_utc_transitions.resize(transitions.size());
+    m_local_transitions.resize(transitions.size());
+    m_offsets.resize(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        m_offsets[i] = offsets[i] * DYND_TICKS_PER_SECOND;
+    }
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        m_utc_transitions[i] = transitions[i] * DYND_TICKS_PER_SECOND;
+        m_local_transitions[i] =
+            m_utc_transitions[i] + max(m_offsets[i], m_offsets[i + 1]);
+    }
+}
+
+void tz_info::get_interval(const std::vector<int64_t>& transitions,
+                           int64_t ticks, tz_interval &out_interval) const
+{
+    size_t i = std::upper_bound(transitions.begin(), transitions.end(),
+                                ticks) - transitions.begin();
+    out_interval.begin =
+        (i > 0) ? transitions[i - 1] : std::numeric_limits<int64_t>::min();
+    out_interval.end = (i < transitions.size())
+                           ? transitions[i]
+                           : std::numeric_limits<int64_t>::max();
+    out_interval.offset = m_offsets[i];
+}
+
+namespace {
+#ifdef DYND_USE_STD_THREAD
+    typedef mutex tz_mutex;
+    typedef lock_guard<mutex> tz_lock;
+#else
+    struct tz_mutex {};
+    struct tz_lock {
+        explicit tz_lock(tz_mutex&) {}
+    };
+#endif
+
+    /**
+     * The loaded zones, which are never freed, so the types
+     * referring to them can hold plain pointers.
+     */
+    struct tz_cache {
+        tz_mutex m_mutex;
+        std::map<std::string, const tz_info *> m_zones;
+    };
+
+    tz_cache& get_tz_cache()
+    {
+        static tz_cache *cache = new tz_cache;
+        return *cache;
+    }
+
+    bool is_valid_tz_name(const std::string& name)
+    {
+        if (name.empty() || name[0] == '/' || name[0] == '.') {
+            return false;
+        }
+        for (size_t i = 0; i < name.size(); ++i) {
+            char c = name[i];
+            if (!(isalnum(c) || c == '/' || c == '_' || c == '-' ||
+                  c == '+' || (c == '.' && name[i - 1] != '/'))) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // anonymous namespace
+
+const tz_info *dynd::get_tz_info(const std::string& name)
+{
+    tz_cache& cache = get_tz_cache();
+    tz_lock lock(cache.m_mutex);
+    std::map<std::string, const tz_info *>::const_iterator it =
+        cache.m_zones.find(name);
+    if (it != cache.m_zones.end()) {
+        return it->second;
+    }
+
+    if (!is_valid_tz_name(name)) {
+        stringstream ss;
+        ss << "invalid time zone name \"" << name << "\"";
+        throw runtime_error(ss.str());
+    }
+    const char *tzdir = getenv("TZDIR");
+    std::string path = (tzdir != NULL && *tzdir != '\0')
+                           ? std::string(tzdir)
+                           : std::string("/usr/share/zoneinfo");
+    path += "/";
+    path += name;
+    ifstream f(path.c_str(), ios::in | ios::binary);
+    if (!f.good()) {
+        stringstream ss;
+        ss << "could not find time zone \"" << name << "\" in the tz database";
+        throw runtime_error(ss.str());
+    }
+    std::string contents((istreambuf_iterator<char>(f)),
+                         istreambuf_iterator<char>());
+    const tz_info *tz = new tz_info(name, contents.data(),
+                                    contents.data() + contents.size());
+    cache.m_zones[name] = tz;
+    return tz;
+}
+
+std::string dynd::tz_offset_to_str(int64_t offset)
+{
+    int64_t minutes = offset / DYND_TICKS_PER_MINUTE;
+    char buf[8];
+    buf[0] = (minutes < 0) ? '-' : '+';
+    if (minutes < 0) {
+        minutes = -minutes;
+    }
+    buf[1] = static_cast<char>('0' + (minutes / 600) % 10);
+    buf[2] = static_cast<char>('0' + (minutes / 60) % 10);
+    buf[3] = ':';
+    buf[4] = static_cast<char>('0' + (minutes % 60) / 10);
+    buf[5] = static_cast<char>('0' + minutes % 10);
+    return std::string(buf, 6);
+}
@@ -18,6 +18,7 @@
 #include <dynd/kernels/string_assignment_kernels.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/func/make_callable.hpp>
+#include <dynd/types/type_intern.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -73,6 +74,7 @@ bool var_dim_type::is_unique_data_owner(const char *arrmeta) const
     if (md->blockref != NULL &&
             (md->blockref->m_use_count != 1 ||
              (md->blockref->m_type != pod_memory_block_type &&
+              md->blockref->m_type != concurrent_pod_memory_block_type &&
               md->blockref->m_type != zeroinit_memory_block_type &&
               md->blockref->m_type != objectarray_memory_block_type))) {
         return false;
@@ -91,7 +93,7 @@ void var_dim_type::transform_child_types(type_transform_fn_t transform_fn, void
     bool was_transformed = false;
     transform_fn(m_element_tp, extra, tmp_tp, was_transformed);
     if (was_transformed) {
-        out_transformed_tp = ndt::type(new var_dim_type(tmp_tp), false);
+        out_transformed_tp = ndt::make_var_dim(tmp_tp);
         out_was_transformed = true;
     } else {
         out_transformed_tp = ndt::type(this, true);
@@ -100,7 +102,7 @@ void var_dim_type::transform_child_types(type_transform_fn_t transform_fn, void
 
 ndt::type var_dim_type::get_canonical_type() const
 {
-    return ndt::type(new var_dim_type(m_element_tp.get_canonical_type()), false);
+    return ndt::make_var_dim(m_element_tp.get_canonical_type());
 }
 
 ndt::type var_dim_type::apply_linear_index(intptr_t nindices, const irange *indices,
@@ -123,7 +125,7 @@ ndt::type var_dim_type::apply_linear_index(intptr_t nindices, const irange *indi
         } else {
             if (leading_dimension) {
                 // In leading dimensions, we convert var_dim to strided_dim
-                return ndt::type(new strided_dim_type(m_element_tp), false);
+                return ndt::make_strided_dim(m_element_tp);
             } else {
                 if (indices->is_nop()) {
                     // If the indexing operation does nothing, then leave things unchanged
@@ -149,13 +151,13 @@ ndt::type var_dim_type::apply_linear_index(intptr_t nindices, const irange *indi
                 // In leading dimensions, we convert var_dim to strided_dim
                 ndt::type edt = m_element_tp.apply_linear_index(nindices-1, indices+1,
                                 current_i+1, root_tp, false);
-                return ndt::type(new strided_dim_type(edt), false);
+                return ndt::make_strided_dim(edt);
             } else {
                 if (indices->is_nop()) {
                     // If the indexing operation does nothing, then leave things unchanged
                     ndt::type edt = m_element_tp.apply_linear_index(nindices-1, indices+1,
                                     current_i+1, root_tp, false);
-                    return ndt::type(new var_dim_type(edt), false);
+                    return ndt::make_var_dim(edt);
                 } else {
                     // TODO: sliced_var_dim_type
                     throw runtime_error("TODO: implement var_dim_type::apply_linear_index for general slices");
@@ -478,7 +480,8 @@ void var_dim_type::arrmeta_reset_buffers(char *arrmeta) const
 
     if (md->blockref != NULL) {
         uint32_t br_type = md->blockref->m_type;
-        if (br_type == zeroinit_memory_block_type || br_type == pod_memory_block_type) {
+        if (br_type == zeroinit_memory_block_type || br_type == pod_memory_block_type ||
+                br_type == concurrent_pod_memory_block_type) {
             memory_block_pod_allocator_api *allocator =
                             get_memory_block_pod_allocator_api(md->blockref);
             allocator->reset(md->blockref);
@@ -761,7 +764,88 @@ void ndt::var_dim_element_resize(const type& tp,
     }
 }
 
+bool ndt::var_dim_rows_consecutive(const char *arrmeta, const char *data,
+        intptr_t stride, intptr_t count, char **out_values,
+        intptr_t *out_total)
+{
+    const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
+    char *values = NULL;
+    intptr_t total = 0;
+    for (intptr_t i = 0; i < count; ++i, data += stride) {
+        const var_dim_type_data *d = reinterpret_cast<const var_dim_type_data *>(data);
+        if (d->begin == NULL) {
+            return false;
+        }
+        if (d->size == 0) {
+            // An empty row can point anywhere
+            continue;
+        }
+        if (values == NULL) {
+            values = d->begin + md->offset;
+        } else if (d->begin + md->offset != values + total * md->stride) {
+            return false;
+        }
+        total += d->size;
+    }
+    *out_values = values;
+    *out_total = total;
+    return true;
+}
+
+bool ndt::var_dim_rows_make_consecutive(const char *arrmeta, char *data,
+        intptr_t stride, intptr_t count, size_t alignment,
+        const char *src_data, intptr_t src_stride, intptr_t total,
+        char **out_values)
+{
+    const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
+    bool uninitialized = true;
+    for (intptr_t i = 0; i != count && uninitialized; ++i) {
+        uninitialized = reinterpret_cast<const var_dim_type_data *>(
+                            data + i * stride)->begin == NULL;
+    }
+    if (uninitialized) {
+        memory_block_data *memblock = md->blockref;
+        if (md->offset != 0 ||
+                (memblock->m_type != pod_memory_block_type &&
+                 memblock->m_type != zeroinit_memory_block_type)) {
+            return false;
+        }
+        memory_block_pod_allocator_api *allocator =
+                        get_memory_block_pod_allocator_api(memblock);
+        char *values = NULL, *values_end = NULL;
+        allocator->allocate(memblock, total * md->stride, alignment, &values,
+                            &values_end);
+        // Carve the rows out of the one allocation
+        char *row = values;
+        for (intptr_t i = 0; i != count; ++i) {
+            var_dim_type_data *d =
+                reinterpret_cast<var_dim_type_data *>(data + i * stride);
+            d->begin = row;
+            d->size = reinterpret_cast<const var_dim_type_data *>(
+                          src_data + i * src_stride)->size;
+            row += d->size * md->stride;
+        }
+        *out_values = values;
+        return true;
+    }
+
+    intptr_t dst_total;
+    if (!var_dim_rows_consecutive(arrmeta, data, stride, count, out_values,
+                                  &dst_total) || dst_total != total) {
+        return false;
+    }
+    for (intptr_t i = 0; i != count; ++i) {
+        if (reinterpret_cast<const var_dim_type_data *>(
+                    data + i * stride)->size !=
+                reinterpret_cast<const var_dim_type_data *>(
+                    src_data + i * src_stride)->size) {
+            return false;
+        }
+    }
+    return true;
+}
+
 ndt::type ndt::make_var_dim(const ndt::type &element_tp)
 {
-  return ndt::type(new var_dim_type(element_tp), false);
+  return ndt::intern_type(new var_dim_type(element_tp));
 }
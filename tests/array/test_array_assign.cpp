@@ -583,3 +583,30 @@ INSTANTIATE_TYPED_TEST_CASE_P(Default, ArrayAssign, DefaultMemoryPairs);
 #ifdef DYND_CUDA
 INSTANTIATE_TYPED_TEST_CASE_P(CUDA, ArrayAssign, CUDAMemoryPairs);
 #endif // DYND_CUDA
+
+TEST(ArrayAssign, UnitStrideLoops) {
+    nd::array a, b;
+    int v[41];
+    for (int i = 0; i < 41; ++i) {
+        v[i] = 3 * i - 20;
+    }
+    a = v;
+
+    // Contiguous conversion
+    b = nd::empty(41, ndt::make_type<double>());
+    b.vals() = a;
+    for (int i = 0; i < 41; ++i) {
+        EXPECT_EQ(3 * i - 20, b(i).as<double>());
+    }
+    // Broadcast scalar
+    b.vals() = 1.5f;
+    for (int i = 0; i < 41; ++i) {
+        EXPECT_EQ(1.5, b(i).as<double>());
+    }
+    // Strided source
+    b = nd::empty(14, ndt::make_type<int64_t>());
+    b.vals() = a(irange().by(3));
+    for (int i = 0; i < 14; ++i) {
+        EXPECT_EQ(9 * i - 20, b(i).as<int64_t>());
+    }
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/memblock/array_data_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ArrayDataAllocator, DataAlignment) {
+    nd::array a = nd::empty(100, ndt::make_type<float>());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.get_readonly_originptr()) %
+                      DYND_ARRAY_DATA_ALIGNMENT);
+    a = nd::empty(30, 5, ndt::make_type<int16_t>());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.get_readonly_originptr()) %
+                      DYND_ARRAY_DATA_ALIGNMENT);
+    // Tiny arrays only get their natural alignment
+    a = nd::empty(3, ndt::make_type<double>());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.get_readonly_originptr()) % 8);
+}
+
+TEST(ArrayDataAllocator, LargeArray) {
+    // Big enough to be mapped from the OS
+    intptr_t n = 3 * DYND_ARRAY_HUGE_PAGE_THRESHOLD / sizeof(int32_t);
+    nd::array a = nd::empty(n, ndt::make_type<int32_t>());
+    int32_t *data = reinterpret_cast<int32_t *>(a.get_readwrite_originptr());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data) % DYND_ARRAY_DATA_ALIGNMENT);
+    for (intptr_t i = 0; i < n; ++i) {
+        data[i] = (int32_t)i;
+    }
+    EXPECT_EQ(0, a(0).as<int32_t>());
+    EXPECT_EQ(n - 1, a(n - 1).as<int32_t>());
+}
+
+namespace {
+struct counting_allocator {
+    array_data_allocator base;
+    const array_data_allocator *inner;
+    intptr_t allocated, freed;
+};
+
+void *counting_allocate(const array_data_allocator *self, size_t size,
+                        size_t alignment, uintptr_t *out_cookie)
+{
+    counting_allocator *ca = const_cast<counting_allocator *>(
+        reinterpret_cast<const counting_allocator *>(self));
+    ++ca->allocated;
+    return ca->inner->allocate(ca->inner, size, alignment, out_cookie);
+}
+
+void counting_deallocate(const array_data_allocator *self, void *ptr,
+                         size_t size, uintptr_t cookie)
+{
+    counting_allocator *ca = const_cast<counting_allocator *>(
+        reinterpret_cast<const counting_allocator *>(self));
+    ++ca->freed;
+    ca->inner->deallocate(ca->inner, ptr, size, cookie);
+}
+} // anonymous namespace
+
+TEST(ArrayDataAllocator, CustomAllocator) {
+    counting_allocator ca = {{&counting_allocate, &counting_deallocate},
+                             get_array_data_allocator(), 0, 0};
+    const array_data_allocator *prev = set_array_data_allocator(&ca.base);
+    {
+        nd::array a = nd::empty(10, ndt::make_type<int>());
+        nd::array b = nd::empty(2, 3, ndt::make_type<double>());
+        EXPECT_EQ(2, ca.allocated);
+        EXPECT_EQ(0, ca.freed);
+    }
+    // Restore before checking, so a failure doesn't leave it installed
+    set_array_data_allocator(prev);
+    EXPECT_EQ(2, ca.freed);
+    // Arrays free with the allocator they came from
+    nd::array c;
+    prev = set_array_data_allocator(&ca.base);
+    c = nd::empty(4, ndt::make_type<int>());
+    set_array_data_allocator(prev);
+    c.vals() = 5;
+    EXPECT_EQ(5, c(3).as<int>());
+    EXPECT_EQ(3, ca.allocated);
+    c = nd::array();
+    EXPECT_EQ(3, ca.freed);
+}
+
+TEST(ArrayDataAllocator, InterleavePolicy) {
+    system_array_data_allocator sys;
+    init_system_array_data_allocator(&sys, 64 * 1024, array_numa_interleave);
+    const array_data_allocator *prev = set_array_data_allocator(&sys.base);
+    nd::array a = nd::empty(100000, ndt::make_type<int>());
+    set_array_data_allocator(prev);
+    int *data = reinterpret_cast<int *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 100000; ++i) {
+        data[i] = i;
+    }
+    EXPECT_EQ(0, a(0).as<int>());
+    EXPECT_EQ(99999, a(99999).as<int>());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.get_readonly_originptr()) %
+                      DYND_ARRAY_DATA_ALIGNMENT);
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/parallel.hpp>
+#include <dynd/memblock/concurrent_pod_memory_block.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ConcurrentPODMemoryBlock, AllocateResize) {
+    memory_block_ptr mb = make_concurrent_pod_memory_block(256, 32);
+    memory_block_pod_allocator_api *api =
+        get_memory_block_pod_allocator_api(mb.get());
+    char *begin, *end;
+    api->allocate(mb.get(), 10, 8, &begin, &end);
+    EXPECT_EQ(10, end - begin);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(begin) % 8);
+    memcpy(begin, "0123456789", 10);
+    // Growing past the sub-arena copies the data along
+    api->resize(mb.get(), 1000, &begin, &end);
+    EXPECT_EQ(1000, end - begin);
+    EXPECT_EQ(0, memcmp(begin, "0123456789", 10));
+    // Only the most recent allocation can be resized
+    char *begin2, *end2;
+    api->allocate(mb.get(), 4, 1, &begin2, &end2);
+    EXPECT_THROW(api->resize(mb.get(), 8, &begin, &end), runtime_error);
+    api->resize(mb.get(), 2, &begin2, &end2);
+    EXPECT_EQ(2, end2 - begin2);
+    api->finalize(mb.get());
+    EXPECT_THROW(api->allocate(mb.get(), 4, 1, &begin2, &end2), runtime_error);
+    // After a reset, it can be used again
+    api->reset(mb.get());
+    api->allocate(mb.get(), 4, 1, &begin2, &end2);
+    EXPECT_EQ(4, end2 - begin2);
+}
+
+TEST(ConcurrentPODMemoryBlock, AlternatingBlocks) {
+    // A thread filling several blocks in turn keeps each one's
+    // allocations and resizes straight
+    const int nblocks = 6;
+    memory_block_ptr mb[nblocks];
+    char *begin[nblocks], *end[nblocks];
+    for (int i = 0; i < nblocks; ++i) {
+        mb[i] = make_concurrent_pod_memory_block(256, 32);
+    }
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < nblocks; ++i) {
+            memory_block_pod_allocator_api *api =
+                get_memory_block_pod_allocator_api(mb[i].get());
+            api->allocate(mb[i].get(), 3, 1, &begin[i], &end[i]);
+            memset(begin[i], 'a' + i, 3);
+        }
+        for (int i = 0; i < nblocks; ++i) {
+            memory_block_pod_allocator_api *api =
+                get_memory_block_pod_allocator_api(mb[i].get());
+            api->resize(mb[i].get(), 5, &begin[i], &end[i]);
+            EXPECT_EQ(5, end[i] - begin[i]);
+            EXPECT_EQ('a' + i, begin[i][2]);
+        }
+    }
+}
+
+namespace {
+struct fill_strings_data {
+    memory_block_data *blockref;
+    char *data;
+    intptr_t stride;
+    intptr_t per_task;
+};
+
+// Writes "item <i>" into each string of the task's range, growing
+// each string with a resize like the string kernels do
+void fill_strings_task(intptr_t task, void *data)
+{
+    fill_strings_data *fsd = reinterpret_cast<fill_strings_data *>(data);
+    memory_block_pod_allocator_api *api =
+        get_memory_block_pod_allocator_api(fsd->blockref);
+    for (intptr_t i = task * fsd->per_task; i < (task + 1) * fsd->per_task;
+            ++i) {
+        stringstream ss;
+        ss << "item " << i;
+        string s = ss.str();
+        string_type_data *d =
+            reinterpret_cast<string_type_data *>(fsd->data + i * fsd->stride);
+        api->allocate(fsd->blockref, 4, 1, &d->begin, &d->end);
+        api->resize(fsd->blockref, s.size(), &d->begin, &d->end);
+        memcpy(d->begin, s.data(), s.size());
+    }
+}
+} // anonymous namespace
+
+TEST(ConcurrentPODMemoryBlock, ParallelStrings) {
+    const intptr_t ntasks = 8, per_task = 2000;
+    nd::array a = nd::empty(ntasks * per_task, ndt::make_string());
+    // Swap the string data's memory block for a concurrent one
+    string_type_arrmeta *md = reinterpret_cast<string_type_arrmeta *>(
+        a.get_arrmeta() + sizeof(strided_dim_type_arrmeta));
+    memory_block_decref(md->blockref);
+    md->blockref = make_concurrent_pod_memory_block().release();
+
+    fill_strings_data fsd;
+    fsd.blockref = md->blockref;
+    fsd.data = a.get_readwrite_originptr();
+    fsd.stride = reinterpret_cast<const strided_dim_type_arrmeta *>(
+        a.get_arrmeta())->stride;
+    fsd.per_task = per_task;
+    parallel::run_tasks(ntasks, 4, &fill_strings_task, &fsd);
+    get_memory_block_pod_allocator_api(md->blockref)->finalize(md->blockref);
+
+    for (intptr_t i = 0; i < ntasks * per_task; i += 7) {
+        stringstream ss;
+        ss << "item " << i;
+        ASSERT_EQ(ss.str(), a(i).as<string>());
+    }
+}
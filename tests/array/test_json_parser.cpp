@@ -399,6 +399,106 @@ TEST(JSONParser, Struct) {
                     invalid_argument);
 }
 
+TEST(JSONParser, ParsePlanReuse) {
+    ndt::type sdt = ndt::make_cstruct(ndt::make_type<int>(), "id", ndt::make_type<double>(), "amount",
+                    ndt::make_string(), "name");
+    json_parse_plan plan(sdt);
+    const char *lines[] = {
+        "{\"id\":1,\"amount\":1.5,\"name\":\"a\"}",
+        // Key order changes, and then stays the same
+        "{\"name\":\"b\",\"amount\":2.5,\"id\":2}",
+        "{\"name\":\"c\",\"amount\":3.5,\"id\":3}",
+        // An extra field and an escaped key
+        "{\"extra\":{\"id\":0},\"n\\u0061me\":\"d\",\"amount\":4.5,\"id\":4}",
+        "{\"id\":5,\"amount\":5.5,\"name\":\"e\"}"};
+    for (int i = 0; i < 5; ++i) {
+        nd::array n = plan.parse(lines[i], lines[i] + strlen(lines[i]));
+        EXPECT_EQ(sdt, n.get_type());
+        EXPECT_EQ(i + 1, n(0).as<int>());
+        EXPECT_EQ(i + 1.5, n(1).as<double>());
+        EXPECT_EQ(string(1, 'a' + i), n(2).as<string>());
+    }
+
+    // Repeating a key doesn't stand in for a missing one
+    const char *bad = "{\"id\":1,\"amount\":1.5,\"id\":2}";
+    EXPECT_THROW(plan.parse(bad, bad + strlen(bad)), invalid_argument);
+    // The plan only parses into its own type
+    nd::array n = nd::empty(ndt::make_type<int>());
+    EXPECT_THROW(plan.parse(n, lines[0], lines[0] + strlen(lines[0])), type_error);
+}
+
+TEST(JSONParser, JSONLines) {
+    ndt::type sdt = ndt::type("{id: int32, name: string, vals: var * int16}");
+    // Enough lines for several chunks
+    stringstream ss;
+    const intptr_t count = 20000;
+    for (intptr_t i = 0; i < count; ++i) {
+        ss << "{\"id\":" << i << ",\"name\":\"item " << i << "\",\"vals\":[";
+        for (intptr_t j = 0; j < i % 4; ++j) {
+            ss << (j ? "," : "") << j;
+        }
+        ss << "]}\n";
+        if (i % 1000 == 0) {
+            ss << "  \n";
+        }
+    }
+    string json = ss.str();
+    eval::eval_context ectx;
+    for (int thread_count = 1; thread_count <= 4; thread_count += 3) {
+        ectx.thread_count = thread_count;
+        nd::array a = parse_json_lines(sdt, json.data(), json.data() + json.size(), &ectx);
+        EXPECT_EQ(ndt::make_var_dim(sdt), a.get_type());
+        ASSERT_EQ(count, a.get_dim_size());
+        for (intptr_t i = 0; i < count; i += 997) {
+            EXPECT_EQ(i, a(i, 0).as<int>());
+            stringstream name;
+            name << "item " << i;
+            EXPECT_EQ(name.str(), a(i, 1).as<string>());
+            EXPECT_EQ(i % 4, a(i, 2).get_dim_size());
+        }
+        EXPECT_EQ(2, a(count - 1, 2, 2).as<int>());
+    }
+
+    // Errors report the line in the whole input
+    json += "{\"id\":1,\"name\":\"x\"}\n";
+    try {
+        parse_json_lines(sdt, json.data(), json.data() + json.size(), &ectx);
+        FAIL() << "expected a parse error";
+    } catch (const invalid_argument& e) {
+        stringstream line;
+        line << "line " << (count + count / 1000 + 1) << ",";
+        EXPECT_NE(string::npos, string(e.what()).find(line.str())) << e.what();
+    }
+}
+
+TEST(JSONParser, ReferenceStrings) {
+    nd::array json = nd::array("[{\"a\": \"first\", \"b\": \"sec\\u006fnd\"},"
+                               " {\"a\": \"\\u00e9t\\u00e9\", \"b\": \"fourth\"}]");
+    const char *json_begin, *json_end;
+    json.get_type().tcast<base_string_type>()->get_string_range(
+        &json_begin, &json_end, json.get_arrmeta(), json.get_readonly_originptr());
+    nd::array a = parse_json(ndt::type("2 * {a: string, b: string}"), json,
+                             json_reference_strings);
+    EXPECT_EQ(ndt::type("2 * {a: string, b: string}"), a.get_type());
+    // Only the escaped strings are copies
+    const string_type_data *d =
+        reinterpret_cast<const string_type_data *>(a(0, 0).get_readonly_originptr());
+    EXPECT_TRUE(json_begin <= d->begin && d->end <= json_end);
+    d = reinterpret_cast<const string_type_data *>(a(0, 1).get_readonly_originptr());
+    EXPECT_FALSE(json_begin <= d->begin && d->end <= json_end);
+    // The strings keep the input alive
+    json = nd::array();
+    EXPECT_EQ("first", a(0, 0).as<string>());
+    EXPECT_EQ("second", a(0, 1).as<string>());
+    EXPECT_EQ("\xc3\xa9t\xc3\xa9", a(1, 0).as<string>());
+    EXPECT_EQ("fourth", a(1, 1).as<string>());
+
+    // Invalid UTF-8 is still caught
+    json = nd::make_bytes_array("[\"\xff\"]", 5);
+    EXPECT_THROW(parse_json(ndt::type("1 * string"), json, json_reference_strings),
+                 invalid_argument);
+}
+
 TEST(JSONParser, NestedStruct) {
     nd::array n;
     ndt::type sdt = ndt::make_cstruct(ndt::make_cfixed_dim(3, ndt::make_type<float>()), "position",
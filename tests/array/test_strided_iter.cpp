@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <inc_gtest.hpp>
+
+#include <dynd/array.hpp>
+#include <dynd/iter/strided_iter.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(StridedIter, Contiguous) {
+    nd::array a = nd::empty<int[3][4]>();
+    iter::strided_iter it(1, 0, &a);
+    EXPECT_EQ(12, it.get_itersize());
+    // Coalesced into a single inner loop
+    EXPECT_EQ(1, it.get_iter_ndim());
+    EXPECT_EQ(12, it.get_inner_size());
+    EXPECT_EQ((intptr_t)sizeof(int), it.get_inner_strides()[0]);
+    EXPECT_EQ(a.get_readwrite_originptr(), it.data()[0]);
+    EXPECT_EQ(ndt::make_type<int>(), it.get_uniform_dtype(0));
+    EXPECT_FALSE(it.next());
+}
+
+TEST(StridedIter, MemoryOrder) {
+    nd::array a = parse_json("3 * 4 * int32",
+        "[[0, 1, 2, 3], [10, 11, 12, 13], [20, 21, 22, 23]]");
+    // A transposed array is visited in memory order, as one inner loop
+    nd::array at = a.transpose();
+    iter::strided_iter it(0, 1, &at);
+    EXPECT_EQ(1, it.get_iter_ndim());
+    EXPECT_EQ(12, it.get_inner_size());
+    EXPECT_EQ((intptr_t)sizeof(int32_t), it.get_inner_strides()[0]);
+    EXPECT_EQ(a.get_readonly_originptr(), it.data()[0]);
+
+    // Every other column of the transpose, which can't be coalesced
+    nd::array b = at(irange(), irange().by(2));
+    iter::strided_iter it2(0, 1, &b);
+    EXPECT_EQ(2, it2.get_iter_ndim());
+    EXPECT_EQ(4, it2.get_inner_size());
+    EXPECT_EQ((intptr_t)sizeof(int32_t), it2.get_inner_strides()[0]);
+    int32_t expected[8] = {0, 1, 2, 3, 20, 21, 22, 23};
+    int count = 0;
+    do {
+        for (intptr_t i = 0; i < it2.get_inner_size(); ++i) {
+            const char *ptr = it2.data()[0] + i * it2.get_inner_strides()[0];
+            EXPECT_EQ(expected[count++], *reinterpret_cast<const int32_t *>(ptr));
+        }
+    } while (it2.next());
+    EXPECT_EQ(8, count);
+}
+
+TEST(StridedIter, Broadcast) {
+    // out = a + b + c, with b and c broadcast
+    nd::array a = parse_json("3 * 4 * int32",
+        "[[0, 1, 2, 3], [10, 11, 12, 13], [20, 21, 22, 23]]");
+    nd::array ops[4] = {nd::empty<int32_t[4][3]>().transpose(), a,
+                        parse_json("4 * int32", "[100, 200, 300, 400]"),
+                        nd::array(1000)};
+    iter::strided_iter it(1, 3, ops);
+    EXPECT_EQ(12, it.get_itersize());
+    do {
+        char *const *data = it.data();
+        const intptr_t *strides = it.get_inner_strides();
+        for (intptr_t i = 0; i < it.get_inner_size(); ++i) {
+            *reinterpret_cast<int32_t *>(data[0] + i * strides[0]) =
+                *reinterpret_cast<const int32_t *>(data[1] + i * strides[1]) +
+                *reinterpret_cast<const int32_t *>(data[2] + i * strides[2]) +
+                *reinterpret_cast<const int32_t *>(data[3] + i * strides[3]);
+        }
+    } while (it.next());
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_EQ(1000 + 100 * (j + 1) + 10 * i + j,
+                      ops[0](i, j).as<int32_t>());
+        }
+    }
+}
+
+TEST(StridedIter, Scalars) {
+    // With no dimensions there is one inner loop of one element
+    nd::array ops[2] = {nd::empty<double>(), nd::array(3.5)};
+    iter::strided_iter it(1, 1, ops);
+    EXPECT_FALSE(it.empty());
+    EXPECT_EQ(1, it.get_itersize());
+    EXPECT_EQ(1, it.get_inner_size());
+    EXPECT_FALSE(it.next());
+
+    nd::array e = nd::empty(0, ndt::make_type<double>());
+    iter::strided_iter it2(0, 1, &e);
+    EXPECT_TRUE(it2.empty());
+    EXPECT_EQ(0, it2.get_inner_size());
+}
+
+TEST(StridedIter, Errors) {
+    // Write operands don't broadcast
+    nd::array ops[2] = {nd::empty<int32_t[4]>(), nd::empty<int32_t[3][4]>()};
+    EXPECT_THROW(iter::strided_iter(1, 1, ops), broadcast_error);
+    ops[1] = nd::empty<int32_t[5]>();
+    EXPECT_THROW(iter::strided_iter(1, 1, ops), broadcast_error);
+    // Only strided dimensions can be iterated
+    ops[1] = parse_json("var * int32", "[1, 2, 3, 4]");
+    EXPECT_THROW(iter::strided_iter(1, 1, ops), type_error);
+}
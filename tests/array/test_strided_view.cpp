@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <inc_gtest.hpp>
+
+#include <dynd/array.hpp>
+#include <dynd/strided_view.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(StridedView, OneDim) {
+    int vals[5] = {1, 2, 3, 4, 5};
+    nd::array a = nd::empty(5, ndt::make_type<int>());
+    a.vals() = vals;
+    nd::strided_view<int, 1> v(a);
+    EXPECT_EQ(1, v.get_ndim());
+    ASSERT_EQ(5, v.get_dim_size());
+    EXPECT_EQ((intptr_t)sizeof(int), v.get_stride());
+    for (intptr_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(vals[i], v(i));
+        EXPECT_EQ(vals[i], v[i]);
+    }
+
+    // Writes go through to the array
+    v(2) = 100;
+    v[3] += 1;
+    EXPECT_EQ(100, a(2).as<int>());
+    EXPECT_EQ(5, a(3).as<int>());
+
+    // A slice is another view of the same data
+    nd::strided_view<int, 1> s = v.slice(irange().by(-2));
+    ASSERT_EQ(3, s.get_dim_size());
+    EXPECT_EQ(-2 * (intptr_t)sizeof(int), s.get_stride());
+    EXPECT_EQ(5, s(0));
+    EXPECT_EQ(100, s(1));
+    EXPECT_EQ(1, s(2));
+    // A single index keeps the dimension
+    s = v.slice(-1);
+    ASSERT_EQ(1, s.get_dim_size());
+    EXPECT_EQ(5, s(0));
+    EXPECT_THROW(v.slice(5), index_out_of_bounds);
+}
+
+TEST(StridedView, MultiDim) {
+    nd::array a = parse_json("3 * 4 * float64",
+        "[[0, 1, 2, 3], [10, 11, 12, 13], [20, 21, 22, 23]]");
+    nd::strided_view<const double, 2> v(a);
+    ASSERT_EQ(3, v.get_dim_size(0));
+    ASSERT_EQ(4, v.get_dim_size(1));
+    for (intptr_t i = 0; i < 3; ++i) {
+        // Subviews of the rows
+        nd::strided_view<const double, 1> row = v[i];
+        ASSERT_EQ(4, row.get_dim_size());
+        for (intptr_t j = 0; j < 4; ++j) {
+            EXPECT_EQ(10 * i + j, v(i, j));
+            EXPECT_EQ(10 * i + j, v[i][j]);
+            EXPECT_EQ(10 * i + j, row(j));
+        }
+    }
+
+    // A view of a strided array view, sliced along the second axis
+    nd::strided_view<const double, 2> t(a(irange(), irange(1, 4)));
+    t = t.slice(irange().by(2), 1);
+    ASSERT_EQ(3, t.get_dim_size(0));
+    ASSERT_EQ(2, t.get_dim_size(1));
+    EXPECT_EQ(11, t(1, 0));
+    EXPECT_EQ(23, t(2, 1));
+
+    // Views of cfixed dimensions work too
+    int vals[2][3][2];
+    for (int i = 0; i < 12; ++i) {
+        (&vals[0][0][0])[i] = i;
+    }
+    nd::array b = vals;
+    nd::strided_view<const int, 3> w(b);
+    EXPECT_EQ(7, w(1, 0, 1));
+    EXPECT_EQ(11, w[1][2][1]);
+}
+
+TEST(StridedView, Errors) {
+    nd::array a = parse_json("3 * 4 * float64",
+        "[[0, 1, 2, 3], [10, 11, 12, 13], [20, 21, 22, 23]]");
+    // The dtype and the number of dimensions must match exactly
+    EXPECT_THROW((nd::strided_view<const float, 2>(a)), type_error);
+    EXPECT_THROW((nd::strided_view<const double, 1>(a)), type_error);
+    EXPECT_THROW((nd::strided_view<const double, 3>(a)), type_error);
+    EXPECT_THROW((nd::strided_view<const double, 1>(nd::array())), type_error);
+    // Variable sized dimensions aren't strided
+    nd::array b = parse_json("var * int32", "[1, 2, 3]");
+    EXPECT_THROW((nd::strided_view<const int32_t, 1>(b)), type_error);
+    // Unevaluated expressions need an eval() first
+    nd::array c = a.ucast<float>();
+    EXPECT_THROW((nd::strided_view<const float, 2>(c)), type_error);
+    nd::array ce = c.eval();
+    nd::strided_view<const float, 2> cv(ce);
+    EXPECT_EQ(12.f, cv(1, 2));
+    // Only the const view can be made of immutable data
+    a.flag_as_immutable();
+    EXPECT_THROW((nd::strided_view<double, 2>(a)), runtime_error);
+    EXPECT_EQ(22, (nd::strided_view<const double, 2>(a)(2, 2)));
+}
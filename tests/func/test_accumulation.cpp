@@ -0,0 +1,169 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+#include <dynd/func/lift_accumulation_arrfunc.hpp>
+#include <dynd/func/functor_arrfunc.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Accumulation, BuiltinCumSum_1D) {
+    nd::arrfunc af = kernels::make_builtin_cumsum1d_arrfunc(float64_type_id);
+    double vals[5] = {1.5, -22., 3.75, 1.125, -3.375};
+    nd::array a = vals;
+    nd::array b = af(a);
+    EXPECT_EQ(ndt::type("strided * float64"), b.get_type());
+    ASSERT_EQ(5, b.get_dim_size());
+    double s = 0;
+    for (int i = 0; i < 5; ++i) {
+        s += vals[i];
+        EXPECT_EQ(s, b(i).as<double>());
+    }
+
+    // An empty input gives an empty output
+    a = nd::empty(0, ndt::make_type<double>());
+    b = af(a);
+    EXPECT_EQ(0, b.get_dim_size());
+}
+
+TEST(Accumulation, BuiltinSum_Lift1D_WithIdentity) {
+    // Use 100.f as the "identity" to confirm it's really being used
+    bool reduction_dimflags[1] = {true};
+    nd::arrfunc af = lift_accumulation_arrfunc(
+        kernels::make_builtin_sum_reduction_arrfunc(float32_type_id),
+        ndt::type("strided * float32"), nd::arrfunc(), 1, reduction_dimflags,
+        true, true, false, nd::array(100.f));
+
+    float vals[3] = {1.5f, -22.f, 3.75f};
+    nd::array a = vals;
+    nd::array b = af(a);
+    EXPECT_EQ(100.f + 1.5f, b(0).as<float>());
+    EXPECT_EQ(100.f + 1.5f - 22.f, b(1).as<float>());
+    EXPECT_EQ(100.f + 1.5f - 22.f + 3.75f, b(2).as<float>());
+}
+
+TEST(Accumulation, BuiltinSum_Lift2D) {
+    nd::arrfunc sum = kernels::make_builtin_sum_reduction_arrfunc(int32_type_id);
+    int32_t vals[3][4] = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+    nd::array a = vals;
+
+    // Accumulating the outer dimension broadcasts over the inner one
+    bool dimflags0[2] = {true, false};
+    nd::arrfunc af = lift_accumulation_arrfunc(
+        sum, ndt::type("strided * strided * int32"), nd::arrfunc(), 2,
+        dimflags0, true, true, false, nd::array());
+    nd::array b = af(a);
+    EXPECT_EQ(ndt::type("strided * strided * int32"), b.get_type());
+    EXPECT_EQ(1, b(0, 0).as<int>());
+    EXPECT_EQ(4, b(0, 3).as<int>());
+    EXPECT_EQ(6, b(1, 0).as<int>());
+    EXPECT_EQ(12, b(1, 3).as<int>());
+    EXPECT_EQ(15, b(2, 0).as<int>());
+    EXPECT_EQ(24, b(2, 3).as<int>());
+
+    // Accumulating the inner dimension, broadcast over the outer one
+    bool dimflags1[2] = {false, true};
+    af = lift_accumulation_arrfunc(
+        sum, ndt::type("strided * strided * int32"), nd::arrfunc(), 2,
+        dimflags1, true, true, false, nd::array());
+    b = af(a);
+    EXPECT_EQ(1, b(0, 0).as<int>());
+    EXPECT_EQ(10, b(0, 3).as<int>());
+    EXPECT_EQ(5, b(1, 0).as<int>());
+    EXPECT_EQ(26, b(1, 3).as<int>());
+    EXPECT_EQ(42, b(2, 3).as<int>());
+
+    // Only one dimension may be accumulated
+    bool dimflags2[2] = {true, true};
+    EXPECT_THROW(lift_accumulation_arrfunc(
+                     sum, ndt::type("strided * strided * int32"),
+                     nd::arrfunc(), 2, dimflags2, true, true, false,
+                     nd::array()),
+                 invalid_argument);
+}
+
+static double running_max(double x, double y)
+{
+    return x > y ? x : y;
+}
+
+TEST(Accumulation, BinaryRunningMax) {
+    nd::arrfunc max_af = nd::make_functor_arrfunc(&running_max);
+    bool reduction_dimflags[1] = {true};
+    nd::arrfunc af = lift_accumulation_arrfunc(
+        max_af, ndt::type("strided * float64"), nd::arrfunc(), 1,
+        reduction_dimflags, true, true, false, nd::array());
+
+    double vals[6] = {3, 1, 4, 1, 5, 2};
+    double expected[6] = {3, 3, 4, 4, 5, 5};
+    nd::array a = vals;
+    nd::array b = af(a);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(expected[i], b(i).as<double>());
+    }
+}
+
+TEST(Accumulation, ParallelCumSum) {
+    // Large enough to use the two pass parallel prefix
+    intptr_t n = 300007;
+    nd::array a = nd::empty(n, ndt::make_type<int64_t>());
+    int64_t *a_data = reinterpret_cast<int64_t *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < n; ++i) {
+        a_data[i] = (i * 7919) % 1000 - 500;
+    }
+
+    nd::arrfunc af = kernels::make_builtin_cumsum1d_arrfunc(int64_type_id);
+    eval::eval_context ectx;
+    ectx.thread_count = 4;
+    nd::array b = af.call(1, &a, &ectx);
+    ASSERT_EQ(n, b.get_dim_size());
+    const int64_t *b_data =
+        reinterpret_cast<const int64_t *>(b.get_readonly_originptr());
+    int64_t s = 0;
+    intptr_t mismatches = 0;
+    for (intptr_t i = 0; i < n; ++i) {
+        s += a_data[i];
+        mismatches += (b_data[i] != s);
+    }
+    EXPECT_EQ(0, mismatches);
+}
+
+TEST(Accumulation, ParallelRunningMax) {
+    // Each block of the parallel prefix runs on its own replica of the
+    // wrapped binary ckernel
+    intptr_t n = 300007;
+    nd::array a = nd::empty(n, ndt::make_type<double>());
+    double *a_data = reinterpret_cast<double *>(a.get_readwrite_originptr());
+    for (intptr_t i = 0; i < n; ++i) {
+        a_data[i] = (double)((i * 7919) % 100003);
+    }
+
+    bool reduction_dimflags[1] = {true};
+    nd::arrfunc af = lift_accumulation_arrfunc(
+        nd::make_functor_arrfunc(&running_max), ndt::type("strided * float64"),
+        nd::arrfunc(), 1, reduction_dimflags, true, true, false, nd::array());
+    eval::eval_context ectx;
+    ectx.thread_count = 4;
+    nd::array b = af.call(1, &a, &ectx);
+    ASSERT_EQ(n, b.get_dim_size());
+    const double *b_data =
+        reinterpret_cast<const double *>(b.get_readonly_originptr());
+    double m = a_data[0];
+    intptr_t mismatches = 0;
+    for (intptr_t i = 0; i < n; ++i) {
+        m = running_max(m, a_data[i]);
+        mismatches += (b_data[i] != m);
+    }
+    EXPECT_EQ(0, mismatches);
+}
@@ -40,3 +40,21 @@ TEST(ChainArrFunc, Simple) {
   chained.call_out(3.1, a);
   EXPECT_DOUBLE_EQ(sin(3.1), a.as<double>());
 }
+
+TEST(ChainArrFunc, CloneUnsupported) {
+  const nd::arrfunc &copy = make_copy_arrfunc();
+  const nd::arrfunc &chained = make_chain_arrfunc(
+      copy, math::sin, ndt::make_type<double>());
+  nd::array a = nd::empty<double>();
+  nd::array b = nd::empty<double>();
+  ndt::type src_tp = b.get_type();
+  const char *src_arrmeta[1] = {b.get_arrmeta()};
+  ckernel_builder ckb, replica;
+  chained.get()->instantiate(chained.get(), &ckb, 0, a.get_type(),
+                             a.get_arrmeta(), &src_tp, src_arrmeta,
+                             kernel_request_single,
+                             &eval::default_eval_context);
+  // The chained ckernel's children refer to its buffer arrmeta
+  EXPECT_THROW(ckb.clone(replica), runtime_error);
+  EXPECT_EQ(NULL, replica.get()->destructor);
+}
@@ -0,0 +1,120 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/func/lift_arrfunc.hpp>
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/kernels/ckernel_profiler.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(CKernelProfiler, DisabledAddsNothing) {
+    eval::eval_context ectx;
+    ckernel_builder ckb_plain, ckb_prof;
+    intptr_t plain_size = make_assignment_kernel(
+        &ckb_plain, 0, ndt::make_type<int32_t>(), NULL,
+        ndt::make_type<double>(), NULL, kernel_request_single, &ectx);
+
+    ckernel_profiler prof;
+    ectx.profiler = &prof;
+    intptr_t prof_size = make_assignment_kernel(
+        &ckb_prof, 0, ndt::make_type<int32_t>(), NULL,
+        ndt::make_type<double>(), NULL, kernel_request_single, &ectx);
+    // The profiled ckernel has a shim in front of it
+    EXPECT_GT(prof_size, plain_size);
+    ASSERT_EQ(1u, prof.get_roots().size());
+    EXPECT_EQ("assign (float64) -> int32", prof.get_roots()[0]->label);
+    EXPECT_EQ(0u, prof.get_roots()[0]->children.size());
+
+    // Both ckernels give the same result, only one is counted
+    double src = 12.0;
+    const char *src_ptr = reinterpret_cast<const char *>(&src);
+    int32_t dst_plain = 0, dst_prof = 0;
+    ckb_plain.get()->get_function<expr_single_t>()(
+        reinterpret_cast<char *>(&dst_plain), &src_ptr, ckb_plain.get());
+    ckb_prof.get()->get_function<expr_single_t>()(
+        reinterpret_cast<char *>(&dst_prof), &src_ptr, ckb_prof.get());
+    EXPECT_EQ(12, dst_plain);
+    EXPECT_EQ(12, dst_prof);
+    EXPECT_EQ(1u, prof.get_roots()[0]->calls);
+    EXPECT_EQ(1u, prof.get_roots()[0]->elements);
+}
+
+TEST(CKernelProfiler, LiftedArrFuncTree) {
+    nd::arrfunc af = lift_arrfunc(make_arrfunc_from_assignment(
+        ndt::make_type<int>(), ndt::make_string(), assign_error_default));
+    nd::array a = parse_json(ndt::type("3 * 4 * string"),
+                             "[[\"1\", \"2\", \"3\", \"4\"],"
+                             " [\"5\", \"6\", \"7\", \"8\"],"
+                             " [\"9\", \"10\", \"11\", \"12\"]]");
+
+    ckernel_profiler prof;
+    eval::eval_context ectx;
+    ectx.profiler = &prof;
+    nd::array b = af.call(1, &a, &ectx);
+    EXPECT_EQ(ndt::type("3 * 4 * int32"), b.get_type());
+    EXPECT_EQ(12, b(2, 3).as<int>());
+
+    // arrfunc -> lift -> lift -> elwise -> assign
+    ASSERT_EQ(1u, prof.get_roots().size());
+    const ckernel_profiler::node *n = prof.get_roots()[0];
+    EXPECT_EQ("arrfunc (3 * 4 * string) -> 3 * 4 * int32", n->label);
+    EXPECT_EQ(1u, n->calls);
+    ASSERT_EQ(1u, n->children.size());
+    n = n->children[0];
+    EXPECT_EQ("lift (3 * 4 * string) -> 3 * 4 * int32", n->label);
+    EXPECT_EQ((uint32_t)kernel_request_single, n->kernreq);
+    EXPECT_EQ(1u, n->calls);
+    ASSERT_EQ(1u, n->children.size());
+    n = n->children[0];
+    EXPECT_EQ("lift (4 * string) -> 4 * int32", n->label);
+    EXPECT_EQ((uint32_t)kernel_request_strided, n->kernreq);
+    EXPECT_EQ(1u, n->calls);
+    EXPECT_EQ(3u, n->elements);
+    ASSERT_EQ(1u, n->children.size());
+    n = n->children[0];
+    EXPECT_EQ("elwise (string) -> int32", n->label);
+    EXPECT_EQ(3u, n->calls);
+    EXPECT_EQ(12u, n->elements);
+    EXPECT_EQ(n->parent->parent->parent, prof.get_roots()[0]);
+
+    // The dump has a line per node, indented by depth
+    stringstream ss;
+    ss << prof;
+    EXPECT_NE(string::npos,
+              ss.str().find("\n      elwise (string) -> int32 [strided]"));
+
+    prof.reset_counts();
+    EXPECT_EQ(0u, n->calls);
+    EXPECT_EQ(0u, n->ticks);
+    prof.clear();
+    EXPECT_EQ(0, prof.get_node_count());
+}
+
+TEST(CKernelProfiler, ExpressionAssignment) {
+    nd::array a = parse_json(ndt::type("5 * int32"), "[1, 2, 3, 4, 5]");
+    nd::array b = nd::empty("5 * float64");
+
+    ckernel_profiler prof;
+    eval::eval_context ectx;
+    ectx.profiler = &prof;
+    b.val_assign(a.ucast<int64_t>(), &ectx);
+    EXPECT_EQ(5., b(4).as<double>());
+
+    // The whole assignment is one root, with the dimension and
+    // buffered conversion ckernels below it
+    ASSERT_EQ(1u, prof.get_roots().size());
+    EXPECT_EQ(1u, prof.get_roots()[0]->calls);
+    EXPECT_GT(prof.get_node_count(), 2);
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/comparison_arrfunc.hpp>
+#include <dynd/func/take_arrfunc.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ComparisonArrFunc, TypedBroadcast) {
+    nd::arrfunc less = kernels::make_comparison_arrfunc(comparison_type_less);
+    nd::arrfunc ge =
+        kernels::make_comparison_arrfunc(comparison_type_greater_equal);
+
+    int vals[6] = {5, -1, 3, 7, 3, 0};
+    nd::array a = vals, c;
+    c = less(a, 3);
+    EXPECT_EQ(ndt::type("strided * bool"), c.get_type());
+    ASSERT_EQ(6, c.get_dim_size());
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+    EXPECT_FALSE(c(3).as<bool>());
+    EXPECT_FALSE(c(4).as<bool>());
+    EXPECT_TRUE(c(5).as<bool>());
+
+    // Elementwise, and strided through a view
+    int vals2[6] = {5, 0, 4, 7, 2, 1};
+    c = ge(a, vals2);
+    EXPECT_TRUE(c(0).as<bool>());
+    EXPECT_FALSE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+    EXPECT_TRUE(c(3).as<bool>());
+    EXPECT_TRUE(c(4).as<bool>());
+    EXPECT_FALSE(c(5).as<bool>());
+    c = ge(a(irange().by(2)), 4);
+    ASSERT_EQ(3, c.get_dim_size());
+    EXPECT_TRUE(c(0).as<bool>());
+    EXPECT_FALSE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+
+    // NaN compares false, except for not_equal
+    double dvals[3] = {1.0, numeric_limits<double>::quiet_NaN(), 2.0};
+    c = less(dvals, 1.5);
+    EXPECT_TRUE(c(0).as<bool>());
+    EXPECT_FALSE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+    c = kernels::make_comparison_arrfunc(comparison_type_not_equal)(dvals,
+                                                                      1.0);
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_TRUE(c(2).as<bool>());
+}
+
+TEST(ComparisonArrFunc, Generic) {
+    nd::arrfunc eq = kernels::make_comparison_arrfunc(comparison_type_equal);
+    nd::arrfunc gt = kernels::make_comparison_arrfunc(comparison_type_greater);
+
+    // Mixed types
+    int16_t vals[4] = {1, 2, 3, 4};
+    double dvals[4] = {1.0, 2.5, 3.0, -4.0};
+    nd::array c = eq(vals, dvals);
+    EXPECT_TRUE(c(0).as<bool>());
+    EXPECT_FALSE(c(1).as<bool>());
+    EXPECT_TRUE(c(2).as<bool>());
+    EXPECT_FALSE(c(3).as<bool>());
+
+    // Strings
+    const char *svals[3] = {"apple", "banana", "cherry"};
+    c = gt(svals, "b");
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_TRUE(c(2).as<bool>());
+
+    EXPECT_THROW(kernels::make_comparison_arrfunc(comparison_type_sorting_less),
+                 runtime_error);
+}
+
+TEST(ComparisonArrFunc, Logical) {
+    nd::arrfunc land = kernels::make_logical_arrfunc(kernels::logical_and);
+    nd::arrfunc lor = kernels::make_logical_arrfunc(kernels::logical_or);
+    nd::arrfunc lxor = kernels::make_logical_arrfunc(kernels::logical_xor);
+    nd::arrfunc lnot = kernels::make_logical_arrfunc(kernels::logical_not);
+
+    dynd_bool avals[4] = {false, false, true, true};
+    dynd_bool bvals[4] = {false, true, false, true};
+    nd::array a = avals, b = bvals, c;
+    c = land(a, b);
+    EXPECT_EQ(ndt::type("strided * bool"), c.get_type());
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_FALSE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+    EXPECT_TRUE(c(3).as<bool>());
+    c = lor(a, b);
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_TRUE(c(2).as<bool>());
+    EXPECT_TRUE(c(3).as<bool>());
+    c = lxor(a, b);
+    EXPECT_FALSE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_TRUE(c(2).as<bool>());
+    EXPECT_FALSE(c(3).as<bool>());
+    c = lnot(a);
+    EXPECT_TRUE(c(0).as<bool>());
+    EXPECT_TRUE(c(1).as<bool>());
+    EXPECT_FALSE(c(2).as<bool>());
+    EXPECT_FALSE(c(3).as<bool>());
+}
+
+TEST(ComparisonArrFunc, FilterWithTake) {
+    nd::arrfunc ge =
+        kernels::make_comparison_arrfunc(comparison_type_greater_equal);
+    nd::arrfunc less = kernels::make_comparison_arrfunc(comparison_type_less);
+    nd::arrfunc land = kernels::make_logical_arrfunc(kernels::logical_and);
+    nd::arrfunc take = kernels::make_take_arrfunc();
+
+    // The values of a in [2, 6)
+    int vals[8] = {7, 2, 5, 1, 6, 3, 0, 4};
+    nd::array a = vals;
+    nd::array mask = land(ge(a, 2), less(a, 6));
+    nd::array c = take(a, mask);
+    EXPECT_EQ(ndt::type("var * int"), c.get_type());
+    ASSERT_EQ(4, c.get_dim_size());
+    EXPECT_EQ(2, c(0).as<int>());
+    EXPECT_EQ(5, c(1).as<int>());
+    EXPECT_EQ(3, c(2).as<int>());
+    EXPECT_EQ(4, c(3).as<int>());
+}
@@ -564,3 +564,57 @@ INSTANTIATE_TYPED_TEST_CASE_P(Builtin, FunctorArrfunc_CallRetRes, test_types);
 
 REGISTER_TYPED_TEST_CASE_P(FunctorArrfunc_CallRefRes, CallRefRes);
 INSTANTIATE_TYPED_TEST_CASE_P(Builtin, FunctorArrfunc_CallRefRes, test_types);
+
+namespace {
+  struct scaled_diff {
+    double scale;
+    double operator()(double x, double y) const { return scale * (x - y); }
+  };
+} // anonymous namespace
+
+TEST(FunctorArrfunc, UnitStrideLoops) {
+  scaled_diff f;
+  f.scale = 0.5;
+  nd::arrfunc af = lift_arrfunc(nd::make_functor_arrfunc(f));
+
+  double avals[33], bvals[33];
+  for (int i = 0; i < 33; ++i) {
+    avals[i] = 4 * i;
+    bvals[i] = i;
+  }
+  nd::array a = avals, b = bvals;
+  // Contiguous
+  nd::array res = af(a, b);
+  for (int i = 0; i < 33; ++i) {
+    EXPECT_EQ(1.5 * i, res(i).as<double>());
+  }
+  // Broadcast and strided
+  res = af(a(irange().by(2)), 2.0);
+  ASSERT_EQ(17, res.get_dim_size());
+  for (int i = 0; i < 17; ++i) {
+    EXPECT_EQ(4 * i - 1, res(i).as<double>());
+  }
+}
+
+TEST(FunctorArrfunc, UnitStrideOverlap) {
+  scaled_diff f;
+  f.scale = 2;
+  nd::arrfunc af = lift_arrfunc(nd::make_functor_arrfunc(f));
+
+  double avals[33], bvals[33], expected[33];
+  for (int i = 0; i < 33; ++i) {
+    avals[i] = expected[i] = i;
+    bvals[i] = 1;
+  }
+  // Writing a[1:] from a[:-1] goes element by element, each
+  // result feeding the next
+  for (int i = 0; i < 32; ++i) {
+    expected[i + 1] = 2 * (expected[i] - 1);
+  }
+  nd::array a = nd::empty(33, ndt::make_type<double>()), b = bvals;
+  a.vals() = avals;
+  af.call_out(a(irange(0, 32)), b(irange(0, 32)), a(irange(1, 33)));
+  for (int i = 0; i < 33; ++i) {
+    EXPECT_EQ(expected[i], a(i).as<double>());
+  }
+}
@@ -18,6 +18,8 @@
 #include <dynd/func/lift_arrfunc.hpp>
 #include <dynd/func/take_arrfunc.hpp>
 #include <dynd/func/call_callable.hpp>
+#include <dynd/func/functor_arrfunc.hpp>
+#include <dynd/json_parser.hpp>
 #include <dynd/array.hpp>
 
 using namespace std;
@@ -224,3 +226,74 @@ TEST(LiftArrFunc, Expr_MultiDimVarToVarDim) {
     EXPECT_EQ(12, out(2, 2).as<int>());
 }
 */
+
+TEST(LiftArrFunc, CloneCKernel) {
+    // Create an arrfunc for converting string to int
+    nd::arrfunc af_base = make_arrfunc_from_assignment(
+        ndt::make_type<int>(), ndt::make_fixedstring(16), assign_error_default);
+
+    // Lift the kernel to particular fixed dim arrays
+    arrfunc_type_data af;
+    lift_arrfunc(&af, af_base);
+
+    ndt::type dst_tp("var * int32");
+    ndt::type src_tp("strided * string[16]");
+    intptr_t three = 3;
+    nd::array in = nd::typed_empty(1, &three, src_tp);
+    in(0).vals() = "172";
+    in(1).vals() = "-139";
+    in(2).vals() = "12345";
+    const char *in_ptr = in.get_readonly_originptr();
+    const char *src_arrmeta[1] = {in.get_arrmeta()};
+
+    // Clone the ckernel, and let the original go away before using the
+    // clone. The replica refers to the same arrmeta, so 'out' must outlive it.
+    nd::array out = nd::empty(dst_tp);
+    ckernel_builder replica;
+    {
+        ckernel_builder ckb;
+        af.instantiate(&af, &ckb, 0, dst_tp, out.get_arrmeta(), &src_tp,
+                       src_arrmeta, kernel_request_single,
+                       &eval::default_eval_context);
+        ckb.clone(replica);
+    }
+    expr_single_t usngo = replica.get()->get_function<expr_single_t>();
+    usngo(out.get_readwrite_originptr(), &in_ptr, replica.get());
+    EXPECT_EQ(3, out.get_shape()[0]);
+    EXPECT_EQ(172, out(0).as<int>());
+    EXPECT_EQ(-139, out(1).as<int>());
+    EXPECT_EQ(12345, out(2).as<int>());
+}
+
+static int32_t add_ints(int32_t x, int32_t y)
+{
+    return x + y;
+}
+
+TEST(LiftArrFunc, Expr_ConsecutiveVarRows) {
+    nd::arrfunc af = lift_arrfunc(nd::make_functor_arrfunc(&add_ints));
+
+    // parse_json lays the rows out back to back, so all the rows go
+    // through one child call
+    nd::array in0 = parse_json("3 * var * int32", "[[1, 2, 3], [4], [-1, 10]]");
+    nd::array in1 = parse_json("3 * var * int32", "[[2, 4, 6], [8], [1, 1]]");
+    nd::array out = af(in0, in1);
+    EXPECT_EQ(ndt::type("3 * var * int32"), out.get_type());
+    ASSERT_EQ(3, out(0).get_dim_size());
+    ASSERT_EQ(1, out(1).get_dim_size());
+    ASSERT_EQ(2, out(2).get_dim_size());
+    EXPECT_EQ(3, out(0, 0).as<int>());
+    EXPECT_EQ(9, out(0, 2).as<int>());
+    EXPECT_EQ(12, out(1, 0).as<int>());
+    EXPECT_EQ(0, out(2, 0).as<int>());
+    EXPECT_EQ(11, out(2, 1).as<int>());
+
+    // Rows which broadcast are done one at a time
+    in1 = parse_json("3 * var * int32", "[[5], [8], [1, 1]]");
+    out = af(in0, in1);
+    ASSERT_EQ(3, out(0).get_dim_size());
+    EXPECT_EQ(6, out(0, 0).as<int>());
+    EXPECT_EQ(8, out(0, 2).as<int>());
+    EXPECT_EQ(12, out(1, 0).as<int>());
+    EXPECT_EQ(11, out(2, 1).as<int>());
+}
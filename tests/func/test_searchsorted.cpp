@@ -0,0 +1,198 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/searchsorted_arrfunc.hpp>
+#include <dynd/func/lift_arrfunc.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/types/cfixed_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(SearchSorted, Int) {
+    int hay[6] = {1, 3, 3, 3, 7, 9};
+    int needles[7] = {0, 1, 3, 4, 9, 10, 3};
+    nd::array b = kernels::make_searchsorted_arrfunc()(hay, needles);
+    EXPECT_EQ(ndt::type("strided * intptr"), b.get_type());
+    intptr_t left[7] = {0, 0, 1, 4, 5, 6, 1};
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(left[i], b(i).as<intptr_t>());
+    }
+    b = kernels::make_searchsorted_arrfunc(kernels::searchsorted_right)(
+        hay, needles);
+    intptr_t right[7] = {0, 1, 4, 4, 6, 6, 4};
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(right[i], b(i).as<intptr_t>());
+    }
+}
+
+TEST(SearchSorted, SortedNeedles) {
+    // Enough sorted needles that the merge walk is used,
+    // checked against the binary search on unsorted needles
+    const intptr_t n = 100, m = 1000;
+    nd::array hay = nd::empty(n, ndt::make_type<double>());
+    nd::array needles = nd::empty(m, ndt::make_type<double>());
+    for (intptr_t i = 0; i < n; ++i) {
+        hay(i).vals() = (double)(2 * i);
+    }
+    for (intptr_t i = 0; i < m; ++i) {
+        needles(i).vals() = 0.25 * i - 10;
+    }
+    nd::array reversed = needles(irange().by(-1)).eval();
+    for (int side = 0; side < 2; ++side) {
+        nd::arrfunc af = kernels::make_searchsorted_arrfunc(
+            (kernels::searchsorted_side_t)side);
+        nd::array a = af(hay, needles), b = af(hay, reversed);
+        for (intptr_t i = 0; i < m; ++i) {
+            ASSERT_EQ(a(i).as<intptr_t>(), b(m - 1 - i).as<intptr_t>());
+        }
+    }
+}
+
+TEST(SearchSorted, NaN) {
+    double hay[4] = {-1, 2, 5, numeric_limits<double>::quiet_NaN()};
+    double needles[2] = {numeric_limits<double>::quiet_NaN(), 100};
+    nd::array b = kernels::make_searchsorted_arrfunc()(hay, needles);
+    EXPECT_EQ(3, b(0).as<intptr_t>());
+    EXPECT_EQ(3, b(1).as<intptr_t>());
+}
+
+TEST(SearchSorted, Generic) {
+    // Strings and mixed types go through comparison kernels
+    const char *hay[4] = {"apple", "banana", "cherry", "date"};
+    const char *needles[3] = {"blueberry", "apple", "zucchini"};
+    nd::array b = kernels::make_searchsorted_arrfunc()(hay, needles);
+    EXPECT_EQ(2, b(0).as<intptr_t>());
+    EXPECT_EQ(0, b(1).as<intptr_t>());
+    EXPECT_EQ(4, b(2).as<intptr_t>());
+
+    int ihay[3] = {1, 5, 10};
+    double dneedles[3] = {0.5, 5.0, 7.5};
+    b = kernels::make_searchsorted_arrfunc(kernels::searchsorted_right)(
+        ihay, dneedles);
+    EXPECT_EQ(0, b(0).as<intptr_t>());
+    EXPECT_EQ(2, b(1).as<intptr_t>());
+    EXPECT_EQ(2, b(2).as<intptr_t>());
+}
+
+TEST(SortedSet, Unique) {
+    int a[9] = {1, 1, 2, 3, 3, 3, 8, 9, 9};
+    nd::array b = kernels::make_unique_arrfunc()(a);
+    EXPECT_EQ(ndt::type("var * int32"), b.get_type());
+    ASSERT_EQ(5, b.get_dim_size());
+    int expected[5] = {1, 2, 3, 8, 9};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(expected[i], b(i).as<int>());
+    }
+
+    const char *s[5] = {"a", "a", "b", "c", "c"};
+    b = kernels::make_unique_arrfunc()(s);
+    ASSERT_EQ(3, b.get_dim_size());
+    EXPECT_EQ("a", b(0).as<string>());
+    EXPECT_EQ("b", b(1).as<string>());
+    EXPECT_EQ("c", b(2).as<string>());
+
+    b = kernels::make_unique_arrfunc()(nd::empty(0, ndt::make_type<int>()));
+    EXPECT_EQ(0, b.get_dim_size());
+}
+
+TEST(SortedSet, IntersectAndUnion) {
+    int a[7] = {1, 2, 2, 5, 7, 7, 20};
+    int b[6] = {2, 3, 5, 5, 7, 30};
+    nd::array c = kernels::make_intersect_arrfunc()(a, b);
+    ASSERT_EQ(3, c.get_dim_size());
+    EXPECT_EQ(2, c(0).as<int>());
+    EXPECT_EQ(5, c(1).as<int>());
+    EXPECT_EQ(7, c(2).as<int>());
+
+    c = kernels::make_union_arrfunc()(a, b);
+    int expected[7] = {1, 2, 3, 5, 7, 20, 30};
+    ASSERT_EQ(7, c.get_dim_size());
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(expected[i], c(i).as<int>());
+    }
+
+    // A small set against a large one, exercising the galloping skips
+    const intptr_t n = 10000;
+    nd::array big = nd::empty(n, ndt::make_type<int64_t>());
+    for (intptr_t i = 0; i < n; ++i) {
+        big(i).vals() = 3 * i;
+    }
+    int64_t small[4] = {-3, 300, 301, 29997};
+    c = kernels::make_intersect_arrfunc()(small, big);
+    ASSERT_EQ(2, c.get_dim_size());
+    EXPECT_EQ(300, c(0).as<int64_t>());
+    EXPECT_EQ(29997, c(1).as<int64_t>());
+    c = kernels::make_union_arrfunc()(big, small);
+    EXPECT_EQ(n + 2, c.get_dim_size());
+    EXPECT_EQ(-3, c(0).as<int64_t>());
+    EXPECT_EQ(301, c(102).as<int64_t>());
+}
+
+TEST(SortedSet, Generic) {
+    nd::array dates = nd::empty(3, ndt::make_date());
+    dates(0).vals() = "2013-12-31";
+    dates(1).vals() = "2014-01-01";
+    dates(2).vals() = "2014-01-01";
+    nd::array b = nd::empty(2, ndt::make_date());
+    b(0).vals() = "2014-01-01";
+    b(1).vals() = "2014-02-01";
+
+    nd::array c = kernels::make_unique_arrfunc()(dates);
+    ASSERT_EQ(2, c.get_dim_size());
+    c = kernels::make_intersect_arrfunc()(dates, b);
+    ASSERT_EQ(1, c.get_dim_size());
+    EXPECT_EQ(ndt::make_date(), c(0).get_type());
+    EXPECT_EQ("2014-01-01", c(0).as<string>());
+    c = kernels::make_union_arrfunc()(dates, b);
+    ASSERT_EQ(3, c.get_dim_size());
+    EXPECT_EQ("2013-12-31", c(0).as<string>());
+    EXPECT_EQ("2014-02-01", c(2).as<string>());
+}
+
+TEST(SortedSet, VarDestination) {
+    // The result goes in a var dimension sized by the kernel
+    int a[5] = {1, 1, 2, 3, 3};
+    nd::arrfunc unique = kernels::make_unique_arrfunc();
+    nd::array c = nd::empty(ndt::type("var * int32"));
+    unique.call_out(a, c);
+    ASSERT_EQ(3, c.get_dim_size());
+    EXPECT_EQ(1, c(0).as<int>());
+    EXPECT_EQ(3, c(2).as<int>());
+    c = nd::empty(3, ndt::make_type<int>());
+    EXPECT_THROW(unique.call_out(a, c), type_error);
+
+    // Lifted, each row gets its own size
+    int rows[3][4] = {{1, 1, 1, 1}, {1, 2, 3, 4}, {5, 5, 6, 6}};
+    c = lift_arrfunc(unique)(rows);
+    EXPECT_EQ(ndt::type("strided * var * int32"), c.get_type());
+    ASSERT_EQ(3, c.get_dim_size());
+    ASSERT_EQ(1, c(0).get_dim_size());
+    ASSERT_EQ(4, c(1).get_dim_size());
+    ASSERT_EQ(2, c(2).get_dim_size());
+    EXPECT_EQ(1, c(0, 0).as<int>());
+    EXPECT_EQ(4, c(1, 3).as<int>());
+    EXPECT_EQ(6, c(2, 1).as<int>());
+}
+
+TEST(BinarySearch, FixedDim) {
+    // binary_search works with any dimension viewable as strided
+    int vals[5] = {1, 4, 6, 9, 12};
+    nd::array a = nd::empty(ndt::make_cfixed_dim(5, ndt::make_type<int>()));
+    a.vals() = vals;
+    int x = 9;
+    EXPECT_EQ(3, nd::binary_search(a, NULL, reinterpret_cast<const char *>(&x)));
+    x = 5;
+    EXPECT_EQ(-1, nd::binary_search(a, NULL, reinterpret_cast<const char *>(&x)));
+}
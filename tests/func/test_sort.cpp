@@ -0,0 +1,202 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/sort_arrfunc.hpp>
+#include <dynd/types/fixedstring_type.hpp>
+#include <dynd/types/date_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Sort, Int) {
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    int avals[7] = {5, -3, 2, 1000000, -7, 2, 0};
+    nd::array b = sort(avals);
+    EXPECT_EQ(ndt::type("strided * int32"), b.get_type());
+    ASSERT_EQ(7, b.get_dim_size());
+    int expected[7] = {-7, -3, 0, 2, 2, 5, 1000000};
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(expected[i], b(i).as<int>());
+    }
+}
+
+TEST(Sort, UInt8AndBool) {
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    uint8_t avals[5] = {200, 3, 255, 0, 17};
+    nd::array b = sort(avals);
+    EXPECT_EQ(0, b(0).as<int>());
+    EXPECT_EQ(3, b(1).as<int>());
+    EXPECT_EQ(17, b(2).as<int>());
+    EXPECT_EQ(200, b(3).as<int>());
+    EXPECT_EQ(255, b(4).as<int>());
+
+    dynd_bool bvals[4] = {true, false, true, false};
+    b = sort(bvals);
+    EXPECT_FALSE(b(0).as<bool>());
+    EXPECT_FALSE(b(1).as<bool>());
+    EXPECT_TRUE(b(2).as<bool>());
+    EXPECT_TRUE(b(3).as<bool>());
+}
+
+TEST(Sort, Double) {
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    double avals[6] = {1.5, -numeric_limits<double>::infinity(),
+                       numeric_limits<double>::quiet_NaN(), -0.25, 1e300, -2.0};
+    nd::array b = sort(avals);
+    EXPECT_EQ(-numeric_limits<double>::infinity(), b(0).as<double>());
+    EXPECT_EQ(-2.0, b(1).as<double>());
+    EXPECT_EQ(-0.25, b(2).as<double>());
+    EXPECT_EQ(1.5, b(3).as<double>());
+    EXPECT_EQ(1e300, b(4).as<double>());
+    // NaN sorts last
+    EXPECT_TRUE(DYND_ISNAN(b(5).as<double>()));
+}
+
+TEST(Sort, ArgsortStable) {
+    nd::arrfunc argsort = kernels::make_argsort_arrfunc();
+    float avals[6] = {3.f, 1.f, 3.f, -1.f, 1.f, 3.f};
+    nd::array b = argsort(avals);
+    EXPECT_EQ(ndt::type("strided * intptr"), b.get_type());
+    intptr_t expected[6] = {3, 1, 4, 0, 2, 5};
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(expected[i], b(i).as<intptr_t>());
+    }
+}
+
+TEST(Sort, String) {
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    nd::arrfunc argsort = kernels::make_argsort_arrfunc();
+    // Shares long prefixes, so the full comparison gets exercised
+    const char *strs[6] = {"banana", "apple_pie_b", "apple_pie_a", "",
+                           "apple", "cherry"};
+    nd::array a = strs;
+    nd::array b = sort(a);
+    EXPECT_EQ(ndt::type("strided * string"), b.get_type());
+    EXPECT_EQ("", b(0).as<string>());
+    EXPECT_EQ("apple", b(1).as<string>());
+    EXPECT_EQ("apple_pie_a", b(2).as<string>());
+    EXPECT_EQ("apple_pie_b", b(3).as<string>());
+    EXPECT_EQ("banana", b(4).as<string>());
+    EXPECT_EQ("cherry", b(5).as<string>());
+
+    b = argsort(a);
+    EXPECT_EQ(3, b(0).as<intptr_t>());
+    EXPECT_EQ(4, b(1).as<intptr_t>());
+    EXPECT_EQ(2, b(2).as<intptr_t>());
+    EXPECT_EQ(1, b(3).as<intptr_t>());
+    EXPECT_EQ(0, b(4).as<intptr_t>());
+    EXPECT_EQ(5, b(5).as<intptr_t>());
+
+    a = a.ucast(ndt::make_fixedstring(12, string_encoding_utf_8)).eval();
+    b = sort(a);
+    EXPECT_EQ(ndt::make_strided_dim(
+                  ndt::make_fixedstring(12, string_encoding_utf_8)),
+              b.get_type());
+    EXPECT_EQ("", b(0).as<string>());
+    EXPECT_EQ("apple", b(1).as<string>());
+    EXPECT_EQ("apple_pie_a", b(2).as<string>());
+    EXPECT_EQ("apple_pie_b", b(3).as<string>());
+    EXPECT_EQ("banana", b(4).as<string>());
+    EXPECT_EQ("cherry", b(5).as<string>());
+}
+
+TEST(Sort, GenericComparison) {
+    nd::arrfunc sort = kernels::make_sort_arrfunc();
+    const char *strs[] = {"2013-05-14", "1931-12-12", "2012-12-25"};
+    nd::array a = nd::array(strs).ucast(ndt::make_date()).eval();
+    nd::array b = sort(a);
+    EXPECT_EQ(ndt::type("strided * date"), b.get_type());
+    EXPECT_EQ("1931-12-12", b(0).as<string>());
+    EXPECT_EQ("2012-12-25", b(1).as<string>());
+    EXPECT_EQ("2013-05-14", b(2).as<string>());
+}
+
+TEST(Sort, PartitionAndTopK) {
+    int avals[8] = {9, 4, 7, 1, 8, 2, 6, 3};
+    nd::array b = kernels::make_partition_arrfunc(3)(avals);
+    ASSERT_EQ(8, b.get_dim_size());
+    EXPECT_EQ(4, b(3).as<int>());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_LE(b(i).as<int>(), 4);
+    }
+    for (int i = 4; i < 8; ++i) {
+        EXPECT_GE(b(i).as<int>(), 4);
+    }
+    // Negative partition index counts from the end
+    b = kernels::make_partition_arrfunc(-1)(avals);
+    EXPECT_EQ(9, b(7).as<int>());
+    EXPECT_THROW(kernels::make_partition_arrfunc(8)(avals), index_out_of_bounds);
+
+    b = kernels::make_topk_arrfunc(3)(avals);
+    ASSERT_EQ(3, b.get_dim_size());
+    EXPECT_EQ(1, b(0).as<int>());
+    EXPECT_EQ(2, b(1).as<int>());
+    EXPECT_EQ(3, b(2).as<int>());
+    // Asking for more than there are gives all of them
+    b = kernels::make_topk_arrfunc(20)(avals);
+    ASSERT_EQ(8, b.get_dim_size());
+    EXPECT_EQ(9, b(7).as<int>());
+    EXPECT_THROW(kernels::make_topk_arrfunc(-1), invalid_argument);
+}
+
+TEST(Sort, Empty) {
+    nd::array a = nd::empty(0, ndt::make_type<int64_t>());
+    nd::array b = kernels::make_sort_arrfunc()(a);
+    EXPECT_EQ(0, b.get_dim_size());
+}
+
+TEST(Sort, LargeParallel) {
+    // Big enough for the parallel block sort and merge, with lots
+    // of duplicates to check the stability of the merges
+    const intptr_t n = 300000;
+    nd::array a = nd::empty(n, ndt::make_type<int32_t>());
+    int32_t *adata = reinterpret_cast<int32_t *>(a.get_readwrite_originptr());
+    vector<int32_t> expected(n);
+    uint32_t state = 12345;
+    for (intptr_t i = 0; i < n; ++i) {
+        state = state * 1103515245u + 12345u;
+        adata[i] = expected[i] = (int32_t)(state >> 8) % 1000 - 500;
+    }
+    std::sort(expected.begin(), expected.end());
+
+    eval::eval_context ectx;
+    ectx.thread_count = 3;
+    nd::array b = kernels::make_sort_arrfunc().call(1, &a, &ectx);
+    const int32_t *bdata = reinterpret_cast<const int32_t *>(b.get_readonly_originptr());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bdata));
+
+    nd::array c = kernels::make_argsort_arrfunc().call(1, &a, &ectx);
+    const intptr_t *cdata = reinterpret_cast<const intptr_t *>(c.get_readonly_originptr());
+    for (intptr_t i = 1; i < n; ++i) {
+        ASSERT_TRUE(adata[cdata[i - 1]] < adata[cdata[i]] ||
+                    (adata[cdata[i - 1]] == adata[cdata[i]] &&
+                     cdata[i - 1] < cdata[i]));
+    }
+
+    // The key prefix sort path in parallel, with strings of the
+    // values offset to four digits so they sort the same way
+    const intptr_t nstr = 70000;
+    vector<int32_t> expected_str(adata, adata + nstr);
+    nd::array d = nd::empty(nstr, ndt::make_type<int32_t>());
+    int32_t *ddata = reinterpret_cast<int32_t *>(d.get_readwrite_originptr());
+    for (intptr_t i = 0; i < nstr; ++i) {
+        ddata[i] = expected_str[i] = adata[i] + 1500;
+    }
+    d = d.ucast(ndt::make_string()).eval();
+    nd::array e = kernels::make_sort_arrfunc().call(1, &d, &ectx);
+    std::sort(expected_str.begin(), expected_str.end());
+    for (intptr_t i = 0; i < nstr; i += 997) {
+        ASSERT_EQ(expected_str[i], e(i).as<int32_t>());
+    }
+}
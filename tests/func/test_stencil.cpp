@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/strided_view.hpp>
+#include <dynd/func/stencil_arrfunc.hpp>
+#include <dynd/kernels/reduction_kernels.hpp>
+#include <dynd/func/lift_reduction_arrfunc.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// The value of a[i][j] extended beyond its bounds by the boundary mode,
+// written out the slow way
+static double extended(const nd::array& a, intptr_t i, intptr_t j,
+                       stencil_boundary_t boundary, double constant)
+{
+    intptr_t idx[2] = {i, j};
+    for (int k = 0; k < 2; ++k) {
+        intptr_t size = a.get_dim_size(k);
+        while (idx[k] < 0 || idx[k] >= size) {
+            switch (boundary) {
+                case stencil_boundary_constant:
+                    return constant;
+                case stencil_boundary_nearest:
+                    idx[k] = idx[k] < 0 ? 0 : size - 1;
+                    break;
+                case stencil_boundary_reflect:
+                    idx[k] = idx[k] < 0 ? -idx[k] - 1 : 2 * size - idx[k] - 1;
+                    break;
+                case stencil_boundary_wrap:
+                    idx[k] += idx[k] < 0 ? size : -size;
+                    break;
+            }
+        }
+    }
+    return a(idx[0], idx[1]).as<double>();
+}
+
+static nd::arrfunc make_sum2d()
+{
+    bool reduction_dimflags[2] = {true, true};
+    return lift_reduction_arrfunc(
+        kernels::make_builtin_sum_reduction_arrfunc(float64_type_id),
+        ndt::type("strided * strided * float64"), nd::arrfunc(), false, 2,
+        reduction_dimflags, true, true, false, 0.0);
+}
+
+TEST(Stencil, Sum2D) {
+    nd::array a = nd::empty(6, 7, ndt::make_type<double>());
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            a(i, j).vals() = 10 * i + j + (i * j) % 3;
+        }
+    }
+    // A 3 x 4 neighborhood, off center in the second dimension
+    intptr_t nh_shape[2] = {3, 4}, nh_offset[2] = {-1, -2};
+    stencil_boundary_t modes[4] = {
+        stencil_boundary_constant, stencil_boundary_nearest,
+        stencil_boundary_reflect, stencil_boundary_wrap};
+    for (int m = 0; m < 4; ++m) {
+        nd::arrfunc sum = make_stencil_arrfunc(make_sum2d(), 2, nh_shape,
+                                               nh_offset, modes[m], 0.5);
+        nd::array b = sum(a);
+        EXPECT_EQ(ndt::type("strided * strided * float64"), b.get_type());
+        ASSERT_EQ(6, b.get_dim_size(0));
+        ASSERT_EQ(7, b.get_dim_size(1));
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 7; ++j) {
+                double s = 0;
+                for (int di = 0; di < 3; ++di) {
+                    for (int dj = 0; dj < 4; ++dj) {
+                        s += extended(a, i + di - 1, j + dj - 2, modes[m], 0.5);
+                    }
+                }
+                EXPECT_EQ(s, b(i, j).as<double>()) << "mode " << m << " at "
+                                                   << i << ", " << j;
+            }
+        }
+    }
+
+    // A transposed view, with the neighborhood larger than the array
+    nd::array at = a.transpose();
+    intptr_t big_shape[2] = {9, 2};
+    nd::arrfunc sum = make_stencil_arrfunc(make_sum2d(), 2, big_shape, NULL,
+                                           stencil_boundary_reflect);
+    nd::array b = sum(at);
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            double s = 0;
+            for (int di = 0; di < 9; ++di) {
+                for (int dj = 0; dj < 2; ++dj) {
+                    s += extended(at, i + di, j + dj,
+                                  stencil_boundary_reflect, 0);
+                }
+            }
+            EXPECT_EQ(s, b(i, j).as<double>());
+        }
+    }
+}
+
+TEST(Stencil, Sum1D) {
+    // Long enough to be split into several interior tiles
+    intptr_t n = 100000;
+    nd::array a = nd::empty(n, ndt::make_type<double>());
+    nd::strided_view<double, 1> av(a);
+    for (intptr_t i = 0; i < n; ++i) {
+        av(i) = (double)(i % 17);
+    }
+    intptr_t nh_shape = 5, nh_offset = -2;
+    nd::arrfunc sum = make_stencil_arrfunc(
+        kernels::make_builtin_sum1d_arrfunc(float64_type_id), 1, &nh_shape,
+        &nh_offset, stencil_boundary_wrap);
+    nd::array b = sum(a);
+    ASSERT_EQ(n, b.get_dim_size());
+    nd::strided_view<const double, 1> bv(b);
+    for (intptr_t i = 0; i < n; ++i) {
+        double s = 0;
+        for (intptr_t j = i - 2; j <= i + 2; ++j) {
+            s += (double)(((j + n) % n) % 17);
+        }
+        ASSERT_EQ(s, bv(i)) << "at " << i;
+    }
+}
+
+TEST(Stencil, Errors) {
+    intptr_t nh_shape[2] = {3, 3};
+    EXPECT_THROW(make_stencil_arrfunc(nd::arrfunc(), 2, nh_shape, NULL,
+                                      stencil_boundary_constant),
+                 invalid_argument);
+    // The window op must accept as many dimensions as the stencil
+    EXPECT_THROW(make_stencil_arrfunc(kernels::make_builtin_sum1d_arrfunc(
+                                          float64_type_id),
+                                      2, nh_shape, NULL,
+                                      stencil_boundary_constant),
+                 invalid_argument);
+    nh_shape[1] = 0;
+    EXPECT_THROW(make_stencil_arrfunc(make_sum2d(), 2, nh_shape, NULL,
+                                      stencil_boundary_constant),
+                 invalid_argument);
+}
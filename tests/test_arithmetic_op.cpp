@@ -247,3 +247,104 @@ TEST(ArithmeticOp, ComplexScalar) {
     EXPECT_EQ(dynd_complex<float>(0,-2), c(1).as<dynd_complex<float> >());
     EXPECT_EQ(dynd_complex<float>(0,-3), c(2).as<dynd_complex<float> >());
 }
+
+TEST(ArithmeticOp, UnitStrideLoops) {
+    nd::array a, b, c;
+    double v0[37], v1[37];
+    for (int i = 0; i < 37; ++i) {
+        v0[i] = i;
+        v1[i] = 100 - 2 * i;
+    }
+    a = v0;
+    b = v1;
+
+    // Both contiguous
+    c = (a - b).eval();
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(3 * i - 100, c(i).as<double>());
+    }
+    // A broadcast scalar on either side
+    c = (a * 2.0).eval();
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(2 * i, c(i).as<double>());
+    }
+    c = (1.0 - a).eval();
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(1 - i, c(i).as<double>());
+    }
+    // Strided views take the general loop
+    c = (a(irange().by(3)) + b(irange().by(3))).eval();
+    ASSERT_EQ(13, c.get_dim_size());
+    for (int i = 0; i < 13; ++i) {
+        EXPECT_EQ(100 - 3 * i, c(i).as<double>());
+    }
+}
+
+TEST(ArithmeticOp, Int128) {
+    // Fixed point values too big for int64 arithmetic
+    nd::array a = nd::empty(3, ndt::make_type<dynd_int128>());
+    nd::array b = nd::empty(3, ndt::make_type<dynd_int128>());
+    dynd_int128 *a_data =
+        reinterpret_cast<dynd_int128 *>(a.get_readwrite_originptr());
+    dynd_int128 *b_data =
+        reinterpret_cast<dynd_int128 *>(b.get_readwrite_originptr());
+    a_data[0] = dynd_int128(0x10ULL, 0ULL);
+    a_data[1] = dynd_int128(-12345);
+    a_data[2] = numeric_limits<dynd_int128>::max();
+    b_data[0] = dynd_int128(10000);
+    b_data[1] = dynd_int128(0x100000000LL);
+    b_data[2] = dynd_int128(-3);
+
+    nd::array c = (a + b).eval();
+    EXPECT_EQ(ndt::make_type<dynd_int128>(), c.get_dtype());
+    EXPECT_EQ(dynd_int128(0x10ULL, 10000ULL), c(0).as<dynd_int128>());
+    c = (a - b).eval();
+    EXPECT_EQ(dynd_int128(-12345LL - 0x100000000LL), c(1).as<dynd_int128>());
+    c = (a * b).eval();
+    EXPECT_EQ(dynd_int128(0x27100ULL, 0ULL), c(0).as<dynd_int128>());
+    EXPECT_EQ(dynd_int128(-12345LL * 0x100000000LL), c(1).as<dynd_int128>());
+    c = (a / b).eval();
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(a_data[i] / b_data[i], c(i).as<dynd_int128>());
+    }
+    EXPECT_EQ(dynd_int128(0), c(1).as<dynd_int128>());
+    EXPECT_EQ(dynd_int128(0xd555555555555555ULL, 0x5555555555555556ULL),
+              c(2).as<dynd_int128>());
+
+    nd::array d = nd::empty(2, ndt::make_type<dynd_uint128>());
+    nd::array e = nd::empty(2, ndt::make_type<dynd_uint128>());
+    dynd_uint128 *d_data =
+        reinterpret_cast<dynd_uint128 *>(d.get_readwrite_originptr());
+    dynd_uint128 *e_data =
+        reinterpret_cast<dynd_uint128 *>(e.get_readwrite_originptr());
+    d_data[0] = dynd_uint128(0xfedcba9876543210ULL, 0x0123456789abcdefULL);
+    d_data[1] = dynd_uint128(0ULL, 0x1000000000000000ULL);
+    e_data[0] = d_data[1];
+    e_data[1] = d_data[0];
+    c = (d / e).eval();
+    EXPECT_EQ(ndt::make_type<dynd_uint128>(), c.get_dtype());
+    EXPECT_EQ(dynd_uint128(0xfULL, 0xedcba98765432100ULL),
+              c(0).as<dynd_uint128>());
+    EXPECT_EQ(dynd_uint128(0ULL, 0ULL), c(1).as<dynd_uint128>());
+}
+
+TEST(ArithmeticOp, UnitStrideInPlace) {
+    double v0[37], v1[37];
+    for (int i = 0; i < 37; ++i) {
+        v0[i] = i;
+        v1[i] = 2 * i;
+    }
+    nd::array a = nd::empty(37, ndt::make_type<double>());
+    nd::array b = nd::empty(37, ndt::make_type<double>());
+    a.vals() = v0;
+    b.vals() = v1;
+    // The destination is one of the operands
+    a.vals() = a + b;
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(3 * i, a(i).as<double>());
+    }
+    b.vals() = 1.0 - b;
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(1 - 2 * i, b(i).as<double>());
+    }
+}
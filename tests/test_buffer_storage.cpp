@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/buffer_storage.hpp>
+#include <dynd/types/convert_type.hpp>
+#include <dynd/types/byteswap_type.hpp>
+#include <dynd/kernels/byteswap_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(BufferStorage, CpuCacheSize) {
+    EXPECT_GT(get_cpu_cache_size(1), 0);
+    EXPECT_GE(get_cpu_cache_size(2), get_cpu_cache_size(1));
+    EXPECT_THROW(get_cpu_cache_size(0), invalid_argument);
+}
+
+TEST(BufferStorage, ChunkSize) {
+    intptr_t narrow[3] = {1, 1, 1}, wide[3] = {200, 8, 200};
+    intptr_t narrow_size = get_buffer_chunk_size(3, narrow, NULL);
+    intptr_t wide_size = get_buffer_chunk_size(3, wide, NULL);
+    EXPECT_GE(narrow_size, wide_size);
+    EXPECT_LE(narrow_size, DYND_BUFFER_CHUNK_SIZE_MAX);
+    EXPECT_GE(wide_size, DYND_BUFFER_CHUNK_SIZE_MIN);
+    EXPECT_EQ(0, narrow_size % DYND_BUFFER_CHUNK_SIZE_MIN);
+    EXPECT_EQ(0, wide_size % DYND_BUFFER_CHUNK_SIZE_MIN);
+    // More buffered stages never gives a bigger chunk
+    EXPECT_LE(get_buffer_chunk_size(3, wide, NULL),
+              get_buffer_chunk_size(2, wide, NULL));
+
+    // The eval_context override is used as is
+    eval::eval_context ectx;
+    ectx.buffer_chunk_size = 7;
+    EXPECT_EQ(7, get_buffer_chunk_size(3, wide, &ectx));
+}
+
+TEST(BufferStorage, Allocate) {
+    eval::eval_context ectx;
+    ectx.buffer_chunk_size = 48;
+    buffer_storage bs(ndt::make_type<double>(), &ectx);
+    EXPECT_EQ(48, bs.get_element_count());
+    EXPECT_EQ(8, bs.get_stride());
+    buffer_storage bs_copy(bs);
+    EXPECT_EQ(48, bs_copy.get_element_count());
+}
+
+TEST(BufferStorage, ChainedConversionChunks) {
+    // A chain of conversions which buffers in between each stage,
+    // run with a few chunk sizes which don't evenly divide the size
+    nd::array a = nd::empty(1000, ndt::make_type<int32_t>());
+    for (int i = 0; i < 1000; ++i) {
+        a(i).vals() = (i - 500) * 12345;
+    }
+    nd::array src = a.view_scalars(ndt::make_byteswap<int32_t>())
+                        .ucast<int64_t>()
+                        .ucast<double>();
+    EXPECT_EQ(expr_kind, src.get_dtype().get_kind());
+    intptr_t chunk_sizes[] = {0, 1, 16, 100};
+    for (size_t k = 0; k < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++k) {
+        eval::eval_context ectx;
+        ectx.buffer_chunk_size = chunk_sizes[k];
+        nd::array b = nd::empty(1000, ndt::make_type<double>());
+        b.val_assign(src, &ectx);
+        for (int i = 0; i < 1000; ++i) {
+            int32_t expected = (int32_t)byteswap_value(
+                (uint32_t)((i - 500) * 12345));
+            EXPECT_EQ((double)expected, b(i).as<double>());
+        }
+    }
+}
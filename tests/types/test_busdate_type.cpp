@@ -0,0 +1,158 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/types/busdate_type.hpp>
+#include <dynd/types/date_type.hpp>
+#include <dynd/kernels/busdate_kernels.hpp>
+#include <dynd/func/lift_arrfunc.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// Business day offsets and counts, stepping one day at a time
+static bool slow_is_busday(const bool *weekmask, const vector<int32_t>& hol,
+                           int32_t days)
+{
+    date_ymd ymd;
+    ymd.set_from_days(days);
+    return weekmask[ymd.get_weekday()] &&
+           find(hol.begin(), hol.end(), days) == hol.end();
+}
+
+static int32_t slow_offset(const bool *weekmask, const vector<int32_t>& hol,
+                           int32_t days, int64_t offset)
+{
+    while (!slow_is_busday(weekmask, hol, days)) {
+        ++days;
+    }
+    for (; offset > 0; --offset) {
+        do {
+            ++days;
+        } while (!slow_is_busday(weekmask, hol, days));
+    }
+    for (; offset < 0; ++offset) {
+        do {
+            --days;
+        } while (!slow_is_busday(weekmask, hol, days));
+    }
+    return days;
+}
+
+static int64_t slow_count(const bool *weekmask, const vector<int32_t>& hol,
+                          int32_t begin, int32_t end)
+{
+    int64_t count = 0;
+    for (int32_t d = min(begin, end); d < max(begin, end); ++d) {
+        count += slow_is_busday(weekmask, hol, d) ? 1 : 0;
+    }
+    return begin <= end ? count : -count;
+}
+
+TEST(BusdateCalendar, MatchesDayByDay) {
+    // Monday to Thursday and Sunday
+    bool weekmask[7] = {true, true, true, true, false, false, true};
+    nd::array holidays = parse_json("7 * date",
+        "[\"2014-01-01\", \"2013-12-25\", \"2014-01-20\", \"2014-01-01\","
+        " \"2014-01-21\", \"2014-02-15\", \"2013-11-28\"]");
+    busdate_calendar cal(weekmask, holidays);
+    // Sorted, without the duplicate or the Saturday
+    const vector<int32_t>& hol = cal.get_holidays();
+    ASSERT_EQ(5u, hol.size());
+    EXPECT_EQ(date_ymd::to_days(2013, 11, 28), hol[0]);
+    EXPECT_EQ(date_ymd::to_days(2014, 1, 21), hol[4]);
+    EXPECT_EQ(5, cal.get_busdays_in_weekmask());
+
+    int32_t first = date_ymd::to_days(2013, 11, 1);
+    int32_t last = date_ymd::to_days(2014, 3, 1);
+    for (int32_t d = first; d < last; ++d) {
+        EXPECT_EQ(slow_is_busday(weekmask, hol, d), cal.is_busday(d));
+        for (int64_t n = -30; n <= 30; n += 7) {
+            ASSERT_EQ(slow_offset(weekmask, hol, d, n),
+                      cal.offset(d, n, busdate_roll_following))
+                << "from day " << d << " by " << n;
+        }
+        for (int32_t e = first; e < last; e += 11) {
+            ASSERT_EQ(slow_count(weekmask, hol, d, e), cal.count(d, e))
+                << "from day " << d << " to " << e;
+        }
+    }
+    // Far away, before and after the epoch
+    int32_t d = date_ymd::to_days(1900, 3, 7);
+    int64_t n = cal.count(d, date_ymd::to_days(2100, 6, 1));
+    EXPECT_EQ(date_ymd::to_days(2100, 6, 1),
+              cal.offset(d, n, busdate_roll_following));
+    EXPECT_EQ(DYND_DATE_NA, cal.offset(DYND_DATE_NA, 3, busdate_roll_following));
+    EXPECT_THROW(cal.count(DYND_DATE_NA, d), invalid_argument);
+}
+
+TEST(BusdateCalendar, Roll) {
+    busdate_calendar cal;
+    // Saturday, May 31, 2014
+    int32_t sat = date_ymd::to_days(2014, 5, 31);
+    EXPECT_EQ(date_ymd::to_days(2014, 6, 2),
+              cal.roll(sat, busdate_roll_following));
+    EXPECT_EQ(date_ymd::to_days(2014, 5, 30),
+              cal.roll(sat, busdate_roll_preceding));
+    EXPECT_EQ(date_ymd::to_days(2014, 5, 30),
+              cal.roll(sat, busdate_roll_modifiedfollowing));
+    EXPECT_EQ(date_ymd::to_days(2014, 5, 30),
+              cal.roll(sat, busdate_roll_modifiedpreceding));
+    // Sunday, June 1, 2014
+    int32_t sun = date_ymd::to_days(2014, 6, 1);
+    EXPECT_EQ(date_ymd::to_days(2014, 6, 2),
+              cal.roll(sun, busdate_roll_modifiedpreceding));
+    EXPECT_EQ(DYND_DATE_NA, cal.roll(sun, busdate_roll_nat));
+    EXPECT_THROW(cal.roll(sun, busdate_roll_throw), invalid_argument);
+    // Business days are left alone
+    EXPECT_EQ(sun + 1, cal.roll(sun + 1, busdate_roll_throw));
+
+    bool no_days[7] = {false, false, false, false, false, false, false};
+    EXPECT_THROW(busdate_calendar(no_days, nd::array()), invalid_argument);
+}
+
+TEST(BusdateType, Holidays) {
+    EXPECT_EQ("busdate", ndt::make_busdate().str());
+    nd::array holidays = parse_json("3 * date",
+        "[\"2014-07-04\", \"2014-01-01\", \"2014-07-05\"]");
+    ndt::type tp = ndt::make_busdate(busdate_roll_following, NULL, holidays);
+    EXPECT_EQ("date<holidays=[\"2014-01-01\", \"2014-07-04\"]>", tp.str());
+    EXPECT_EQ(ndt::make_busdate(busdate_roll_following, NULL, holidays), tp);
+}
+
+TEST(BusdateKernels, OffsetAndCount) {
+    nd::array holidays = parse_json("1 * date", "[\"2014-07-04\"]");
+    ndt::type tp = ndt::make_busdate(busdate_roll_following, NULL, holidays);
+    nd::arrfunc offset = lift_arrfunc(kernels::make_busday_offset_arrfunc(tp));
+    nd::arrfunc count = lift_arrfunc(kernels::make_busday_count_arrfunc(tp));
+
+    nd::array dates = parse_json("4 * date",
+        "[\"2014-07-02\", \"2014-07-05\", \"2014-07-03\", \"2014-06-27\"]");
+    nd::array n = parse_json("4 * int64", "[1, 0, 2, -1]");
+    nd::array result = offset(dates, n);
+    EXPECT_EQ(ndt::type("4 * date"), result.get_type());
+    EXPECT_EQ("2014-07-03", result(0).as<string>());
+    EXPECT_EQ("2014-07-07", result(1).as<string>());
+    EXPECT_EQ("2014-07-08", result(2).as<string>());
+    EXPECT_EQ("2014-06-26", result(3).as<string>());
+
+    // The offsets broadcast against the dates
+    result = offset(dates, nd::array((int64_t)5));
+    EXPECT_EQ("2014-07-10", result(0).as<string>());
+
+    nd::array counts = count(dates, result);
+    EXPECT_EQ(ndt::type("4 * int64"), counts.get_type());
+    EXPECT_EQ(5, counts(0).as<int64_t>());
+    EXPECT_EQ(-5, count(result, dates)(0).as<int64_t>());
+
+    EXPECT_THROW(kernels::make_busday_count_arrfunc(ndt::make_date()),
+                 type_error);
+}
@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "inc_gtest.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/types/dynd_float16.hpp>
+#include <dynd/kernels/float16_assignment_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Float16, StridedFromHalf) {
+    // Every float16 bit pattern, converted in bulk, matches the
+    // scalar conversion
+    vector<uint16_t> h(65536);
+    for (int i = 0; i < 65536; ++i) {
+        h[i] = (uint16_t)i;
+    }
+    vector<float> f(65536);
+    vector<double> d(65536);
+    float16_to_float32_strided(reinterpret_cast<char *>(&f[0]), sizeof(float),
+                               reinterpret_cast<const char *>(&h[0]),
+                               sizeof(uint16_t), h.size());
+    float16_to_float64_strided(reinterpret_cast<char *>(&d[0]), sizeof(double),
+                               reinterpret_cast<const char *>(&h[0]),
+                               sizeof(uint16_t), h.size());
+    intptr_t mismatches = 0;
+    for (int i = 0; i < 65536; ++i) {
+        float fs = halfbits_to_float(h[i]);
+        double ds = halfbits_to_double(h[i]);
+        if (fs != fs) {
+            // NaN payloads may differ
+            mismatches += (f[i] == f[i]) + (d[i] == d[i]);
+        } else {
+            mismatches += (f[i] != fs) + (d[i] != ds);
+        }
+    }
+    EXPECT_EQ(0, mismatches);
+
+    // A non-contiguous source and destination, of an odd length
+    float fs[37 * 3];
+    float16_to_float32_strided(reinterpret_cast<char *>(fs), 3 * sizeof(float),
+                               reinterpret_cast<const char *>(&h[15360]),
+                               2 * sizeof(uint16_t), 37);
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(halfbits_to_float(h[15360 + 2 * i]), fs[3 * i]);
+    }
+}
+
+TEST(Float16, StridedToHalf) {
+    // Values in the normal float16 range, including ties and values
+    // which round up to inf
+    vector<float> f;
+    vector<double> d;
+    for (int i = 0; i < 20000; ++i) {
+        float v = (float)((i * 7919) % 70000 - 35000) / (1 + i % 13) + 0.125f;
+        f.push_back(v);
+        d.push_back(v * (1.0 + 1e-9));
+    }
+    f.push_back(65519.f);
+    f.push_back(65520.f);
+    f.push_back(2049.f);
+    f.push_back(2051.f);
+    d.push_back(65519.99);
+    d.push_back(-65520.0);
+    vector<uint16_t> hf(f.size()), hd(d.size());
+    float32_to_float16_strided(reinterpret_cast<char *>(&hf[0]),
+                               sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&f[0]),
+                               sizeof(float), f.size(), assign_error_nocheck);
+    float64_to_float16_strided(reinterpret_cast<char *>(&hd[0]),
+                               sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&d[0]),
+                               sizeof(double), d.size(), assign_error_nocheck);
+    intptr_t mismatches = 0;
+    for (size_t i = 0; i < f.size(); ++i) {
+        mismatches += (hf[i] != float_to_halfbits(f[i], assign_error_nocheck));
+    }
+    for (size_t i = 0; i < d.size(); ++i) {
+        mismatches += (hd[i] != double_to_halfbits(d[i], assign_error_nocheck));
+    }
+    EXPECT_EQ(0, mismatches);
+    EXPECT_EQ(DYND_FLOAT16_PINF, hf[f.size() - 3]);
+    EXPECT_EQ(DYND_FLOAT16_NINF, hd[d.size() - 1]);
+}
+
+TEST(Float16, StridedToHalfErrors) {
+    vector<float> f(1000, 1.5f);
+    vector<uint16_t> h(f.size());
+
+    // Rounding in the normal range is fine in every mode
+    f[700] = 1.0001f;
+    float32_to_float16_strided(reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&f[0]),
+                               sizeof(float), f.size(), assign_error_inexact);
+    EXPECT_EQ(DYND_FLOAT16_ONE, h[700]);
+
+    // Overflow is caught in the block it happens in
+    f[700] = 1e6f;
+    EXPECT_THROW(float32_to_float16_strided(
+                     reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                     reinterpret_cast<const char *>(&f[0]), sizeof(float),
+                     f.size(), assign_error_overflow),
+                 overflow_error);
+    float32_to_float16_strided(reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&f[0]),
+                               sizeof(float), f.size(), assign_error_nocheck);
+    EXPECT_EQ(DYND_FLOAT16_PINF, h[700]);
+
+    // Underflow is only an error in inexact mode
+    vector<double> d(1000, -2.5);
+    d[999] = 1e-9;
+    float64_to_float16_strided(reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&d[0]),
+                               sizeof(double), d.size(), assign_error_fractional);
+    EXPECT_EQ(DYND_FLOAT16_ZERO, h[999]);
+    EXPECT_THROW(float64_to_float16_strided(
+                     reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                     reinterpret_cast<const char *>(&d[0]), sizeof(double),
+                     d.size(), assign_error_inexact),
+                 runtime_error);
+    // Infinities and NaNs aren't overflow
+    d[999] = numeric_limits<double>::infinity();
+    d[998] = numeric_limits<double>::quiet_NaN();
+    float64_to_float16_strided(reinterpret_cast<char *>(&h[0]), sizeof(uint16_t),
+                               reinterpret_cast<const char *>(&d[0]),
+                               sizeof(double), d.size(), assign_error_inexact);
+    EXPECT_EQ(DYND_FLOAT16_PINF, h[999]);
+    EXPECT_TRUE(dynd_float16(h[998], dynd_float16::raw_bits_tag()).isnan_());
+}
+
+TEST(Float16, ArrayAssign) {
+    // Array assignment uses the bulk conversions
+    nd::array a = nd::empty(1000, ndt::make_type<float>());
+    float *a_data = reinterpret_cast<float *>(a.get_readwrite_originptr());
+    for (int i = 0; i < 1000; ++i) {
+        a_data[i] = i * 0.25f;
+    }
+    nd::array b = nd::empty(1000, ndt::make_type<dynd_float16>());
+    b.vals() = a;
+    nd::array c = nd::empty(1000, ndt::make_type<double>());
+    c.vals() = b;
+    EXPECT_EQ(0.25, c(1).as<double>());
+    EXPECT_EQ(999 * 0.25, c(999).as<double>());
+    // The default error mode catches overflow
+    a_data[500] = 70000.f;
+    EXPECT_THROW(b.vals() = a, overflow_error);
+}
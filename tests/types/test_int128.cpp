@@ -0,0 +1,141 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "inc_gtest.hpp"
+
+#include <dynd/types/dynd_int128.hpp>
+#include <dynd/types/dynd_uint128.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// A spread of bit patterns, including the interesting edge values
+static vector<dynd_uint128> uint128_test_values()
+{
+    vector<dynd_uint128> vals;
+    vals.push_back(dynd_uint128(0ULL, 0ULL));
+    vals.push_back(dynd_uint128(0ULL, 1ULL));
+    vals.push_back(dynd_uint128(0ULL, 7ULL));
+    vals.push_back(dynd_uint128(0ULL, 0xffffffffULL));
+    vals.push_back(dynd_uint128(0ULL, 0x100000000ULL));
+    vals.push_back(dynd_uint128(0ULL, 0xffffffffffffffffULL));
+    vals.push_back(dynd_uint128(1ULL, 0ULL));
+    vals.push_back(dynd_uint128(0x7fffffffffffffffULL, 0xffffffffffffffffULL));
+    vals.push_back(dynd_uint128(0x8000000000000000ULL, 0ULL));
+    vals.push_back(dynd_uint128(0xffffffffffffffffULL, 0xffffffffffffffffULL));
+    uint64_t x = 0x243f6a8885a308d3ULL;
+    for (int i = 0; i < 40; ++i) {
+        // xorshift, with the high word sometimes truncated so the
+        // values have a range of magnitudes
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        uint64_t hi = x >> (i % 4) * 21;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        vals.push_back(dynd_uint128(hi, x));
+    }
+    return vals;
+}
+
+TEST(Int128, UnsignedMulDiv) {
+    vector<dynd_uint128> vals = uint128_test_values();
+    for (size_t i = 0; i < vals.size(); ++i) {
+        for (size_t j = 0; j < vals.size(); ++j) {
+            const dynd_uint128& a = vals[i], &b = vals[j];
+            EXPECT_EQ(a * b, dynd_uint128::mul_portable(a, b));
+            if (b != dynd_uint128(0ULL)) {
+                dynd_uint128 div = a / b, rem = a % b;
+                EXPECT_TRUE(rem < b);
+                EXPECT_EQ(a, div * b + rem);
+                dynd_uint128 pdiv, prem;
+                dynd_uint128::divrem_portable(a, b, pdiv, prem);
+                EXPECT_EQ(div, pdiv);
+                EXPECT_EQ(rem, prem);
+            }
+        }
+    }
+
+    // 2^64 * 2^63 and back
+    dynd_uint128 a(1ULL, 0ULL), b(0ULL, 0x8000000000000000ULL);
+    EXPECT_EQ(dynd_uint128(0x8000000000000000ULL, 0ULL), a * b);
+    EXPECT_EQ(b, (a * b) / a);
+    // The 32-bit divisor overloads
+    EXPECT_EQ(dynd_uint128(3ULL, 0ULL), dynd_uint128(6ULL, 0ULL) / 2u);
+    EXPECT_EQ(dynd_uint128(0ULL, 123456789ULL * 1000u),
+              dynd_uint128(0ULL, 123456789ULL) * 1000u);
+}
+
+TEST(Int128, SignedMulDiv) {
+    vector<dynd_uint128> uvals = uint128_test_values();
+    vector<dynd_int128> vals;
+    for (size_t i = 0; i < uvals.size(); ++i) {
+        vals.push_back(dynd_int128(uvals[i].m_hi, uvals[i].m_lo));
+        vals.push_back(-vals.back());
+    }
+    dynd_int128 int128_min = numeric_limits<dynd_int128>::min();
+    for (size_t i = 0; i < vals.size(); ++i) {
+        for (size_t j = 0; j < vals.size(); ++j) {
+            const dynd_int128& a = vals[i], &b = vals[j];
+            EXPECT_EQ(a * b, dynd_int128::mul_portable(a, b));
+            // Skip division by zero, and the one quotient which overflows
+            if (b != 0 && !(a == int128_min && b == -1)) {
+                dynd_int128 div = a / b, rem = a % b;
+                EXPECT_EQ(a, div * b + rem);
+                // The remainder is smaller than the divisor, and has the
+                // sign of the dividend
+                EXPECT_TRUE(rem == 0 || rem.is_negative() == a.is_negative());
+                dynd_int128 pdiv, prem;
+                dynd_int128::divrem_portable(a, b, pdiv, prem);
+                EXPECT_EQ(div, pdiv);
+                EXPECT_EQ(rem, prem);
+            }
+        }
+    }
+
+    // Division truncates toward zero
+    EXPECT_EQ(dynd_int128(-3), dynd_int128(-7) / dynd_int128(2));
+    EXPECT_EQ(dynd_int128(-1), dynd_int128(-7) % dynd_int128(2));
+    EXPECT_EQ(dynd_int128(-3), dynd_int128(7) / dynd_int128(-2));
+    EXPECT_EQ(dynd_int128(1), dynd_int128(7) % dynd_int128(-2));
+    // The minimum value works with the 32-bit divisor overloads
+    EXPECT_EQ(dynd_int128(0xc000000000000000ULL, 0ULL), int128_min / 2u);
+    EXPECT_EQ(dynd_int128(0ULL, 0ULL), int128_min * 2u);
+}
+
+TEST(Int128, Conversions) {
+    EXPECT_EQ(-1.5e30, double(dynd_int128(-1.5e30)));
+    EXPECT_EQ(1.5e30, double(dynd_int128(1.5e30)));
+    EXPECT_EQ(-1.5e30f, float(dynd_int128(-1.5e30f)));
+    EXPECT_EQ(-170141183460469231731687303715884105728.0,
+              double(numeric_limits<dynd_int128>::min()));
+    EXPECT_EQ(3.0e38, double(dynd_uint128(3.0e38)));
+    EXPECT_EQ(dynd_uint128(0ULL, 0ULL), dynd_uint128(-1.0));
+    EXPECT_EQ(-12345, (int)dynd_int128(-12345.75));
+
+    stringstream ss;
+    ss << dynd_int128(0x8000000000000000ULL, 0ULL) << " "
+       << dynd_uint128(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    EXPECT_EQ("-170141183460469231731687303715884105728 "
+              "340282366920938463463374607431768211455", ss.str());
+}
+
+TEST(Int128, Comparisons) {
+    dynd_int128 neg(-5), pos(5);
+    EXPECT_TRUE(neg < pos);
+    EXPECT_TRUE(neg <= pos);
+    EXPECT_FALSE(pos < neg);
+    EXPECT_TRUE(numeric_limits<dynd_int128>::min() < neg);
+    EXPECT_TRUE(pos < numeric_limits<dynd_int128>::max());
+    dynd_uint128 big(1ULL, 0ULL), small(0ULL, 0xffffffffffffffffULL);
+    EXPECT_TRUE(small < big);
+    EXPECT_TRUE(big >= small);
+    EXPECT_FALSE(big <= small);
+}
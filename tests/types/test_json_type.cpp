@@ -11,6 +11,8 @@
 #include <dynd/array.hpp>
 #include <dynd/types/json_type.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/json_formatter.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -38,3 +40,42 @@ TEST(JSONDType, Validation) {
 
     EXPECT_THROW(nd::array("[1,2,3]#").ucast(ndt::make_json()).eval(), invalid_argument);
 }
+
+TEST(JSONDType, BulkValidation) {
+    nd::array a = nd::empty(4, ndt::make_string());
+    a(0).vals() = "[1, 2]";
+    a(1).vals() = " {\"a\": null} ";
+    a(2).vals() = "true false";
+    a(3).vals() = "\"x\"";
+    EXPECT_EQ(2, validate_json_strings(a.get_readonly_originptr(),
+                                       a.get_strides()[0], 4));
+    EXPECT_EQ(2, validate_json_strings(a.get_readonly_originptr(),
+                                       a.get_strides()[0], 2));
+
+    // Strided assignment validates all the strings in one pass
+    nd::array b = nd::empty(4, ndt::make_json());
+    b(irange() < 2).vals() = a(irange() < 2);
+    EXPECT_EQ("[1, 2]", b(0).as<string>());
+    EXPECT_EQ(" {\"a\": null} ", b(1).as<string>());
+    b = nd::empty(4, ndt::make_json());
+    EXPECT_THROW(b.vals() = a, invalid_argument);
+    // The values before the invalid one are assigned, the rest cleared
+    EXPECT_EQ(" {\"a\": null} ", b(1).as<string>());
+    EXPECT_EQ("", b(3).as<string>());
+}
+
+TEST(JSONDType, ProducedValuesAreValid) {
+    // json values in parsed JSON, and formatted JSON, are already valid
+    nd::array a = parse_json("2 * json", "[{\"a\": [1, 2]}, \"s\"]");
+    EXPECT_EQ("{\"a\": [1, 2]}", a(0).as<string>());
+    EXPECT_EQ("\"s\"", a(1).as<string>());
+    EXPECT_THROW(parse_json("2 * json", "[{\"a\": [1, 2}, 3]"),
+                 invalid_argument);
+
+    nd::array b = format_json_value(a);
+    EXPECT_EQ(ndt::make_json(), b.get_type());
+    EXPECT_EQ("[{\"a\": [1, 2]},\"s\"]", b.as<string>());
+    nd::array c = nd::empty(ndt::make_json());
+    c.vals() = b;
+    EXPECT_EQ(b.as<string>(), c.as<string>());
+}
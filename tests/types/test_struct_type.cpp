@@ -124,6 +124,42 @@ TEST(StructType, CreateThreeField) {
     EXPECT_EQ("z", tdt->get_field_name(2));
 }
 
+TEST(StructType, ManyFieldLookup) {
+    // Enough fields that lookups go through the hash table
+    const intptr_t field_count = 300;
+    vector<string> names(field_count);
+    vector<ndt::type> types(field_count, ndt::make_type<int32_t>());
+    for (intptr_t i = 0; i < field_count; ++i) {
+        stringstream ss;
+        ss << "field_" << i;
+        names[i] = ss.str();
+    }
+    ndt::type tp = ndt::make_struct(nd::array(names), nd::array(types));
+    const base_struct_type *bsd = tp.tcast<base_struct_type>();
+    for (intptr_t i = 0; i < field_count; ++i) {
+        EXPECT_EQ(i, bsd->get_field_index(names[i]));
+    }
+    EXPECT_EQ(-1, bsd->get_field_index("field_300"));
+    EXPECT_EQ(-1, bsd->get_field_index("field_"));
+    EXPECT_EQ(-1, bsd->get_field_index(""));
+
+    vector<string> lookup;
+    lookup.push_back("field_299");
+    lookup.push_back("missing");
+    lookup.push_back("field_0");
+    vector<intptr_t> indices = bsd->get_field_indices(lookup);
+    ASSERT_EQ(3u, indices.size());
+    EXPECT_EQ(299, indices[0]);
+    EXPECT_EQ(-1, indices[1]);
+    EXPECT_EQ(0, indices[2]);
+
+    // Property access goes through the same lookup
+    nd::array a = nd::empty(tp);
+    a.vals() = 0;
+    a.p("field_123").vals() = 7;
+    EXPECT_EQ(7, a(123).as<int>());
+}
+
 TEST(StructType, ReplaceScalarTypes) {
     ndt::type dt, dt2;
 
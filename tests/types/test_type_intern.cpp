@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/types/type_intern.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/strided_dim_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+#include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(TypeIntern, EqualTypesShareInstance) {
+    ndt::type a = ndt::make_fixed_dim(3, ndt::make_var_dim(ndt::make_string()));
+    ndt::type b = ndt::type("3 * var * string");
+    EXPECT_EQ(a.extended(), b.extended());
+    EXPECT_TRUE(a.extended()->is_interned());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.get_hash(), b.get_hash());
+
+    // Differing only in the dim size, or in a field name
+    ndt::type c = ndt::make_fixed_dim(4, ndt::make_var_dim(ndt::make_string()));
+    EXPECT_NE(a.extended(), c.extended());
+    EXPECT_NE(a, c);
+    ndt::type s1 = ndt::type("{x : int32, y : float64}");
+    ndt::type s2 = ndt::type("{x : int32, y : float64}");
+    ndt::type s3 = ndt::type("{x : int32, z : float64}");
+    EXPECT_EQ(s1.extended(), s2.extended());
+    EXPECT_NE(s1, s3);
+
+    ndt::type t1 = ndt::make_tuple(ndt::make_type<int16_t>(), a);
+    ndt::type t2 = ndt::make_tuple(ndt::make_type<int16_t>(), b);
+    EXPECT_EQ(t1.extended(), t2.extended());
+}
+
+TEST(TypeIntern, RemovedWhenDestroyed) {
+    // Making the first dim type may lazily create types kept in statics
+    ndt::make_fixed_dim(12344, ndt::make_type<int8_t>());
+    intptr_t count = ndt::get_interned_type_count();
+    {
+        ndt::type a = ndt::make_fixed_dim(12345, ndt::make_type<int8_t>());
+        EXPECT_EQ(count + 1, ndt::get_interned_type_count());
+        EXPECT_EQ(1, a.extended()->get_use_count());
+        ndt::type b = ndt::make_fixed_dim(12345, ndt::make_type<int8_t>());
+        EXPECT_EQ(count + 1, ndt::get_interned_type_count());
+        EXPECT_EQ(2, a.extended()->get_use_count());
+    }
+    EXPECT_EQ(count, ndt::get_interned_type_count());
+}
+
+TEST(TypeIntern, StaticStridedInstances) {
+    // Strided dims of builtin types are static instances, which are
+    // not interned, but still compare equal to the same type
+    ndt::type a = ndt::make_strided_dim(ndt::make_type<int32_t>());
+    ndt::type b = ndt::type("strided * int32");
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.get_hash(), b.get_hash());
+    EXPECT_NE(a, ndt::type("strided * int64"));
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2011-14 Mark Wiebe, DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <stdexcept>
+#include "inc_gtest.hpp"
+
+#include <dynd/types/tz_database.hpp>
+#include <dynd/types/datetime_util.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static void append_be32(string &s, int32_t v)
+{
+    for (int i = 3; i >= 0; --i) {
+        s += static_cast<char>((v >> (8 * i)) & 0xff);
+    }
+}
+
+/**
+ * A version 2 TZif file with no transitions and one local time type,
+ * so all the transitions come from the POSIX TZ footer.
+ */
+static string make_footer_only_tzif(int32_t utoff, const char *abbrev,
+                                    const char *footer)
+{
+    string block;
+    // ttinfo: utoff, isdst, desigidx, then the abbreviation
+    append_be32(block, utoff);
+    block += '\0';
+    block += '\0';
+    block += abbrev;
+    block += '\0';
+
+    string header("TZif2", 5);
+    header.append(15, '\0');
+    append_be32(header, 0); // isutcnt
+    append_be32(header, 0); // isstdcnt
+    append_be32(header, 0); // leapcnt
+    append_be32(header, 0); // timecnt
+    append_be32(header, 1); // typecnt
+    append_be32(header, (int32_t)strlen(abbrev) + 1); // charcnt
+
+    return header + block + header + block + "\n" + footer + "\n";
+}
+
+static int64_t ticks_from_str(const char *s)
+{
+    datetime_struct dts;
+    dts.set_from_str(s);
+    return dts.to_ticks();
+}
+
+TEST(TZDatabase, POSIXFooterRules) {
+    string tzif = make_footer_only_tzif(-5 * 3600, "EST",
+                                        "EST5EDT,M3.2.0,M11.1.0");
+    tz_info tz("Test/Eastern", tzif.data(), tzif.data() + tzif.size());
+    EXPECT_EQ("Test/Eastern", tz.get_name());
+    // Two transitions a year from 1970 through 2100
+    EXPECT_EQ(2 * (2100 - 1970 + 1), tz.get_transition_count());
+
+    // 2014 DST ran from March 9 to November 2
+    EXPECT_EQ(-5 * DYND_TICKS_PER_HOUR,
+              tz.get_utc_offset(ticks_from_str("2014-03-09T06:59")));
+    EXPECT_EQ(-4 * DYND_TICKS_PER_HOUR,
+              tz.get_utc_offset(ticks_from_str("2014-03-09T07:00")));
+    EXPECT_EQ(-4 * DYND_TICKS_PER_HOUR,
+              tz.get_utc_offset(ticks_from_str("2014-11-02T05:59")));
+    EXPECT_EQ(-5 * DYND_TICKS_PER_HOUR,
+              tz.get_utc_offset(ticks_from_str("2014-11-02T06:00")));
+
+    // The interval bounds are the transitions
+    tz_interval iv;
+    tz.get_utc_interval(ticks_from_str("2014-06-01T00:00"), iv);
+    EXPECT_EQ(ticks_from_str("2014-03-09T07:00"), iv.begin);
+    EXPECT_EQ(ticks_from_str("2014-11-02T06:00"), iv.end);
+    EXPECT_EQ(-4 * DYND_TICKS_PER_HOUR, iv.offset);
+    tz.get_local_interval(ticks_from_str("2014-06-01T00:00"), iv);
+    EXPECT_EQ(ticks_from_str("2014-03-09T03:00"), iv.begin);
+    EXPECT_EQ(ticks_from_str("2014-11-02T02:00"), iv.end);
+
+    // The southern hemisphere has DST over the new year
+    tzif = make_footer_only_tzif(10 * 3600, "AEST",
+                                 "AEST-10AEDT,M10.1.0,M4.1.0/3");
+    tz_info stz("Test/Sydney", tzif.data(), tzif.data() + tzif.size());
+    EXPECT_EQ(11 * DYND_TICKS_PER_HOUR,
+              stz.get_utc_offset(ticks_from_str("2015-01-01T00:00")));
+    EXPECT_EQ(10 * DYND_TICKS_PER_HOUR,
+              stz.get_utc_offset(ticks_from_str("2015-07-01T00:00")));
+}
+
+TEST(TZDatabase, InvalidData) {
+    string tzif = "TZif2 not really";
+    EXPECT_THROW(tz_info("Bad", tzif.data(), tzif.data() + tzif.size()),
+                 runtime_error);
+    tzif = make_footer_only_tzif(0, "UTC", "UTC0");
+    tzif.resize(60);
+    EXPECT_THROW(tz_info("Bad", tzif.data(), tzif.data() + tzif.size()),
+                 runtime_error);
+}
+
+TEST(TZDatabase, SystemZones) {
+    const tz_info *tz;
+    try {
+        tz = get_tz_info("America/New_York");
+    } catch (const runtime_error&) {
+        // No zoneinfo files on this system
+        return;
+    }
+    // Each zone is loaded once
+    EXPECT_EQ(tz, get_tz_info("America/New_York"));
+    EXPECT_EQ("America/New_York", tz->get_name());
+    EXPECT_THROW(get_tz_info("America/Nowhere"), runtime_error);
+    EXPECT_THROW(get_tz_info("/etc/passwd"), runtime_error);
+
+    int64_t t = ticks_from_str("1999-12-31T23:00");
+    EXPECT_EQ(t - 5 * DYND_TICKS_PER_HOUR, tz->utc_to_local(t));
+    EXPECT_EQ(t + 5 * DYND_TICKS_PER_HOUR, tz->local_to_utc(t));
+    // Before 1883 it was local mean time
+    EXPECT_EQ(-(4 * 3600 + 56 * 60 + 2) * DYND_TICKS_PER_SECOND,
+              tz->get_utc_offset(ticks_from_str("1850-01-01T00:00")));
+}
+
+TEST(TZDatabase, OffsetToString) {
+    EXPECT_EQ("+00:00", tz_offset_to_str(0));
+    EXPECT_EQ("-05:00", tz_offset_to_str(-5 * DYND_TICKS_PER_HOUR));
+    EXPECT_EQ("+05:30", tz_offset_to_str(5 * DYND_TICKS_PER_HOUR +
+                                         30 * DYND_TICKS_PER_MINUTE));
+}
@@ -568,3 +568,46 @@ TEST(VarArrayDType, AssignAfterCreated) {
   a.vals() = vals;
   EXPECT_JSON_EQ_ARR("[1, 3, 5]", a);
 }
+
+TEST(VarArrayDType, AssignConsecutiveRows) {
+  nd::array a = parse_json("3 * var * int32", "[[1, 2], [], [3, 4, 5]]");
+  char *values;
+  intptr_t total;
+  ASSERT_TRUE(ndt::var_dim_rows_consecutive(
+      a.get_arrmeta() + sizeof(strided_dim_type_arrmeta), a.get_readonly_originptr(),
+      sizeof(var_dim_type_data), 3, &values, &total));
+  EXPECT_EQ(5, total);
+  EXPECT_EQ(3, reinterpret_cast<const int32_t *>(values)[2]);
+
+  // Assigning to fresh storage lays the rows out back to back too
+  nd::array b = nd::empty("3 * var * int64");
+  b.vals() = a;
+  EXPECT_JSON_EQ_ARR("[1, 2]", b(0));
+  EXPECT_JSON_EQ_ARR("[]", b(1));
+  EXPECT_JSON_EQ_ARR("[3, 4, 5]", b(2));
+  ASSERT_TRUE(ndt::var_dim_rows_consecutive(
+      b.get_arrmeta() + sizeof(strided_dim_type_arrmeta), b.get_readonly_originptr(),
+      sizeof(var_dim_type_data), 3, &values, &total));
+  EXPECT_EQ(5, total);
+  // And again into the now allocated rows
+  b.vals() = parse_json("3 * var * int32", "[[6, 7], [], [8, 9, 10]]");
+  EXPECT_JSON_EQ_ARR("[6, 7]", b(0));
+  EXPECT_JSON_EQ_ARR("[]", b(1));
+  EXPECT_JSON_EQ_ARR("[8, 9, 10]", b(2));
+
+  // Rows created out of order aren't consecutive, and are assigned one by one
+  nd::array c = nd::empty("3 * var * int32");
+  c(2).vals() = a(2);
+  c(0).vals() = a(0);
+  c(1).vals() = a(1);
+  EXPECT_FALSE(ndt::var_dim_rows_consecutive(
+      c.get_arrmeta() + sizeof(strided_dim_type_arrmeta), c.get_readonly_originptr(),
+      sizeof(var_dim_type_data), 3, &values, &total));
+  b.vals() = c;
+  EXPECT_JSON_EQ_ARR("[1, 2]", b(0));
+  EXPECT_JSON_EQ_ARR("[]", b(1));
+  EXPECT_JSON_EQ_ARR("[3, 4, 5]", b(2));
+  // A row size mismatch still raises the broadcast error
+  EXPECT_THROW(b.vals() = parse_json("3 * var * int32", "[[1, 2, 3], [], [4, 5]]"),
+               broadcast_error);
+}